@@ -12,6 +12,7 @@
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 /**
  * @file
@@ -32,14 +33,23 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EventTraceFile",
+                          "The file in which the executed events are recorded "
+                          "(see EventTraceRecorder); empty to disable the trace.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_eventTraceFile),
+                          MakeStringChecker());
     return tid;
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl()
+    : m_eventsWithContextInbox(EVENTS_WITH_CONTEXT_INBOX_SIZE),
+      m_eventsWithContextOverflow(false)
 {
     NS_LOG_FUNCTION(this);
     m_stop = false;
@@ -49,7 +59,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_crossThreadEventCount = 0;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -70,6 +80,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_eventTrace = nullptr;
     SimulatorImpl::DoDispose();
 }
 
@@ -128,6 +139,10 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
+    if (m_eventTrace)
+    {
+        m_eventTrace->Record(next.key.m_ts, next.key.m_context, next.key.m_uid, next.impl);
+    }
     next.impl->Invoke();
     next.impl->Unref();
 
@@ -143,7 +158,20 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContextInbox.IsEmpty() &&
+        !m_eventsWithContextOverflow.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // drain the inbox in one batch, without locking
+    EventWithContext event;
+    while (m_eventsWithContextInbox.TryPop(event))
+    {
+        InsertEventWithContext(event);
+    }
+
+    if (!m_eventsWithContextOverflow.load(std::memory_order_acquire))
     {
         return;
     }
@@ -152,24 +180,35 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
     EventsWithContext eventsWithContext;
     {
         std::unique_lock lock{m_eventsWithContextMutex};
+        // The inbox may hold events pushed before the events in the overflow
+        // list by the same thread: move them first.
+        while (m_eventsWithContextInbox.TryPop(event))
+        {
+            InsertEventWithContext(event);
+        }
         m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        m_eventsWithContextOverflow.store(false, std::memory_order_release);
     }
-    while (!eventsWithContext.empty())
+    for (const auto& ev : eventsWithContext)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
-        Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
-        ev.key.m_uid = m_uid;
-        m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        InsertEventWithContext(ev);
     }
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext(const EventWithContext& event)
+{
+    Scheduler::Event ev;
+    ev.impl = event.event;
+    ev.key.m_ts = m_currentTs + event.timestamp;
+    ev.key.m_context = event.context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_unscheduledEvents++;
+    m_crossThreadEventCount++;
+    m_events->Insert(ev);
+}
+
 void
 DefaultSimulatorImpl::Run()
 {
@@ -179,11 +218,22 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
+    if (!m_eventTraceFile.empty() && !m_eventTrace)
+    {
+        m_eventTrace = std::make_unique<EventTraceRecorder>();
+        m_eventTrace->Open(m_eventTraceFile);
+    }
+
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
     }
 
+    if (m_eventTrace)
+    {
+        m_eventTrace->RecordEndOfRun(m_currentTs);
+    }
+
     // If the simulator stopped naturally by lack of events, make a
     // consistency test to check that we didn't lose any events along the way.
     NS_ASSERT(!m_events->IsEmpty() || m_unscheduledEvents == 0);
@@ -251,10 +301,15 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
+        if (!m_eventsWithContextOverflow.load(std::memory_order_acquire) &&
+            m_eventsWithContextInbox.TryPush(ev))
+        {
+            return;
+        }
         {
             std::unique_lock lock{m_eventsWithContextMutex};
             m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
+            m_eventsWithContextOverflow.store(true, std::memory_order_release);
         }
     }
 }
@@ -384,4 +439,10 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetCrossThreadEventCount() const
+{
+    return m_crossThreadEventCount;
+}
+
 } // namespace ns3
@@ -9,9 +9,13 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-trace.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -31,6 +35,10 @@ class Scheduler;
  * @ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * The events executed by the simulator can be recorded in a compact
+ * binary trace (see EventTraceRecorder), by setting the EventTraceFile
+ * attribute.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -67,6 +75,15 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the number of events scheduled with ScheduleWithContext() by
+     * threads other than the main simulation thread (e.g., by emulation
+     * devices), and moved into the event queue so far.
+     *
+     * @return The number of cross-thread events.
+     */
+    uint64_t GetCrossThreadEventCount() const;
+
   private:
     void DoDispose() override;
 
@@ -86,17 +103,34 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
+    /**
+     * Insert an event from a different context in the main event queue.
+     *
+     * @param [in] event The event with its context.
+     */
+    void InsertEventWithContext(const EventWithContext& event);
+
+    /** Capacity of the lock-free inbox of events from a different context. */
+    static constexpr std::size_t EVENTS_WITH_CONTEXT_INBOX_SIZE = 4096;
+    /** Lock-free inbox of the events from a different context. */
+    MpscQueue<EventWithContext> m_eventsWithContextInbox;
     /** Container type for the events from a different context. */
     typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
+    /**
+     * The container of events from a different context which did not fit
+     * in the inbox.
+     */
     EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * Flag \c true if m_eventsWithContext holds events. While it is set,
+     * the other threads bypass the inbox, so that their events are kept
+     * in order.
      */
-    bool m_eventsWithContextEmpty;
+    std::atomic<bool> m_eventsWithContextOverflow;
     /** Mutex to control access to the list of events with context. */
     std::mutex m_eventsWithContextMutex;
+    /** Number of events from a different context moved to the event queue. */
+    uint64_t m_crossThreadEventCount;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -125,6 +159,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Event trace file name, or empty to disable the event trace. */
+    std::string m_eventTraceFile;
+    /** The event trace recorder, if enabled. */
+    std::unique_ptr<EventTraceRecorder> m_eventTrace;
 };
 
 } // namespace ns3
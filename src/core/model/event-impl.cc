@@ -8,6 +8,7 @@
 
 #include "event-impl.h"
 
+#include "event-pool.h"
 #include "log.h"
 
 /**
@@ -56,4 +57,28 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+void*
+EventImpl::operator new(std::size_t size)
+{
+    return EventPool::Allocate(size);
+}
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    EventPool::Deallocate(p, size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size, std::align_val_t alignment)
+{
+    ::operator delete(p, size, alignment);
+}
+
 } // namespace ns3
@@ -10,6 +10,8 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
 
 /**
@@ -30,6 +32,9 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from the EventPool, to avoid the cost of
+ * the global allocator on each scheduled event.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -56,6 +61,37 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate an event from the EventPool.
+     *
+     * @param [in] size The size of the event object.
+     * @return The allocated memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Allocate an over-aligned event, with the global allocator.
+     *
+     * @param [in] size The size of the event object.
+     * @param [in] alignment The alignment of the event object.
+     * @return The allocated memory.
+     */
+    static void* operator new(std::size_t size, std::align_val_t alignment);
+    /**
+     * Give the memory of an event back to the EventPool.
+     *
+     * @param [in] p The memory of the event object.
+     * @param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Free the memory of an over-aligned event.
+     *
+     * @param [in] p The memory of the event object.
+     * @param [in] size The size of the event object.
+     * @param [in] alignment The alignment of the event object.
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t alignment);
+
   protected:
     /**
      * Implementation for Invoke().
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <set>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup events
+ * ns3::EventPool implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+
+/** Number of size classes. */
+constexpr std::size_t N_SIZE_CLASSES =
+    EventPool::MAX_BLOCK_SIZE / EventPool::SIZE_CLASS_GRANULARITY;
+
+/**
+ * Get the size class of a block.
+ *
+ * @param [in] size The requested size, in bytes.
+ * @return The index of the smallest size class which can hold \p size bytes.
+ */
+inline std::size_t
+GetSizeClass(std::size_t size)
+{
+    return size == 0 ? 0 : (size - 1) / EventPool::SIZE_CLASS_GRANULARITY;
+}
+
+/**
+ * Get the size of the blocks of a size class.
+ *
+ * @param [in] sizeClass The size class.
+ * @return The block size, in bytes.
+ */
+inline std::size_t
+GetBlockSize(std::size_t sizeClass)
+{
+    return (sizeClass + 1) * EventPool::SIZE_CLASS_GRANULARITY;
+}
+
+/**
+ * Increment a counter which is only written by the owning thread, but
+ * can be read by the other threads.
+ *
+ * @param [in,out] counter The counter.
+ * @param [in] value The increment.
+ */
+inline void
+Increment(std::atomic<uint64_t>& counter, uint64_t value = 1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/** A free block, linked in a free list. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block.
+};
+
+/** An intrusive list of free blocks. */
+struct FreeList
+{
+    FreeBlock* head{nullptr}; //!< First block.
+    uint32_t length{0};       //!< Number of blocks.
+
+    /**
+     * Push a block at the head of the list.
+     * @param [in] p The block.
+     */
+    void Push(void* p)
+    {
+        auto block = static_cast<FreeBlock*>(p);
+        block->next = head;
+        head = block;
+        length++;
+    }
+
+    /**
+     * Pop the block at the head of the list.
+     * @return The block, or \c nullptr if the list is empty.
+     */
+    void* Pop()
+    {
+        FreeBlock* block = head;
+        if (block != nullptr)
+        {
+            head = block->next;
+            length--;
+        }
+        return block;
+    }
+
+    /**
+     * Move blocks to the head of another list.
+     * @param [in,out] other The destination list.
+     * @param [in] count The maximum number of blocks to move.
+     */
+    void MoveTo(FreeList& other, uint32_t count)
+    {
+        while (count-- > 0 && head != nullptr)
+        {
+            other.Push(Pop());
+        }
+    }
+};
+
+class ThreadCache;
+
+/**
+ * The state shared by all the threads, protected by a mutex.
+ *
+ * It is allocated on the first use and deleted at exit by the
+ * GlobalPoolReleaser, unless some blocks are still in use then.
+ */
+struct GlobalPool
+{
+    /** Mutex protecting the pool. */
+    std::mutex mutex;
+    /** Free blocks given back by the threads. */
+    FreeList lists[N_SIZE_CLASSES];
+    /** Lengths of the free lists, which can be read without lock. */
+    std::atomic<uint32_t> lengths[N_SIZE_CLASSES]{};
+    /** All the slabs. */
+    std::vector<void*> slabs;
+    /** The blocks allocated outside of the slabs by the exiting threads. */
+    std::vector<void*> blocks;
+    /** The per-thread caches alive. */
+    std::set<const ThreadCache*> caches;
+    /** Counters of the threads which exited. */
+    EventPool::Stats retired{};
+
+    /**
+     * Move blocks to the global free list of a size class.
+     * @param [in,out] list The list of blocks to move.
+     * @param [in] sizeClass The size class.
+     * @param [in] count The maximum number of blocks to move.
+     */
+    void Give(FreeList& list, std::size_t sizeClass, uint32_t count)
+    {
+        std::unique_lock lock{mutex};
+        list.MoveTo(lists[sizeClass], count);
+        lengths[sizeClass].store(lists[sizeClass].length, std::memory_order_relaxed);
+    }
+
+    /**
+     * Move blocks from the global free list of a size class.
+     * @param [in,out] list The list receiving the blocks.
+     * @param [in] sizeClass The size class.
+     * @param [in] count The maximum number of blocks to move.
+     */
+    void Take(FreeList& list, std::size_t sizeClass, uint32_t count)
+    {
+        std::unique_lock lock{mutex};
+        lists[sizeClass].MoveTo(list, count);
+        lengths[sizeClass].store(lists[sizeClass].length, std::memory_order_relaxed);
+    }
+};
+
+/** The global pool, or \c nullptr if not created yet or released. */
+GlobalPool* g_pool = nullptr;
+/** Whether the global pool was released at exit. */
+bool g_poolReleased = false;
+
+/**
+ * Get the global pool.
+ * @return The global pool.
+ */
+GlobalPool&
+GetGlobalPool()
+{
+    static auto pool = g_pool = new GlobalPool();
+    return *pool;
+}
+
+/**
+ * Releases the global pool and its slabs at exit.
+ *
+ * The thread-local caches of the main thread are destroyed before this
+ * object, hence their blocks are back in the global pool by then.  If
+ * some blocks are still in use (e.g., by another thread, or by events
+ * which were not freed), the pool is kept, since the blocks could be
+ * freed later during the destruction of the static objects.  Once the
+ * pool is released, the blocks are allocated with the global
+ * `operator new`.
+ */
+struct GlobalPoolReleaser
+{
+    ~GlobalPoolReleaser()
+    {
+        if (g_pool == nullptr)
+        {
+            return;
+        }
+        {
+            std::unique_lock lock{g_pool->mutex};
+            if (!g_pool->caches.empty() ||
+                g_pool->retired.allocations != g_pool->retired.deallocations)
+            {
+                return;
+            }
+            for (auto slab : g_pool->slabs)
+            {
+                ::operator delete(slab);
+            }
+            for (auto block : g_pool->blocks)
+            {
+                ::operator delete(block);
+            }
+        }
+        delete g_pool;
+        g_pool = nullptr;
+        g_poolReleased = true;
+    }
+};
+
+/** The releaser of the global pool. */
+GlobalPoolReleaser g_globalPoolReleaser;
+
+/** The free lists and counters of a thread. */
+class ThreadCache
+{
+  public:
+    ThreadCache()
+    {
+        auto& pool = GetGlobalPool();
+        std::unique_lock lock{pool.mutex};
+        pool.caches.insert(this);
+    }
+
+    ~ThreadCache()
+    {
+        // give all the blocks to the global pool, including the
+        // remainder of the slabs being carved
+        auto& pool = GetGlobalPool();
+        std::unique_lock lock{pool.mutex};
+        for (std::size_t sizeClass = 0; sizeClass < N_SIZE_CLASSES; ++sizeClass)
+        {
+            std::size_t blockSize = GetBlockSize(sizeClass);
+            while (static_cast<std::size_t>(m_bumpEnd[sizeClass] - m_bump[sizeClass]) >= blockSize)
+            {
+                m_lists[sizeClass].Push(m_bump[sizeClass]);
+                m_bump[sizeClass] += blockSize;
+            }
+            m_lists[sizeClass].MoveTo(pool.lists[sizeClass], m_lists[sizeClass].length);
+            pool.lengths[sizeClass].store(pool.lists[sizeClass].length, std::memory_order_relaxed);
+        }
+        AddStats(pool.retired);
+        pool.caches.erase(this);
+    }
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    /**
+     * Allocate a block.
+     * @param [in] sizeClass The size class.
+     * @return The block.
+     */
+    void* Allocate(std::size_t sizeClass)
+    {
+        Increment(m_allocations);
+        FreeList& list = m_lists[sizeClass];
+        if (list.head == nullptr)
+        {
+            auto& pool = GetGlobalPool();
+            if (pool.lengths[sizeClass].load(std::memory_order_relaxed) > 0)
+            {
+                pool.Take(list, sizeClass, EventPool::MAX_CACHED_BLOCKS / 2);
+            }
+        }
+        if (void* p = list.Pop())
+        {
+            Increment(m_recycled);
+            return p;
+        }
+
+        std::size_t blockSize = GetBlockSize(sizeClass);
+        if (static_cast<std::size_t>(m_bumpEnd[sizeClass] - m_bump[sizeClass]) < blockSize)
+        {
+            auto slab = static_cast<char*>(::operator new(EventPool::SLAB_SIZE));
+            {
+                auto& pool = GetGlobalPool();
+                std::unique_lock lock{pool.mutex};
+                pool.slabs.push_back(slab);
+            }
+            Increment(m_slabs);
+            Increment(m_slabBytes, EventPool::SLAB_SIZE);
+            m_bump[sizeClass] = slab;
+            m_bumpEnd[sizeClass] = slab + EventPool::SLAB_SIZE;
+        }
+        void* p = m_bump[sizeClass];
+        m_bump[sizeClass] += blockSize;
+        return p;
+    }
+
+    /**
+     * Free a block.
+     * @param [in] p The block.
+     * @param [in] sizeClass The size class.
+     */
+    void Deallocate(void* p, std::size_t sizeClass)
+    {
+        Increment(m_deallocations);
+        FreeList& list = m_lists[sizeClass];
+        list.Push(p);
+        if (list.length > EventPool::MAX_CACHED_BLOCKS)
+        {
+            // the blocks are freed by this thread but allocated by another one
+            GetGlobalPool().Give(list, sizeClass, EventPool::MAX_CACHED_BLOCKS / 2);
+        }
+    }
+
+    /** Count an allocation too large for the pool. */
+    void CountLargeAllocation()
+    {
+        Increment(m_allocations);
+        Increment(m_largeAllocations);
+    }
+
+    /** Count the deallocation of a block too large for the pool. */
+    void CountLargeDeallocation()
+    {
+        Increment(m_deallocations);
+    }
+
+    /**
+     * Add the counters of this cache.
+     * @param [in,out] stats The statistics to add the counters to.
+     */
+    void AddStats(EventPool::Stats& stats) const
+    {
+        stats.allocations += m_allocations.load(std::memory_order_relaxed);
+        stats.deallocations += m_deallocations.load(std::memory_order_relaxed);
+        stats.recycled += m_recycled.load(std::memory_order_relaxed);
+        stats.slabs += m_slabs.load(std::memory_order_relaxed);
+        stats.slabBytes += m_slabBytes.load(std::memory_order_relaxed);
+        stats.largeAllocations += m_largeAllocations.load(std::memory_order_relaxed);
+    }
+
+  private:
+    FreeList m_lists[N_SIZE_CLASSES]{};          //!< Free blocks.
+    char* m_bump[N_SIZE_CLASSES]{};              //!< Next block of the slab being carved.
+    char* m_bumpEnd[N_SIZE_CLASSES]{};           //!< End of the slab being carved.
+    std::atomic<uint64_t> m_allocations{0};      //!< Number of allocations.
+    std::atomic<uint64_t> m_deallocations{0};    //!< Number of deallocations.
+    std::atomic<uint64_t> m_recycled{0};         //!< Number of recycled blocks.
+    std::atomic<uint64_t> m_slabs{0};            //!< Number of slabs.
+    std::atomic<uint64_t> m_slabBytes{0};        //!< Size of the slabs.
+    std::atomic<uint64_t> m_largeAllocations{0}; //!< Number of large allocations.
+};
+
+/** The cache of the current thread, or \c nullptr if not created yet or destroyed. */
+thread_local ThreadCache* t_cache = nullptr;
+/** Whether the cache of the current thread was destroyed. */
+thread_local bool t_cacheDestroyed = false;
+
+/** Owner of the cache of a thread, which clears t_cache when the thread exits. */
+struct ThreadCacheOwner
+{
+    ThreadCache cache; //!< The cache.
+
+    ThreadCacheOwner()
+    {
+        t_cache = &cache;
+    }
+
+    ~ThreadCacheOwner()
+    {
+        t_cache = nullptr;
+        t_cacheDestroyed = true;
+    }
+};
+
+/**
+ * Get the cache of the current thread.
+ * @return The cache, or \c nullptr if the thread is exiting.
+ */
+inline ThreadCache*
+GetThreadCache()
+{
+    if (t_cache != nullptr)
+    {
+        return t_cache;
+    }
+    if (t_cacheDestroyed || g_poolReleased)
+    {
+        return nullptr;
+    }
+    static thread_local ThreadCacheOwner owner;
+    return t_cache;
+}
+
+} // namespace
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (cache == nullptr && g_poolReleased)
+    {
+        return ::operator new(size);
+    }
+    if (size > MAX_BLOCK_SIZE)
+    {
+        if (cache != nullptr)
+        {
+            cache->CountLargeAllocation();
+        }
+        else
+        {
+            auto& pool = GetGlobalPool();
+            std::unique_lock lock{pool.mutex};
+            pool.retired.allocations++;
+            pool.retired.largeAllocations++;
+        }
+        return ::operator new(size);
+    }
+    std::size_t sizeClass = GetSizeClass(size);
+    if (cache != nullptr)
+    {
+        return cache->Allocate(sizeClass);
+    }
+
+    // the thread is exiting: use the global pool
+    auto& pool = GetGlobalPool();
+    std::unique_lock lock{pool.mutex};
+    pool.retired.allocations++;
+    if (void* p = pool.lists[sizeClass].Pop())
+    {
+        pool.retired.recycled++;
+        pool.lengths[sizeClass].store(pool.lists[sizeClass].length, std::memory_order_relaxed);
+        return p;
+    }
+    void* p = ::operator new(GetBlockSize(sizeClass));
+    pool.blocks.push_back(p);
+    return p;
+}
+
+void
+EventPool::Deallocate(void* p, std::size_t size)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (cache == nullptr && g_poolReleased)
+    {
+        ::operator delete(p);
+        return;
+    }
+    if (size > MAX_BLOCK_SIZE)
+    {
+        if (cache != nullptr)
+        {
+            cache->CountLargeDeallocation();
+        }
+        else
+        {
+            auto& pool = GetGlobalPool();
+            std::unique_lock lock{pool.mutex};
+            pool.retired.deallocations++;
+        }
+        ::operator delete(p);
+        return;
+    }
+    std::size_t sizeClass = GetSizeClass(size);
+    if (cache != nullptr)
+    {
+        cache->Deallocate(p, sizeClass);
+        return;
+    }
+
+    // the thread is exiting: use the global pool
+    auto& pool = GetGlobalPool();
+    std::unique_lock lock{pool.mutex};
+    pool.retired.deallocations++;
+    pool.lists[sizeClass].Push(p);
+    pool.lengths[sizeClass].store(pool.lists[sizeClass].length, std::memory_order_relaxed);
+}
+
+EventPool::Stats
+EventPool::GetStats()
+{
+    if (g_poolReleased)
+    {
+        return Stats{};
+    }
+    auto& pool = GetGlobalPool();
+    std::unique_lock lock{pool.mutex};
+    Stats stats = pool.retired;
+    for (const auto cache : pool.caches)
+    {
+        cache->AddStats(stats);
+    }
+    return stats;
+}
+
+} // namespace ns3
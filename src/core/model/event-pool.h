@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file
+ * @ingroup events
+ * ns3::EventPool declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup events
+ * @brief Pooled allocator for the EventImpl objects.
+ *
+ * Every scheduled event allocates an EventImpl subclass, which is freed
+ * once the event is executed or cancelled.  To avoid the corresponding
+ * malloc/free churn, EventImpl overrides its class-specific
+ * `operator new` and `operator delete` to allocate from this pool.
+ *
+ * The memory is allocated in slabs, which are carved into blocks of a
+ * few size classes (multiples of SIZE_CLASS_GRANULARITY bytes, up to
+ * MAX_BLOCK_SIZE bytes); larger objects are allocated with the global
+ * `operator new`.  Freed blocks are recycled through per-thread free
+ * lists, so that neither allocation nor deallocation takes a lock in
+ * the common case.  As events can be created in one thread and freed in
+ * another one (e.g., with ScheduleWithContext() from a foreign thread, or
+ * with the MultithreadedSimulatorImpl), a per-thread free list which
+ * grows beyond MAX_CACHED_BLOCKS blocks gives half of its blocks back to
+ * a global free list, from which the other threads refill.  The slabs
+ * are returned to the system at exit, provided that all the blocks have
+ * been freed by then.
+ *
+ * The pool keeps counters, which can be read with GetStats() to check
+ * the allocation rate, e.g., with `utils/bench-scheduler`.
+ */
+class EventPool
+{
+  public:
+    /** Allocator statistics. */
+    struct Stats
+    {
+        uint64_t allocations;      //!< Number of blocks allocated.
+        uint64_t deallocations;    //!< Number of blocks freed.
+        uint64_t recycled;         //!< Number of allocations served by a free list.
+        uint64_t slabs;            //!< Number of slabs allocated from the system.
+        uint64_t slabBytes;        //!< Total size of the slabs.
+        uint64_t largeAllocations; //!< Number of allocations too large for the pool.
+    };
+
+    /** The size classes are multiples of this size, in bytes. */
+    static constexpr std::size_t SIZE_CLASS_GRANULARITY = 16;
+    /** Largest size served by the pool, in bytes. */
+    static constexpr std::size_t MAX_BLOCK_SIZE = 256;
+    /** Size of a slab, in bytes. */
+    static constexpr std::size_t SLAB_SIZE = 16384;
+    /** Maximum number of blocks in a per-thread free list of a size class. */
+    static constexpr uint32_t MAX_CACHED_BLOCKS = 1024;
+
+    /**
+     * Allocate a block.
+     *
+     * @param [in] size The size of the block, in bytes.
+     * @return The block.
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Free a block.
+     *
+     * @param [in] p The block, as returned by Allocate().
+     * @param [in] size The size passed to Allocate().
+     */
+    static void Deallocate(void* p, std::size_t size);
+
+    /**
+     * Get the allocator statistics, summed over all the threads.
+     *
+     * @return The statistics.
+     */
+    static Stats GetStats();
+};
+
+} // namespace ns3
+
+#endif /* EVENT_POOL_H */
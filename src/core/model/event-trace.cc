@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-trace.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "hash.h"
+#include "log.h"
+
+#include <cstring>
+#include <typeinfo>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceRecorder and ns3::EventTraceReader implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventTrace");
+
+namespace
+{
+
+/** Size of the record buffer of the recorder, in records. */
+constexpr std::size_t BUFFER_RECORDS = 32768;
+/** Size of the header of a trace file. */
+constexpr std::size_t HEADER_SIZE = 8 + 4;
+/** Size of the trailer of a closed trace file. */
+constexpr std::size_t TRAILER_SIZE = 8 + 8;
+
+/**
+ * Copy a value into a buffer.
+ *
+ * @tparam T \deduced The value type.
+ * @param [in,out] p The buffer position, advanced past the value.
+ * @param [in] value The value.
+ */
+template <typename T>
+inline void
+Put(char*& p, T value)
+{
+    std::memcpy(p, &value, sizeof(T));
+    p += sizeof(T);
+}
+
+/**
+ * Copy a value from a buffer.
+ *
+ * @tparam T \deduced The value type.
+ * @param [in,out] p The buffer position, advanced past the value.
+ * @param [out] value The value.
+ */
+template <typename T>
+inline void
+Get(const char*& p, T& value)
+{
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+}
+
+} // namespace
+
+EventTraceRecorder::EventTraceRecorder()
+    : m_buffer(BUFFER_RECORDS * EventTraceRecord::SIZE),
+      m_used(0),
+      m_typeCache{}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventTraceRecorder::~EventTraceRecorder()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+EventTraceRecorder::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_os.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_os.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open event trace file " << filename);
+    }
+    m_os.write(MAGIC, 8);
+    uint32_t version = VERSION;
+    m_os.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_used = 0;
+    m_start = std::chrono::steady_clock::now();
+}
+
+void
+EventTraceRecorder::Record(uint64_t timestamp,
+                           uint32_t context,
+                           uint32_t uid,
+                           const EventImpl* event)
+{
+    auto wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - m_start)
+                        .count();
+    Append({timestamp, static_cast<uint64_t>(wallTime), context, uid, GetTypeHash(event)});
+}
+
+void
+EventTraceRecorder::RecordEndOfRun(uint64_t timestamp)
+{
+    NS_LOG_FUNCTION(this << timestamp);
+    auto wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - m_start)
+                        .count();
+    Append({timestamp, static_cast<uint64_t>(wallTime), 0, 0, EventTraceRecord::END_OF_RUN});
+}
+
+void
+EventTraceRecorder::Append(const EventTraceRecord& record)
+{
+    if (m_used == m_buffer.size())
+    {
+        Flush();
+    }
+    char* p = m_buffer.data() + m_used;
+    Put(p, record.timestamp);
+    Put(p, record.wallTime);
+    Put(p, record.context);
+    Put(p, record.uid);
+    Put(p, record.typeHash);
+    m_used += EventTraceRecord::SIZE;
+}
+
+uint32_t
+EventTraceRecorder::GetTypeHash(const EventImpl* event)
+{
+    // type_info names are unique strings, whose address can be used as key
+    const char* name = typeid(*event).name();
+    auto& entry = m_typeCache[(reinterpret_cast<uintptr_t>(name) >> 4) % m_typeCache.size()];
+    if (entry.first == name)
+    {
+        return entry.second;
+    }
+
+    auto it = m_hashes.find(name);
+    if (it == m_hashes.end())
+    {
+        uint32_t hash = Hash32(name);
+        if (hash == EventTraceRecord::END_OF_RUN)
+        {
+            hash++;
+        }
+        it = m_hashes.emplace(name, hash).first;
+        m_names.emplace(hash, Demangle(name));
+    }
+    entry = *it;
+    return it->second;
+}
+
+void
+EventTraceRecorder::Flush()
+{
+    m_os.write(m_buffer.data(), m_used);
+    m_used = 0;
+}
+
+void
+EventTraceRecorder::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_os.is_open())
+    {
+        return;
+    }
+    Flush();
+
+    uint64_t offset = m_os.tellp();
+    uint32_t count = m_names.size();
+    m_os.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& [hash, name] : m_names)
+    {
+        uint32_t length = name.size();
+        m_os.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        m_os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        m_os.write(name.data(), length);
+    }
+    m_os.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    m_os.write(END_MAGIC, 8);
+    m_os.close();
+}
+
+EventTraceReader::EventTraceReader(const std::string& filename)
+    : m_is(filename, std::ios::binary),
+      m_ok(false),
+      m_position(HEADER_SIZE),
+      m_end(HEADER_SIZE)
+{
+    NS_LOG_FUNCTION(this << filename);
+    char header[HEADER_SIZE];
+    if (!m_is.read(header, HEADER_SIZE) ||
+        std::memcmp(header, EventTraceRecorder::MAGIC, 8) != 0)
+    {
+        NS_LOG_WARN(filename << " is not an event trace");
+        return;
+    }
+    uint32_t version;
+    std::memcpy(&version, header + 8, sizeof(version));
+    if (version != EventTraceRecorder::VERSION)
+    {
+        NS_LOG_WARN(filename << ": unsupported event trace version " << version);
+        return;
+    }
+
+    m_is.seekg(0, std::ios::end);
+    uint64_t size = m_is.tellg();
+    m_end = HEADER_SIZE + (size - HEADER_SIZE) / EventTraceRecord::SIZE * EventTraceRecord::SIZE;
+    m_ok = true;
+    ReadTypeNames(size);
+    // the records are then read sequentially
+    m_is.clear();
+    m_is.seekg(HEADER_SIZE);
+}
+
+void
+EventTraceReader::ReadTypeNames(uint64_t size)
+{
+    char trailer[TRAILER_SIZE];
+    if (size < HEADER_SIZE + TRAILER_SIZE)
+    {
+        return;
+    }
+    m_is.seekg(size - TRAILER_SIZE);
+    m_is.read(trailer, TRAILER_SIZE);
+    if (std::memcmp(trailer + 8, EventTraceRecorder::END_MAGIC, 8) != 0)
+    {
+        NS_LOG_WARN("Event trace not closed, type names are missing");
+        return;
+    }
+    uint64_t offset;
+    std::memcpy(&offset, trailer, sizeof(offset));
+    m_end = offset;
+    m_is.seekg(offset);
+    uint32_t count = 0;
+    m_is.read(reinterpret_cast<char*>(&count), sizeof(count));
+    for (uint32_t i = 0; i < count && m_is; ++i)
+    {
+        uint32_t hash;
+        uint32_t length;
+        m_is.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+        m_is.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string name(length, '\0');
+        m_is.read(name.data(), length);
+        m_names[hash] = name;
+    }
+}
+
+bool
+EventTraceReader::IsOk() const
+{
+    return m_ok;
+}
+
+bool
+EventTraceReader::Read(EventTraceRecord& record)
+{
+    if (!m_ok || m_position + EventTraceRecord::SIZE > m_end)
+    {
+        return false;
+    }
+    char buffer[EventTraceRecord::SIZE];
+    if (!m_is.read(buffer, EventTraceRecord::SIZE))
+    {
+        return false;
+    }
+    m_position += EventTraceRecord::SIZE;
+    const char* p = buffer;
+    Get(p, record.timestamp);
+    Get(p, record.wallTime);
+    Get(p, record.context);
+    Get(p, record.uid);
+    Get(p, record.typeHash);
+    return true;
+}
+
+std::string
+EventTraceReader::GetTypeName(uint32_t typeHash) const
+{
+    auto it = m_names.find(typeHash);
+    if (it != m_names.end())
+    {
+        return it->second;
+    }
+    return "type-" + std::to_string(typeHash);
+}
+
+} // namespace ns3
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceRecorder and ns3::EventTraceReader declarations.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ * @brief A record of an event trace.
+ */
+struct EventTraceRecord
+{
+    uint64_t timestamp; //!< Event timestamp, in time steps.
+    uint64_t wallTime;  //!< Wall clock time at the event start, in ns since Open().
+    uint32_t context;   //!< Event context.
+    uint32_t uid;       //!< Event unique id.
+    uint32_t typeHash;  //!< Hash of the type name of the event, or END_OF_RUN.
+
+    /** Type hash of the records marking the end of a Simulator::Run(). */
+    static constexpr uint32_t END_OF_RUN = 0;
+    /** Size of a serialized record, in bytes. */
+    static constexpr std::size_t SIZE = 28;
+
+    /**
+     * Check whether this record marks the end of a Simulator::Run().
+     *
+     * @return \c true if this is an end of run record.
+     */
+    bool IsEndOfRun() const
+    {
+        return typeHash == END_OF_RUN;
+    }
+};
+
+/**
+ * @ingroup simulator
+ * @brief Record the events executed by a simulator in a compact binary file.
+ *
+ * Unlike DesMetrics, which writes a JSON line for each scheduled event,
+ * the recorder appends a fixed-size binary record for each executed
+ * event to a memory buffer, which is written to the file when full.
+ * Each record holds the event timestamp, context and uid, the hash of
+ * the type name of the event (i.e., of the EventImpl subclass created by
+ * MakeEvent(), which identifies the signature of the callback and the
+ * types of its bound arguments), and the wall clock time at which the
+ * event started.  The wall clock time spent by an event is the difference
+ * with the start time of the next record.
+ *
+ * The file starts with an 8-byte magic string and a 4-byte version; the
+ * table of the type names is written after the records when the
+ * recorder is closed, followed by its offset and a second magic string.
+ * The records of a trace which was not closed (e.g., after a crash) can
+ * still be read, without the type names.
+ *
+ * The recorder is enabled with the
+ * ns3::DefaultSimulatorImpl::EventTraceFile attribute, and the traces
+ * can be summarized and compared with `utils/event-trace.cc`.
+ */
+class EventTraceRecorder
+{
+  public:
+    /** Constructor. */
+    EventTraceRecorder();
+    /** Destructor, closing the trace. */
+    ~EventTraceRecorder();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    EventTraceRecorder(const EventTraceRecorder&) = delete;
+    EventTraceRecorder& operator=(const EventTraceRecorder&) = delete;
+
+    /**
+     * Open the trace file, and write the header.
+     *
+     * @param [in] filename The trace file name.
+     */
+    void Open(const std::string& filename);
+
+    /**
+     * Record an event, before it is executed.
+     *
+     * @param [in] timestamp The event timestamp.
+     * @param [in] context The event context.
+     * @param [in] uid The event unique id.
+     * @param [in] event The event implementation.
+     */
+    void Record(uint64_t timestamp, uint32_t context, uint32_t uid, const EventImpl* event);
+
+    /**
+     * Record the end of a Simulator::Run(), which ends the wall clock
+     * time spent by the last event.
+     *
+     * @param [in] timestamp The current simulation time.
+     */
+    void RecordEndOfRun(uint64_t timestamp);
+
+    /** Write the table of the type names, and close the trace file. */
+    void Close();
+
+    /** Magic string at the start of the trace file. */
+    static constexpr char MAGIC[9] = "NS3EVTRC";
+    /** Magic string at the end of the trace file. */
+    static constexpr char END_MAGIC[9] = "NS3EVTND";
+    /** Version of the trace format. */
+    static constexpr uint32_t VERSION = 1;
+
+  private:
+    /**
+     * Append a record to the buffer.
+     *
+     * @param [in] record The record.
+     */
+    void Append(const EventTraceRecord& record);
+
+    /**
+     * Get the hash of the type name of an event.
+     *
+     * @param [in] event The event implementation.
+     * @return The hash of its type name.
+     */
+    uint32_t GetTypeHash(const EventImpl* event);
+
+    /** Write the buffer to the file. */
+    void Flush();
+
+    std::ofstream m_os;                                 //!< The trace file.
+    std::vector<char> m_buffer;                         //!< The record buffer.
+    std::size_t m_used;                                 //!< Bytes used in the buffer.
+    std::chrono::steady_clock::time_point m_start;      //!< Wall clock time at Open().
+    std::unordered_map<const char*, uint32_t> m_hashes; //!< Type hashes by type name.
+    /** Direct-mapped cache of m_hashes, which is faster to look up. */
+    std::array<std::pair<const char*, uint32_t>, 256> m_typeCache;
+    std::map<uint32_t, std::string> m_names; //!< Type names by hash.
+};
+
+/**
+ * @ingroup simulator
+ * @brief Read an event trace written by an EventTraceRecorder.
+ */
+class EventTraceReader
+{
+  public:
+    /**
+     * Open a trace file.
+     *
+     * @param [in] filename The trace file name.
+     */
+    EventTraceReader(const std::string& filename);
+
+    /**
+     * Check whether the trace file was opened successfully.
+     *
+     * @return \c true if the file is a valid trace.
+     */
+    bool IsOk() const;
+
+    /**
+     * Read the next record.
+     *
+     * @param [out] record The record.
+     * @return \c false if there are no more records.
+     */
+    bool Read(EventTraceRecord& record);
+
+    /**
+     * Get the name of an event type.
+     *
+     * @param [in] typeHash The hash of the type name.
+     * @return The (demangled) type name, or the hash if the trace holds no name for it.
+     */
+    std::string GetTypeName(uint32_t typeHash) const;
+
+  private:
+    /**
+     * Read the table of the type names, if the trace was closed.
+     *
+     * @param [in] size The size of the trace file.
+     */
+    void ReadTypeNames(uint64_t size);
+
+    std::ifstream m_is;                      //!< The trace file.
+    bool m_ok;                               //!< Whether the trace file is valid.
+    uint64_t m_position;                     //!< Offset of the next record.
+    uint64_t m_end;                          //!< Offset of the end of the records.
+    std::map<uint32_t, std::string> m_names; //!< Type names by hash.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
@@ -224,6 +224,17 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
+            if (IsBottom(i))
+            {
+                // the last event was removed
+                return;
+            }
+            // the event moved to index i may be earlier than its parent
+            while (!IsRoot(i) && IsLessStrictly(i, Parent(i)))
+            {
+                Exch(i, Parent(i));
+                i = Parent(i);
+            }
             TopDown(i);
             return;
         }
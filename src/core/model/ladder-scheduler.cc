@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "The maximum number of events in a bucket which is sorted "
+                          "into the bottom; larger buckets are split into a new rung",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "The maximum number of rungs in the ladder",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_qSize(0),
+      m_threshold(50),
+      m_maxRungs(8)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::Rung::CurrentStart() const
+{
+    return start + current * width;
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_qSize++;
+    uint64_t ts = ev.key.m_ts;
+
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else
+    {
+        bool inserted = false;
+        for (auto& rung : m_rungs)
+        {
+            if (ts >= rung.CurrentStart())
+            {
+                std::size_t bucket = (ts - rung.start) / rung.width;
+                NS_ASSERT(bucket < rung.buckets.size());
+                rung.buckets[bucket].push_back(ev);
+                rung.count++;
+                inserted = true;
+                break;
+            }
+        }
+        if (!inserted)
+        {
+            InsertBottom(ev);
+        }
+    }
+
+    if (m_bottom.empty())
+    {
+        RefillBottom();
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Scheduler::Event& ev)
+{
+    // the bottom is sorted in decreasing order, to pop the next event from its back
+    m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>()), ev);
+
+    if (m_bottom.size() > m_threshold && m_rungs.size() < m_maxRungs &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // too many events to keep sorted: move them to a new rung, which
+        // must cover all the timestamps up to the lowest rung
+        uint64_t boundary = m_rungs.empty() ? m_topStart : m_rungs.back().CurrentStart();
+        Events events;
+        events.swap(m_bottom);
+        SpawnRung(events, events.back().key.m_ts, boundary);
+        RefillBottom();
+    }
+}
+
+void
+LadderScheduler::SpawnRung(Events& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    NS_ASSERT(end > start);
+    uint64_t span = end - start;
+    uint64_t n = std::max<uint64_t>(1, std::min<uint64_t>(events.size(), span));
+
+    Rung rung;
+    rung.start = start;
+    rung.width = (span + n - 1) / n;
+    rung.current = 0;
+    rung.count = events.size();
+    rung.buckets.resize((span + rung.width - 1) / rung.width);
+    for (const auto& ev : events)
+    {
+        std::size_t bucket = (ev.key.m_ts - start) / rung.width;
+        NS_ASSERT(bucket < rung.buckets.size());
+        rung.buckets[bucket].push_back(ev);
+    }
+    events.clear();
+    m_rungs.push_back(std::move(rung));
+}
+
+void
+LadderScheduler::RefillBottom()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_bottom.empty());
+
+    while (m_bottom.empty() && m_qSize > 0)
+    {
+        if (m_rungs.empty())
+        {
+            NS_ASSERT(!m_top.empty());
+            if (m_top.size() <= m_threshold || m_topMin == m_topMax)
+            {
+                // few events: sort them directly into the bottom
+                m_bottom.swap(m_top);
+                std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+                m_topStart = m_topMax + 1;
+            }
+            else
+            {
+                // start a new epoch
+                SpawnRung(m_top, m_topMin, m_topMax + 1);
+                const Rung& rung = m_rungs.back();
+                m_topStart = rung.start + rung.buckets.size() * rung.width;
+            }
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            continue;
+        }
+
+        Rung& rung = m_rungs.back();
+        if (rung.count == 0)
+        {
+            m_rungs.pop_back();
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        Events& bucket = rung.buckets[rung.current];
+        rung.current++;
+        rung.count -= bucket.size();
+
+        if (bucket.size() > m_threshold && rung.width > 1 && m_rungs.size() < m_maxRungs)
+        {
+            // split the bucket into a finer rung
+            uint64_t start = rung.start + (rung.current - 1) * rung.width;
+            uint64_t end = start + rung.width;
+            Events events;
+            events.swap(bucket);
+            SpawnRung(events, start, end);
+        }
+        else
+        {
+            m_bottom.swap(bucket);
+            std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+        }
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_qSize--;
+    if (m_bottom.empty() && m_qSize > 0)
+    {
+        RefillBottom();
+    }
+    return ev;
+}
+
+bool
+LadderScheduler::RemoveUnsorted(Events& events, const Scheduler::Event& ev)
+{
+    for (auto i = events.begin(); i != events.end(); ++i)
+    {
+        if (i->key.m_uid == ev.key.m_uid)
+        {
+            NS_ASSERT(ev.impl == i->impl);
+            *i = events.back();
+            events.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+
+    bool removed = false;
+    if (ts >= m_topStart)
+    {
+        removed = RemoveUnsorted(m_top, ev);
+    }
+    else
+    {
+        for (auto& rung : m_rungs)
+        {
+            if (ts >= rung.CurrentStart())
+            {
+                removed = RemoveUnsorted(rung.buckets[(ts - rung.start) / rung.width], ev);
+                if (removed)
+                {
+                    rung.count--;
+                }
+                break;
+            }
+        }
+        if (!removed)
+        {
+            auto i = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+            if (i != m_bottom.end() && i->key.m_uid == ev.key.m_uid)
+            {
+                NS_ASSERT(ev.impl == i->impl);
+                m_bottom.erase(i);
+                removed = true;
+            }
+        }
+    }
+    NS_ASSERT_MSG(removed, "Event not found");
+    m_qSize--;
+
+    if (m_bottom.empty() && m_qSize > 0)
+    {
+        RefillBottom();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].  The events are spread over three tiers:
+ *
+ * - the \em top, an unsorted vector holding all the events of future
+ *   epochs (at or after `m_topStart`);
+ * - the \em ladder, a stack of \em rungs, each of them being an array of
+ *   unsorted buckets covering a uniform time span; each rung spans a
+ *   single bucket of the rung above it;
+ * - the \em bottom, a short sorted vector holding the earliest events.
+ *
+ * Events are dequeued from the bottom.  When the bottom is empty, the
+ * first non-empty bucket of the lowest rung is sorted into the bottom,
+ * unless it holds more than \c Threshold events, in which case a new,
+ * finer rung is created from it.  When the ladder is empty, the events
+ * in the top are spread over a new rung, whose bucket width is derived
+ * from the actual span of the timestamps.
+ *
+ * Unlike the CalendarScheduler, no operation ever re-buckets the whole
+ * event set: each event is moved at most once per rung, and the bucket
+ * width of each rung is computed from the events it receives, which
+ * makes the scheduler robust to skewed timestamp distributions.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to top or bucket; sorted insertion in short bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept sorted
+ * Remove()     | Linear          | Search within top, bucket or bottom
+ * RemoveNext() | ~Constant       | Pop from bottom; amortized transfers between tiers
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | Vectors of top, rungs and bottom | `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Container type for the events in a tier, or in a bucket. */
+    typedef std::vector<Scheduler::Event> Events;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        /** Timestamp at the start of the first bucket. */
+        uint64_t start;
+        /** Duration of a bucket, in dimensionless time units. */
+        uint64_t width;
+        /** Index of the next bucket to dequeue. */
+        std::size_t current;
+        /** Number of events in the rung. */
+        std::size_t count;
+        /** The buckets. */
+        std::vector<Events> buckets;
+
+        /**
+         * Get the start of the next bucket to dequeue.
+         *
+         * @return The smallest timestamp which can be stored in this rung.
+         */
+        uint64_t CurrentStart() const;
+    };
+
+    /**
+     * Create a new rung at the bottom of the ladder, and spread events over it.
+     *
+     * @param [in] events The events.
+     * @param [in] start The smallest timestamp of the events.
+     * @param [in] end The largest timestamp of the events.
+     */
+    void SpawnRung(Events& events, uint64_t start, uint64_t end);
+
+    /**
+     * Insert an event into the sorted bottom.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /**
+     * Move events into the bottom, after it became empty.
+     *
+     * The bottom must be empty, and the queue must not be empty.
+     */
+    void RefillBottom();
+
+    /**
+     * Remove an event from an unsorted container, if found.
+     *
+     * @param [in] events The container.
+     * @param [in] ev The event.
+     * @return \c true if the event was found and removed.
+     */
+    static bool RemoveUnsorted(Events& events, const Scheduler::Event& ev);
+
+    /** Events of the future epochs. */
+    Events m_top;
+    /** Smallest timestamp of the events which are stored in the top. */
+    uint64_t m_topStart;
+    /** Smallest timestamp in the top. */
+    uint64_t m_topMin;
+    /** Largest timestamp in the top. */
+    uint64_t m_topMax;
+    /** The rungs, from the coarsest (front) to the finest (back). */
+    std::vector<Rung> m_rungs;
+    /** The earliest events, sorted in decreasing order. */
+    Events m_bottom;
+    /** Number of events in the queue. */
+    std::size_t m_qSize;
+    /** Maximum number of events in a bucket sorted into the bottom. */
+    uint32_t m_threshold;
+    /** Maximum number of rungs. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
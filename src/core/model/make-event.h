@@ -153,7 +153,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
             m_function();
         }
 
-        std::function<void()> m_function;
+        /**
+         * The bound method is stored in the event itself, to avoid the
+         * heap allocation of a std::function holding large arguments.
+         */
+        decltype(std::bind(mem_ptr, obj, args...)) m_function;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
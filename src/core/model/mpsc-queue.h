@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ *
+ * @brief A bounded, lock-free, multiple-producer single-consumer FIFO queue.
+ *
+ * The queue is a ring of cells, each tagged with a sequence number which
+ * tells whether the cell can be written by a producer or read by the
+ * consumer (Dmitry Vyukov's bounded queue).  Producers reserve a cell
+ * with a single compare-and-swap on the enqueue position; the consumer
+ * only needs acquire loads and release stores.  Items pushed by the same
+ * thread are popped in the order in which they were pushed.
+ *
+ * TryPush() can be called concurrently from any thread; TryPop() and
+ * IsEmpty() must only be called by the (single) consumer thread.
+ *
+ * @tparam T \explicit The item type, which must be default-constructible
+ *           and copy-assignable.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] capacity The maximum number of items in the queue,
+     *             rounded up to the next power of two.
+     */
+    explicit MpscQueue(std::size_t capacity);
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Push an item at the tail of the queue.
+     *
+     * @param [in] item The item.
+     * @return \c false if the queue is full.
+     */
+    bool TryPush(const T& item);
+
+    /**
+     * Pop the item at the head of the queue.
+     *
+     * @param [out] item The item.
+     * @return \c false if the queue is empty.
+     */
+    bool TryPop(T& item);
+
+    /**
+     * Check whether the queue is empty.
+     *
+     * @return \c true if no item can be popped.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Get the capacity of the queue.
+     *
+     * @return The maximum number of items in the queue.
+     */
+    std::size_t GetCapacity() const;
+
+  private:
+    /** A cell of the ring. */
+    struct Cell
+    {
+        /**
+         * Sequence number: equal to the enqueue position when the cell is
+         * free, and to the enqueue position plus one when it holds an item.
+         */
+        std::atomic<std::size_t> sequence;
+        /** The item. */
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> m_cells; //!< The ring of cells.
+    std::size_t m_mask;              //!< Ring size minus one.
+    /** Position of the next cell to write, shared by the producers. */
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    /** Position of the next cell to read, owned by the consumer. */
+    alignas(64) std::size_t m_dequeuePos;
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : m_enqueuePos(0),
+      m_dequeuePos(0)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_cells = std::make_unique<Cell[]>(size);
+    m_mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPush(const T& item)
+{
+    Cell* cell;
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        cell = &m_cells[pos & m_mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0)
+        {
+            // the cell is free: try to reserve it
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the cell still holds an item of the previous lap: the queue is full
+            return false;
+        }
+        else
+        {
+            // another producer reserved the cell
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->data = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPop(T& item)
+{
+    Cell* cell = &m_cells[m_dequeuePos & m_mask];
+    if (cell->sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+    {
+        return false;
+    }
+    item = cell->data;
+    // free the cell for the next lap of the producers
+    cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    m_dequeuePos++;
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    const Cell* cell = &m_cells[m_dequeuePos & m_mask];
+    return cell->sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+}
+
+template <typename T>
+std::size_t
+MpscQueue<T>::GetCapacity() const
+{
+    return m_mask + 1;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -0,0 +1,737 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::m_currentPartition =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("PartitionCount",
+                          "The number of partitions the event contexts are split into. "
+                          "The simulation results depend on this value, but not on the "
+                          "number of threads.",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_partitionCount),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ThreadCount",
+                          "The number of threads executing the partitions "
+                          "(0 means one thread per partition, up to the number of "
+                          "hardware threads).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threadCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "The minimum delay of the events scheduled by a partition for "
+                          "another partition, i.e., the minimum delay of the channels "
+                          "connecting nodes in different partitions. Must be strictly "
+                          "positive if there is more than one partition.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookahead),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_partitionCount = 1;
+    m_threadCount = 0;
+    m_runThreads = 1;
+    m_windowEnd = 0;
+    m_done = false;
+    m_running = false;
+    m_windowCount = 0;
+    m_uidCounter = nullptr;
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    DeliverRemoteEvents();
+
+    for (auto& partition : m_partitions)
+    {
+        while (!partition.events->IsEmpty())
+        {
+            Scheduler::Event next = partition.events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition.events = nullptr;
+    }
+    m_partitions.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (true)
+    {
+        Ptr<EventImpl> ev;
+        {
+            std::unique_lock lock{m_destroyEventsMutex};
+            if (m_destroyEvents.empty())
+            {
+                break;
+            }
+            ev = m_destroyEvents.front().PeekEventImpl();
+            m_destroyEvents.pop_front();
+        }
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions()
+{
+    if (!m_partitions.empty())
+    {
+        return;
+    }
+    m_partitions = std::vector<Partition>(m_partitionCount);
+    for (uint32_t i = 0; i < m_partitionCount; ++i)
+    {
+        m_partitions[i].outbox.resize(m_partitionCount);
+        m_partitions[i].index = i;
+        m_partitions[i].simulator = this;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_running, "Cannot change the scheduler while the simulation is running");
+    CreatePartitions();
+
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition.events)
+        {
+            while (!partition.events->IsEmpty())
+            {
+                Scheduler::Event next = partition.events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        partition.events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_partitionCount;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return 0;
+    }
+    return context % m_partitionCount;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount() const
+{
+    return m_windowCount;
+}
+
+bool
+MultithreadedSimulatorImpl::IsRemoteContext(uint32_t context)
+{
+    const Partition* partition = m_currentPartition;
+    return partition != nullptr && partition->simulator->GetPartition(context) != partition->index;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::AllocateUid(uint32_t& counter)
+{
+    Partition* partition = m_currentPartition;
+    if (partition == nullptr)
+    {
+        return ++counter;
+    }
+    if (partition->nextUid == 0)
+    {
+        // the counter is not modified while the partitions run, hence all the
+        // partitions read the same value
+        auto simulator = const_cast<MultithreadedSimulatorImpl*>(partition->simulator);
+        [[maybe_unused]] uint32_t* previous = simulator->m_uidCounter.exchange(&counter);
+        NS_ASSERT_MSG(previous == nullptr || previous == &counter,
+                      "AllocateUid() called with different counters");
+        partition->nextUid = counter + partition->index + 1;
+    }
+    uint32_t uid = partition->nextUid;
+    partition->nextUid += partition->simulator->m_partitionCount;
+    return uid;
+}
+
+MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetCurrentPartition()
+{
+    if (m_currentPartition != nullptr)
+    {
+        return *m_currentPartition;
+    }
+    return m_partitions.front();
+}
+
+const MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetCurrentPartition() const
+{
+    if (m_currentPartition != nullptr)
+    {
+        return *m_currentPartition;
+    }
+    return m_partitions.front();
+}
+
+Scheduler::EventKey
+MultithreadedSimulatorImpl::Insert(Partition& partition,
+                                   uint32_t context,
+                                   uint64_t ts,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = partition.uid;
+    partition.uid++;
+    partition.unscheduledEvents++;
+    partition.events->Insert(ev);
+    return ev.key;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition& partition)
+{
+    Scheduler::Event next = partition.events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition.currentTs);
+    partition.unscheduledEvents--;
+    partition.eventCount++;
+
+    partition.currentTs = next.key.m_ts;
+    partition.currentContext = next.key.m_context;
+    partition.currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(uint32_t thread)
+{
+    for (uint32_t i = thread; i < m_partitionCount; i += m_runThreads)
+    {
+        Partition& partition = m_partitions[i];
+        m_currentPartition = &partition;
+        while (!partition.stop && !partition.events->IsEmpty() &&
+               partition.events->PeekNext().key.m_ts < m_windowEnd)
+        {
+            ProcessOneEvent(partition);
+        }
+    }
+    m_currentPartition = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop(uint32_t thread)
+{
+    while (true)
+    {
+        // wait for the next window to be published
+        m_barrier->arrive_and_wait();
+        if (m_done)
+        {
+            break;
+        }
+        ProcessWindow(thread);
+        m_barrier->arrive_and_wait();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::NextWindow(uint64_t& windowEnd)
+{
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    bool found = false;
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition.events->IsEmpty())
+        {
+            next = std::min(next, partition.events->PeekNext().key.m_ts);
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    windowEnd = std::numeric_limits<uint64_t>::max();
+    if (m_partitionCount > 1)
+    {
+        // saturate, since the next event can be close to the end of time
+        auto lookahead = static_cast<uint64_t>(m_lookahead.GetTimeStep());
+        if (next < windowEnd - lookahead)
+        {
+            windowEnd = next + lookahead;
+        }
+    }
+
+    std::unique_lock lock{m_stopTimesMutex};
+    while (!m_stopTimes.empty() && *m_stopTimes.begin() < next)
+    {
+        m_stopTimes.erase(m_stopTimes.begin());
+    }
+    if (!m_stopTimes.empty())
+    {
+        // the window includes the stop time, so that the stop event is
+        // executed; the other partitions execute all their events at that time
+        windowEnd = std::min(windowEnd, *m_stopTimes.begin() + 1);
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::DeliverRemoteEvents()
+{
+    // The order of the loops makes the delivery order, and hence the uids
+    // assigned by the destination, independent of the thread scheduling.
+    for (uint32_t dst = 0; dst < m_partitions.size(); ++dst)
+    {
+        Partition& destination = m_partitions[dst];
+        for (auto& source : m_partitions)
+        {
+            for (const auto& remote : source.outbox[dst])
+            {
+                NS_ASSERT(remote.timestamp >= destination.currentTs);
+                Insert(destination, remote.context, remote.timestamp, remote.event);
+            }
+            source.outbox[dst].clear();
+        }
+    }
+
+    std::vector<RemoteEvent> foreignEvents;
+    {
+        std::unique_lock lock{m_foreignEventsMutex};
+        m_foreignEvents.swap(foreignEvents);
+    }
+    for (const auto& foreign : foreignEvents)
+    {
+        Partition& destination = m_partitions[GetPartition(foreign.context)];
+        // the timestamp of a foreign event is relative to the destination clock
+        Insert(destination,
+               foreign.context,
+               destination.currentTs + foreign.timestamp,
+               foreign.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    NS_ABORT_MSG_IF(m_partitionCount > 1 && !m_lookahead.IsStrictlyPositive(),
+                    "MultithreadedSimulatorImpl: the Lookahead must be strictly positive "
+                    "with more than one partition");
+
+    m_runThreads = m_threadCount;
+    if (m_runThreads == 0)
+    {
+        m_runThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    m_runThreads = std::min(m_runThreads, m_partitionCount);
+
+    for (auto& partition : m_partitions)
+    {
+        partition.stop = false;
+    }
+    DeliverRemoteEvents();
+
+    m_running = true;
+    m_done = false;
+    m_barrier = std::make_unique<std::barrier<>>(m_runThreads);
+    for (uint32_t thread = 1; thread < m_runThreads; ++thread)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this, thread);
+    }
+
+    uint64_t windowEnd;
+    while (NextWindow(windowEnd))
+    {
+        m_windowEnd = windowEnd;
+        m_windowCount++;
+        if (m_runThreads > 1)
+        {
+            m_barrier->arrive_and_wait();
+            ProcessWindow(0);
+            m_barrier->arrive_and_wait();
+        }
+        else
+        {
+            ProcessWindow(0);
+        }
+        DeliverRemoteEvents();
+
+        if (std::any_of(m_partitions.begin(), m_partitions.end(), [](const Partition& p) {
+                return p.stop;
+            }))
+        {
+            break;
+        }
+    }
+
+    m_done = true;
+    if (m_runThreads > 1)
+    {
+        m_barrier->arrive_and_wait();
+    }
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    m_barrier.reset();
+    m_running = false;
+
+    // Advance the counter of AllocateUid() past the identifiers allocated
+    // by the partitions
+    if (uint32_t* counter = m_uidCounter.exchange(nullptr))
+    {
+        for (auto& partition : m_partitions)
+        {
+            if (partition.nextUid != 0)
+            {
+                *counter = std::max(*counter, partition.nextUid - m_partitionCount);
+                partition.nextUid = 0;
+            }
+        }
+    }
+
+    // Align the partition clocks, so that the main thread sees a single
+    // simulation time until the next call to Run(). No pending event is
+    // earlier than the latest executed event.
+    uint64_t now = 0;
+    for (const auto& partition : m_partitions)
+    {
+        now = std::max(now, partition.currentTs);
+    }
+    for (auto& partition : m_partitions)
+    {
+        if (partition.currentTs < now)
+        {
+            partition.currentTs = now;
+            partition.currentUid = EventId::UID::INVALID;
+        }
+    }
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    NS_ASSERT(!IsFinished() ||
+              std::any_of(m_partitions.begin(),
+                          m_partitions.end(),
+                          [](const Partition& p) { return p.stop; }) ||
+              std::all_of(m_partitions.begin(), m_partitions.end(), [](const Partition& p) {
+                  return p.unscheduledEvents == 0;
+              }));
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    return std::all_of(m_partitions.begin(),
+                       m_partitions.end(),
+                       [](const Partition& p) { return p.events->IsEmpty(); }) ||
+           std::any_of(m_partitions.begin(), m_partitions.end(), [](const Partition& p) {
+               return p.stop;
+           });
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    GetCurrentPartition().stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    {
+        std::unique_lock lock{m_stopTimesMutex};
+        m_stopTimes.insert(static_cast<uint64_t>((Now() + delay).GetTimeStep()));
+    }
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(m_currentPartition != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    Partition& partition = GetCurrentPartition();
+    Time tAbsolute = delay + TimeStep(partition.currentTs);
+    Scheduler::EventKey key = Insert(partition,
+                                     partition.currentContext,
+                                     static_cast<uint64_t>(tAbsolute.GetTimeStep()),
+                                     event);
+    return EventId(event, key.m_ts, key.m_context, key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    uint32_t dst = GetPartition(context);
+    if (m_currentPartition != nullptr)
+    {
+        // called by an event, from one of the simulation threads
+        Partition& partition = *m_currentPartition;
+        uint64_t ts = partition.currentTs + static_cast<uint64_t>(delay.GetTimeStep());
+        if (&partition == &m_partitions[dst])
+        {
+            Insert(partition, context, ts, event);
+        }
+        else
+        {
+            NS_ABORT_MSG_IF(delay < m_lookahead,
+                            "MultithreadedSimulatorImpl: event for context "
+                                << context << " scheduled " << delay.As(Time::S)
+                                << " in the future from another partition, which is less than "
+                                   "the Lookahead ("
+                                << m_lookahead.As(Time::S) << ")");
+            partition.outbox[dst].push_back({context, ts, event});
+        }
+    }
+    else if (!m_running && m_mainThreadId == std::this_thread::get_id())
+    {
+        // called by the main thread, between two runs
+        Time tAbsolute = delay + Now();
+        Insert(m_partitions[dst], context, static_cast<uint64_t>(tAbsolute.GetTimeStep()), event);
+    }
+    else
+    {
+        // Current time added in DeliverRemoteEvents()
+        std::unique_lock lock{m_foreignEventsMutex};
+        m_foreignEvents.push_back({context, static_cast<uint64_t>(delay.GetTimeStep()), event});
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_currentPartition != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_currentPartition != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), GetCurrentPartition().currentTs, 0xffffffff, 2);
+    std::unique_lock lock{m_destroyEventsMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentPartition().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrentPartition().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition& partition = m_partitions[GetPartition(id.GetContext())];
+    NS_ASSERT_MSG(m_currentPartition == nullptr || m_currentPartition == &partition,
+                  "Simulator::Remove of an event belonging to another partition");
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (id.PeekEventImpl() == nullptr)
+    {
+        return true;
+    }
+    const Partition& partition = m_partitions[GetPartition(id.GetContext())];
+    return id.GetTs() < partition.currentTs ||
+           (id.GetTs() == partition.currentTs && id.GetUid() <= partition.currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentPartition().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& partition : m_partitions)
+    {
+        count += partition.eventCount;
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "nstime.h"
+#include "scheduler.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ *
+ * A conservative, shared-memory parallel simulator implementation.
+ *
+ * The event contexts (which the network models interpret as node ids)
+ * are split into \c PartitionCount partitions, context \c c being
+ * executed by partition <tt>c % PartitionCount</tt>.  Events without
+ * a context (Simulator::NO_CONTEXT) belong to partition 0.  Each
+ * partition owns its own Scheduler, clock and event uid counter.
+ *
+ * The partitions are advanced in lockstep windows: if \c T is the
+ * timestamp of the earliest pending event over all partitions, every
+ * partition executes, independently of the others, all its events
+ * with a timestamp strictly lower than <tt>T + Lookahead</tt>.  The
+ * partitions are handed out to \c ThreadCount worker threads, and the
+ * threads synchronize on a barrier at the end of each window.
+ *
+ * An event scheduled with Simulator::ScheduleWithContext for a context
+ * which belongs to another partition is not inserted directly: it is
+ * buffered by the sending partition and handed over to the receiving
+ * partition at the end of the window.  The buffered events are
+ * delivered in (sender partition, send order) order, which makes the
+ * outcome of a simulation independent of the number of threads and of
+ * the thread interleaving: a given seed and \c PartitionCount always
+ * produce the same results.  For this to be correct, every event sent
+ * to another partition must be scheduled at least \c Lookahead in the
+ * future; this is checked at run time.  The \c Lookahead should hence
+ * be set to the minimum delay of the channels which connect nodes
+ * belonging to different partitions, e.g., the \c Delay attribute of
+ * the PointToPointChannel instances in a wired backbone.
+ *
+ * Some restrictions apply:
+ *
+ * - Model code executed in different partitions runs concurrently,
+ *   and must not share mutable state without synchronization (e.g.,
+ *   output streams written by trace sinks).  In particular, the
+ *   reference counts of the objects (e.g., of the packets, of their
+ *   buffers and of the nodes) are not atomic, hence an object must
+ *   not be referenced by two partitions at the same time.  The
+ *   PointToPointChannel hands a deep copy of the packets over to the
+ *   receiving partition (see IsRemoteContext()), which makes it
+ *   suitable to connect nodes in different partitions; the other
+ *   channels must only connect nodes of the same partition.  The
+ *   packet uids are allocated per partition (see AllocateUid()), and
+ *   the free lists of the packets are per thread.
+ * - An EventId can only be cancelled, removed or queried by the
+ *   partition which scheduled it.
+ * - Simulator::Stop() stops the partition which executes it at once,
+ *   and the other partitions at the end of the current window.
+ *   Simulator::Stop(const Time&) clamps the windows so that no event
+ *   later than the requested stop time is executed.  Unlike with the
+ *   DefaultSimulatorImpl, where the events at the stop time which were
+ *   scheduled after the stop event are not executed, the other
+ *   partitions execute all their events at the stop time, since the
+ *   events of different partitions are not ordered within a time step.
+ *   The partition executing the stop event stops at once, as with the
+ *   DefaultSimulatorImpl.
+ * - Events scheduled from threads which do not belong to the simulator
+ *   (e.g., emulation devices) are delivered at the next window boundary.
+ *
+ * With a single partition, the events are executed in the same order as
+ * with the DefaultSimulatorImpl.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of partitions.
+     *
+     * @return The number of partitions.
+     */
+    uint32_t GetPartitionCount() const;
+
+    /**
+     * Get the partition which executes the events of a context.
+     *
+     * @param [in] context The event context.
+     * @return The partition index.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+    /**
+     * Get the number of synchronization windows executed so far.
+     *
+     * @return The number of windows.
+     */
+    uint64_t GetWindowCount() const;
+
+    /**
+     * Check whether a context belongs to another partition than the one
+     * executing the current event.
+     *
+     * The objects handed over to an event of another partition must not
+     * be shared with the current partition, e.g., a packet must be deep
+     * copied instead of being copied with Packet::Copy().
+     *
+     * @param [in] context The event context.
+     * @return \c true if the calling thread executes an event of a
+     * MultithreadedSimulatorImpl and \p context belongs to another partition.
+     */
+    static bool IsRemoteContext(uint32_t context);
+
+    /**
+     * Allocate a unique identifier, e.g., a packet uid, independently of
+     * the thread scheduling.
+     *
+     * Outside of the events of a MultithreadedSimulatorImpl, the counter
+     * is simply incremented.  While the partitions run, the counter is
+     * left untouched and partition \c p out of \c P allocates the
+     * identifiers <tt>counter + p + 1</tt>, <tt>counter + p + 1 + P</tt>,
+     * and so on; the counter is advanced past all of them at the end of
+     * Run().  Only one counter can be used while the partitions run.
+     *
+     * @param [in,out] counter The counter of the last identifier allocated.
+     * @return The identifier.
+     */
+    static uint32_t AllocateUid(uint32_t& counter);
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent by a partition to another partition. */
+    struct RemoteEvent
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Absolute event timestamp. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /**
+     * The state of a partition.
+     *
+     * Aligned on a cache line, since each partition is updated by
+     * a different thread.
+     */
+    struct alignas(64) Partition
+    {
+        /** The event priority queue. */
+        Ptr<Scheduler> events;
+        /** Events sent to other partitions, indexed by destination partition. */
+        std::vector<std::vector<RemoteEvent>> outbox;
+        /** Next event unique id. */
+        uint32_t uid{EventId::UID::VALID};
+        /** Unique id of the current event. */
+        uint32_t currentUid{EventId::UID::INVALID};
+        /** Timestamp of the current event. */
+        uint64_t currentTs{0};
+        /** Execution context of the current event. */
+        uint32_t currentContext{0xffffffff};
+        /** The event count. */
+        uint64_t eventCount{0};
+        /** Number of events that have been inserted but not yet executed. */
+        int unscheduledEvents{0};
+        /** Flag set when Simulator::Stop() is called by an event of this partition. */
+        bool stop{false};
+        /** Index of the partition. */
+        uint32_t index{0};
+        /** Next identifier allocated by AllocateUid(), 0 if none yet in this Run(). */
+        uint32_t nextUid{0};
+        /** The simulator owning the partition. */
+        const MultithreadedSimulatorImpl* simulator{nullptr};
+    };
+
+    /**
+     * Get the partition of the calling thread.
+     *
+     * Outside of Simulator::Run(), the main thread is attached to partition 0.
+     *
+     * @return The current partition.
+     * @{
+     */
+    Partition& GetCurrentPartition();
+    const Partition& GetCurrentPartition() const;
+    /** @} */
+
+    /**
+     * Insert an event in the queue of a partition.
+     *
+     * @param [in] partition The partition.
+     * @param [in] context The event context.
+     * @param [in] ts The absolute event timestamp.
+     * @param [in] event The event implementation.
+     * @return The scheduler key of the inserted event.
+     */
+    Scheduler::EventKey Insert(Partition& partition,
+                               uint32_t context,
+                               uint64_t ts,
+                               EventImpl* event);
+
+    /** Create the partitions, if not done yet. */
+    void CreatePartitions();
+
+    /**
+     * Process the next event of a partition.
+     *
+     * @param [in] partition The partition.
+     */
+    void ProcessOneEvent(Partition& partition);
+
+    /**
+     * Execute the current window on the partitions assigned to a thread.
+     *
+     * @param [in] thread The thread index.
+     */
+    void ProcessWindow(uint32_t thread);
+
+    /**
+     * Body of the worker threads.
+     *
+     * @param [in] thread The thread index.
+     */
+    void WorkerLoop(uint32_t thread);
+
+    /**
+     * Compute the end of the next window.
+     *
+     * @param [out] windowEnd The (exclusive) end of the next window.
+     * @return \c false if there is no event left to execute.
+     */
+    bool NextWindow(uint64_t& windowEnd);
+
+    /**
+     * Move the events exchanged during the last window, and the events
+     * scheduled by foreign threads, into the destination partitions.
+     */
+    void DeliverRemoteEvents();
+
+    /** Number of partitions. */
+    uint32_t m_partitionCount;
+    /** Number of threads executing the partitions. */
+    uint32_t m_threadCount;
+    /** Minimum delay of the events exchanged between partitions. */
+    Time m_lookahead;
+
+    /** The partitions. */
+    std::vector<Partition> m_partitions;
+    /** The partition whose events are being executed by the calling thread, if any. */
+    static thread_local Partition* m_currentPartition;
+    /** The number of threads used by the current Run(). */
+    uint32_t m_runThreads;
+    /** Barrier synchronizing the threads at the start and end of each window. */
+    std::unique_ptr<std::barrier<>> m_barrier;
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+    /** The (exclusive) end of the current window. */
+    uint64_t m_windowEnd;
+    /** Flag set to make the workers exit. */
+    bool m_done;
+    /** Flag \c true while Run() executes events. */
+    bool m_running;
+    /** Number of windows executed. */
+    uint64_t m_windowCount;
+    /** The counter passed to AllocateUid() while the partitions run, if any. */
+    std::atomic<uint32_t*> m_uidCounter;
+
+    /** Events scheduled by threads which do not belong to the simulator. */
+    std::vector<RemoteEvent> m_foreignEvents;
+    /** Mutex to control access to the foreign events. */
+    std::mutex m_foreignEventsMutex;
+
+    /** Absolute times requested through Stop(const Time&). */
+    std::multiset<uint64_t> m_stopTimes;
+    /** Mutex to control access to the stop times. */
+    std::mutex m_stopTimesMutex;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Mutex to control access to the destroy events. */
+    mutable std::mutex m_destroyEventsMutex;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef OPEN_HASH_MAP_H
+#define OPEN_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::OpenHashMap declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ *
+ * @brief A hash map with open addressing, for lookups on the fast path.
+ *
+ * The entries are stored in a single array of slots, and collisions are
+ * resolved by linear probing, hence a lookup reads a few consecutive
+ * slots and never allocates.  Erased entries are filled by shifting the
+ * following entries of their probe sequence backwards, so that the map
+ * does not degrade with tombstones.  The array grows by doubling when
+ * the map is three quarters full; Reserve() preallocates the slots for
+ * a given number of entries, after which insertions do not allocate.
+ *
+ * The hash of the keys is mixed by a multiplication before it is
+ * reduced to a slot index, hence simple hash functions, like the
+ * identity of std::hash for integers, can be used.
+ *
+ * The pointers returned by Find() and Insert() are invalidated by the
+ * next call to Insert(), Erase(), Reserve() or Clear().
+ *
+ * @tparam K \explicit The key type, which must be default-constructible,
+ *           move-assignable and equality comparable.
+ * @tparam V \explicit The value type, which must be default-constructible
+ *           and move-assignable.
+ * @tparam H \explicit The hash function of the keys.
+ */
+template <typename K, typename V, typename H = std::hash<K>>
+class OpenHashMap
+{
+  public:
+    OpenHashMap();
+
+    /**
+     * Constructor.
+     *
+     * @param [in] count The number of entries to preallocate.
+     */
+    explicit OpenHashMap(std::size_t count);
+
+    /**
+     * Preallocate the slots for a number of entries.
+     *
+     * @param [in] count The number of entries.
+     */
+    void Reserve(std::size_t count);
+
+    /**
+     * Find the value of a key.
+     *
+     * @param [in] key The key.
+     * @return The value, or \c nullptr if the key is not in the map.
+     */
+    V* Find(const K& key);
+
+    /**
+     * @copydoc Find(const K&)
+     */
+    const V* Find(const K& key) const;
+
+    /**
+     * Insert a key, if it is not in the map yet.
+     *
+     * @param [in] key The key.
+     * @return The value of the key, default-constructed if the key was
+     *         not in the map, and whether the key has been inserted.
+     */
+    std::pair<V*, bool> Insert(const K& key);
+
+    /**
+     * Erase a key and its value.
+     *
+     * @param [in] key The key.
+     * @return \c true if the key was in the map.
+     */
+    bool Erase(const K& key);
+
+    /**
+     * Erase all the entries, keeping the slots allocated.
+     */
+    void Clear();
+
+    /**
+     * Get the number of entries.
+     *
+     * @return The number of entries in the map.
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * Get the number of entries which can be inserted without allocation.
+     *
+     * @return The capacity of the map.
+     */
+    std::size_t GetCapacity() const;
+
+  private:
+    /** A slot of the array. */
+    struct Slot
+    {
+        K key;             //!< The key.
+        V value;           //!< The value.
+        bool used = false; //!< Whether the slot holds an entry.
+    };
+
+    /**
+     * Get the first slot of the probe sequence of a key.
+     *
+     * @param [in] key The key.
+     * @return The index of the slot.
+     */
+    std::size_t GetHome(const K& key) const;
+
+    /**
+     * Get the slot holding a key.
+     *
+     * @param [in] key The key.
+     * @return The index of the slot, or the size of the array if the key
+     *         is not in the map.
+     */
+    std::size_t Lookup(const K& key) const;
+
+    /**
+     * Move the entries to a new array of slots.
+     *
+     * @param [in] slots The number of slots of the new array, a power of two.
+     */
+    void Rehash(std::size_t slots);
+
+    std::vector<Slot> m_slots; //!< The array of slots.
+    std::size_t m_size;        //!< The number of entries.
+    unsigned m_shift;          //!< 64 minus the log2 of the number of slots.
+    H m_hash;                  //!< The hash function.
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename K, typename V, typename H>
+OpenHashMap<K, V, H>::OpenHashMap()
+    : m_size(0),
+      m_shift(64)
+{
+}
+
+template <typename K, typename V, typename H>
+OpenHashMap<K, V, H>::OpenHashMap(std::size_t count)
+    : OpenHashMap()
+{
+    Reserve(count);
+}
+
+template <typename K, typename V, typename H>
+void
+OpenHashMap<K, V, H>::Reserve(std::size_t count)
+{
+    std::size_t slots = 8;
+    while (slots / 4 * 3 < count)
+    {
+        slots <<= 1;
+    }
+    if (slots > m_slots.size())
+    {
+        Rehash(slots);
+    }
+}
+
+template <typename K, typename V, typename H>
+std::size_t
+OpenHashMap<K, V, H>::GetHome(const K& key) const
+{
+    // Fibonacci hashing: the high bits of the product depend on all the bits of the hash
+    return (static_cast<uint64_t>(m_hash(key)) * 0x9e3779b97f4a7c15ULL) >> m_shift;
+}
+
+template <typename K, typename V, typename H>
+std::size_t
+OpenHashMap<K, V, H>::Lookup(const K& key) const
+{
+    if (m_size == 0)
+    {
+        return m_slots.size();
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = GetHome(key);; i = (i + 1) & mask)
+    {
+        if (!m_slots[i].used)
+        {
+            return m_slots.size();
+        }
+        if (m_slots[i].key == key)
+        {
+            return i;
+        }
+    }
+}
+
+template <typename K, typename V, typename H>
+V*
+OpenHashMap<K, V, H>::Find(const K& key)
+{
+    const std::size_t i = Lookup(key);
+    return i < m_slots.size() ? &m_slots[i].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+const V*
+OpenHashMap<K, V, H>::Find(const K& key) const
+{
+    const std::size_t i = Lookup(key);
+    return i < m_slots.size() ? &m_slots[i].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+std::pair<V*, bool>
+OpenHashMap<K, V, H>::Insert(const K& key)
+{
+    if (m_size + 1 > m_slots.size() / 4 * 3)
+    {
+        Rehash(m_slots.empty() ? 8 : 2 * m_slots.size());
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t i = GetHome(key);
+    for (; m_slots[i].used; i = (i + 1) & mask)
+    {
+        if (m_slots[i].key == key)
+        {
+            return {&m_slots[i].value, false};
+        }
+    }
+    m_slots[i].key = key;
+    m_slots[i].used = true;
+    m_size++;
+    return {&m_slots[i].value, true};
+}
+
+template <typename K, typename V, typename H>
+bool
+OpenHashMap<K, V, H>::Erase(const K& key)
+{
+    std::size_t hole = Lookup(key);
+    if (hole == m_slots.size())
+    {
+        return false;
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    // shift back the following entries which cannot be found any more past the hole
+    for (std::size_t i = (hole + 1) & mask; m_slots[i].used; i = (i + 1) & mask)
+    {
+        const std::size_t home = GetHome(m_slots[i].key);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole].key = std::move(m_slots[i].key);
+            m_slots[hole].value = std::move(m_slots[i].value);
+            hole = i;
+        }
+    }
+    m_slots[hole].key = K();
+    m_slots[hole].value = V();
+    m_slots[hole].used = false;
+    m_size--;
+    return true;
+}
+
+template <typename K, typename V, typename H>
+void
+OpenHashMap<K, V, H>::Clear()
+{
+    for (auto& slot : m_slots)
+    {
+        slot = Slot();
+    }
+    m_size = 0;
+}
+
+template <typename K, typename V, typename H>
+std::size_t
+OpenHashMap<K, V, H>::GetSize() const
+{
+    return m_size;
+}
+
+template <typename K, typename V, typename H>
+std::size_t
+OpenHashMap<K, V, H>::GetCapacity() const
+{
+    return m_slots.size() / 4 * 3;
+}
+
+template <typename K, typename V, typename H>
+void
+OpenHashMap<K, V, H>::Rehash(std::size_t slots)
+{
+    std::vector<Slot> old(slots);
+    m_slots.swap(old);
+    m_shift = 64;
+    for (std::size_t n = slots; n > 1; n >>= 1)
+    {
+        m_shift--;
+    }
+    const std::size_t mask = slots - 1;
+    for (auto& slot : old)
+    {
+        if (slot.used)
+        {
+            std::size_t i = GetHome(slot.key);
+            while (m_slots[i].used)
+            {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = std::move(slot);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* OPEN_HASH_MAP_H */
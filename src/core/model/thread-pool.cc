@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "thread-pool.h"
+
+#include "assert.h"
+#include "log.h"
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ThreadPool implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ThreadPool");
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+    : m_task(nullptr),
+      m_count(0),
+      m_next(0),
+      m_generation(0),
+      m_running(0),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this << threadCount);
+    for (uint32_t i = 1; i < threadCount; ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t
+ThreadPool::GetThreadCount() const
+{
+    return m_workers.size() + 1;
+}
+
+void
+ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    NS_LOG_FUNCTION(this << count);
+    if (m_workers.empty() || count <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        NS_ASSERT_MSG(m_task == nullptr, "ThreadPool::ParallelFor is not reentrant");
+        m_task = &task;
+        m_count = count;
+        m_next.store(0, std::memory_order_relaxed);
+        m_running = m_workers.size();
+        m_generation++;
+    }
+    m_start.notify_all();
+    RunTasks();
+
+    // wait until no worker can access the task any longer
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_running == 0; });
+    m_task = nullptr;
+}
+
+void
+ThreadPool::RunTasks()
+{
+    for (auto i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_count;
+         i = m_next.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*m_task)(i);
+    }
+}
+
+void
+ThreadPool::WorkerLoop()
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_start.wait(lock, [this, generation] { return m_stop || m_generation != generation; });
+            if (m_stop)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+        RunTasks();
+        {
+            std::lock_guard lock(m_mutex);
+            m_running--;
+        }
+        m_done.notify_one();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ThreadPool declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ *
+ * @brief A fixed set of worker threads executing the iterations of a loop.
+ *
+ * ParallelFor() executes a task for every index of a range, and returns
+ * once all of them have completed.  The indexes are handed out one at a
+ * time to the worker threads and to the calling thread, which also takes
+ * part in the work, so that a pool of \c N threads only creates \c N-1
+ * worker threads, and a pool of a single thread executes the loop in the
+ * calling thread.  The workers sleep between two calls.
+ *
+ * The order in which the indexes are executed, and the thread executing
+ * each of them, is unspecified: the tasks must be independent of each
+ * other, and write their results to locations owned by their index.
+ * As the reference counts of the ns-3 objects are not atomic, the tasks
+ * must neither copy nor release a Ptr to an object shared with another
+ * task; they must not call the Simulator, draw random numbers or log
+ * either.
+ *
+ * ParallelFor() must not be called concurrently, nor from a task.
+ */
+class ThreadPool
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] threadCount The number of threads executing the tasks,
+     *             including the calling thread; zero is interpreted as one.
+     */
+    explicit ThreadPool(uint32_t threadCount);
+    /** Destructor, which joins the worker threads. */
+    ~ThreadPool();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Get the number of threads executing the tasks.
+     *
+     * @return The number of threads, including the calling thread.
+     */
+    uint32_t GetThreadCount() const;
+
+    /**
+     * Execute a task for every index in <tt>[0, count)</tt>.
+     *
+     * @param [in] count The number of indexes.
+     * @param [in] task The task, called once with each index.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+  private:
+    /** Main loop of the worker threads. */
+    void WorkerLoop();
+    /** Execute the tasks of the current loop until all indexes are taken. */
+    void RunTasks();
+
+    std::vector<std::thread> m_workers;              //!< The worker threads.
+    std::mutex m_mutex;                              //!< Protects the loop state below.
+    std::condition_variable m_start;                 //!< Signals a new loop to the workers.
+    std::condition_variable m_done;                  //!< Signals the end of the workers' part.
+    const std::function<void(std::size_t)>* m_task; //!< The task of the current loop.
+    std::size_t m_count;                             //!< The number of indexes of the loop.
+    std::atomic<std::size_t> m_next;                 //!< The next index to hand out.
+    uint64_t m_generation;                           //!< Incremented at each loop.
+    uint32_t m_running;                              //!< Number of workers in the loop.
+    bool m_stop;                                     //!< True when the workers must exit.
+};
+
+} // namespace ns3
+
+#endif /* THREAD_POOL_H */
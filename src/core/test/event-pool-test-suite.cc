@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/event-pool.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup event-pool-tests
+ * EventPool test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup event-pool-tests EventPool tests
+ */
+
+/**
+ * @ingroup event-pool-tests
+ *
+ * @brief Check that the blocks are recycled within a size class.
+ */
+class EventPoolRecycleTestCase : public TestCase
+{
+  public:
+    EventPoolRecycleTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventPoolRecycleTestCase::EventPoolRecycleTestCase()
+    : TestCase("Check that the blocks are recycled")
+{
+}
+
+void
+EventPoolRecycleTestCase::DoRun()
+{
+    auto before = EventPool::GetStats();
+
+    void* p = EventPool::Allocate(40);
+    EventPool::Deallocate(p, 40);
+    // same size class
+    void* q = EventPool::Allocate(48);
+    NS_TEST_EXPECT_MSG_EQ(q, p, "Block not recycled");
+    // other size class
+    void* r = EventPool::Allocate(72);
+    NS_TEST_EXPECT_MSG_NE(r, p, "Block given twice");
+    EventPool::Deallocate(q, 48);
+    EventPool::Deallocate(r, 72);
+
+    // large blocks use the global allocator
+    void* large = EventPool::Allocate(EventPool::MAX_BLOCK_SIZE + 1);
+    EventPool::Deallocate(large, EventPool::MAX_BLOCK_SIZE + 1);
+
+    auto after = EventPool::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 4, "Wrong allocation count");
+    NS_TEST_EXPECT_MSG_EQ(after.deallocations - before.deallocations,
+                          4,
+                          "Wrong deallocation count");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.recycled - before.recycled, 1, "Wrong recycled count");
+    NS_TEST_EXPECT_MSG_EQ(after.largeAllocations - before.largeAllocations,
+                          1,
+                          "Wrong large allocation count");
+}
+
+/**
+ * @ingroup event-pool-tests
+ *
+ * @brief Check that the events scheduled in a simulation are recycled.
+ */
+class EventPoolSimulatorTestCase : public TestCase
+{
+  public:
+    EventPoolSimulatorTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Event rescheduling itself.
+     * @param remaining The number of events still to schedule.
+     * @param payload A payload, larger than the small buffer of std::function.
+     */
+    void Reschedule(uint32_t remaining, std::array<uint64_t, 4> payload);
+
+    uint32_t m_executed; //!< Number of executed events.
+};
+
+EventPoolSimulatorTestCase::EventPoolSimulatorTestCase()
+    : TestCase("Check that the simulation events are recycled")
+{
+}
+
+void
+EventPoolSimulatorTestCase::Reschedule(uint32_t remaining, std::array<uint64_t, 4> payload)
+{
+    m_executed++;
+    if (remaining > 0)
+    {
+        payload[0]++;
+        Simulator::Schedule(NanoSeconds(1),
+                            &EventPoolSimulatorTestCase::Reschedule,
+                            this,
+                            remaining - 1,
+                            payload);
+    }
+}
+
+void
+EventPoolSimulatorTestCase::DoRun()
+{
+    const uint32_t chains = 10;
+    const uint32_t events = 10000;
+    m_executed = 0;
+
+    auto before = EventPool::GetStats();
+    for (uint32_t i = 0; i < chains; ++i)
+    {
+        Simulator::Schedule(NanoSeconds(i),
+                            &EventPoolSimulatorTestCase::Reschedule,
+                            this,
+                            events - 1,
+                            std::array<uint64_t, 4>{i, 0, 0, 0});
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    auto after = EventPool::GetStats();
+
+    NS_TEST_EXPECT_MSG_EQ(m_executed, chains * events, "Not all the events were executed");
+    // one allocation per event, and no allocation for the bound arguments
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.allocations - before.allocations,
+                                chains * events,
+                                "Events not allocated from the pool");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.recycled - before.recycled,
+                                chains * (events - 2),
+                                "Events not recycled");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(after.slabs - before.slabs, 1, "Too many slabs allocated");
+}
+
+/**
+ * @ingroup event-pool-tests
+ *
+ * @brief Check blocks allocated by a thread and freed by another one.
+ */
+class EventPoolThreadsTestCase : public TestCase
+{
+  public:
+    EventPoolThreadsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventPoolThreadsTestCase::EventPoolThreadsTestCase()
+    : TestCase("Check blocks allocated and freed by different threads")
+{
+}
+
+void
+EventPoolThreadsTestCase::DoRun()
+{
+    const uint32_t nBlocks = 4 * EventPool::MAX_CACHED_BLOCKS;
+    const std::size_t size = 64;
+
+    // allocate in a thread which exits, free in this thread, several times:
+    // the blocks given back to the global pool must be recycled
+    std::vector<void*> blocks(nBlocks);
+    uint64_t slabs = 0;
+    for (uint32_t round = 0; round < 4; ++round)
+    {
+        std::thread producer([&blocks, nBlocks, size]() {
+            for (uint32_t i = 0; i < nBlocks; ++i)
+            {
+                blocks[i] = EventPool::Allocate(size);
+                *static_cast<uint64_t*>(blocks[i]) = i;
+            }
+        });
+        producer.join();
+
+        bool intact = true;
+        for (uint32_t i = 0; i < nBlocks; ++i)
+        {
+            intact &= (*static_cast<uint64_t*>(blocks[i]) == i);
+            EventPool::Deallocate(blocks[i], size);
+        }
+        NS_TEST_EXPECT_MSG_EQ(intact, true, "Block shared by two allocations");
+
+        auto stats = EventPool::GetStats();
+        if (round == 1)
+        {
+            slabs = stats.slabs;
+        }
+        else if (round > 1)
+        {
+            NS_TEST_EXPECT_MSG_EQ(stats.slabs, slabs, "Freed blocks not recycled");
+        }
+    }
+}
+
+/**
+ * @ingroup event-pool-tests
+ *
+ * @brief The EventPool Test Suite.
+ */
+class EventPoolTestSuite : public TestSuite
+{
+  public:
+    EventPoolTestSuite()
+        : TestSuite("event-pool")
+    {
+        AddTestCase(new EventPoolRecycleTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new EventPoolSimulatorTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new EventPoolThreadsTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static EventPoolTestSuite g_eventPoolTestSuite;
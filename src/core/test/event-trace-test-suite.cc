@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/event-trace.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup event-trace-tests
+ * EventTraceRecorder test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup event-trace-tests EventTraceRecorder tests
+ */
+
+/**
+ * @ingroup event-trace-tests
+ *
+ * @brief Check the event trace recorded by the DefaultSimulatorImpl.
+ */
+class EventTraceTestCase : public TestCase
+{
+  public:
+    EventTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the events of a simulation.
+     * @param filename The trace file name.
+     */
+    void RunSimulation(const std::string& filename);
+
+    /**
+     * Read an event trace.
+     * @param filename The trace file name.
+     * @return The records.
+     */
+    std::vector<EventTraceRecord> ReadTrace(const std::string& filename);
+
+    /**
+     * Event rescheduling itself.
+     * @param remaining The number of events still to schedule.
+     */
+    void Ping(uint32_t remaining);
+
+    /**
+     * Other type of event.
+     * @param value A value.
+     */
+    void Pong(double value);
+
+    uint32_t m_pings{0}; //!< Number of executed Ping events.
+    uint32_t m_pongs{0}; //!< Number of executed Pong events.
+};
+
+EventTraceTestCase::EventTraceTestCase()
+    : TestCase("Check the event trace of the DefaultSimulatorImpl")
+{
+}
+
+void
+EventTraceTestCase::Ping(uint32_t remaining)
+{
+    m_pings++;
+    if (remaining > 0)
+    {
+        Simulator::Schedule(MicroSeconds(3), &EventTraceTestCase::Ping, this, remaining - 1);
+        Simulator::ScheduleWithContext(remaining,
+                                       MicroSeconds(1),
+                                       &EventTraceTestCase::Pong,
+                                       this,
+                                       remaining);
+    }
+}
+
+void
+EventTraceTestCase::Pong(double /* value */)
+{
+    m_pongs++;
+}
+
+void
+EventTraceTestCase::RunSimulation(const std::string& filename)
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventTraceFile", StringValue(filename));
+    Simulator::Schedule(MicroSeconds(1), &EventTraceTestCase::Ping, this, 99);
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::Reset();
+}
+
+std::vector<EventTraceRecord>
+EventTraceTestCase::ReadTrace(const std::string& filename)
+{
+    std::vector<EventTraceRecord> records;
+    EventTraceReader reader(filename);
+    NS_TEST_EXPECT_MSG_EQ(reader.IsOk(), true, "Unable to read " << filename);
+    EventTraceRecord record;
+    while (reader.Read(record))
+    {
+        records.push_back(record);
+    }
+    for (const auto& r : records)
+    {
+        if (!r.IsEndOfRun())
+        {
+            auto name = reader.GetTypeName(r.typeHash);
+            NS_TEST_EXPECT_MSG_NE(name.find("EventTraceTestCase"),
+                                  std::string::npos,
+                                  "Wrong type name " << name);
+        }
+    }
+    return records;
+}
+
+void
+EventTraceTestCase::DoRun()
+{
+    auto first = CreateTempDirFilename("event-trace-1.bin");
+    auto second = CreateTempDirFilename("event-trace-2.bin");
+
+    RunSimulation(first);
+    NS_TEST_EXPECT_MSG_EQ(m_pings, 100, "Wrong number of Ping events");
+    NS_TEST_EXPECT_MSG_EQ(m_pongs, 99, "Wrong number of Pong events");
+    RunSimulation(second);
+
+    auto records = ReadTrace(first);
+    auto other = ReadTrace(second);
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 200, "Wrong number of records");
+    NS_TEST_ASSERT_MSG_EQ(other.size(), records.size(), "Traces of the same simulation differ");
+
+    NS_TEST_EXPECT_MSG_EQ(records.back().IsEndOfRun(), true, "No end of run record");
+    NS_TEST_EXPECT_MSG_EQ(records.back().timestamp,
+                          static_cast<uint64_t>(MicroSeconds(298).GetTimeStep()),
+                          "Wrong end of run time");
+    NS_TEST_EXPECT_MSG_EQ(records[0].timestamp,
+                          static_cast<uint64_t>(MicroSeconds(1).GetTimeStep()),
+                          "Wrong time");
+    NS_TEST_EXPECT_MSG_EQ(records[1].context, 99, "Wrong context");
+    NS_TEST_EXPECT_MSG_NE(records[0].typeHash, records[1].typeHash, "Same type hash");
+
+    bool same = true;
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(records[i].wallTime,
+                                    records[i == 0 ? 0 : i - 1].wallTime,
+                                    "Wall clock time going backward");
+        same &= (records[i].timestamp == other[i].timestamp &&
+                 records[i].context == other[i].context && records[i].uid == other[i].uid &&
+                 records[i].typeHash == other[i].typeHash);
+    }
+    NS_TEST_EXPECT_MSG_EQ(same, true, "Traces of the same simulation differ");
+}
+
+/**
+ * @ingroup event-trace-tests
+ *
+ * @brief The EventTraceRecorder Test Suite.
+ */
+class EventTraceTestSuite : public TestSuite
+{
+  public:
+    EventTraceTestSuite()
+        : TestSuite("event-trace")
+    {
+        AddTestCase(new EventTraceTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static EventTraceTestSuite g_eventTraceTestSuite;
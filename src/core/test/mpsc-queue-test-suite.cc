@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/mpsc-queue.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup mpsc-queue-tests
+ * MpscQueue test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup mpsc-queue-tests MpscQueue tests
+ */
+
+/**
+ * @ingroup mpsc-queue-tests
+ *
+ * @brief Check the MpscQueue from a single thread.
+ */
+class MpscQueueSingleThreadTestCase : public TestCase
+{
+  public:
+    MpscQueueSingleThreadTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueSingleThreadTestCase::MpscQueueSingleThreadTestCase()
+    : TestCase("Check the MpscQueue from a single thread")
+{
+}
+
+void
+MpscQueueSingleThreadTestCase::DoRun()
+{
+    MpscQueue<int> queue(5);
+    NS_TEST_EXPECT_MSG_EQ(queue.GetCapacity(), 8, "Capacity not rounded to a power of two");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue should be empty");
+
+    int item = -1;
+    NS_TEST_EXPECT_MSG_EQ(queue.TryPop(item), false, "Pop from an empty queue");
+
+    // wrap around the ring several times
+    int next = 0;
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(queue.TryPush(lap * 8 + i), true, "Push failed");
+        }
+        NS_TEST_EXPECT_MSG_EQ(queue.TryPush(100), false, "Push in a full queue");
+        NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), false, "Queue should not be empty");
+        for (int i = 0; i < 8; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(queue.TryPop(item), true, "Pop failed");
+            NS_TEST_EXPECT_MSG_EQ(item, next++, "Items not in FIFO order");
+        }
+        NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue should be empty");
+    }
+}
+
+/**
+ * @ingroup mpsc-queue-tests
+ *
+ * @brief Check that no item is lost or reordered with concurrent producers.
+ */
+class MpscQueueMultipleProducersTestCase : public TestCase
+{
+  public:
+    MpscQueueMultipleProducersTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueMultipleProducersTestCase::MpscQueueMultipleProducersTestCase()
+    : TestCase("Check the MpscQueue with concurrent producers")
+{
+}
+
+void
+MpscQueueMultipleProducersTestCase::DoRun()
+{
+    const uint32_t nProducers = 4;
+    const uint32_t nItems = 20000;
+    // items are (producer << 32 | sequence number)
+    MpscQueue<uint64_t> queue(64);
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < nProducers; ++p)
+    {
+        producers.emplace_back([&queue, p, nItems]() {
+            for (uint64_t i = 0; i < nItems; ++i)
+            {
+                while (!queue.TryPush((static_cast<uint64_t>(p) << 32) | i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint64_t> expected(nProducers, 0);
+    uint64_t popped = 0;
+    bool ordered = true;
+    while (popped < nProducers * nItems)
+    {
+        uint64_t item;
+        if (!queue.TryPop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t p = item >> 32;
+        ordered &= (p < nProducers && (item & 0xffffffff) == expected[p]);
+        expected[p]++;
+        popped++;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(ordered, true, "Items of a producer not in FIFO order");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue should be empty");
+}
+
+/**
+ * @ingroup mpsc-queue-tests
+ *
+ * @brief The MpscQueue Test Suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+  public:
+    MpscQueueTestSuite()
+        : TestSuite("mpsc-queue")
+    {
+        AddTestCase(new MpscQueueSingleThreadTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MpscQueueMultipleProducersTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MpscQueueTestSuite g_mpscQueueTestSuite;
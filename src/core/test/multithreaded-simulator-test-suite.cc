@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup multithreaded-simulator-tests
+ * MultithreadedSimulatorImpl test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup multithreaded-simulator-tests MultithreadedSimulatorImpl tests
+ */
+
+/**
+ * @ingroup multithreaded-simulator-tests
+ *
+ * @brief Check the basic event handling of the MultithreadedSimulatorImpl.
+ */
+class MultithreadedSimulatorEventsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param partitions The number of partitions.
+     */
+    MultithreadedSimulatorEventsTestCase(uint32_t partitions);
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Event checking the context and time it is executed in.
+     * @param context The expected context.
+     * @param time The expected time.
+     */
+    void CheckContext(uint32_t context, Time time);
+    /** Event which is removed before being executed. */
+    void Removed();
+    /** Destroy event. */
+    void Destroy();
+
+    uint32_t m_partitions; //!< Number of partitions.
+    uint32_t m_executed;   //!< Number of executed CheckContext events.
+    bool m_removed;        //!< Whether the removed event was executed.
+    bool m_destroy;        //!< Whether the destroy event was executed.
+};
+
+MultithreadedSimulatorEventsTestCase::MultithreadedSimulatorEventsTestCase(uint32_t partitions)
+    : TestCase("Check basic event handling with " + std::to_string(partitions) + " partition(s)"),
+      m_partitions(partitions)
+{
+}
+
+void
+MultithreadedSimulatorEventsTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount",
+                       UintegerValue(m_partitions));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue(MicroSeconds(5)));
+}
+
+void
+MultithreadedSimulatorEventsTestCase::DoTeardown()
+{
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+void
+MultithreadedSimulatorEventsTestCase::CheckContext(uint32_t context, Time time)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), context, "Wrong context");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), time, "Wrong time");
+    m_executed++;
+}
+
+void
+MultithreadedSimulatorEventsTestCase::Removed()
+{
+    m_removed = true;
+}
+
+void
+MultithreadedSimulatorEventsTestCase::Destroy()
+{
+    m_destroy = true;
+}
+
+void
+MultithreadedSimulatorEventsTestCase::DoRun()
+{
+    m_executed = 0;
+    m_removed = false;
+    m_destroy = false;
+
+    auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_EQ((impl != nullptr), true, "Wrong simulator implementation");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), m_partitions, "Wrong partition count");
+
+    for (uint32_t context = 0; context < 8; ++context)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       MicroSeconds(10 * (context + 1)),
+                                       &MultithreadedSimulatorEventsTestCase::CheckContext,
+                                       this,
+                                       context,
+                                       MicroSeconds(10 * (context + 1)));
+    }
+    EventId removed =
+        Simulator::Schedule(MicroSeconds(15), &MultithreadedSimulatorEventsTestCase::Removed, this);
+    EventId cancelled =
+        Simulator::Schedule(MicroSeconds(16), &MultithreadedSimulatorEventsTestCase::Removed, this);
+    NS_TEST_EXPECT_MSG_EQ(removed.IsPending(), true, "Event should be pending");
+    Simulator::Remove(removed);
+    Simulator::Cancel(cancelled);
+    NS_TEST_EXPECT_MSG_EQ(removed.IsExpired(), true, "Event was removed: it is now expired");
+    NS_TEST_EXPECT_MSG_EQ(cancelled.IsExpired(), true, "Event was cancelled: it is now expired");
+
+    EventId destroy =
+        Simulator::ScheduleDestroy(&MultithreadedSimulatorEventsTestCase::Destroy, this);
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_executed, 8, "Not all the events were executed");
+    NS_TEST_EXPECT_MSG_EQ(m_removed, false, "Removed event was executed");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(80), "Wrong final time");
+    // the cancelled event is counted
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 9, "Wrong event count");
+    NS_TEST_EXPECT_MSG_EQ(destroy.IsPending(), true, "Destroy event should be pending");
+
+    // Schedule again after a first run
+    Simulator::ScheduleWithContext(3,
+                                   MicroSeconds(1),
+                                   &MultithreadedSimulatorEventsTestCase::CheckContext,
+                                   this,
+                                   3,
+                                   MicroSeconds(81));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_executed, 9, "Event scheduled after the first run not executed");
+
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Destroy event was not executed");
+}
+
+/**
+ * @ingroup multithreaded-simulator-tests
+ *
+ * @brief Check that a model exchanging events between contexts produces the
+ * same events as with the DefaultSimulatorImpl, whatever the number of threads.
+ *
+ * Each event either schedules the next event locally or sends it to one of
+ * the next contexts, with a delay at least equal to the lookahead. The content of the
+ * events only depends on the event payload, so that the set of events
+ * executed by each context does not depend on the relative order of events
+ * with the same timestamp.
+ */
+class MultithreadedSimulatorDeterminismTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorDeterminismTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Trace of the events executed by a context: (time, payload)
+    using Trace = std::vector<std::tuple<int64_t, uint64_t>>;
+
+    /**
+     * Run the model.
+     * @param simulatorType The simulator implementation.
+     * @param partitions The number of partitions.
+     * @param threads The number of threads.
+     * @return The traces of the contexts.
+     */
+    std::vector<Trace> RunModel(const std::string& simulatorType,
+                                uint32_t partitions,
+                                uint32_t threads);
+
+    /**
+     * The model event.
+     * @param payload The event payload.
+     */
+    void Receive(uint64_t payload);
+
+    std::vector<Trace> m_traces; //!< Traces of the contexts.
+};
+
+/// Number of contexts in the determinism test.
+static constexpr uint32_t N_CONTEXTS = 16;
+/// Lookahead used in the determinism test, in microseconds.
+static constexpr uint64_t LOOKAHEAD_US = 20;
+
+MultithreadedSimulatorDeterminismTestCase::MultithreadedSimulatorDeterminismTestCase()
+    : TestCase("Check that the events do not depend on the number of threads")
+{
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::Receive(uint64_t payload)
+{
+    uint32_t context = Simulator::GetContext();
+    m_traces[context].emplace_back(Simulator::Now().GetNanoSeconds(), payload);
+
+    // simple LCG to derive the next payload, which is either handled locally
+    // or sent to another context
+    uint64_t next = payload * 6364136223846793005ULL + 1442695040888963407ULL;
+    if ((next >> 62) == 0)
+    {
+        Simulator::ScheduleWithContext((context + 1 + (next >> 40) % 3) % N_CONTEXTS,
+                                       MicroSeconds(LOOKAHEAD_US + (next >> 56) % 7),
+                                       &MultithreadedSimulatorDeterminismTestCase::Receive,
+                                       this,
+                                       next);
+    }
+    else
+    {
+        Simulator::Schedule(MicroSeconds(1 + (next >> 60)),
+                            &MultithreadedSimulatorDeterminismTestCase::Receive,
+                            this,
+                            next);
+    }
+}
+
+std::vector<MultithreadedSimulatorDeterminismTestCase::Trace>
+MultithreadedSimulatorDeterminismTestCase::RunModel(const std::string& simulatorType,
+                                                    uint32_t partitions,
+                                                    uint32_t threads)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount",
+                       UintegerValue(partitions));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue(threads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Lookahead",
+                       TimeValue(MicroSeconds(LOOKAHEAD_US)));
+
+    m_traces.assign(N_CONTEXTS, Trace());
+    for (uint32_t context = 0; context < N_CONTEXTS; ++context)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       MicroSeconds(context),
+                                       &MultithreadedSimulatorDeterminismTestCase::Receive,
+                                       this,
+                                       context + 1);
+    }
+    // stop between two integer microseconds, i.e., never at the same time as an event
+    Simulator::Stop(MicroSeconds(5000) + NanoSeconds(500));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    return m_traces;
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::DoRun()
+{
+    auto reference = RunModel("ns3::DefaultSimulatorImpl", 1, 1);
+    auto oneThread = RunModel("ns3::MultithreadedSimulatorImpl", 4, 1);
+    auto fourThreads = RunModel("ns3::MultithreadedSimulatorImpl", 4, 4);
+    auto singlePartition = RunModel("ns3::MultithreadedSimulatorImpl", 1, 1);
+
+    for (uint32_t context = 0; context < N_CONTEXTS; ++context)
+    {
+        NS_TEST_ASSERT_MSG_GT(reference[context].size(), 100, "Too few events");
+        NS_TEST_EXPECT_MSG_EQ((oneThread[context] == fourThreads[context]),
+                              true,
+                              "Events of context " << context << " depend on the thread count");
+        NS_TEST_EXPECT_MSG_EQ((singlePartition[context] == reference[context]),
+                              true,
+                              "Events of context " << context
+                                                   << " differ from DefaultSimulatorImpl");
+        std::sort(reference[context].begin(), reference[context].end());
+        std::sort(oneThread[context].begin(), oneThread[context].end());
+        NS_TEST_EXPECT_MSG_EQ((oneThread[context] == reference[context]),
+                              true,
+                              "Events of context " << context
+                                                   << " differ from DefaultSimulatorImpl");
+    }
+}
+
+/**
+ * @ingroup multithreaded-simulator-tests
+ *
+ * @brief The MultithreadedSimulatorImpl Test Suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    MultithreadedSimulatorTestSuite()
+        : TestSuite("multithreaded-simulator")
+    {
+        AddTestCase(new MultithreadedSimulatorEventsTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new MultithreadedSimulatorEventsTestCase(3), TestCase::Duration::QUICK);
+        AddTestCase(new MultithreadedSimulatorDeterminismTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/open-hash-map.h"
+#include "ns3/test.h"
+
+#include <map>
+#include <random>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup open-hash-map-tests
+ * OpenHashMap test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup open-hash-map-tests OpenHashMap tests
+ */
+
+/**
+ * @ingroup open-hash-map-tests
+ *
+ * A hash function of the integers with many collisions, which makes long
+ * probe sequences.
+ */
+struct CollidingHash
+{
+    /**
+     * @param [in] key The key.
+     * @return The hash of the key.
+     */
+    std::size_t operator()(uint32_t key) const
+    {
+        return key % 16;
+    }
+};
+
+/**
+ * @ingroup open-hash-map-tests
+ *
+ * @brief Check the OpenHashMap against a std::map, while keys are inserted
+ * and erased in random order.
+ *
+ * @tparam H \explicit The hash function of the keys.
+ */
+template <typename H>
+class OpenHashMapRandomTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] name The name of the test case.
+     * @param [in] keyRange The keys are drawn in [0, keyRange).
+     */
+    OpenHashMapRandomTestCase(const std::string& name, uint32_t keyRange);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_keyRange; //!< The keys are drawn in [0, m_keyRange).
+};
+
+template <typename H>
+OpenHashMapRandomTestCase<H>::OpenHashMapRandomTestCase(const std::string& name,
+                                                        uint32_t keyRange)
+    : TestCase("Check the OpenHashMap with " + name + " and keys in [0, " +
+               std::to_string(keyRange) + ")"),
+      m_keyRange(keyRange)
+{
+}
+
+template <typename H>
+void
+OpenHashMapRandomTestCase<H>::DoRun()
+{
+    std::mt19937 rng(1);
+    OpenHashMap<uint32_t, std::string, H> map;
+    std::map<uint32_t, std::string> reference;
+    for (uint32_t step = 0; step < 50000; ++step)
+    {
+        const uint32_t key = rng() % m_keyRange;
+        const auto op = rng() % 10;
+        if (op < 4)
+        {
+            auto [value, inserted] = map.Insert(key);
+            NS_TEST_ASSERT_MSG_EQ(inserted,
+                                  (reference.count(key) == 0),
+                                  "Unexpected insertion of key " << key);
+            *value = std::to_string(step);
+            reference[key] = *value;
+        }
+        else if (op < 7)
+        {
+            NS_TEST_ASSERT_MSG_EQ(map.Erase(key),
+                                  (reference.erase(key) == 1),
+                                  "Unexpected erasure of key " << key);
+        }
+        else
+        {
+            const auto value = map.Find(key);
+            const auto it = reference.find(key);
+            NS_TEST_ASSERT_MSG_EQ((value != nullptr),
+                                  (it != reference.end()),
+                                  "Unexpected lookup of key " << key);
+            if (value)
+            {
+                NS_TEST_ASSERT_MSG_EQ(*value, it->second, "Unexpected value of key " << key);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(map.GetSize(), reference.size(), "Unexpected number of entries");
+    }
+
+    // every remaining entry can still be found after the shifts of the erasures
+    for (const auto& [key, value] : reference)
+    {
+        const auto found = map.Find(key);
+        NS_TEST_ASSERT_MSG_NE(found, nullptr, "Key " << key << " lost");
+        NS_TEST_EXPECT_MSG_EQ(*found, value, "Unexpected value of key " << key);
+    }
+
+    map.Clear();
+    NS_TEST_EXPECT_MSG_EQ(map.GetSize(), 0, "The map should be empty");
+    NS_TEST_EXPECT_MSG_EQ(map.Find(reference.begin()->first), nullptr, "The map should be empty");
+}
+
+/**
+ * @ingroup open-hash-map-tests
+ *
+ * @brief Check that the OpenHashMap does not grow below the reserved capacity.
+ */
+class OpenHashMapReserveTestCase : public TestCase
+{
+  public:
+    OpenHashMapReserveTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+OpenHashMapReserveTestCase::OpenHashMapReserveTestCase()
+    : TestCase("Check the reserved capacity of the OpenHashMap")
+{
+}
+
+void
+OpenHashMapReserveTestCase::DoRun()
+{
+    OpenHashMap<uint64_t, uint32_t> map(1000);
+    const auto capacity = map.GetCapacity();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(capacity, 1000, "Capacity below the reserved count");
+
+    for (uint64_t key = 0; key < 1000; ++key)
+    {
+        *map.Insert(key << 32).first = key;
+    }
+    NS_TEST_EXPECT_MSG_EQ(map.GetCapacity(), capacity, "The map grew below its capacity");
+
+    // growing past the capacity keeps the entries
+    for (uint64_t key = 1000; key < 2 * capacity; ++key)
+    {
+        *map.Insert(key << 32).first = key;
+    }
+    NS_TEST_EXPECT_MSG_GT(map.GetCapacity(), capacity, "The map did not grow");
+    for (uint64_t key = 0; key < 2 * capacity; ++key)
+    {
+        const auto value = map.Find(key << 32);
+        NS_TEST_ASSERT_MSG_NE(value, nullptr, "Key " << key << " lost");
+        NS_TEST_EXPECT_MSG_EQ(*value, key, "Unexpected value of key " << key);
+    }
+}
+
+/**
+ * @ingroup open-hash-map-tests
+ *
+ * @brief OpenHashMap TestSuite
+ */
+class OpenHashMapTestSuite : public TestSuite
+{
+  public:
+    OpenHashMapTestSuite();
+};
+
+OpenHashMapTestSuite::OpenHashMapTestSuite()
+    : TestSuite("open-hash-map", Type::UNIT)
+{
+    AddTestCase(new OpenHashMapRandomTestCase<std::hash<uint32_t>>("std::hash", 100),
+                TestCase::Duration::QUICK);
+    AddTestCase(new OpenHashMapRandomTestCase<std::hash<uint32_t>>("std::hash", 5000),
+                TestCase::Duration::QUICK);
+    AddTestCase(new OpenHashMapRandomTestCase<CollidingHash>("colliding hashes", 1000),
+                TestCase::Duration::QUICK);
+    AddTestCase(new OpenHashMapReserveTestCase(), TestCase::Duration::QUICK);
+}
+
+static OpenHashMapTestSuite g_openHashMapTestSuite; //!< Static variable for test initialization
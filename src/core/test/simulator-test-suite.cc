@@ -7,12 +7,15 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <set>
+
 using namespace ns3;
 
 /**
@@ -200,6 +203,103 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that a scheduler returns the events in order, under a mix of
+ * insertions and removals with skewed timestamps.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the event order under random operations with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::EventKey> reference;
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    uint64_t lcg = 42;
+    // simple LCG, to avoid depending on the random variable framework
+    auto next = [&lcg]() {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lcg >> 33;
+    };
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint64_t op = next() % 16;
+        if (op < 9 || reference.empty())
+        {
+            // skewed delays: mostly short, some very long, some simultaneous
+            uint64_t r = next();
+            uint64_t delay = (r % 4 == 0) ? 0 : (r % 4 == 1) ? r % 100 : (r % 4 == 2) ? r % 10000 : r;
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = now + delay;
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            scheduler->Insert(ev);
+            reference.insert(ev.key);
+        }
+        else if (op < 15)
+        {
+            Scheduler::Event ev = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_ts, reference.begin()->m_ts, "Wrong next timestamp");
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, reference.begin()->m_uid, "Wrong next uid");
+            reference.erase(reference.begin());
+            now = ev.key.m_ts;
+        }
+        else
+        {
+            // remove a random pending event
+            auto it = reference.lower_bound({now + next() % 10000, 0, 0});
+            if (it == reference.end())
+            {
+                it = reference.begin();
+            }
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key = *it;
+            scheduler->Remove(ev);
+            reference.erase(it);
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference.empty(), "Wrong emptiness");
+        if (!reference.empty())
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  reference.begin()->m_uid,
+                                  "Wrong peeked event");
+        }
+    }
+    while (!reference.empty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, reference.begin()->m_uid, "Wrong next uid");
+        reference.erase(reference.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -670,6 +770,19 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (const auto& tid : {ListScheduler::GetTypeId(),
+                                MapScheduler::GetTypeId(),
+                                HeapScheduler::GetTypeId(),
+                                CalendarScheduler::GetTypeId(),
+                                PriorityQueueScheduler::GetTypeId(),
+                                LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
     }
 };
 
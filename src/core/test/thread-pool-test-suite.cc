@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/test.h"
+#include "ns3/thread-pool.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup thread-pool-tests
+ * ThreadPool test suite
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup thread-pool-tests ThreadPool tests
+ */
+
+/**
+ * @ingroup thread-pool-tests
+ *
+ * @brief Check that ThreadPool::ParallelFor executes every index exactly once.
+ */
+class ThreadPoolTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param threadCount The number of threads of the pool.
+     */
+    ThreadPoolTestCase(uint32_t threadCount);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_threadCount; //!< The number of threads of the pool.
+};
+
+ThreadPoolTestCase::ThreadPoolTestCase(uint32_t threadCount)
+    : TestCase("Check a ThreadPool of " + std::to_string(threadCount) + " threads"),
+      m_threadCount(threadCount)
+{
+}
+
+void
+ThreadPoolTestCase::DoRun()
+{
+    ThreadPool pool(m_threadCount);
+    NS_TEST_EXPECT_MSG_EQ(pool.GetThreadCount(),
+                          std::max(m_threadCount, 1U),
+                          "Unexpected number of threads");
+
+    // loops of various sizes, including smaller than the number of threads
+    for (std::size_t count : {0, 1, 2, 3, 17, 1000})
+    {
+        for (uint32_t run = 0; run < 20; ++run)
+        {
+            std::vector<uint32_t> executions(count, 0);
+            std::vector<uint64_t> results(count, 0);
+            pool.ParallelFor(count, [&](std::size_t i) {
+                executions[i]++;
+                results[i] = i * i + run;
+            });
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                NS_TEST_ASSERT_MSG_EQ(executions[i],
+                                      1,
+                                      "Index " << i << " of " << count << " not executed once");
+                NS_TEST_ASSERT_MSG_EQ(results[i], i * i + run, "Wrong result for index " << i);
+            }
+        }
+    }
+}
+
+/**
+ * @ingroup thread-pool-tests
+ *
+ * @brief The ThreadPool Test Suite.
+ */
+class ThreadPoolTestSuite : public TestSuite
+{
+  public:
+    ThreadPoolTestSuite()
+        : TestSuite("thread-pool")
+    {
+        for (uint32_t threadCount : {0, 1, 2, 4})
+        {
+            AddTestCase(new ThreadPoolTestCase(threadCount), TestCase::Duration::QUICK);
+        }
+    }
+};
+
+/// Static variable for test initialization.
+static ThreadPoolTestSuite g_threadPoolTestSuite;
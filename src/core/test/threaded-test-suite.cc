@@ -7,6 +7,7 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
@@ -258,6 +259,14 @@ ThreadedSimulatorEventsTestCase::DoRun()
     }
 
     Simulator::Run();
+
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    if (impl && m_threads > 0)
+    {
+        NS_TEST_EXPECT_MSG_GT(impl->GetCrossThreadEventCount(),
+                              0,
+                              "Cross-thread events not counted");
+    }
     Simulator::Destroy();
 
     NS_TEST_EXPECT_MSG_EQ(m_error.empty(), true, m_error);
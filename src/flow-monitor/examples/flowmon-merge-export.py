@@ -0,0 +1,231 @@
+# -*-  Mode: Python; -*-
+#  Copyright (c) 2026
+#
+#  SPDX-License-Identifier: GPL-2.0-only
+
+import argparse
+import csv
+import os
+import sys
+
+## File merged when no file is given
+SAMPLE_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "flowmon-export-sample.csv")
+
+## Columns of the exported files, in order
+COLUMNS = [
+    "flowId",
+    "sourceAddress",
+    "destinationAddress",
+    "protocol",
+    "sourcePort",
+    "destinationPort",
+    "timeFirstTxPacket",
+    "timeFirstRxPacket",
+    "timeLastTxPacket",
+    "timeLastRxPacket",
+    "delaySum",
+    "jitterSum",
+    "lastDelay",
+    "maxDelay",
+    "minDelay",
+    "txBytes",
+    "rxBytes",
+    "txPackets",
+    "rxPackets",
+    "lostPackets",
+    "timesForwarded",
+    "packetsDropped",
+    "bytesDropped",
+    "delayHistogram",
+]
+
+## Columns of the five-tuple, which are empty if the flow was not known by the classifiers
+TUPLE_COLUMNS = ["sourceAddress", "destinationAddress", "protocol", "sourcePort", "destinationPort"]
+
+## Columns holding lists separated by semicolons, which are summed element by element
+LIST_COLUMNS = ["packetsDropped", "bytesDropped", "delayHistogram"]
+
+## Columns which are summed when the rows of a flow are merged
+SUMMED_COLUMNS = [
+    "delaySum",
+    "jitterSum",
+    "txBytes",
+    "rxBytes",
+    "txPackets",
+    "rxPackets",
+    "lostPackets",
+    "timesForwarded",
+]
+
+
+def parse_list(value):
+    """! Parse a list of counters, e.g., the drops indexed by reason code.
+    @param value The list of counters, separated by semicolons.
+    @return The list of counters.
+    """
+    return [int(count) for count in value.split(";")] if value else []
+
+
+def add_lists(a, b):
+    """! Add two lists of counters, element by element.
+    @param a A list of counters.
+    @param b Another list of counters.
+    @return The sum of the lists.
+    """
+    if len(a) < len(b):
+        a, b = b, a
+    return [count + (b[i] if i < len(b) else 0) for i, count in enumerate(a)]
+
+
+def parse_row(row):
+    """! Parse a row of an exported file.
+    @param row The row, as a dictionary of strings.
+    @return The statistics of the flow.
+    """
+    stats = {}
+    for column in COLUMNS:
+        if column in LIST_COLUMNS:
+            stats[column] = parse_list(row[column])
+        elif column in TUPLE_COLUMNS:
+            stats[column] = row[column]
+        else:
+            stats[column] = int(row[column])
+    return stats
+
+
+def merge(a, b):
+    """! Merge the statistics of a flow exported in two rows.
+    @param a The statistics of the flow.
+    @param b Other statistics of the flow.
+    @return The merged statistics.
+    """
+    merged = dict(a)
+    merged["flowId"] = min(a["flowId"], b["flowId"])
+    if not a["sourceAddress"]:
+        for column in TUPLE_COLUMNS:
+            merged[column] = b[column]
+    for column in SUMMED_COLUMNS:
+        merged[column] = a[column] + b[column]
+    # the times of a row without any packet sent or received are not set
+    if b["txPackets"] > 0:
+        if a["txPackets"] == 0:
+            merged["timeFirstTxPacket"] = b["timeFirstTxPacket"]
+        else:
+            merged["timeFirstTxPacket"] = min(a["timeFirstTxPacket"], b["timeFirstTxPacket"])
+        merged["timeLastTxPacket"] = max(a["timeLastTxPacket"], b["timeLastTxPacket"])
+    if b["rxPackets"] > 0:
+        if a["rxPackets"] == 0:
+            for column in ("timeFirstRxPacket", "lastDelay", "maxDelay", "minDelay"):
+                merged[column] = b[column]
+        else:
+            merged["timeFirstRxPacket"] = min(a["timeFirstRxPacket"], b["timeFirstRxPacket"])
+            merged["maxDelay"] = max(a["maxDelay"], b["maxDelay"])
+            merged["minDelay"] = min(a["minDelay"], b["minDelay"])
+            if b["timeLastRxPacket"] >= a["timeLastRxPacket"]:
+                merged["lastDelay"] = b["lastDelay"]
+        merged["timeLastRxPacket"] = max(a["timeLastRxPacket"], b["timeLastRxPacket"])
+    for column in LIST_COLUMNS:
+        merged[column] = add_lists(a[column], b[column])
+    return merged
+
+
+def five_tuple(stats):
+    """! Get the five-tuple of a flow.
+    @param stats The statistics of the flow.
+    @return The five-tuple, or None if unknown.
+    """
+    if not stats["sourceAddress"]:
+        return None
+    return tuple(stats[column] for column in TUPLE_COLUMNS)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description="Merge the flow statistics exported by the FlowMonitor in CSV files"
+    )
+    parser.add_argument(
+        "files",
+        nargs="*",
+        default=[SAMPLE_FILE],
+        help="the exported files (default: a sample file)",
+    )
+    parser.add_argument(
+        "--five-tuple",
+        action="store_true",
+        help="merge the flows with the same five-tuple, which get a new flow identifier "
+        "when they become active again after being exported",
+    )
+    parser.add_argument("--output", help="the file of the merged statistics, one row per flow")
+    args = parser.parse_args(argv[1:])
+
+    flows = {}
+    for file_name in args.files:
+        with open(file_name, encoding="utf-8", newline="") as file_obj:
+            for row in csv.DictReader(file_obj):
+                stats = parse_row(row)
+                flowId = stats["flowId"]
+                flows[flowId] = merge(flows[flowId], stats) if flowId in flows else stats
+
+    if args.five_tuple:
+        tuples = {}
+        for flowId in sorted(flows):
+            key = five_tuple(flows[flowId]) or flowId
+            tuples[key] = merge(tuples[key], flows[flowId]) if key in tuples else flows[flowId]
+        flows = {stats["flowId"]: stats for stats in tuples.values()}
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8", newline="") as file_obj:
+            writer = csv.writer(file_obj, lineterminator="\n")
+            writer.writerow(COLUMNS)
+            for flowId in sorted(flows):
+                stats = flows[flowId]
+                writer.writerow(
+                    [
+                        ";".join(str(drops) for drops in stats[column])
+                        if isinstance(stats[column], list)
+                        else stats[column]
+                        for column in COLUMNS
+                    ]
+                )
+
+    for flowId in sorted(flows):
+        stats = flows[flowId]
+        if five_tuple(stats):
+            print(
+                "FlowID: %i (%s %s:%s --> %s:%s)"
+                % (
+                    flowId,
+                    {"6": "TCP", "17": "UDP"}.get(stats["protocol"], stats["protocol"]),
+                    stats["sourceAddress"],
+                    stats["sourcePort"],
+                    stats["destinationAddress"],
+                    stats["destinationPort"],
+                )
+            )
+        else:
+            print("FlowID: %i" % flowId)
+        duration = (stats["timeLastTxPacket"] - stats["timeFirstTxPacket"]) * 1e-9
+        if stats["txPackets"] > 1 and duration > 0:
+            print("\tTX bitrate: %.2f kbit/s" % (stats["txBytes"] * 8e-3 / duration,))
+        else:
+            print("\tTX bitrate: None")
+        duration = (stats["timeLastRxPacket"] - stats["timeFirstRxPacket"]) * 1e-9
+        if stats["rxPackets"] > 1 and duration > 0:
+            print("\tRX bitrate: %.2f kbit/s" % (stats["rxBytes"] * 8e-3 / duration,))
+        else:
+            print("\tRX bitrate: None")
+        if stats["rxPackets"] > 0:
+            print("\tMean Delay: %.2f ms" % (stats["delaySum"] * 1e-6 / stats["rxPackets"],))
+        else:
+            print("\tMean Delay: None")
+        if stats["rxPackets"] + stats["lostPackets"] > 0:
+            print(
+                "\tPacket Loss Ratio: %.2f %%"
+                % (100.0 * stats["lostPackets"] / (stats["rxPackets"] + stats["lostPackets"]))
+            )
+        else:
+            print("\tPacket Loss Ratio: None")
+
+
+if __name__ == "__main__":
+    main(sys.argv)
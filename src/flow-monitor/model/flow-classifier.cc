@@ -20,6 +20,22 @@ FlowClassifier::~FlowClassifier()
 {
 }
 
+void
+FlowClassifier::Reserve(uint32_t flows)
+{
+}
+
+bool
+FlowClassifier::SerializeFlowToCsvStream(std::ostream& os, FlowId flowId) const
+{
+    return false;
+}
+
+void
+FlowClassifier::RemoveFlows(const std::vector<FlowId>& flowIds)
+{
+}
+
 FlowId
 FlowClassifier::GetNewFlowId()
 {
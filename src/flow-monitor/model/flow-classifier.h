@@ -12,6 +12,7 @@
 #include "ns3/simple-ref-count.h"
 
 #include <ostream>
+#include <vector>
 
 namespace ns3
 {
@@ -57,6 +58,26 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// @param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Preallocates the memory needed to classify a number of flows,
+    /// so that the classification of their packets does not allocate
+    /// @param flows the number of flows
+    virtual void Reserve(uint32_t flows);
+
+    /// Serializes the fields identifying a flow, e.g., its five-tuple, to
+    /// an std::ostream as comma-separated values
+    /// @param os the output stream
+    /// @param flowId the flow identifier
+    /// @returns true if the flow is known by this classifier, false if
+    /// nothing was written
+    virtual bool SerializeFlowToCsvStream(std::ostream& os, FlowId flowId) const;
+
+    /// Removes flows, e.g., after their statistics have been exported, so
+    /// that the memory of the classifier does not grow with the number of
+    /// flows. A packet of a removed flow which is classified afterwards is
+    /// assigned a new flow identifier.
+    /// @param flowIds the identifiers of the flows to remove, in increasing order
+    virtual void RemoveFlows(const std::vector<FlowId>& flowIds);
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// @returns a new FlowId
@@ -11,7 +11,10 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -69,12 +72,47 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("FlowCapacity",
+                          "The number of flows for which memory is preallocated, in the "
+                          "FlowMonitor and in its FlowClassifiers.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&FlowMonitor::m_flowCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("TrackedPacketCapacity",
+                          "The number of packets in flight for which memory is preallocated.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&FlowMonitor::m_trackedCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ExportFileName",
+                          "The name of the CSV file to which the statistics of the idle flows "
+                          "are periodically exported, before being removed from the FlowMonitor. "
+                          "The flows are not exported if empty. It cannot be changed once the "
+                          "file is open.",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::SetExportFileName),
+                          MakeStringChecker())
+            .AddAttribute("ExportInterval",
+                          "The interval between the exports of the idle flows.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportInterval),
+                          MakeTimeChecker())
+            .AddAttribute("ExportIdleTime",
+                          "The time without any packet sent or received after which a flow is "
+                          "exported.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportIdleTime),
+                          MakeTimeChecker());
     return tid;
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_oldestTrackedPacket(NO_TRACKED_PACKET),
+      m_newestTrackedPacket(NO_TRACKED_PACKET),
+      m_freeTrackedPacket(NO_TRACKED_PACKET),
+      m_enabled(false),
+      m_exportAtDestroy(false),
+      m_constructed(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -85,6 +123,7 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_exportEvent);
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -101,10 +140,11 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    auto [stats, inserted] = m_flowStatsIndex.Insert(flowId);
+    if (inserted)
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        *stats = &ref;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -124,10 +164,97 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
     else
     {
-        return iter->second;
+        return **stats;
     }
 }
 
+inline uint32_t
+FlowMonitor::FindTrackedPacket(FlowId flowId, FlowPacketId packetId) const
+{
+    const uint32_t* index =
+        m_trackedPacketIndex.Find((static_cast<uint64_t>(flowId) << 32) | packetId);
+    return index ? *index : NO_TRACKED_PACKET;
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackPacket(FlowId flowId, FlowPacketId packetId)
+{
+    auto [index, inserted] =
+        m_trackedPacketIndex.Insert((static_cast<uint64_t>(flowId) << 32) | packetId);
+    if (inserted)
+    {
+        if (m_freeTrackedPacket != NO_TRACKED_PACKET)
+        {
+            *index = m_freeTrackedPacket;
+            m_freeTrackedPacket = m_trackedPackets[m_freeTrackedPacket].next;
+        }
+        else
+        {
+            *index = m_trackedPackets.size();
+            m_trackedPackets.emplace_back();
+        }
+        TrackedPacket& tracked = m_trackedPackets[*index];
+        tracked.flowId = flowId;
+        tracked.packetId = packetId;
+    }
+    else
+    {
+        UnlinkTrackedPacket(*index);
+    }
+    const uint32_t trackedIndex = *index;
+    LinkNewestTrackedPacket(trackedIndex);
+    return m_trackedPackets[trackedIndex];
+}
+
+inline void
+FlowMonitor::LinkNewestTrackedPacket(uint32_t index)
+{
+    TrackedPacket& tracked = m_trackedPackets[index];
+    tracked.prev = m_newestTrackedPacket;
+    tracked.next = NO_TRACKED_PACKET;
+    if (m_newestTrackedPacket != NO_TRACKED_PACKET)
+    {
+        m_trackedPackets[m_newestTrackedPacket].next = index;
+    }
+    else
+    {
+        m_oldestTrackedPacket = index;
+    }
+    m_newestTrackedPacket = index;
+}
+
+inline void
+FlowMonitor::UnlinkTrackedPacket(uint32_t index)
+{
+    const TrackedPacket& tracked = m_trackedPackets[index];
+    if (tracked.prev != NO_TRACKED_PACKET)
+    {
+        m_trackedPackets[tracked.prev].next = tracked.next;
+    }
+    else
+    {
+        m_oldestTrackedPacket = tracked.next;
+    }
+    if (tracked.next != NO_TRACKED_PACKET)
+    {
+        m_trackedPackets[tracked.next].prev = tracked.prev;
+    }
+    else
+    {
+        m_newestTrackedPacket = tracked.prev;
+    }
+}
+
+void
+FlowMonitor::UntrackPacket(uint32_t index)
+{
+    UnlinkTrackedPacket(index);
+    TrackedPacket& tracked = m_trackedPackets[index];
+    m_trackedPacketIndex.Erase((static_cast<uint64_t>(tracked.flowId) << 32) | tracked.packetId);
+    tracked.next = m_freeTrackedPacket;
+    m_freeTrackedPacket = index;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -141,7 +268,7 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    TrackedPacket& tracked = TrackPacket(flowId, packetId);
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
@@ -172,19 +299,22 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    uint32_t index = FindTrackedPacket(flowId, packetId);
+    if (index == NO_TRACKED_PACKET)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    // keep the tracked packets sorted by lastSeenTime
+    UnlinkTrackedPacket(index);
+    LinkNewestTrackedPacket(index);
+    TrackedPacket& tracked = m_trackedPackets[index];
+    tracked.timesForwarded++;
+    tracked.lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -200,16 +330,17 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    uint32_t index = FindTrackedPacket(flowId, packetId);
+    if (index == NO_TRACKED_PACKET)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    const TrackedPacket& tracked = m_trackedPackets[index];
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
@@ -256,12 +387,12 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked.timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    UntrackPacket(index); // we don't need to track this packet anymore
 }
 
 void
@@ -292,14 +423,14 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    uint32_t index = FindTrackedPacket(flowId, packetId);
+    if (index != NO_TRACKED_PACKET)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        UntrackPacket(index);
     }
 }
 
@@ -315,22 +446,16 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // the tracked packets are sorted by lastSeenTime, hence the sweep stops at the first
+    // packet which is not lost
+    while (m_oldestTrackedPacket != NO_TRACKED_PACKET &&
+           now - m_trackedPackets[m_oldestTrackedPacket].lastSeenTime >= maxDelay)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+        // packet is considered lost, add it to the loss statistics, which may have been exported
+        GetStatsForFlow(m_trackedPackets[m_oldestTrackedPacket].flowId).lostPackets++;
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
-        }
+        // we won't track it anymore
+        UntrackPacket(m_oldestTrackedPacket);
     }
 }
 
@@ -351,7 +476,154 @@ void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
+    m_flowStatsIndex.Reserve(m_flowCapacity);
+    m_trackedPackets.reserve(m_trackedCapacity);
+    m_trackedPacketIndex.Reserve(m_trackedCapacity);
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    m_constructed = true;
+    ScheduleExport();
+}
+
+void
+FlowMonitor::SetExportFileName(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    NS_ABORT_MSG_IF(m_exportFile.is_open() && fileName != m_exportFileName,
+                    "The ExportFileName attribute cannot be changed once the file is open");
+    m_exportFileName = fileName;
+    if (m_constructed)
+    {
+        ScheduleExport();
+    }
+}
+
+void
+FlowMonitor::ScheduleExport()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_exportEvent);
+    if (m_exportFileName.empty())
+    {
+        return;
+    }
+    NS_ABORT_MSG_IF(!m_exportInterval.IsStrictlyPositive(),
+                    "The ExportInterval attribute must be positive");
+    m_exportEvent =
+        Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExportIdleFlows, this);
+    if (!m_exportAtDestroy)
+    {
+        // the reference keeps the FlowMonitor alive until the remaining flows are exported
+        Simulator::ScheduleDestroy(&FlowMonitor::ExportAllFlows, Ptr<FlowMonitor>(this));
+        m_exportAtDestroy = true;
+    }
+}
+
+void
+FlowMonitor::PeriodicExportIdleFlows()
+{
+    ExportIdleFlows(m_exportIdleTime);
+    m_exportEvent =
+        Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExportIdleFlows, this);
+}
+
+void
+FlowMonitor::ExportAllFlows()
+{
+    if (m_exportFileName.empty())
+    {
+        return;
+    }
+    ExportIdleFlows(Seconds(0));
+    m_exportFile.close();
+}
+
+void
+FlowMonitor::ExportIdleFlows(Time idleTime)
+{
+    NS_LOG_FUNCTION(this << idleTime.As(Time::S));
+    NS_ABORT_MSG_IF(m_exportFileName.empty(), "The ExportFileName attribute is not set");
+    if (!m_exportFile.is_open())
+    {
+        m_exportFile.open(m_exportFileName, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_IF(!m_exportFile.is_open(), "Cannot open the file " << m_exportFileName);
+        m_exportFile << "flowId,sourceAddress,destinationAddress,protocol,sourcePort,"
+                        "destinationPort,timeFirstTxPacket,timeFirstRxPacket,timeLastTxPacket,"
+                        "timeLastRxPacket,delaySum,jitterSum,lastDelay,maxDelay,minDelay,"
+                        "txBytes,rxBytes,txPackets,rxPackets,lostPackets,timesForwarded,"
+                        "packetsDropped,bytesDropped,delayHistogram\n";
+    }
+    CheckForLostPackets();
+
+    Time now = Simulator::Now();
+    std::vector<FlowId> exported;
+    for (auto iter = m_flowStats.begin(); iter != m_flowStats.end();)
+    {
+        const auto& [flowId, stats] = *iter;
+        if (now - std::max(stats.timeLastTxPacket, stats.timeLastRxPacket) < idleTime)
+        {
+            ++iter;
+            continue;
+        }
+        // the five-tuple is left empty if the flow is not known by the classifiers anymore
+        auto& os = m_exportFile;
+        os << flowId << ',';
+        if (std::none_of(m_classifiers.begin(),
+                         m_classifiers.end(),
+                         [&os, flowId](const Ptr<FlowClassifier>& classifier) {
+                             return classifier && classifier->SerializeFlowToCsvStream(os, flowId);
+                         }))
+        {
+            os << ",,,,";
+        }
+        // the times are in nanoseconds, the drops are lists indexed by reason code and the
+        // delay histogram is the list of the counts of its bins
+        os << ',' << stats.timeFirstTxPacket.GetNanoSeconds() << ','
+           << stats.timeFirstRxPacket.GetNanoSeconds() << ','
+           << stats.timeLastTxPacket.GetNanoSeconds() << ','
+           << stats.timeLastRxPacket.GetNanoSeconds() << ',' << stats.delaySum.GetNanoSeconds()
+           << ',' << stats.jitterSum.GetNanoSeconds() << ',' << stats.lastDelay.GetNanoSeconds()
+           << ',' << stats.maxDelay.GetNanoSeconds() << ',' << stats.minDelay.GetNanoSeconds()
+           << ',' << stats.txBytes << ',' << stats.rxBytes << ',' << stats.txPackets << ','
+           << stats.rxPackets << ',' << stats.lostPackets << ',' << stats.timesForwarded << ',';
+        for (std::size_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+        {
+            os << (reasonCode > 0 ? ";" : "") << stats.packetsDropped[reasonCode];
+        }
+        os << ',';
+        for (std::size_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++)
+        {
+            os << (reasonCode > 0 ? ";" : "") << stats.bytesDropped[reasonCode];
+        }
+        os << ',';
+        for (uint32_t bin = 0; bin < stats.delayHistogram.GetNBins(); bin++)
+        {
+            os << (bin > 0 ? ";" : "") << stats.delayHistogram.GetBinCount(bin);
+        }
+        os << '\n';
+
+        exported.push_back(flowId);
+        m_flowStatsIndex.Erase(flowId);
+        iter = m_flowStats.erase(iter);
+    }
+    m_exportFile.flush();
+
+    // the flows are exported in increasing order of FlowId
+    for (const auto& classifier : m_classifiers)
+    {
+        if (classifier)
+        {
+            classifier->RemoveFlows(exported);
+        }
+    }
+    for (const auto& probe : m_flowProbes)
+    {
+        if (probe)
+        {
+            probe->RemoveFlows(exported);
+        }
+    }
+    NS_LOG_DEBUG("Exported " << exported.size() << " flows, " << m_flowStats.size()
+                             << " remaining");
 }
 
 void
@@ -417,6 +689,7 @@ FlowMonitor::StopRightNow()
 void
 FlowMonitor::AddFlowClassifier(Ptr<FlowClassifier> classifier)
 {
+    classifier->Reserve(m_flowCapacity);
     m_classifiers.push_back(classifier);
 }
 
@@ -16,8 +16,11 @@
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/open-hash-map.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -269,6 +272,26 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// Export the statistics of the flows which have not sent nor received
+    /// any packet for a given time to the file set by the ExportFileName
+    /// attribute, and remove them from the statistics of the FlowMonitor.
+    ///
+    /// The statistics are appended to the file as CSV rows, one per flow,
+    /// with the five-tuple of the flow and its delay histogram, but without
+    /// the other histograms.  The exported flows are also removed from the
+    /// FlowClassifiers and from the FlowProbes.  A packet of an exported
+    /// flow still in flight gets new statistics for the same flow, exported
+    /// later in another row without the five-tuple, while a flow which
+    /// becomes active again gets a new flow identifier.  The rows can be
+    /// merged with the flowmon-merge-export.py program.
+    ///
+    /// This function is called periodically, with the idle time set by the
+    /// ExportIdleTime attribute, when the ExportFileName attribute is set,
+    /// and the remaining flows are exported when the simulator is destroyed.
+    /// @param idleTime the minimum time since the last packet of the
+    /// exported flows was sent or received
+    void ExportIdleFlows(Time idleTime);
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -280,16 +303,31 @@ class FlowMonitor : public Object
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+        FlowId flowId;           //!< the flow of the packet
+        FlowPacketId packetId;   //!< the identifier of the packet within the flow
+        uint32_t prev;           //!< previous packet in the order of lastSeenTime
+        uint32_t next;           //!< next packet in the order of lastSeenTime, or next free slot
     };
 
+    /// Index of no tracked packet
+    static constexpr uint32_t NO_TRACKED_PACKET = std::numeric_limits<uint32_t>::max();
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
-
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    /// FlowId --> FlowStats in m_flowStats
+    OpenHashMap<FlowId, FlowStats*> m_flowStatsIndex;
+
+    /// Tracked packets, and free slots chained through TrackedPacket::next
+    std::vector<TrackedPacket> m_trackedPackets;
+    /// (FlowId,PacketId) --> index of the TrackedPacket in m_trackedPackets
+    OpenHashMap<uint64_t, uint32_t> m_trackedPacketIndex;
+    uint32_t m_oldestTrackedPacket;  //!< tracked packet with the smallest lastSeenTime
+    uint32_t m_newestTrackedPacket;  //!< tracked packet with the largest lastSeenTime
+    uint32_t m_freeTrackedPacket;    //!< first free slot of m_trackedPackets
+    uint32_t m_flowCapacity;         //!< number of flows to preallocate memory for
+    uint32_t m_trackedCapacity;      //!< number of tracked packets to preallocate memory for
+    Time m_maxPerHopDelay;           //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -302,14 +340,59 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    std::string m_exportFileName;       //!< name of the file of the exported flows
+    Time m_exportInterval;              //!< interval between the exports
+    Time m_exportIdleTime;              //!< idle time of the exported flows
+    std::ofstream m_exportFile;         //!< the file of the exported flows
+    EventId m_exportEvent;              //!< next periodic export
+    bool m_exportAtDestroy;             //!< the final export is scheduled
+    bool m_constructed;                 //!< the construction is completed
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
     /// @returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Start tracking a packet, or restart tracking it if already tracked
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet identification
+    /// @returns the tracked packet
+    TrackedPacket& TrackPacket(FlowId flowId, FlowPacketId packetId);
+
+    /// Get the index of a tracked packet
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet identification
+    /// @returns the index of the packet in m_trackedPackets, or NO_TRACKED_PACKET
+    uint32_t FindTrackedPacket(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Move a tracked packet last in the order of lastSeenTime
+    /// @param index the index of the packet in m_trackedPackets
+    void LinkNewestTrackedPacket(uint32_t index);
+
+    /// Remove a tracked packet from the order of lastSeenTime
+    /// @param index the index of the packet in m_trackedPackets
+    void UnlinkTrackedPacket(uint32_t index);
+
+    /// Stop tracking a packet
+    /// @param index the index of the packet in m_trackedPackets
+    void UntrackPacket(uint32_t index);
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Periodic function to export the idle flows
+    void PeriodicExportIdleFlows();
+
+    /// Export all the flows when the simulator is destroyed
+    void ExportAllFlows();
+
+    /// Set the name of the file of the exported flows, and schedule the
+    /// periodic export if the FlowMonitor is already constructed
+    /// @param fileName the name of the file, or an empty string to stop exporting
+    void SetExportFileName(const std::string& fileName);
+
+    /// Schedule the periodic export of the idle flows, if enabled
+    void ScheduleExport();
 };
 
 } // namespace ns3
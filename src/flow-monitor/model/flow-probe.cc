@@ -41,10 +41,21 @@ FlowProbe::DoDispose()
     Object::DoDispose();
 }
 
+FlowProbe::FlowStats&
+FlowProbe::GetStatsForFlow(FlowId flowId)
+{
+    auto [stats, inserted] = m_statsIndex.Insert(flowId);
+    if (inserted)
+    {
+        *stats = &m_stats[flowId];
+    }
+    return **stats;
+}
+
 void
 FlowProbe::AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
 {
-    FlowStats& flow = m_stats[flowId];
+    FlowStats& flow = GetStatsForFlow(flowId);
     flow.delayFromFirstProbeSum += delayFromFirstProbe;
     flow.bytes += packetSize;
     ++flow.packets;
@@ -53,7 +64,7 @@ FlowProbe::AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirs
 void
 FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode)
 {
-    FlowStats& flow = m_stats[flowId];
+    FlowStats& flow = GetStatsForFlow(flowId);
 
     if (flow.packetsDropped.size() < reasonCode + 1)
     {
@@ -70,6 +81,18 @@ FlowProbe::GetStats() const
     return m_stats;
 }
 
+void
+FlowProbe::RemoveFlows(const std::vector<FlowId>& flowIds)
+{
+    for (const auto flowId : flowIds)
+    {
+        if (m_statsIndex.Erase(flowId))
+        {
+            m_stats.erase(flowId);
+        }
+    }
+}
+
 void
 FlowProbe::SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t index) const
 {
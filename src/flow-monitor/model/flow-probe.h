@@ -13,6 +13,7 @@
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/open-hash-map.h"
 
 #include <map>
 #include <vector>
@@ -88,6 +89,11 @@ class FlowProbe : public Object
     /// @returns the partial flow statistics
     Stats GetStats() const;
 
+    /// Remove the statistics of flows, e.g., after the statistics of the
+    /// FlowMonitor for these flows have been exported
+    /// @param flowIds the identifiers of the flows to remove
+    void RemoveFlows(const std::vector<FlowId>& flowIds);
+
     /// Serializes the results to an std::ostream in XML format
     /// @param os the output stream
     /// @param indent number of spaces to use as base indentation level
@@ -97,6 +103,15 @@ class FlowProbe : public Object
   protected:
     Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
     Stats m_stats;                  //!< The flow stats
+
+  private:
+    /// Get the stats of a flow, inserting them if needed
+    /// @param flowId the flow Identifier
+    /// @returns the stats of the flow
+    FlowStats& GetStatsForFlow(FlowId flowId);
+
+    /// FlowId --> FlowStats in m_stats
+    OpenHashMap<FlowId, FlowStats*> m_statsIndex;
 };
 
 } // namespace ns3
@@ -133,34 +133,40 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    auto insert = m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    auto [index, inserted] = m_flowIndex.Insert(tuple);
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
-    if (insert.second)
+    if (inserted)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        *index = m_flows.size();
+        m_flows.push_back({tuple, GetNewFlowId(), 0, {}});
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        m_flows[*index].lastPacketId++;
     }
+    Flow& flow = m_flows[*index];
 
     // increment the counter of packets with the same DSCP value
     Ipv6Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv6Header::DscpType, uint32_t>(dscp, 1));
-
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
+    auto dscpCount = std::lower_bound(
+        flow.dscpCounts.begin(),
+        flow.dscpCounts.end(),
+        dscp,
+        [](const std::pair<Ipv6Header::DscpType, uint32_t>& count, Ipv6Header::DscpType value) {
+            return count.first < value;
+        });
+    if (dscpCount == flow.dscpCounts.end() || dscpCount->first != dscp)
+    {
+        flow.dscpCounts.insert(dscpCount, std::make_pair(dscp, 1));
+    }
+    else
     {
-        m_flowDscpMap[insert.first->second][dscp]++;
+        dscpCount->second++;
     }
 
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
@@ -168,16 +174,22 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    const Flow* flow = GetFlow(flowId);
+    if (flow == nullptr)
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv6Address::GetZero(), Ipv6Address::GetZero(), 0, 0, 0};
-    return retval;
+    return flow->tuple;
+}
+
+const Ipv6FlowClassifier::Flow*
+Ipv6FlowClassifier::GetFlow(FlowId flowId) const
+{
+    auto flow = std::lower_bound(m_flows.begin(),
+                                 m_flows.end(),
+                                 flowId,
+                                 [](const Flow& flow, FlowId id) { return flow.flowId < id; });
+    return (flow != m_flows.end() && flow->flowId == flowId) ? &*flow : nullptr;
 }
 
 bool
@@ -190,15 +202,15 @@ Ipv6FlowClassifier::SortByCount::operator()(std::pair<Ipv6Header::DscpType, uint
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t>>
 Ipv6FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
+    const Flow* flow = GetFlow(flowId);
 
-    if (flow == m_flowDscpMap.end())
+    if (flow == nullptr)
     {
         NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
 
-    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
+    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->dscpCounts.begin(),
+                                                             flow->dscpCounts.end());
     std::sort(v.begin(), v.end(), SortByCount());
     return v;
 }
@@ -209,28 +221,34 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     Indent(os, indent);
     os << "<Ipv6FlowClassifier>\n";
 
+    // the flows are sorted by FiveTuple
+    std::vector<const Flow*> flows;
+    flows.reserve(m_flows.size());
+    for (const auto& flow : m_flows)
+    {
+        flows.push_back(&flow);
+    }
+    std::sort(flows.begin(), flows.end(), [](const Flow* f1, const Flow* f2) {
+        return f1->tuple < f2->tuple;
+    });
+
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const auto flow : flows)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+        os << "<Flow flowId=\"" << flow->flowId << "\""
+           << " sourceAddress=\"" << flow->tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << flow->tuple.destinationAddress << "\""
+           << " protocol=\"" << int(flow->tuple.protocol) << "\""
+           << " sourcePort=\"" << flow->tuple.sourcePort << "\""
+           << " destinationPort=\"" << flow->tuple.destinationPort << "\">\n";
 
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        for (const auto& [dscp, packets] : flow->dscpCounts)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(dscp) << "\""
+               << " packets=\"" << std::dec << packets << "\" />\n";
         }
 
         indent -= 2;
@@ -243,4 +261,67 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     os << "</Ipv6FlowClassifier>\n";
 }
 
+void
+Ipv6FlowClassifier::Reserve(uint32_t flows)
+{
+    m_flows.reserve(flows);
+    m_flowIndex.Reserve(flows);
+}
+
+bool
+Ipv6FlowClassifier::SerializeFlowToCsvStream(std::ostream& os, FlowId flowId) const
+{
+    const Flow* flow = GetFlow(flowId);
+    if (flow == nullptr)
+    {
+        return false;
+    }
+    os << flow->tuple.sourceAddress << ',' << flow->tuple.destinationAddress << ','
+       << int(flow->tuple.protocol) << ',' << flow->tuple.sourcePort << ','
+       << flow->tuple.destinationPort;
+    return true;
+}
+
+void
+Ipv6FlowClassifier::RemoveFlows(const std::vector<FlowId>& flowIds)
+{
+    // both the flows and the removed flow identifiers are sorted by FlowId
+    auto removed = flowIds.begin();
+    std::size_t kept = 0;
+    for (auto& flow : m_flows)
+    {
+        removed = std::lower_bound(removed, flowIds.end(), flow.flowId);
+        if (removed != flowIds.end() && *removed == flow.flowId)
+        {
+            m_flowIndex.Erase(flow.tuple);
+            continue;
+        }
+        if (&m_flows[kept] != &flow)
+        {
+            m_flows[kept] = std::move(flow);
+        }
+        kept++;
+    }
+    m_flows.erase(m_flows.begin() + kept, m_flows.end());
+
+    // the remaining flows may have moved
+    for (uint32_t i = 0; i < m_flows.size(); i++)
+    {
+        *m_flowIndex.Find(m_flows[i].tuple) = i;
+    }
+}
+
+std::size_t
+Ipv6FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    // combine the fields with a multiplicative hash
+    const uint64_t multiplier = 0xc6a4a7935bd1e995ULL;
+    uint64_t hash = std::hash<Ipv6Address>()(tuple.sourceAddress);
+    hash = hash * multiplier + std::hash<Ipv6Address>()(tuple.destinationAddress);
+    hash = hash * multiplier + ((static_cast<uint64_t>(tuple.protocol) << 32) |
+                                (static_cast<uint32_t>(tuple.sourcePort) << 16) |
+                                tuple.destinationPort);
+    return hash;
+}
+
 } // namespace ns3
@@ -13,9 +13,10 @@
 #include "flow-classifier.h"
 
 #include "ns3/ipv6-header.h"
+#include "ns3/open-hash-map.h"
 
-#include <map>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -82,13 +83,40 @@ class Ipv6FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    void Reserve(uint32_t flows) override;
+
+    bool SerializeFlowToCsvStream(std::ostream& os, FlowId flowId) const override;
+
+    void RemoveFlows(const std::vector<FlowId>& flowIds) override;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Hash function of the FiveTuple
+    struct FiveTupleHash
+    {
+        /// @param tuple the FiveTuple
+        /// @return the hash of the FiveTuple
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
+    /// A flow and its packet counters
+    struct Flow
+    {
+        FiveTuple tuple;           //!< the FiveTuple of the flow
+        FlowId flowId;             //!< the FlowId of the flow
+        FlowPacketId lastPacketId; //!< the FlowPacketId of the last packet of the flow
+        /// (DSCP value, packet count) pairs, sorted by DSCP value
+        std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> dscpCounts;
+    };
+
+    /// Searches for the flow with the given FlowId
+    /// @param flowId the FlowId to search for
+    /// @returns the flow, or nullptr if no flow has this FlowId
+    const Flow* GetFlow(FlowId flowId) const;
+
+    /// The flows, in the order of creation, hence of increasing FlowId
+    std::vector<Flow> m_flows;
+    /// Map Flows Identifiers to the index of the flows in m_flows
+    OpenHashMap<FiveTuple, uint32_t, FiveTupleHash> m_flowIndex;
 };
 
 /**
@@ -16,4 +16,6 @@ cpp_examples = []
 # See test.py for more information.
 python_examples = [
     ("wifi-olsr-flowmon.py", "True"),
+    ("flowmon-merge-export.py", "True"),
+    ("flowmon-merge-export.py --five-tuple", "True"),
 ]
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor
+ * @defgroup flow-monitor-test flow-monitor module tests
+ */
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief Check the periodic export of the idle flows to a CSV file
+ *
+ * Two UDP flows are sent between two nodes. The first one is idle between
+ * 0.5 s and 3 s, hence it is exported and removed from the FlowMonitor, the
+ * classifier and the probes, then it is seen again with a new flow
+ * identifier. The rows of the file are checked at the end of the simulation.
+ */
+class FlowMonitorExportTestCase : public TestCase
+{
+  public:
+    FlowMonitorExportTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a packet
+     * @param socket the sending socket
+     */
+    void SendPacket(Ptr<Socket> socket);
+
+    /**
+     * Get the five-tuple of a flow, as serialized by the classifier
+     * @param flowId the flow identifier
+     * @return the five-tuple, or an empty string if the flow is not known
+     */
+    std::string GetFiveTuple(FlowId flowId) const;
+
+    /**
+     * Check the flows in the FlowMonitor, the classifier and the probes
+     * @param flowIds the identifiers of the flows expected in memory
+     * @param removedFlowIds the identifiers of the flows expected to be removed
+     */
+    void CheckFlows(std::vector<FlowId> flowIds, std::vector<FlowId> removedFlowIds);
+
+    /// Record the five-tuple of the first flow, before it is exported
+    void RecordFiveTuple();
+
+    Ptr<FlowMonitor> m_monitor;       //!< the FlowMonitor
+    Ptr<FlowClassifier> m_classifier; //!< the IPv4 classifier
+    std::string m_fiveTuple;          //!< the five-tuple of the first flow
+};
+
+FlowMonitorExportTestCase::FlowMonitorExportTestCase()
+    : TestCase("Check the periodic export of the idle flows")
+{
+}
+
+void
+FlowMonitorExportTestCase::SendPacket(Ptr<Socket> socket)
+{
+    socket->Send(Create<Packet>(100));
+}
+
+std::string
+FlowMonitorExportTestCase::GetFiveTuple(FlowId flowId) const
+{
+    std::ostringstream oss;
+    m_classifier->SerializeFlowToCsvStream(oss, flowId);
+    return oss.str();
+}
+
+void
+FlowMonitorExportTestCase::RecordFiveTuple()
+{
+    m_fiveTuple = GetFiveTuple(1);
+    NS_TEST_EXPECT_MSG_EQ(m_fiveTuple.empty(), false, "The first flow is not classified");
+}
+
+void
+FlowMonitorExportTestCase::CheckFlows(std::vector<FlowId> flowIds,
+                                      std::vector<FlowId> removedFlowIds)
+{
+    const auto& flowStats = m_monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(flowStats.size(),
+                          flowIds.size(),
+                          "Unexpected number of flows at " << Simulator::Now().As(Time::S));
+    for (auto flowId : flowIds)
+    {
+        NS_TEST_EXPECT_MSG_EQ(flowStats.count(flowId), 1, "Flow " << flowId << " not in memory");
+        NS_TEST_EXPECT_MSG_EQ(GetFiveTuple(flowId).empty(),
+                              false,
+                              "Flow " << flowId << " not in the classifier");
+    }
+    for (auto flowId : removedFlowIds)
+    {
+        NS_TEST_EXPECT_MSG_EQ(flowStats.count(flowId), 0, "Flow " << flowId << " not exported");
+        NS_TEST_EXPECT_MSG_EQ(GetFiveTuple(flowId).empty(),
+                              true,
+                              "Flow " << flowId << " still in the classifier");
+        for (const auto& probe : m_monitor->GetAllProbes())
+        {
+            NS_TEST_EXPECT_MSG_EQ(probe->GetStats().count(flowId),
+                                  0,
+                                  "Flow " << flowId << " still in a probe");
+        }
+    }
+}
+
+void
+FlowMonitorExportTestCase::DoRun()
+{
+    const auto fileName = CreateTempDirFilename("flowmon-export.csv");
+
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(MilliSeconds(2)));
+    auto devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.0");
+    auto interfaces = ipv4.Assign(devices);
+
+    auto sink = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    std::vector<Ptr<Socket>> sockets;
+    for (uint16_t port : {1000, 2000})
+    {
+        auto socket = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+        socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), port));
+        socket->Connect(InetSocketAddress(interfaces.GetAddress(1), 9));
+        sockets.push_back(socket);
+    }
+
+    // flow 1 is sent until 0.5 s, flow 2 until 4.1 s, and the five-tuple of flow 1 is
+    // sent again as flow 3 from 3 s
+    for (auto i = 0; i < 5; i++)
+    {
+        Simulator::Schedule(Seconds(0.1 * (i + 1)),
+                            &FlowMonitorExportTestCase::SendPacket,
+                            this,
+                            sockets[0]);
+    }
+    for (auto i = 0; i < 9; i++)
+    {
+        Simulator::Schedule(Seconds(0.1 + 0.5 * i),
+                            &FlowMonitorExportTestCase::SendPacket,
+                            this,
+                            sockets[1]);
+    }
+    for (auto i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(Seconds(3 + 0.1 * i),
+                            &FlowMonitorExportTestCase::SendPacket,
+                            this,
+                            sockets[0]);
+    }
+
+    FlowMonitorHelper flowmonHelper;
+    flowmonHelper.SetMonitorAttribute("ExportInterval", TimeValue(Seconds(1)));
+    flowmonHelper.SetMonitorAttribute("ExportIdleTime", TimeValue(Seconds(1)));
+    m_monitor = flowmonHelper.Install(nodes);
+    m_classifier = flowmonHelper.GetClassifier();
+    // the export is scheduled when the file name is set after the construction
+    m_monitor->SetAttribute("ExportFileName", StringValue(fileName));
+
+    Simulator::Schedule(Seconds(0.6), &FlowMonitorExportTestCase::RecordFiveTuple, this);
+    // flow 1 is exported at 2 s, flow 3 at 5 s and flow 2 at 6 s
+    Simulator::Schedule(Seconds(2.5),
+                        &FlowMonitorExportTestCase::CheckFlows,
+                        this,
+                        std::vector<FlowId>{2},
+                        std::vector<FlowId>{1});
+    Simulator::Schedule(Seconds(3.5),
+                        &FlowMonitorExportTestCase::CheckFlows,
+                        this,
+                        std::vector<FlowId>{2, 3},
+                        std::vector<FlowId>{1});
+    Simulator::Schedule(Seconds(6.5),
+                        &FlowMonitorExportTestCase::CheckFlows,
+                        this,
+                        std::vector<FlowId>{},
+                        std::vector<FlowId>{1, 2, 3});
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::ifstream file(fileName);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Cannot open " << fileName);
+    std::string line;
+    std::getline(file, line);
+    std::vector<std::string> columns;
+    {
+        std::istringstream iss(line);
+        for (std::string column; std::getline(iss, column, ',');)
+        {
+            columns.push_back(column);
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(columns.size(), 24, "Unexpected number of columns");
+    NS_TEST_EXPECT_MSG_EQ(columns[0], "flowId", "Unexpected column");
+    NS_TEST_EXPECT_MSG_EQ(columns[1], "sourceAddress", "Unexpected column");
+    NS_TEST_EXPECT_MSG_EQ(columns[23], "delayHistogram", "Unexpected column");
+
+    // the rows, in the order of export
+    std::vector<std::map<std::string, std::string>> rows;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::map<std::string, std::string> row;
+        for (const auto& column : columns)
+        {
+            std::getline(iss, row[column], ',');
+        }
+        rows.push_back(row);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rows.size(), 3, "Unexpected number of rows");
+
+    const std::vector<std::string> flowIds{"1", "3", "2"};
+    const std::vector<uint32_t> packets{5, 3, 9};
+    std::map<std::string, uint32_t> txPacketsByFiveTuple;
+    for (std::size_t i = 0; i < rows.size(); i++)
+    {
+        auto& row = rows[i];
+        NS_TEST_EXPECT_MSG_EQ(row["flowId"], flowIds[i], "Unexpected order of export");
+        NS_TEST_EXPECT_MSG_EQ(row["txPackets"],
+                              std::to_string(packets[i]),
+                              "Unexpected TX packets of flow " << row["flowId"]);
+        NS_TEST_EXPECT_MSG_EQ(row["rxPackets"],
+                              std::to_string(packets[i]),
+                              "Unexpected RX packets of flow " << row["flowId"]);
+        NS_TEST_EXPECT_MSG_EQ(row["minDelay"],
+                              std::to_string(MilliSeconds(2).GetNanoSeconds()),
+                              "Unexpected delay of flow " << row["flowId"]);
+
+        // the delay histogram holds all the received packets
+        std::vector<uint32_t> bins;
+        std::istringstream iss(row["delayHistogram"]);
+        for (std::string count; std::getline(iss, count, ';');)
+        {
+            bins.push_back(std::stoul(count));
+        }
+        NS_TEST_EXPECT_MSG_EQ(std::accumulate(bins.begin(), bins.end(), 0U),
+                              packets[i],
+                              "Unexpected delay histogram of flow " << row["flowId"]);
+
+        std::string fiveTuple = row["sourceAddress"] + "," + row["destinationAddress"] + "," +
+                                row["protocol"] + "," + row["sourcePort"] + "," +
+                                row["destinationPort"];
+        txPacketsByFiveTuple[fiveTuple] += std::stoul(row["txPackets"]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(rows[0]["sourcePort"], "1000", "Unexpected five-tuple of flow 1");
+
+    // merging the rows by five-tuple gives the packets sent by each socket
+    NS_TEST_EXPECT_MSG_EQ(txPacketsByFiveTuple.size(), 2, "Unexpected number of five-tuples");
+    NS_TEST_EXPECT_MSG_EQ(txPacketsByFiveTuple[m_fiveTuple],
+                          8,
+                          "Unexpected packets of the first five-tuple");
+
+    m_monitor = nullptr;
+    m_classifier = nullptr;
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", Type::UNIT)
+{
+    AddTestCase(new FlowMonitorExportTestCase, TestCase::Duration::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
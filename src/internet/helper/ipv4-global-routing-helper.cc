@@ -166,9 +166,7 @@ Ipv4GlobalRoutingHelper::PrintRouteAt(Ptr<Node> sourceNode,
 void
 Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
 {
-    Ipv4GlobalRouteManager::DeleteGlobalRoutes();
-    Ipv4GlobalRouteManager::BuildGlobalRoutingDatabase();
-    Ipv4GlobalRouteManager::InitializeRoutes();
+    Ipv4GlobalRouteManager::RecomputeRoutes();
 }
 
 } // namespace ns3
@@ -195,6 +195,9 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * This method does not change the set of nodes
      * over which GlobalRouting is being used, but it will dynamically update
      * its representation of the global topology before recomputing routes.
+     * With Ipv4GlobalRouteManager::SetIncrementalSpf (true), only the
+     * routers affected by the changes of the topology have their routes
+     * recomputed.
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
@@ -58,9 +58,7 @@ Ipv6GlobalRoutingHelper::PopulateRoutingTables()
 void
 Ipv6GlobalRoutingHelper::RecomputeRoutingTables()
 {
-    GlobalRouteManager<Ipv6Manager>::DeleteGlobalRoutes();
-    GlobalRouteManager<Ipv6Manager>::BuildGlobalRoutingDatabase();
-    GlobalRouteManager<Ipv6Manager>::InitializeRoutes();
+    GlobalRouteManager<Ipv6Manager>::RecomputeRoutes();
 }
 
 } // namespace ns3
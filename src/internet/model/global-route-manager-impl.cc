@@ -27,10 +27,13 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/thread-pool.h"
 
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -105,7 +108,6 @@ SPFVertex<T>::SPFVertex(GlobalRoutingLSA<IpManager>* lsa)
     {
         NS_LOG_LOGIC("Setting m_vertexType to VertexRouter");
         m_vertexType = SPFVertex<T>::VertexRouter;
-        m_node = lsa->GetNode();
     }
     else if (lsa->GetLSType() == GlobalRoutingLSA<IpManager>::NetworkLSA)
     {
@@ -436,7 +438,18 @@ template <typename T>
 Ptr<Node>
 SPFVertex<T>::GetNode() const
 {
-    return m_node;
+    if (m_node || m_vertexType != SPFVertex<T>::VertexRouter)
+    {
+        return m_node;
+    }
+    return m_lsa->GetNode();
+}
+
+template <typename T>
+void
+SPFVertex<T>::SetNode(Ptr<Node> node)
+{
+    m_node = node;
 }
 
 // ---------------------------------------------------------------------------
@@ -469,6 +482,7 @@ GlobalRouteManagerLSDB<T>::~GlobalRouteManagerLSDB()
         delete temp;
     }
     NS_LOG_LOGIC("clear map");
+    m_linkDataIndex.clear();
     m_database.clear();
 }
 
@@ -495,7 +509,25 @@ GlobalRouteManagerLSDB<T>::Insert(IpAddress addr, GlobalRoutingLSA<IpManager>* l
     }
     else
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        auto [entry, inserted] = m_database.insert(LSDBPair_t(addr, lsa));
+        if (!inserted)
+        {
+            return;
+        }
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord<IpManager>::TransitNetwork)
+            {
+                continue;
+            }
+            // GetLSAByLinkData returns the first LSA in the order of the database
+            auto [index, indexed] = m_linkDataIndex.emplace(lr->GetLinkData(), entry);
+            if (!indexed && entry->first < index->second->first)
+            {
+                index->second = entry;
+            }
+        }
     }
 }
 
@@ -523,12 +555,10 @@ GlobalRouteManagerLSDB<T>::GetLSA(IpAddress addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -539,23 +569,155 @@ GlobalRouteManagerLSDB<T>::GetLSAByLinkData(IpAddress addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its transit network link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataIndex.find(addr);
+    if (i != m_linkDataIndex.end())
     {
-        GlobalRoutingLSA<IpManager>* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        return i->second->second;
+    }
+    return nullptr;
+}
+
+template <typename T>
+uint32_t
+GlobalRouteManagerLSDB<T>::GetNumLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_database.size();
+}
+
+template <typename T>
+GlobalRouteManagerLSDB<T>*
+GlobalRouteManagerLSDB<T>::Copy() const
+{
+    NS_LOG_FUNCTION(this);
+    auto lsdb = new GlobalRouteManagerLSDB<T>();
+    for (const auto& [addr, lsa] : m_database)
+    {
+        lsdb->Insert(addr, new GlobalRoutingLSA<IpManager>(*lsa));
+    }
+    for (const auto lsa : m_extdatabase)
+    {
+        lsdb->Insert(lsa->GetLinkStateId(), new GlobalRoutingLSA<IpManager>(*lsa));
+    }
+    return lsdb;
+}
+
+/**
+ * @brief Compare the contents of two Link State Advertisements, except their SPF status.
+ * @tparam T Ipv4Manager or Ipv6Manager
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the LSAs have the same contents
+ */
+template <typename T>
+static bool
+IsSameLSA(GlobalRoutingLSA<T>* a, GlobalRoutingLSA<T>* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNLinkRecords() != b->GetNLinkRecords() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t j = 0; j < a->GetNLinkRecords(); j++)
+    {
+        GlobalRoutingLinkRecord<T>* la = a->GetLinkRecord(j);
+        GlobalRoutingLinkRecord<T>* lb = b->GetLinkRecord(j);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric() ||
+            la->GetLinkLocData() != lb->GetLinkLocData())
         {
-            GlobalRoutingLinkRecord<IpManager>* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
+            return false;
         }
     }
-    return nullptr;
+    for (uint32_t j = 0; j < a->GetNAttachedRouters(); j++)
+    {
+        if (a->GetAttachedRouter(j) != b->GetAttachedRouter(j))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool
+GlobalRouteManagerLSDB<T>::GetChangedLSAs(const GlobalRouteManagerLSDB<T>& other,
+                                          std::vector<bool>& changed) const
+{
+    NS_LOG_FUNCTION(this << &other);
+    if (m_database.size() != other.m_database.size() ||
+        m_extdatabase.size() != other.m_extdatabase.size())
+    {
+        return false;
+    }
+    for (uint32_t j = 0; j < m_extdatabase.size(); j++)
+    {
+        if (!IsSameLSA(m_extdatabase[j], other.m_extdatabase[j]))
+        {
+            return false;
+        }
+    }
+    std::vector<bool> result(m_database.size(), false);
+    auto i = m_database.begin();
+    auto j = other.m_database.begin();
+    for (std::size_t index = 0; i != m_database.end(); ++i, ++j, ++index)
+    {
+        if (i->first != j->first)
+        {
+            return false;
+        }
+        result[index] = !IsSameLSA(i->second, j->second);
+    }
+    changed = std::move(result);
+    return true;
+}
+
+template <typename T>
+std::vector<bool>
+GlobalRouteManagerLSDB<T>::GetExploredLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<bool> explored;
+    explored.reserve(m_database.size());
+    for (const auto& [addr, lsa] : m_database)
+    {
+        explored.push_back(lsa->GetStatus() !=
+                           GlobalRoutingLSA<IpManager>::LSA_SPF_NOT_EXPLORED);
+    }
+    return explored;
+}
+
+template <typename T>
+uint64_t
+GlobalRouteManagerLSDB<T>::GetMemoryUsage() const
+{
+    NS_LOG_FUNCTION(this);
+    // a node of a std::map has three pointers and a color, a node of a std::list two pointers
+    const uint64_t mapNode = 4 * sizeof(void*);
+    const uint64_t listNode = 2 * sizeof(void*);
+    uint64_t bytes = sizeof(*this);
+    auto lsaBytes = [&](GlobalRoutingLSA<IpManager>* lsa) {
+        return sizeof(GlobalRoutingLSA<IpManager>) +
+               lsa->GetNLinkRecords() *
+                   (sizeof(GlobalRoutingLinkRecord<IpManager>) + listNode + sizeof(void*)) +
+               lsa->GetNAttachedRouters() * (sizeof(IpAddress) + listNode);
+    };
+    for (const auto& [addr, lsa] : m_database)
+    {
+        bytes += mapNode + sizeof(LSDBPair_t) + lsaBytes(lsa);
+    }
+    for (const auto lsa : m_extdatabase)
+    {
+        bytes += sizeof(lsa) + lsaBytes(lsa);
+    }
+    bytes += m_linkDataIndex.size() *
+             (mapNode + sizeof(typename decltype(m_linkDataIndex)::value_type));
+    return bytes;
 }
 
 // ---------------------------------------------------------------------------
@@ -566,7 +728,11 @@ GlobalRouteManagerLSDB<T>::GetLSAByLinkData(IpAddress addr) const
 
 template <typename T>
 GlobalRouteManagerImpl<T>::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_incrementalSpf(false),
+      m_spfThreadCount(1),
+      m_spfVertices(0),
+      m_spfBytes(0)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB<IpManager>();
@@ -601,26 +767,9 @@ GlobalRouteManagerImpl<T>::DeleteGlobalRoutes()
     NS_LOG_FUNCTION(this);
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
-        Ptr<Node> node = *i;
-        Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
-        if (!router)
-        {
-            continue;
-        }
-        Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        DeleteRoutes(*i);
     }
+    m_spfDependencies.clear();
     if (m_lsdb)
     {
         NS_LOG_LOGIC("Deleting LSDB, creating new one");
@@ -629,6 +778,31 @@ GlobalRouteManagerImpl<T>::DeleteGlobalRoutes()
     }
 }
 
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::DeleteRoutes(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(node);
+    Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+}
+
 //
 // In order to build the routing database, we need to walk the list of nodes
 // in the system and look for those that support the GlobalRouter interface.
@@ -644,6 +818,8 @@ void
 GlobalRouteManagerImpl<T>::BuildGlobalRoutingDatabase()
 {
     NS_LOG_FUNCTION(this);
+    SystemWallClockMs clock;
+    clock.Start();
     //
     // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
     // global router interfaces are, not too surprisingly, our routers.
@@ -687,6 +863,12 @@ GlobalRouteManagerImpl<T>::BuildGlobalRoutingDatabase()
             m_lsdb->Insert(lsa->GetLinkStateId(), lsa);
         }
     }
+    m_stats.lsaCount = m_lsdb->GetNumLSAs();
+    m_stats.externalLsaCount = m_lsdb->GetNumExtLSAs();
+    m_stats.lsdbBytes = m_lsdb->GetMemoryUsage();
+    m_stats.lsdbBuildTime = clock.End();
+    NS_LOG_INFO("Built LSDB with " << m_stats.lsaCount << " LSAs, " << m_stats.lsdbBytes
+                                   << " bytes, in " << m_stats.lsdbBuildTime << " ms");
 }
 
 //
@@ -728,10 +910,91 @@ void
 GlobalRouteManagerImpl<T>::InitializeRoutes()
 {
     NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("About to start SPF calculation");
+    m_spfDependencies.clear();
+    m_stats.spfSkipped = 0;
+    ComputeRoutes(GetSpfRoots());
+    NS_LOG_INFO("Finished SPF calculation: " << m_stats);
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::RecomputeRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_incrementalSpf || m_spfDependencies.empty())
+    {
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    GlobalRouteManagerLSDB<IpManager>* previous = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB<IpManager>();
+    BuildGlobalRoutingDatabase();
+    std::vector<bool> changed;
+    bool sameLsas = m_lsdb->GetChangedLSAs(*previous, changed);
+    delete previous;
+    if (!sameLsas)
+    {
+        NS_LOG_INFO("LSAs added or removed, computing the routes of all the routers");
+        for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+        {
+            DeleteRoutes(*i);
+        }
+        InitializeRoutes();
+        return;
+    }
+
+    std::vector<std::size_t> changedIndexes;
+    for (std::size_t j = 0; j < changed.size(); j++)
+    {
+        if (changed[j])
+        {
+            changedIndexes.push_back(j);
+        }
+    }
+    NS_LOG_INFO(changedIndexes.size() << " LSAs changed");
+    //
+    // The SPF tree of a router, hence its routes, only depends on the LSAs
+    // explored by its SPF calculation: the routers which have not explored any
+    // changed LSA keep their routes.
+    //
+    std::vector<SpfRoot_t> roots;
+    uint32_t skipped = 0;
+    for (const auto& root : GetSpfRoots())
+    {
+        auto dependencies = m_spfDependencies.find(root.second);
+        bool affected = (dependencies == m_spfDependencies.end());
+        for (auto j = changedIndexes.begin(); !affected && j != changedIndexes.end(); j++)
+        {
+            affected = dependencies->second[*j];
+        }
+        if (affected)
+        {
+            DeleteRoutes(root.first);
+            roots.push_back(root);
+        }
+        else
+        {
+            skipped++;
+        }
+    }
+    ComputeRoutes(roots);
+    m_stats.spfSkipped = skipped;
+    NS_LOG_INFO("Finished incremental SPF calculation: " << m_stats);
+}
+
+template <typename T>
+std::vector<typename GlobalRouteManagerImpl<T>::SpfRoot_t>
+GlobalRouteManagerImpl<T>::GetSpfRoots() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<SpfRoot_t> roots;
     //
     // Walk the list of nodes in the system.
     //
-    NS_LOG_INFO("About to start SPF calculation");
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -754,10 +1017,111 @@ GlobalRouteManagerImpl<T>::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.emplace_back(node, rtr->GetRouterId());
         }
     }
-    NS_LOG_INFO("Finished SPF calculation");
+    return roots;
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::ComputeRoutes(const std::vector<SpfRoot_t>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    SystemWallClockMs clock;
+    clock.Start();
+    const auto threads = static_cast<uint32_t>(
+        std::max<std::size_t>(1, std::min<std::size_t>(m_spfThreadCount, roots.size())));
+    std::vector<std::vector<bool>> dependencies(m_incrementalSpf ? roots.size() : 0);
+    m_stats.maxSpfVertices = 0;
+    m_stats.maxSpfBytes = 0;
+
+    if (threads == 1)
+    {
+        for (std::size_t i = 0; i < roots.size(); i++)
+        {
+            SPFCalculate(roots[i].second, roots[i].first);
+            if (m_incrementalSpf)
+            {
+                dependencies[i] = m_lsdb->GetExploredLSAs();
+            }
+        }
+    }
+    else
+    {
+        //
+        // The SPF calculation of a router only adds routes to that router, but
+        // updates the status of the LSAs: every thread computes the trees of
+        // its share of the routers with its own copy of the LSDB.  The copies
+        // are created and deleted by this thread, since they reference the
+        // nodes.
+        //
+        std::vector<std::unique_ptr<GlobalRouteManagerImpl<T>>> workers;
+        for (uint32_t w = 0; w < threads; w++)
+        {
+            workers.push_back(std::make_unique<GlobalRouteManagerImpl<T>>());
+            workers.back()->DebugUseLsdb(m_lsdb->Copy());
+        }
+        ThreadPool pool(threads);
+        pool.ParallelFor(threads, [&](std::size_t w) {
+            for (std::size_t i = w; i < roots.size(); i += threads)
+            {
+                workers[w]->SPFCalculate(roots[i].second, roots[i].first);
+                if (m_incrementalSpf)
+                {
+                    dependencies[i] = workers[w]->m_lsdb->GetExploredLSAs();
+                }
+            }
+        });
+        for (const auto& worker : workers)
+        {
+            m_stats.maxSpfVertices =
+                std::max(m_stats.maxSpfVertices, worker->m_stats.maxSpfVertices);
+            m_stats.maxSpfBytes = std::max(m_stats.maxSpfBytes, worker->m_stats.maxSpfBytes);
+        }
+    }
+
+    for (std::size_t i = 0; i < dependencies.size(); i++)
+    {
+        m_spfDependencies[roots[i].second] = std::move(dependencies[i]);
+    }
+    m_stats.dependencyBytes = 0;
+    for (const auto& [root, explored] : m_spfDependencies)
+    {
+        // a node of a std::map has three pointers and a color
+        m_stats.dependencyBytes += 4 * sizeof(void*) + sizeof(root) + sizeof(explored) +
+                                   (explored.capacity() + 7) / 8;
+    }
+    m_stats.spfRuns = roots.size();
+    m_stats.spfThreads = threads;
+    m_stats.spfTime = clock.End();
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::SetIncrementalSpf(bool enable)
+{
+    NS_LOG_FUNCTION(this << enable);
+    m_incrementalSpf = enable;
+    if (!enable)
+    {
+        m_spfDependencies.clear();
+    }
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::SetSpfThreadCount(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+    m_spfThreadCount = std::max<uint32_t>(count, 1);
+}
+
+template <typename T>
+const GlobalRouteManagerStatistics&
+GlobalRouteManagerImpl<T>::GetStatistics() const
+{
+    return m_stats;
 }
 
 //
@@ -1374,7 +1738,7 @@ GlobalRouteManagerImpl<T>::CheckForStubNode(IpAddress root)
                 {
                     // Next hop is stored in the LinkID field of lr
                     Ptr<GlobalRouter<IpManager>> router =
-                        rlsa->GetNode()->template GetObject<GlobalRouter<IpManager>>();
+                        m_spfroot->GetNode()->template GetObject<GlobalRouter<IpManager>>();
                     NS_ASSERT(router);
                     Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
                     NS_ASSERT(gr);
@@ -1401,6 +1765,8 @@ GlobalRouteManagerImpl<T>::CheckForStubNode(IpAddress root)
                                      << " via interface "
                                      << FindOutgoingInterfaceId(transitLink->GetLinkLocData()));
                     }
+                    // The default route depends on the LSA of the neighbor
+                    w_lsa->SetStatus(GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
                     return true;
                 }
             }
@@ -1415,7 +1781,14 @@ template <typename T>
 void
 GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
 {
-    NS_LOG_FUNCTION(this << root);
+    SPFCalculate(root, nullptr);
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root, Ptr<Node> rootNode)
+{
+    NS_LOG_FUNCTION(this << root << rootNode);
 
     SPFVertex<T>* v;
     //
@@ -1440,9 +1813,14 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
     // We also mark this vertex as being in the SPF tree.
     //
     m_spfroot = v;
+    // The node of the root is the only node used by the calculation
+    v->SetNode(rootNode ? rootNode : v->GetNode());
     v->SetDistanceFromRoot(0);
     v->GetLSA()->SetStatus(GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
+    m_spfVertices = 0;
+    m_spfBytes = 0;
+    CountSpfVertex(v);
 
     //
     // Optimize SPF calculation, for ns-3.
@@ -1451,9 +1829,11 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if ((rootNode || NodeList::GetNNodes() > 0) && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
+        m_stats.maxSpfVertices = std::max(m_stats.maxSpfVertices, m_spfVertices);
+        m_stats.maxSpfBytes = std::max(m_stats.maxSpfBytes, m_spfBytes);
         delete m_spfroot;
         return;
     }
@@ -1511,6 +1891,7 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
         // to now.
         //
         SPFVertexAddParent(v);
+        CountSpfVertex(v);
         //
         // Note that when there is a choice of vertices closest to the root, network
         // vertices must be chosen before router vertices in order to necessarily
@@ -1573,10 +1954,31 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
     // the SPF tree.  Delete all of the vertices and corresponding resources.  Go
     // possibly do it again for the next router.
     //
+    m_stats.maxSpfVertices = std::max(m_stats.maxSpfVertices, m_spfVertices);
+    m_stats.maxSpfBytes = std::max(m_stats.maxSpfBytes, m_spfBytes);
     delete m_spfroot;
     m_spfroot = nullptr;
 }
 
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::CountSpfVertex(SPFVertex<T>* v)
+{
+    NS_LOG_FUNCTION(this << v);
+    // a node of a std::list has two pointers; every parent link is in the list
+    // of parents of the vertex and in the list of children of the parent
+    const uint64_t listNode = 2 * sizeof(void*);
+    uint32_t nParents = 0;
+    while (v->GetParent(nParents))
+    {
+        nParents++;
+    }
+    m_spfVertices++;
+    m_spfBytes += sizeof(SPFVertex<T>) + 2 * nParents * (listNode + sizeof(v)) +
+                  v->GetNRootExitDirections() *
+                      (listNode + sizeof(typename SPFVertex<T>::NodeExit_t));
+}
+
 template <typename T>
 void
 GlobalRouteManagerImpl<T>::ProcessASExternals(SPFVertex<T>* v, GlobalRoutingLSA<IpManager>* extlsa)
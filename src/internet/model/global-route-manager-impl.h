@@ -568,10 +568,25 @@ class SPFVertex
 
     /**
      * @brief Get the node pointer corresponding to this Vertex
+     *
+     * The node is looked up from the LSA of a router vertex, unless it was
+     * set with SetNode ().
+     *
      * @returns the node pointer corresponding to this Vertex
      */
     Ptr<Node> GetNode() const;
 
+    /**
+     * @brief Set the node pointer corresponding to this Vertex
+     *
+     * The SPF calculation sets the node of the root vertex, which is the only
+     * vertex whose node is used, so that the node list is not looked up for
+     * every vertex of the tree.
+     *
+     * @param node the node pointer corresponding to this Vertex
+     */
+    void SetNode(Ptr<Node> node);
+
   private:
     VertexType m_vertexType;                        //!< Vertex type
     IpAddress m_vertexId;                           //!< Vertex ID
@@ -761,6 +776,58 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Get the number of router and network Link State Advertisements.
+     *
+     * The router and network LSAs are indexed from 0 in the order of their
+     * link state IDs by GetChangedLSAs () and GetExploredLSAs ().
+     *
+     * @returns the number of router and network Link State Advertisements.
+     */
+    uint32_t GetNumLSAs() const;
+
+    /**
+     * @brief Create a copy of the database, with copies of all of its Link
+     * State Advertisements.
+     *
+     * Since the SPF calculation updates the status of the LSAs, every thread
+     * of a parallel calculation uses its own copy of the database.
+     *
+     * @returns the copy, to be deleted by the caller
+     */
+    GlobalRouteManagerLSDB<T>* Copy() const;
+
+    /**
+     * @brief Compare the Link State Advertisements with those of another
+     * database.
+     *
+     * The SPF status of the LSAs is ignored.
+     *
+     * @param other the other database
+     * @param changed set to true at the index of every router and network LSA
+     * which differs from the LSA with the same link state ID in the other database
+     * @returns true if both databases hold router and network LSAs with the same
+     * link state IDs, and the same external LSAs; if false, changed is not set.
+     */
+    bool GetChangedLSAs(const GlobalRouteManagerLSDB<T>& other, std::vector<bool>& changed) const;
+
+    /**
+     * @brief Get the Link State Advertisements explored by the last SPF
+     * calculation.
+     *
+     * @returns true at the index of every router and network LSA whose status
+     * is not LSA_SPF_NOT_EXPLORED.
+     */
+    std::vector<bool> GetExploredLSAs() const;
+
+    /**
+     * @brief Estimate the memory used by the database.
+     *
+     * @returns the estimated number of bytes used by the LSAs, their link
+     * records and attached routers, and the containers of the database.
+     */
+    uint64_t GetMemoryUsage() const;
+
   private:
     typedef std::map<IpAddress, GlobalRoutingLSA<IpManager>*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -768,6 +835,8 @@ class GlobalRouteManagerLSDB
         LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
 
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+    /// Entries of the database by link data of their transit network link records
+    std::map<IpAddress, typename LSDBMap_t::const_iterator> m_linkDataIndex;
     std::vector<GlobalRoutingLSA<IpManager>*>
         m_extdatabase; //!< database of External Link State Advertisements
 };
@@ -860,6 +929,49 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Delete the global routes, rebuild the routing database and compute
+     * the routes again.
+     *
+     * Unless incremental SPF is enabled, this is DeleteGlobalRoutes (),
+     * BuildGlobalRoutingDatabase () and InitializeRoutes ().  With incremental
+     * SPF, if the new database holds the same LSAs as the previous one, only
+     * the contents of some LSAs having changed, the routers whose last SPF
+     * calculation did not explore any changed LSA keep their routes; the other
+     * routers have their routes deleted and their SPF tree computed again.
+     */
+    virtual void RecomputeRoutes();
+
+    /**
+     * @brief Enable or disable incremental SPF in RecomputeRoutes ().
+     *
+     * When enabled, the route computations record the LSAs explored by the SPF
+     * calculation of every router, see GlobalRouteManagerStatistics::dependencyBytes.
+     * Since the routers which are not recomputed keep all of their routes, the
+     * routes added by hand to the global routing protocol of these routers are
+     * kept as well.
+     *
+     * @param enable whether incremental SPF is enabled
+     */
+    void SetIncrementalSpf(bool enable);
+
+    /**
+     * @brief Set the number of threads computing the SPF trees of the routers.
+     *
+     * With more than one thread, the routers are shared among the threads,
+     * each of them using its own copy of the LSDB; the routes are the same as
+     * with a single thread.
+     *
+     * @param count the number of threads, including the calling thread
+     */
+    void SetSpfThreadCount(uint32_t count);
+
+    /**
+     * @brief Get the statistics of the last LSDB build and route computation.
+     * @returns the statistics
+     */
+    const GlobalRouteManagerStatistics& GetStatistics() const;
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -909,9 +1021,47 @@ class GlobalRouteManagerImpl
     void InitializeRouters();
 
   private:
+    /// A router whose SPF tree is computed, and its router ID
+    typedef std::pair<Ptr<Node>, IpAddress> SpfRoot_t;
+
     SPFVertex<T>* m_spfroot; //!< the root node
     GlobalRouteManagerLSDB<IpManager>*
         m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_incrementalSpf;     //!< whether RecomputeRoutes () is incremental
+    uint32_t m_spfThreadCount; //!< the number of threads computing the SPF trees
+    /// The LSAs explored by the last SPF calculation of every router, by router ID
+    std::map<IpAddress, std::vector<bool>> m_spfDependencies;
+    GlobalRouteManagerStatistics m_stats; //!< the statistics of the last computations
+    uint32_t m_spfVertices;               //!< the number of vertices of the current SPF tree
+    uint64_t m_spfBytes; //!< the estimated memory used by the current SPF tree, in bytes
+
+    /**
+     * @brief Get the routers whose SPF tree is computed by InitializeRoutes ().
+     * @returns the routers, in the order of the node list
+     */
+    std::vector<SpfRoot_t> GetSpfRoots() const;
+
+    /**
+     * @brief Compute the SPF trees of some routers and add their routes, with
+     * the number of threads set by SetSpfThreadCount ().
+     *
+     * The LSAs explored by every tree are recorded if incremental SPF is enabled.
+     *
+     * @param roots the routers
+     */
+    void ComputeRoutes(const std::vector<SpfRoot_t>& roots);
+
+    /**
+     * @brief Delete all the routes of the global routing protocol of a node.
+     * @param node the node
+     */
+    static void DeleteRoutes(Ptr<Node> node);
+
+    /**
+     * @brief Add a vertex of the SPF tree to the size of the tree.
+     * @param v the vertex, whose parents have been set
+     */
+    void CountSpfVertex(SPFVertex<T>* v);
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
@@ -933,6 +1083,18 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(IpAddress root);
 
+    /**
+     * @brief Calculate the shortest path first (SPF) tree of a router whose
+     * node is known.
+     *
+     * This does not look up the node list, and can be called by the threads
+     * of a parallel calculation.
+     *
+     * @param root the root node
+     * @param rootNode the node of the root, or nullptr to look it up
+     */
+    void SPFCalculate(IpAddress root, Ptr<Node> rootNode);
+
     /**
      * @brief Process Stub nodes
      *
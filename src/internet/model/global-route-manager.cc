@@ -27,6 +27,24 @@ NS_LOG_COMPONENT_DEFINE("GlobalRouteManager");
 //
 // ---------------------------------------------------------------------------
 
+void
+GlobalRouteManagerStatistics::Print(std::ostream& os) const
+{
+    os << "LSDB: " << lsaCount << " LSAs, " << externalLsaCount << " external LSAs, "
+       << lsdbBytes << " bytes, built in " << lsdbBuildTime << " ms; "
+       << "SPF: " << spfRuns << " trees computed, " << spfSkipped << " routers kept, "
+       << spfThreads << " threads, " << spfTime << " ms; largest tree: " << maxSpfVertices
+       << " vertices, " << maxSpfBytes << " bytes; dependencies: " << dependencyBytes
+       << " bytes";
+}
+
+std::ostream&
+operator<<(std::ostream& os, const GlobalRouteManagerStatistics& stats)
+{
+    stats.Print(os);
+    return os;
+}
+
 template <typename T>
 uint32_t GlobalRouteManager<T>::routerId = 0; //!< Router ID counter
 
@@ -57,6 +75,42 @@ GlobalRouteManager<T>::InitializeRoutes()
         ->InitializeRoutes();
 }
 
+template <typename T>
+void
+GlobalRouteManager<T>::RecomputeRoutes()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    SimulationSingleton<GlobalRouteManagerImpl<typename GlobalRouteManager<T>::IpManager>>::Get()
+        ->RecomputeRoutes();
+}
+
+template <typename T>
+void
+GlobalRouteManager<T>::SetIncrementalSpf(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    SimulationSingleton<GlobalRouteManagerImpl<typename GlobalRouteManager<T>::IpManager>>::Get()
+        ->SetIncrementalSpf(enable);
+}
+
+template <typename T>
+void
+GlobalRouteManager<T>::SetSpfThreadCount(uint32_t count)
+{
+    NS_LOG_FUNCTION(count);
+    SimulationSingleton<GlobalRouteManagerImpl<typename GlobalRouteManager<T>::IpManager>>::Get()
+        ->SetSpfThreadCount(count);
+}
+
+template <typename T>
+GlobalRouteManagerStatistics
+GlobalRouteManager<T>::GetStatistics()
+{
+    return SimulationSingleton<
+               GlobalRouteManagerImpl<typename GlobalRouteManager<T>::IpManager>>::Get()
+        ->GetStatistics();
+}
+
 template <typename T>
 uint32_t
 GlobalRouteManager<T>::AllocateRouterId()
@@ -16,6 +16,7 @@
 #include "ns3/ipv6-routing-helper.h"
 
 #include <cstdint>
+#include <ostream>
 
 namespace ns3
 {
@@ -34,6 +35,44 @@ struct Ipv6Manager
 {
 };
 
+/**
+ * @ingroup globalrouting
+ *
+ * @brief Statistics of the last routing database build and route computation
+ * of a GlobalRouteManager.
+ *
+ * The durations are wall-clock times; the memory sizes are estimates from the
+ * sizes of the objects and of their containers.
+ */
+struct GlobalRouteManagerStatistics
+{
+    uint32_t lsaCount{0};         //!< Router and network LSAs in the LSDB
+    uint32_t externalLsaCount{0}; //!< AS external LSAs in the LSDB
+    uint64_t lsdbBytes{0};        //!< Memory used by the LSDB, in bytes
+    int64_t lsdbBuildTime{0};     //!< Duration of the last LSDB build, in milliseconds
+    uint32_t spfRuns{0};          //!< SPF trees computed by the last route computation
+    uint32_t spfSkipped{0};       //!< Routers kept by the last incremental computation
+    uint32_t spfThreads{0};       //!< Threads used by the last route computation
+    int64_t spfTime{0};           //!< Duration of the last route computation, in milliseconds
+    uint32_t maxSpfVertices{0};   //!< Vertices of the largest SPF tree of the last computation
+    uint64_t maxSpfBytes{0};      //!< Memory used by the largest SPF tree, in bytes
+    uint64_t dependencyBytes{0};  //!< Memory used to record the LSAs explored by the SPF trees
+
+    /**
+     * Print the statistics.
+     * @param os the output stream
+     */
+    void Print(std::ostream& os) const;
+};
+
+/**
+ * @brief Stream insertion operator.
+ * @param os the output stream
+ * @param stats the statistics
+ * @returns the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const GlobalRouteManagerStatistics& stats);
+
 /**
  * @ingroup globalrouting
  *
@@ -95,6 +134,43 @@ class GlobalRouteManager
      */
     static void InitializeRoutes();
 
+    /**
+     * @brief Delete the global routes, rebuild the routing database and compute
+     * the routes again.
+     *
+     * With incremental SPF, only the routers affected by the changes of the
+     * routing database are computed again.
+     * @see SetIncrementalSpf
+     */
+    static void RecomputeRoutes();
+
+    /**
+     * @brief Enable or disable incremental SPF in RecomputeRoutes ().
+     *
+     * The routers whose last SPF calculation did not explore any LSA changed
+     * since then keep their routes, including the routes added by hand to
+     * their global routing protocol.  Disabled by default.
+     *
+     * @param enable whether incremental SPF is enabled
+     */
+    static void SetIncrementalSpf(bool enable);
+
+    /**
+     * @brief Set the number of threads computing the SPF trees of the routers.
+     *
+     * The routes do not depend on the number of threads.  Defaults to one.
+     *
+     * @param count the number of threads, including the calling thread
+     */
+    static void SetSpfThreadCount(uint32_t count);
+
+    /**
+     * @brief Get the statistics of the last routing database build and route
+     * computation, such as their durations and memory usage.
+     * @returns the statistics
+     */
+    static GlobalRouteManagerStatistics GetStatistics();
+
     /**
      * @brief Reset the router ID counter to zero. This should only be called by tests to reset the
      * router ID counter between simulations within the same program. This function should not be
@@ -20,6 +20,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -103,16 +104,7 @@ GlobalRouting<T>::AddHostRouteTo(IpAddress dest, IpAddress nextHop, uint32_t int
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    AddRoute(m_hostRoutes, m_hostRoutesTrie, route);
 }
 
 template <typename T>
@@ -122,16 +114,7 @@ GlobalRouting<T>::AddHostRouteTo(IpAddress dest, uint32_t interface)
     NS_LOG_FUNCTION(this << dest << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateHostRouteTo(dest, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    AddRoute(m_hostRoutes, m_hostRoutesTrie, route);
 }
 
 template <typename T>
@@ -144,16 +127,7 @@ GlobalRouting<T>::AddNetworkRouteTo(IpAddress network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    AddRoute(m_networkRoutes, m_networkRoutesTrie, route);
 }
 
 template <typename T>
@@ -165,16 +139,7 @@ GlobalRouting<T>::AddNetworkRouteTo(IpAddress network,
     NS_LOG_FUNCTION(this << network << networkMask << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    AddRoute(m_networkRoutes, m_networkRoutesTrie, route);
 }
 
 template <typename T>
@@ -199,6 +164,61 @@ GlobalRouting<T>::AddASExternalRouteTo(IpAddress network,
     m_ASexternalRoutes.push_back(route);
 }
 
+template <typename T>
+std::pair<typename GlobalRouting<T>::RoutesTrie::Key, uint8_t>
+GlobalRouting<T>::GetTrieKey(const IpRoutingTableEntry* route)
+{
+    uint8_t length;
+    if constexpr (IsIpv4)
+    {
+        length = route->GetDestNetworkMask().GetPrefixLength();
+    }
+    else
+    {
+        length = route->GetDestNetworkPrefix().GetPrefixLength();
+    }
+    return {RoutesTrie::MakeKey(route->GetDest()), length};
+}
+
+template <typename T>
+void
+GlobalRouting<T>::AddRoute(std::list<IpRoutingTableEntry*>& routes,
+                           RoutesTrie& trie,
+                           IpRoutingTableEntry* route)
+{
+    const auto [key, length] = GetTrieKey(route);
+    auto& prefixRoutes = trie.Insert(key, length);
+    for (auto routePointer : prefixRoutes)
+    {
+        if (*routePointer == *route)
+        {
+            NS_LOG_LOGIC("Route already exists");
+            delete route;
+            return;
+        }
+    }
+    prefixRoutes.push_back(route);
+    routes.push_back(route);
+}
+
+template <typename T>
+void
+GlobalRouting<T>::EraseRoute(std::list<IpRoutingTableEntry*>& routes,
+                             RoutesTrie& trie,
+                             typename std::list<IpRoutingTableEntry*>::iterator it)
+{
+    const auto [key, length] = GetTrieKey(*it);
+    PrefixRoutes* prefixRoutes = trie.Find(key, length);
+    NS_ASSERT(prefixRoutes);
+    prefixRoutes->erase(std::find(prefixRoutes->begin(), prefixRoutes->end(), *it));
+    if (prefixRoutes->empty())
+    {
+        trie.Erase(key, length);
+    }
+    delete *it;
+    routes.erase(it);
+}
+
 template <typename T>
 Ptr<typename GlobalRouting<T>::IpRoute>
 GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
@@ -211,11 +231,13 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
     RouteVec_t allRoutes;
 
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    const auto destKey = RoutesTrie::MakeKey(dest);
+    const PrefixRoutes* hostRoutes = m_hostRoutesTrie.Find(destKey, IsIpv4 ? 32 : 128);
+    if (hostRoutes)
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (auto i = hostRoutes->begin(); i != hostRoutes->end(); i++)
         {
+            NS_ASSERT((*i)->IsHost());
             if (oif)
             {
                 if (oif != m_ip->GetNetDevice((*i)->GetInterface()))
@@ -231,51 +253,40 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        // store the length of the longest mask.
-        uint16_t longest_mask = 0;
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            IpMaskOrPrefix mask;
-            if constexpr (IsIpv4)
-            {
-                mask = (*j)->GetDestNetworkMask();
-            }
-            else
-            {
-                mask = (*j)->GetDestNetworkPrefix();
-            }
-            uint16_t masklen = mask.GetPrefixLength();
-
-            IpAddress entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                if (oif)
+        // the network routes matching the destination are visited from the longest
+        // mask, and all the routes with the longest mask are kept
+        m_networkRoutesTrie.LongestMatch(
+            destKey,
+            [&](uint8_t masklen, const PrefixRoutes& networkRoutes) {
+                for (auto j = networkRoutes.begin(); j != networkRoutes.end(); j++)
                 {
-                    if (oif != m_ip->GetNetDevice((*j)->GetInterface()))
+                    IpMaskOrPrefix mask;
+                    if constexpr (IsIpv4)
+                    {
+                        mask = (*j)->GetDestNetworkMask();
+                    }
+                    else
+                    {
+                        mask = (*j)->GetDestNetworkPrefix();
+                    }
+                    if (!mask.IsMatch(dest, (*j)->GetDestNetwork()))
                     {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
                         continue;
                     }
-                }
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-                if (masklen < longest_mask) // Not interested if got shorter mask
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-                else if (masklen == longest_mask)
-                {
-                    NS_LOG_LOGIC("Equal mask length, adding this to the list");
-                    allRoutes.push_back(*j);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("Longer mask length found, clearing the list and adding");
-                    allRoutes.clear();
+                    if (oif)
+                    {
+                        if (oif != m_ip->GetNetDevice((*j)->GetInterface()))
+                        {
+                            NS_LOG_LOGIC("Not on requested interface, skipping");
+                            continue;
+                        }
+                    }
+                    NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j
+                                                  << ", mask length " << +masklen);
                     allRoutes.push_back(*j);
                 }
-            }
-        }
+                return !allRoutes.empty();
+            });
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
@@ -416,8 +427,7 @@ GlobalRouting<T>::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
-                delete *i;
-                m_hostRoutes.erase(i);
+                EraseRoute(m_hostRoutes, m_hostRoutesTrie, i);
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -432,8 +442,7 @@ GlobalRouting<T>::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
-            delete *j;
-            m_networkRoutes.erase(j);
+            EraseRoute(m_networkRoutes, m_networkRoutesTrie, j);
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -480,6 +489,8 @@ GlobalRouting<T>::DoDispose()
     {
         delete (*j);
     }
+    m_hostRoutesTrie.Clear();
+    m_networkRoutesTrie.Clear();
     for (auto l = m_ASexternalRoutes.begin(); l != m_ASexternalRoutes.end();
          l = m_ASexternalRoutes.erase(l))
     {
@@ -693,9 +704,7 @@ GlobalRouting<T>::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager<IpManager>::DeleteGlobalRoutes();
-        GlobalRouteManager<IpManager>::BuildGlobalRoutingDatabase();
-        GlobalRouteManager<IpManager>::InitializeRoutes();
+        GlobalRouteManager<IpManager>::RecomputeRoutes();
     }
 }
 
@@ -706,9 +715,7 @@ GlobalRouting<T>::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager<IpManager>::DeleteGlobalRoutes();
-        GlobalRouteManager<IpManager>::BuildGlobalRoutingDatabase();
-        GlobalRouteManager<IpManager>::InitializeRoutes();
+        GlobalRouteManager<IpManager>::RecomputeRoutes();
     }
 }
 
@@ -719,9 +726,7 @@ GlobalRouting<T>::NotifyAddAddress(uint32_t interface, IpInterfaceAddress addres
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager<IpManager>::DeleteGlobalRoutes();
-        GlobalRouteManager<IpManager>::BuildGlobalRoutingDatabase();
-        GlobalRouteManager<IpManager>::InitializeRoutes();
+        GlobalRouteManager<IpManager>::RecomputeRoutes();
     }
 }
 
@@ -732,9 +737,7 @@ GlobalRouting<T>::NotifyRemoveAddress(uint32_t interface, IpInterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager<IpManager>::DeleteGlobalRoutes();
-        GlobalRouteManager<IpManager>::BuildGlobalRoutingDatabase();
-        GlobalRouteManager<IpManager>::InitializeRoutes();
+        GlobalRouteManager<IpManager>::RecomputeRoutes();
     }
 }
 
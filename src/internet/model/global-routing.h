@@ -79,6 +79,7 @@
 #define GLOBAL_ROUTING_H
 
 #include "global-route-manager.h"
+#include "ip-prefix-trie.h"
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -93,6 +94,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -544,6 +547,39 @@ class GlobalRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef typename std::list<IpRoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// routes with the same destination prefix, in the order of their container
+    typedef std::vector<IpRoutingTableEntry*> PrefixRoutes;
+    /// trie of the destination prefixes of the host or network routes
+    typedef IpPrefixTrie<PrefixRoutes> RoutesTrie;
+
+    /**
+     * @brief Get the key and the prefix length of the destination of a route in a trie.
+     * @param route the route
+     * @return the key and the prefix length of the destination
+     */
+    static std::pair<typename RoutesTrie::Key, uint8_t> GetTrieKey(
+        const IpRoutingTableEntry* route);
+
+    /**
+     * @brief Add a route to the host or network routes, unless it is already there.
+     * @param routes the host or network routes
+     * @param trie the trie of the routes
+     * @param route the route, which is deleted if it is already in the routes
+     */
+    void AddRoute(std::list<IpRoutingTableEntry*>& routes,
+                  RoutesTrie& trie,
+                  IpRoutingTableEntry* route);
+
+    /**
+     * @brief Remove a route from the host or network routes, and delete it.
+     * @param routes the host or network routes
+     * @param trie the trie of the routes
+     * @param it the route
+     */
+    void EraseRoute(std::list<IpRoutingTableEntry*>& routes,
+                    RoutesTrie& trie,
+                    typename std::list<IpRoutingTableEntry*>::iterator it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -555,6 +591,8 @@ class GlobalRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProtocol
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
+    RoutesTrie m_hostRoutesTrie;         //!< Routes to hosts, indexed by destination
+    RoutesTrie m_networkRoutesTrie;      //!< Routes to networks, indexed by destination prefix
 
     Ptr<Ip> m_ip; //!< associated IPv4 instance
 };
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IP_PREFIX_TRIE_H
+#define IP_PREFIX_TRIE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace ns3
+{
+
+/**
+ * @ingroup ipv4Routing
+ * @ingroup ipv6Routing
+ *
+ * @brief Binary trie of IPv4 or IPv6 prefixes, used by the routing protocols for the
+ * longest prefix match of the destination of the packets.
+ *
+ * Every node of the trie is a prefix, and the nodes holding a value are the prefixes which
+ * have been inserted. The trie is path-compressed: except the root, a node without value has
+ * two children, hence the trie has less than two nodes per prefix, and a lookup visits at most
+ * one node per bit of the address. Prefixes are inserted and erased one at a time, without
+ * rebuilding the trie.
+ *
+ * @tparam T the type of the values associated with the prefixes
+ */
+template <class T>
+class IpPrefixTrie
+{
+  public:
+    /// The bytes of an address or of a prefix, in network order. IPv4 uses the first 4 bytes.
+    using Key = std::array<uint8_t, 16>;
+
+    IpPrefixTrie()
+        : m_root(std::make_unique<Node>(Key{}, 0))
+    {
+    }
+
+    /**
+     * @param address an IPv4 address
+     * @return the key of the address
+     */
+    static Key MakeKey(Ipv4Address address)
+    {
+        Key key{};
+        address.Serialize(key.data());
+        return key;
+    }
+
+    /**
+     * @param address an IPv6 address
+     * @return the key of the address
+     */
+    static Key MakeKey(Ipv6Address address)
+    {
+        Key key{};
+        address.GetBytes(key.data());
+        return key;
+    }
+
+    /**
+     * Insert a prefix in the trie, if it is not there yet.
+     *
+     * @param prefix the prefix; the bits beyond the prefix length are ignored
+     * @param length the prefix length, in bits
+     * @return the value associated with the prefix, default constructed if the prefix was
+     * not in the trie
+     */
+    T& Insert(const Key& prefix, uint8_t length)
+    {
+        const Key key = Mask(prefix, length);
+        Node* node = m_root.get();
+        while (node->length < length)
+        {
+            auto& child = node->children[GetBit(key, node->length)];
+            if (!child)
+            {
+                child = std::make_unique<Node>(key, length);
+                node = child.get();
+                break;
+            }
+            const auto common = CommonLength(key, child->prefix, std::min(length, child->length));
+            if (common < child->length)
+            {
+                // split the edge towards the child with a node for the common prefix
+                auto branch = std::make_unique<Node>(Mask(key, common), common);
+                branch->children[GetBit(child->prefix, common)] = std::move(child);
+                child = std::move(branch);
+            }
+            node = child.get();
+        }
+        if (!node->hasValue)
+        {
+            node->hasValue = true;
+            ++m_size;
+        }
+        return node->value;
+    }
+
+    /**
+     * @param prefix the prefix; the bits beyond the prefix length are ignored
+     * @param length the prefix length, in bits
+     * @return the value associated with the prefix, or nullptr if the prefix is not in the trie
+     */
+    T* Find(const Key& prefix, uint8_t length) const
+    {
+        const Key key = Mask(prefix, length);
+        Node* node = m_root.get();
+        while (node->length < length)
+        {
+            node = node->children[GetBit(key, node->length)].get();
+            if (!node || CommonLength(key, node->prefix, std::min(length, node->length)) <
+                             node->length)
+            {
+                return nullptr;
+            }
+        }
+        return (node->length == length && node->hasValue) ? &node->value : nullptr;
+    }
+
+    /**
+     * Erase a prefix and its value from the trie, if it is there.
+     *
+     * @param prefix the prefix; the bits beyond the prefix length are ignored
+     * @param length the prefix length, in bits
+     */
+    void Erase(const Key& prefix, uint8_t length)
+    {
+        const Key key = Mask(prefix, length);
+        std::unique_ptr<Node>* link = nullptr;
+        std::unique_ptr<Node>* parentLink = nullptr;
+        Node* node = m_root.get();
+        while (node->length < length)
+        {
+            parentLink = link;
+            link = &node->children[GetBit(key, node->length)];
+            node = link->get();
+            if (!node || CommonLength(key, node->prefix, std::min(length, node->length)) <
+                             node->length)
+            {
+                return;
+            }
+        }
+        if (node->length != length || !node->hasValue)
+        {
+            return;
+        }
+        node->hasValue = false;
+        node->value = T();
+        --m_size;
+        // the root is never removed
+        if (link)
+        {
+            Compact(*link);
+            if (parentLink)
+            {
+                Compact(*parentLink);
+            }
+        }
+    }
+
+    /**
+     * Erase all the prefixes from the trie.
+     */
+    void Clear()
+    {
+        m_root = std::make_unique<Node>(Key{}, 0);
+        m_size = 0;
+    }
+
+    /**
+     * @return the number of prefixes in the trie
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Visit the prefixes matching an address, from the longest to the shortest, until the
+     * visitor accepts one of them.
+     *
+     * @tparam F the type of the visitor, callable as bool (uint8_t length, T& value)
+     * @param address the address
+     * @param visit the visitor, called with the length and the value of each matching
+     * prefix, which returns true to stop the visit
+     * @return true if the visitor has accepted a prefix
+     */
+    template <class F>
+    bool LongestMatch(const Key& address, F visit) const
+    {
+        std::array<Node*, 129> matches;
+        std::size_t nMatches = 0;
+        Node* node = m_root.get();
+        while (node && CommonLength(address, node->prefix, node->length) == node->length)
+        {
+            if (node->hasValue)
+            {
+                matches[nMatches++] = node;
+            }
+            if (node->length == 8 * sizeof(Key))
+            {
+                break;
+            }
+            node = node->children[GetBit(address, node->length)].get();
+        }
+        while (nMatches > 0)
+        {
+            --nMatches;
+            if (visit(matches[nMatches]->length, matches[nMatches]->value))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    /// A prefix of the trie
+    struct Node
+    {
+        /**
+         * Constructor
+         * @param p the prefix, with the bits beyond the prefix length set to zero
+         * @param l the prefix length
+         */
+        Node(const Key& p, uint8_t l)
+            : prefix(p),
+              length(l)
+        {
+        }
+
+        Key prefix;                                    //!< the prefix
+        uint8_t length;                                //!< the prefix length, in bits
+        bool hasValue{false};                          //!< whether the prefix was inserted
+        T value{};                                     //!< the value of the prefix
+        std::array<std::unique_ptr<Node>, 2> children; //!< the longer prefixes, by next bit
+    };
+
+    /**
+     * @param key a key
+     * @param bit the index of a bit, from the most significant bit of the first byte
+     * @return the bit of the key
+     */
+    static uint8_t GetBit(const Key& key, uint8_t bit)
+    {
+        return (key[bit / 8] >> (7 - bit % 8)) & 1;
+    }
+
+    /**
+     * @param key a key
+     * @param length a prefix length, in bits
+     * @return the key with the bits beyond the prefix length set to zero
+     */
+    static Key Mask(const Key& key, uint8_t length)
+    {
+        Key masked{};
+        std::copy_n(key.begin(), length / 8, masked.begin());
+        if (length % 8 != 0)
+        {
+            masked[length / 8] = key[length / 8] & static_cast<uint8_t>(0xff << (8 - length % 8));
+        }
+        return masked;
+    }
+
+    /**
+     * @param a a key
+     * @param b another key
+     * @param maxLength the maximum length to compare, in bits
+     * @return the length of the common prefix of the keys, up to the maximum length
+     */
+    static uint8_t CommonLength(const Key& a, const Key& b, uint8_t maxLength)
+    {
+        uint8_t length = 0;
+        for (std::size_t i = 0; length < maxLength; ++i)
+        {
+            const uint8_t diff = a[i] ^ b[i];
+            if (diff != 0)
+            {
+                length += std::countl_zero(diff);
+                break;
+            }
+            length += 8;
+        }
+        return std::min(length, maxLength);
+    }
+
+    /**
+     * Remove a node without value which does not branch, replacing it with its child.
+     * @param link the pointer to the node
+     */
+    static void Compact(std::unique_ptr<Node>& link)
+    {
+        if (link->hasValue || (link->children[0] && link->children[1]))
+        {
+            return;
+        }
+        auto child = std::move(link->children[link->children[0] ? 0 : 1]);
+        link = std::move(child);
+    }
+
+    std::unique_ptr<Node> m_root; //!< the root of the trie, which is the empty prefix
+    std::size_t m_size{0};        //!< the number of prefixes in the trie
+};
+
+} // namespace ns3
+
+#endif /* IP_PREFIX_TRIE_H */
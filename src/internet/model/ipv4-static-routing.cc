@@ -25,7 +25,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
 
 using std::make_pair;
 
@@ -67,8 +69,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -84,9 +85,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -141,7 +140,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -210,10 +209,44 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
     }
 }
 
+void
+Ipv4StaticRouting::AppendNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesTrie
+        .Insert(IpPrefixTrie<PrefixRoutes>::MakeKey(route->GetDestNetwork()),
+                route->GetDestNetworkMask().GetPrefixLength())
+        .push_back(std::prev(m_networkRoutes.end()));
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv4RoutingTableEntry* route = it->first;
+    const auto key = IpPrefixTrie<PrefixRoutes>::MakeKey(route->GetDestNetwork());
+    const auto length = route->GetDestNetworkMask().GetPrefixLength();
+    PrefixRoutes* prefixRoutes = m_networkRoutesTrie.Find(key, length);
+    NS_ASSERT(prefixRoutes);
+    prefixRoutes->erase(std::find(prefixRoutes->begin(), prefixRoutes->end(), it));
+    if (prefixRoutes->empty())
+    {
+        m_networkRoutesTrie.Erase(key, length);
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    const PrefixRoutes* prefixRoutes =
+        m_networkRoutesTrie.Find(IpPrefixTrie<PrefixRoutes>::MakeKey(route.GetDestNetwork()),
+                                 route.GetDestNetworkMask().GetPrefixLength());
+    if (!prefixRoutes)
+    {
+        return false;
+    }
+    for (const auto& j : *prefixRoutes)
     {
         Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -233,8 +266,6 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
-    uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
     {
@@ -250,55 +281,52 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+    // The routes matching the destination are found in the trie from the longest prefix
+    // length. Among the routes with the longest prefix length on the requested interface,
+    // the route with the lowest metric is selected; in case of tie, the last route of the
+    // table is selected, except for /32 routes, where the first route is selected.
+    Ipv4RoutingTableEntry* route = nullptr;
+    m_networkRoutesTrie.LongestMatch(
+        IpPrefixTrie<PrefixRoutes>::MakeKey(dest),
+        [&](uint8_t masklen, const PrefixRoutes& prefixRoutes) {
+            uint32_t shortest_metric = 0xffffffff;
+            for (const auto& i : prefixRoutes)
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                Ipv4RoutingTableEntry* j = i->first;
+                uint32_t metric = i->second;
+                if (!j->GetDestNetworkMask().IsMatch(dest, j->GetDestNetwork()))
+                {
+                    continue;
+                }
+                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << +masklen
+                                                           << ", metric " << metric);
+                if (oif && oif != m_ipv4->GetNetDevice(j->GetInterface()))
                 {
                     NS_LOG_LOGIC("Not on requested interface, skipping");
                     continue;
                 }
+                if (metric > shortest_metric)
+                {
+                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                    continue;
+                }
+                shortest_metric = metric;
+                route = j;
+                if (masklen == 32)
+                {
+                    break;
+                }
             }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
-        }
+            return route != nullptr;
+        });
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -446,8 +474,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +608,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRoutesTrie.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +648,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -665,8 +692,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -10,6 +10,7 @@
 #ifndef IPV4_STATIC_ROUTING_H
 #define IPV4_STATIC_ROUTING_H
 
+#include "ip-prefix-trie.h"
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -21,6 +22,7 @@
 #include <list>
 #include <stdint.h>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -370,6 +372,23 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Network routes with the same destination prefix, in the order of the forwarding table
+    typedef std::vector<NetworkRoutesI> PrefixRoutes;
+
+    /**
+     * @brief Add a route at the end of the forwarding table for network.
+     * @param route route
+     * @param metric metric of route
+     */
+    void AppendNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the forwarding table for network, and delete it.
+     * @param it the route
+     * @return the route following the removed route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -400,6 +419,14 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table for network, indexed by destination prefix.
+     *
+     * The routes are found in the trie by the prefix length of their mask, and
+     * checked against their mask, which may not be contiguous.
+     */
+    IpPrefixTrie<PrefixRoutes> m_networkRoutesTrie;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -18,7 +18,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
 
 namespace ns3
 {
@@ -170,8 +172,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -197,8 +198,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -214,8 +214,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -257,7 +256,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     auto network = Ipv6Address("ff00::"); /* RFC 3513 */
     auto networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -349,10 +348,44 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
     return false;
 }
 
+void
+Ipv6StaticRouting::AppendNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesTrie
+        .Insert(IpPrefixTrie<PrefixRoutes>::MakeKey(route->GetDestNetwork()),
+                route->GetDestNetworkPrefix().GetPrefixLength())
+        .push_back(std::prev(m_networkRoutes.end()));
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv6RoutingTableEntry* route = it->first;
+    const auto key = IpPrefixTrie<PrefixRoutes>::MakeKey(route->GetDestNetwork());
+    const auto length = route->GetDestNetworkPrefix().GetPrefixLength();
+    PrefixRoutes* prefixRoutes = m_networkRoutesTrie.Find(key, length);
+    NS_ASSERT(prefixRoutes);
+    prefixRoutes->erase(std::find(prefixRoutes->begin(), prefixRoutes->end(), it));
+    if (prefixRoutes->empty())
+    {
+        m_networkRoutesTrie.Erase(key, length);
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    const PrefixRoutes* prefixRoutes =
+        m_networkRoutesTrie.Find(IpPrefixTrie<PrefixRoutes>::MakeKey(route.GetDestNetwork()),
+                                 route.GetDestNetworkPrefix().GetPrefixLength());
+    if (!prefixRoutes)
+    {
+        return false;
+    }
+    for (const auto& j : *prefixRoutes)
     {
         Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -373,8 +406,6 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
-    uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -391,70 +422,66 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
-
-            /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+    // The routes matching the destination are found in the trie from the longest prefix
+    // length. Among the routes with the longest prefix length on the requested interface,
+    // the route with the lowest metric is selected; in case of tie, the last route of the
+    // table is selected, except for /128 routes, where the first route is selected.
+    Ipv6RoutingTableEntry* route = nullptr;
+    m_networkRoutesTrie.LongestMatch(
+        IpPrefixTrie<PrefixRoutes>::MakeKey(dst),
+        [&](uint8_t maskLen, const PrefixRoutes& prefixRoutes) {
+            uint32_t shortestMetric = 0xffffffff;
+            for (const auto& it : prefixRoutes)
             {
-                if (maskLen < longestMask)
+                Ipv6RoutingTableEntry* j = it->first;
+                uint32_t metric = it->second;
+                if (!j->GetDestNetworkPrefix().IsMatch(dst, j->GetDestNetwork()))
                 {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
                     continue;
                 }
+                NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << +maskLen
+                                                           << ", metric " << metric);
 
-                if (maskLen > longestMask)
+                /* if interface is given, check the route will output on this interface */
+                if (interface && interface != m_ipv6->GetNetDevice(j->GetInterface()))
                 {
-                    shortestMetric = 0xffffffff;
+                    continue;
                 }
-
-                longestMask = maskLen;
                 if (metric > shortestMetric)
                 {
                     NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                     continue;
                 }
-
                 shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
-
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
-
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
+                route = j;
                 if (maskLen == 128)
                 {
                     break;
                 }
             }
+            return route != nullptr;
+        });
+
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
+
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
         }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+        }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -475,6 +502,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRoutesTrie.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -631,8 +659,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -654,8 +681,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -796,8 +822,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -834,8 +859,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -892,8 +916,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
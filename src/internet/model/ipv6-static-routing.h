@@ -9,6 +9,7 @@
 #ifndef IPV6_STATIC_ROUTING_H
 #define IPV6_STATIC_ROUTING_H
 
+#include "ip-prefix-trie.h"
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
@@ -18,6 +19,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -295,6 +297,23 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Network routes with the same destination prefix, in the order of the forwarding table
+    typedef std::vector<NetworkRoutesI> PrefixRoutes;
+
+    /**
+     * @brief Add a route at the end of the forwarding table for network.
+     * @param route route
+     * @param metric metric of route
+     */
+    void AppendNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the forwarding table for network, and delete it.
+     * @param it the route
+     * @return the route following the removed route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -325,6 +344,11 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table for network, indexed by destination prefix.
+     */
+    IpPrefixTrie<PrefixRoutes> m_networkRoutesTrie;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -37,6 +37,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
+#include <string>
 #include <vector>
 using namespace ns3;
 
@@ -2942,6 +2944,137 @@ GlobalRoutingv6ProtocolTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief TestCase checking that the incremental and parallel SPF calculations of the
+ * GlobalRouteManager add the same routes as the full sequential calculation, and that the
+ * incremental calculation only recomputes the routers affected by a link failure.
+ */
+class IncrementalSpfTestCase : public TestCase
+{
+  public:
+    IncrementalSpfTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * @return the routes of the global routing protocol of every node
+     */
+    std::vector<std::string> GetRoutes() const;
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+IncrementalSpfTestCase::IncrementalSpfTestCase()
+    : TestCase("Incremental and parallel SPF calculation")
+{
+}
+
+void
+IncrementalSpfTestCase::DoSetup()
+{
+    // Two disconnected islands: a ring n0-n1-n2-n3-n0 and a line n4-n5-n6
+    m_nodes.Create(7);
+
+    Ipv4GlobalRoutingHelper globalhelperv4;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelperv4);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(m_nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.252");
+    const std::vector<std::pair<uint32_t, uint32_t>> links{{0, 1},
+                                                          {1, 2},
+                                                          {2, 3},
+                                                          {3, 0},
+                                                          {4, 5},
+                                                          {5, 6}};
+    for (const auto& [a, b] : links)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer devices = devHelper.Install(m_nodes.Get(a), channel);
+        devices.Add(devHelper.Install(m_nodes.Get(b), channel));
+        address.Assign(devices);
+        address.NewNetwork();
+    }
+}
+
+std::vector<std::string>
+IncrementalSpfTestCase::GetRoutes() const
+{
+    std::vector<std::string> routes;
+    for (auto node = m_nodes.Begin(); node != m_nodes.End(); node++)
+    {
+        Ptr<Ipv4GlobalRouting> globalRouting =
+            (*node)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+        std::ostringstream os;
+        for (uint32_t i = 0; i < globalRouting->GetNRoutes(); i++)
+        {
+            os << *globalRouting->GetRoute(i) << std::endl;
+        }
+        routes.push_back(os.str());
+    }
+    return routes;
+}
+
+void
+IncrementalSpfTestCase::DoRun()
+{
+    // Full sequential calculations, with and without the link n0-n1
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    const auto initialRoutes = GetRoutes();
+    Ptr<Ipv4> ipv40 = m_nodes.Get(0)->GetObject<Ipv4>();
+    ipv40->SetDown(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    const auto failureRoutes = GetRoutes();
+    NS_TEST_ASSERT_MSG_EQ((failureRoutes != initialRoutes),
+                          true,
+                          "The link failure should change the routes");
+    ipv40->SetUp(1);
+
+    Ipv4GlobalRouteManager::SetIncrementalSpf(true);
+    Ipv4GlobalRouteManager::SetSpfThreadCount(3);
+
+    // The first calculation computes all the routers
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == initialRoutes), true, "Unexpected routes");
+    auto stats = Ipv4GlobalRouteManager::GetStatistics();
+    NS_TEST_EXPECT_MSG_EQ(stats.lsaCount, 7, "Unexpected number of LSAs");
+    NS_TEST_EXPECT_MSG_GT(stats.lsdbBytes, 0, "The LSDB should use some memory");
+    NS_TEST_EXPECT_MSG_EQ(stats.spfRuns, 7, "All the routers should be computed");
+    NS_TEST_EXPECT_MSG_EQ(stats.spfSkipped, 0, "No router should be kept");
+    NS_TEST_EXPECT_MSG_EQ(stats.spfThreads, 3, "Unexpected number of threads");
+    NS_TEST_EXPECT_MSG_EQ(stats.maxSpfVertices, 4, "The largest tree is the ring");
+    NS_TEST_EXPECT_MSG_GT(stats.maxSpfBytes, 0, "The trees should use some memory");
+    NS_TEST_EXPECT_MSG_GT(stats.dependencyBytes, 0, "The dependencies should be recorded");
+
+    // The link failure only affects the routers of the ring
+    ipv40->SetDown(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == failureRoutes), true, "Unexpected routes");
+    stats = Ipv4GlobalRouteManager::GetStatistics();
+    NS_TEST_EXPECT_MSG_EQ(stats.spfRuns, 4, "The routers of the ring should be computed");
+    NS_TEST_EXPECT_MSG_EQ(stats.spfSkipped, 3, "The routers of the line should be kept");
+
+    ipv40->SetUp(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == initialRoutes), true, "Unexpected routes");
+
+    // Without any change, all the routes are kept
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == initialRoutes), true, "Unexpected routes");
+    stats = Ipv4GlobalRouteManager::GetStatistics();
+    NS_TEST_EXPECT_MSG_EQ(stats.spfRuns, 0, "No router should be computed");
+    NS_TEST_EXPECT_MSG_EQ(stats.spfSkipped, 7, "All the routers should be kept");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -2968,6 +3101,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingv4ProtocolTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingv6ProtocolTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new IncrementalSpfTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ip-prefix-trie.h"
+#include "ns3/test.h"
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Check the prefixes found in the IpPrefixTrie against a brute-force search, while
+ * prefixes are inserted and erased in random order.
+ */
+class IpPrefixTrieTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param bits the number of bits of the addresses (32 or 128)
+     */
+    IpPrefixTrieTestCase(uint8_t bits);
+
+  private:
+    void DoRun() override;
+
+    using Trie = IpPrefixTrie<uint32_t>; //!< trie under test
+    using Key = Trie::Key;               //!< key of the trie
+
+    /**
+     * @param key a key
+     * @param length a prefix length
+     * @return the key with the bits beyond the prefix length set to zero
+     */
+    static Key Mask(Key key, uint8_t length);
+
+    uint8_t m_bits; //!< number of bits of the addresses
+};
+
+IpPrefixTrieTestCase::IpPrefixTrieTestCase(uint8_t bits)
+    : TestCase("Check the IP prefix trie with " + std::to_string(bits) + "-bit addresses"),
+      m_bits(bits)
+{
+}
+
+IpPrefixTrieTestCase::Key
+IpPrefixTrieTestCase::Mask(Key key, uint8_t length)
+{
+    for (uint32_t bit = length; bit < 8 * key.size(); ++bit)
+    {
+        key[bit / 8] &= ~(1 << (7 - bit % 8));
+    }
+    return key;
+}
+
+void
+IpPrefixTrieTestCase::DoRun()
+{
+    std::mt19937 rng(1);
+    // addresses close to each other, so that the prefixes share bits
+    auto randomKey = [&]() {
+        Key key{};
+        for (uint32_t i = 0; i < m_bits / 8u; ++i)
+        {
+            key[i] = (rng() % 4 == 0) ? rng() : (i < 2 ? 10 : 0);
+        }
+        return key;
+    };
+
+    Trie trie;
+    std::map<std::pair<Key, uint8_t>, uint32_t> reference;
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        const auto op = rng() % 10;
+        const uint8_t length = rng() % (m_bits + 1);
+        const auto key = randomKey();
+        const auto prefix = Mask(key, length);
+        if (op < 5)
+        {
+            const uint32_t value = rng();
+            // the bits beyond the prefix length are ignored
+            trie.Insert(key, length) = value;
+            reference[{prefix, length}] = value;
+        }
+        else if (op < 7)
+        {
+            trie.Erase(prefix, length);
+            reference.erase({prefix, length});
+        }
+        else
+        {
+            const auto found = trie.Find(prefix, length);
+            const auto it = reference.find({prefix, length});
+            NS_TEST_ASSERT_MSG_EQ((found != nullptr),
+                                  (it != reference.end()),
+                                  "Unexpected result of Find for prefix length " << +length);
+            if (found)
+            {
+                NS_TEST_ASSERT_MSG_EQ(*found, it->second, "Unexpected value");
+            }
+
+            const auto address = randomKey();
+            std::vector<std::pair<uint8_t, uint32_t>> matches;
+            trie.LongestMatch(address, [&](uint8_t matchLength, uint32_t& value) {
+                matches.emplace_back(matchLength, value);
+                return false;
+            });
+            std::vector<std::pair<uint8_t, uint32_t>> expected;
+            for (int matchLength = m_bits; matchLength >= 0; --matchLength)
+            {
+                const auto match = reference.find({Mask(address, matchLength), matchLength});
+                if (match != reference.end())
+                {
+                    expected.emplace_back(matchLength, match->second);
+                }
+            }
+            NS_TEST_ASSERT_MSG_EQ((matches == expected),
+                                  true,
+                                  "Unexpected prefixes matching the address at step " << step);
+        }
+        NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), reference.size(), "Unexpected number of prefixes");
+    }
+
+    // the visit stops at the first prefix accepted by the visitor
+    trie.Clear();
+    trie.Insert(Trie::MakeKey(Ipv4Address("10.0.0.0")), 8) = 8;
+    trie.Insert(Trie::MakeKey(Ipv4Address("10.1.0.0")), 16) = 16;
+    trie.Insert(Trie::MakeKey(Ipv4Address("10.1.2.3")), 32) = 32;
+    uint32_t visited = 0;
+    NS_TEST_EXPECT_MSG_EQ(trie.LongestMatch(Trie::MakeKey(Ipv4Address("10.1.2.4")),
+                                            [&](uint8_t, uint32_t& value) {
+                                                ++visited;
+                                                return value == 16;
+                                            }),
+                          true,
+                          "The visitor should have accepted the /16 prefix");
+    NS_TEST_EXPECT_MSG_EQ(visited, 1, "The /32 prefix should not match");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IpPrefixTrie TestSuite
+ */
+class IpPrefixTrieTestSuite : public TestSuite
+{
+  public:
+    IpPrefixTrieTestSuite();
+};
+
+IpPrefixTrieTestSuite::IpPrefixTrieTestSuite()
+    : TestSuite("ip-prefix-trie", Type::UNIT)
+{
+    AddTestCase(new IpPrefixTrieTestCase(32), TestCase::Duration::QUICK);
+    AddTestCase(new IpPrefixTrieTestCase(128), TestCase::Duration::QUICK);
+}
+
+static IpPrefixTrieTestSuite g_ipPrefixTrieTestSuite; //!< Static variable for test initialization
@@ -7,6 +7,8 @@
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
@@ -199,7 +201,153 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
 /**
  * @ingroup internet-test
  *
- * @brief IPv4 StaticRouting /32 TestSuite
+ * @brief IPv4 StaticRouting longest prefix match Test
+ *
+ * Check the route selected for several destinations: the route with the longest mask is
+ * selected, then the route with the lowest metric. Among routes with the same mask length
+ * and metric, the last route is selected, except for /32 routes where the first route is.
+ */
+class Ipv4StaticRoutingLongestPrefixMatchTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLongestPrefixMatchTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the gateway of the route to a destination.
+     * @param destination the destination
+     * @param gateway the expected gateway, or the any address if no route is expected
+     * @param oif the output device, if any
+     */
+    void CheckGateway(const std::string& destination,
+                      const std::string& gateway,
+                      Ptr<NetDevice> oif = nullptr);
+
+    Ptr<Ipv4StaticRouting> m_routing; //!< the routing protocol under test
+};
+
+Ipv4StaticRoutingLongestPrefixMatchTestCase::Ipv4StaticRoutingLongestPrefixMatchTestCase()
+    : TestCase("Longest prefix match of the static routes")
+{
+}
+
+void
+Ipv4StaticRoutingLongestPrefixMatchTestCase::CheckGateway(const std::string& destination,
+                                                          const std::string& gateway,
+                                                          Ptr<NetDevice> oif)
+{
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address(destination.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+    if (Ipv4Address(gateway.c_str()).IsAny())
+    {
+        NS_TEST_EXPECT_MSG_EQ(route, nullptr, "Unexpected route to " << destination);
+        return;
+    }
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route to " << destination);
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv4Address(gateway.c_str()),
+                          "Unexpected gateway to " << destination);
+}
+
+void
+Ipv4StaticRoutingLongestPrefixMatchTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    std::vector<Ptr<NetDevice>> devices;
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        devices.push_back(device);
+        int32_t ifIndex = ipv4->AddInterface(device);
+        std::string address = "192.168." + std::to_string(i) + ".1";
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(Ipv4Address(address.c_str()), Ipv4Mask("/24")));
+        ipv4->SetUp(ifIndex);
+    }
+
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    m_routing = ipv4RoutingHelper.GetStaticRouting(ipv4);
+    // the routes to the networks of the two interfaces are the first routes of the table
+    const uint32_t nInterfaceRoutes = m_routing->GetNRoutes();
+
+    m_routing->AddNetworkRouteTo(Ipv4Address("10.0.0.0"),
+                                 Ipv4Mask("/8"),
+                                 Ipv4Address("192.168.1.8"),
+                                 1);
+    m_routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                                 Ipv4Mask("/16"),
+                                 Ipv4Address("192.168.1.16"),
+                                 1,
+                                 1);
+    CheckGateway("10.1.2.3", "192.168.1.16");
+    CheckGateway("10.2.2.3", "192.168.1.8");
+    CheckGateway("11.2.2.3", "0.0.0.0");
+
+    // a default route matches all the destinations
+    m_routing->SetDefaultRoute(Ipv4Address("192.168.2.254"), 2);
+    CheckGateway("11.2.2.3", "192.168.2.254");
+
+    // the route with the lowest metric is selected, and the last one in case of tie
+    m_routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                                 Ipv4Mask("/16"),
+                                 Ipv4Address("192.168.2.16"),
+                                 2,
+                                 2);
+    CheckGateway("10.1.2.3", "192.168.1.16");
+    m_routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                                 Ipv4Mask("/16"),
+                                 Ipv4Address("192.168.2.17"),
+                                 2,
+                                 1);
+    CheckGateway("10.1.2.3", "192.168.2.17");
+    // a route on the requested interface is selected
+    CheckGateway("10.1.2.3", "192.168.1.16", devices[0]);
+    CheckGateway("10.2.2.3", "192.168.2.254", devices[1]);
+
+    // the first /32 route is selected
+    m_routing->AddHostRouteTo(Ipv4Address("10.1.2.3"), Ipv4Address("192.168.1.32"), 1, 5);
+    m_routing->AddHostRouteTo(Ipv4Address("10.1.2.3"), Ipv4Address("192.168.1.33"), 1, 1);
+    CheckGateway("10.1.2.3", "192.168.1.32");
+    CheckGateway("10.1.2.4", "192.168.2.17");
+
+    // many host routes, and the removal of the routes
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        m_routing->AddHostRouteTo(Ipv4Address(0x0b000000 + i),
+                                  Ipv4Address(0xc0a80200 + i % 200),
+                                  2);
+    }
+    CheckGateway("11.0.7.1", "192.168.2.193");
+    CheckGateway("11.0.7.208", "192.168.2.254");
+    // remove the /8 route, then the host routes to 10.1.2.3
+    m_routing->RemoveRoute(nInterfaceRoutes);
+    CheckGateway("10.2.2.3", "192.168.2.254");
+    for (uint32_t i = m_routing->GetNRoutes(); i-- > 0;)
+    {
+        if (m_routing->GetRoute(i).GetDest() == Ipv4Address("10.1.2.3"))
+        {
+            m_routing->RemoveRoute(i);
+        }
+    }
+    CheckGateway("10.1.2.3", "192.168.2.17");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 StaticRouting TestSuite
  */
 class Ipv4StaticRoutingTestSuite : public TestSuite
 {
@@ -211,6 +359,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLongestPrefixMatchTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mobility-grid.h"
+
+#include "mobility-model.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityGrid");
+
+MobilityGrid::MobilityGrid(double cellSize)
+    : m_cellSize(cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The cell size must be positive");
+}
+
+MobilityGrid::~MobilityGrid()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [ptr, tracked] : m_tracked)
+    {
+        tracked.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid::CourseChanged, this));
+    }
+}
+
+double
+MobilityGrid::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+std::size_t
+MobilityGrid::GetNItems() const
+{
+    return m_items.size();
+}
+
+int32_t
+MobilityGrid::GetCellIndex(double coordinate) const
+{
+    const double index = std::floor(coordinate / m_cellSize);
+    return static_cast<int32_t>(std::clamp<double>(index,
+                                                   std::numeric_limits<int32_t>::min(),
+                                                   std::numeric_limits<int32_t>::max()));
+}
+
+uint64_t
+MobilityGrid::GetCellKey(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t
+MobilityGrid::Add(MobilityCallback getMobility)
+{
+    NS_LOG_FUNCTION(this);
+    const auto index = m_nextIndex++;
+    auto& item = m_items[index];
+    item.getMobility = getMobility;
+    Track(index, item);
+    return index;
+}
+
+void
+MobilityGrid::Remove(uint64_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    auto it = m_items.find(index);
+    if (it == m_items.end())
+    {
+        return;
+    }
+    const auto& item = it->second;
+    if (!item.mobility)
+    {
+        m_untracked.erase(index);
+    }
+    else
+    {
+        Unplace(index, item);
+        auto trackedIt = m_tracked.find(PeekPointer(item.mobility));
+        NS_ASSERT(trackedIt != m_tracked.end());
+        auto& indexes = trackedIt->second.indexes;
+        indexes.erase(std::find(indexes.begin(), indexes.end(), index));
+        if (indexes.empty())
+        {
+            item.mobility->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&MobilityGrid::CourseChanged, this));
+            m_tracked.erase(trackedIt);
+        }
+    }
+    m_items.erase(it);
+}
+
+void
+MobilityGrid::Track(uint64_t index, Item& item)
+{
+    item.mobility = item.getMobility();
+    if (!item.mobility)
+    {
+        NS_LOG_LOGIC("No mobility model for item " << index);
+        m_untracked.insert(index);
+        return;
+    }
+    auto& tracked = m_tracked[PeekPointer(item.mobility)];
+    if (tracked.indexes.empty())
+    {
+        tracked.mobility = item.mobility;
+        item.mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid::CourseChanged, this));
+    }
+    tracked.indexes.push_back(index);
+    Place(index, item);
+}
+
+void
+MobilityGrid::Place(uint64_t index, Item& item)
+{
+    item.moving = (item.mobility->GetVelocity().GetLength() > 0);
+    if (item.moving)
+    {
+        NS_LOG_LOGIC("Item " << index << " is moving");
+        m_moving.insert(index);
+        return;
+    }
+    item.position = item.mobility->GetPosition();
+    item.cell = GetCellKey(GetCellIndex(item.position.x), GetCellIndex(item.position.y));
+    NS_LOG_LOGIC("Item " << index << " at " << item.position);
+    m_cells[item.cell].push_back(index);
+}
+
+void
+MobilityGrid::Unplace(uint64_t index, const Item& item)
+{
+    if (item.moving)
+    {
+        m_moving.erase(index);
+        return;
+    }
+    auto cellIt = m_cells.find(item.cell);
+    NS_ASSERT(cellIt != m_cells.end());
+    auto& indexes = cellIt->second;
+    indexes.erase(std::find(indexes.begin(), indexes.end(), index));
+    if (indexes.empty())
+    {
+        m_cells.erase(cellIt);
+    }
+}
+
+void
+MobilityGrid::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto trackedIt = m_tracked.find(PeekPointer(mobility));
+    if (trackedIt == m_tracked.end())
+    {
+        return;
+    }
+    for (auto index : trackedIt->second.indexes)
+    {
+        auto& item = m_items.at(index);
+        Unplace(index, item);
+        Place(index, item);
+    }
+}
+
+void
+MobilityGrid::AddInRange(const std::vector<uint64_t>& cellIndexes,
+                         const Vector& position,
+                         double range,
+                         std::vector<uint64_t>& indexes) const
+{
+    for (auto index : cellIndexes)
+    {
+        if (CalculateDistance(m_items.at(index).position, position) <= range)
+        {
+            indexes.push_back(index);
+        }
+    }
+}
+
+std::vector<uint64_t>
+MobilityGrid::GetCandidates(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+
+    // the MobilityModel of an item may have been aggregated after it was added
+    for (auto it = m_untracked.begin(); it != m_untracked.end();)
+    {
+        auto& item = m_items.at(*it);
+        if (item.getMobility())
+        {
+            const auto index = *it;
+            it = m_untracked.erase(it);
+            Track(index, item);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    std::vector<uint64_t> indexes(m_untracked.begin(), m_untracked.end());
+    const auto span = std::ceil(range / m_cellSize);
+    if ((2 * span + 1) * (2 * span + 1) > m_cells.size())
+    {
+        // the range covers more cells than the occupied ones, check all of them
+        for (const auto& [key, cellIndexes] : m_cells)
+        {
+            AddInRange(cellIndexes, position, range, indexes);
+        }
+    }
+    else
+    {
+        const auto cx = GetCellIndex(position.x);
+        const auto cy = GetCellIndex(position.y);
+        const auto s = static_cast<int64_t>(span);
+        const auto minX = std::max<int64_t>(cx - s, std::numeric_limits<int32_t>::min());
+        const auto maxX = std::min<int64_t>(cx + s, std::numeric_limits<int32_t>::max());
+        const auto minY = std::max<int64_t>(cy - s, std::numeric_limits<int32_t>::min());
+        const auto maxY = std::min<int64_t>(cy + s, std::numeric_limits<int32_t>::max());
+        for (auto x = minX; x <= maxX; ++x)
+        {
+            for (auto y = minY; y <= maxY; ++y)
+            {
+                if (auto cellIt = m_cells.find(GetCellKey(x, y)); cellIt != m_cells.end())
+                {
+                    AddInRange(cellIt->second, position, range, indexes);
+                }
+            }
+        }
+    }
+    for (auto index : m_moving)
+    {
+        if (CalculateDistance(m_items.at(index).mobility->GetPosition(), position) <= range)
+        {
+            indexes.push_back(index);
+        }
+    }
+    std::sort(indexes.begin(), indexes.end());
+    NS_LOG_LOGIC(indexes.size() << " candidates out of " << m_items.size() << " items");
+    return indexes;
+}
+
+} // namespace ns3
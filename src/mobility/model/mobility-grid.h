@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MOBILITY_GRID_H
+#define MOBILITY_GRID_H
+
+#include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Uniform grid index of the positions of a set of items
+ *
+ * The grid is used by the channels to find the receivers which are within a
+ * maximum range of a transmitter without evaluating the propagation models
+ * for all the receivers (see SpectrumReceiverGrid and YansWifiChannel).
+ *
+ * The items are identified by the index returned when they are added, and
+ * their MobilityModel is obtained with a callback, so that a MobilityModel
+ * aggregated after the item was added is taken into account.
+ *
+ * The items are indexed by the square cell of the XY plane holding their
+ * position. The index is updated whenever the CourseChange trace source of
+ * their MobilityModel fires. An item whose velocity is not zero keeps
+ * moving without notification, hence it is not indexed by cell: its current
+ * position is checked at each lookup. Items without a MobilityModel are
+ * always returned by the lookups, and are indexed as soon as their
+ * MobilityModel becomes available.
+ */
+class MobilityGrid : public SimpleRefCount<MobilityGrid>
+{
+  public:
+    /// Callback returning the MobilityModel of an item, or nullptr if it is not known yet
+    typedef Callback<Ptr<MobilityModel>> MobilityCallback;
+
+    /**
+     * Constructor
+     *
+     * @param cellSize the length [m] of the side of the cells of the grid
+     */
+    MobilityGrid(double cellSize);
+    ~MobilityGrid();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MobilityGrid(const MobilityGrid&) = delete;
+    MobilityGrid& operator=(const MobilityGrid&) = delete;
+
+    /**
+     * @return the length [m] of the side of the cells of the grid
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add an item to the grid.
+     *
+     * @param getMobility the callback returning the MobilityModel of the item
+     * @return the index of the item, which is the number of items added before it
+     */
+    uint64_t Add(MobilityCallback getMobility);
+
+    /**
+     * Remove an item from the grid, if present.
+     *
+     * @param index the index of the item
+     */
+    void Remove(uint64_t index);
+
+    /**
+     * @return the number of items in the grid
+     */
+    std::size_t GetNItems() const;
+
+    /**
+     * Get the items which may be within the given range of a position, i.e.,
+     * the items whose distance from the position is not larger than the range,
+     * and the items without a MobilityModel.
+     *
+     * @param position the position
+     * @param range the range [m]
+     * @return the indexes of the items, in increasing order
+     */
+    std::vector<uint64_t> GetCandidates(const Vector& position, double range);
+
+  private:
+    /// An item in the grid
+    struct Item
+    {
+        MobilityCallback getMobility; //!< the callback returning its mobility model
+        Ptr<MobilityModel> mobility;  //!< its mobility model, nullptr if not known yet
+        bool moving{false};           //!< whether it was moving at its last course change
+        Vector position;              //!< its position at its last course change, if not moving
+        uint64_t cell{0};             //!< the key of the cell holding it, if not moving
+    };
+
+    /// The items sharing a MobilityModel
+    struct TrackedMobility
+    {
+        Ptr<MobilityModel> mobility;   //!< the mobility model
+        std::vector<uint64_t> indexes; //!< the indexes of the items
+    };
+
+    /**
+     * @param coordinate a coordinate [m]
+     * @return the index of the cells holding the coordinate along an axis
+     */
+    int32_t GetCellIndex(double coordinate) const;
+
+    /**
+     * @param x the index of a cell along the X axis
+     * @param y the index of a cell along the Y axis
+     * @return the key of the cell
+     */
+    static uint64_t GetCellKey(int32_t x, int32_t y);
+
+    /**
+     * Start tracking the course changes of an item, if its MobilityModel is known.
+     *
+     * @param index the index of the item
+     * @param item the item
+     */
+    void Track(uint64_t index, Item& item);
+
+    /**
+     * Insert a tracked item in the cell holding its current position, or
+     * in the set of moving items.
+     *
+     * @param index the index of the item
+     * @param item the item
+     */
+    void Place(uint64_t index, Item& item);
+
+    /**
+     * Remove a tracked item from its cell or from the set of moving items.
+     *
+     * @param index the index of the item
+     * @param item the item
+     */
+    void Unplace(uint64_t index, const Item& item);
+
+    /**
+     * Append the indexes of the items of a cell which are within range of a position.
+     *
+     * @param cellIndexes the indexes of the items of the cell
+     * @param position the position
+     * @param range the range [m]
+     * @param indexes the vector to which the indexes are appended
+     */
+    void AddInRange(const std::vector<uint64_t>& cellIndexes,
+                    const Vector& position,
+                    double range,
+                    std::vector<uint64_t>& indexes) const;
+
+    /**
+     * Update the items using a MobilityModel whose course changed.
+     *
+     * @param mobility the MobilityModel
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                           //!< length of the cell side [m]
+    uint64_t m_nextIndex{0};                                     //!< index of the next item
+    std::map<uint64_t, Item> m_items;                            //!< items, by index
+    std::unordered_map<uint64_t, std::vector<uint64_t>> m_cells; //!< indexes of items, by cell
+    std::set<uint64_t> m_moving;                                 //!< indexes of moving items
+    std::set<uint64_t> m_untracked;                              //!< items with no mobility
+    std::map<const MobilityModel*, TrackedMobility> m_tracked;   //!< tracked mobility models
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_H */
@@ -10,6 +10,9 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <array>
+#include <bit>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -43,46 +46,187 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
+bool Buffer::g_poolEnabled = true;
+#else
+bool Buffer::g_poolEnabled = false;
+#endif
+uint32_t Buffer::g_maxBuffersPerClass = 1024;
+bool Buffer::g_chainingEnabled = false;
+uint64_t Buffer::g_maxPoolBytes = 32 * 1024 * 1024;
+
+namespace
+{
+
+/// log2 of Buffer::MIN_POOLED_SIZE
+constexpr uint32_t MIN_POOLED_SHIFT = 7;
+/// log2 of Buffer::MAX_POOLED_SIZE
+constexpr uint32_t MAX_POOLED_SHIFT = 17;
+/// log2 of the capacity above which the size classes are finer than powers of two
+constexpr uint32_t FINE_POOLED_SHIFT = 12;
+/// log2 of the number of fine size classes between two powers of two
+constexpr uint32_t FINE_STEPS_SHIFT = 2;
+/// Number of size classes, from Buffer::MIN_POOLED_SIZE to Buffer::MAX_POOLED_SIZE
+constexpr uint32_t POOL_SIZE_CLASSES = FINE_POOLED_SHIFT - MIN_POOLED_SHIFT +
+                                       ((MAX_POOLED_SHIFT - FINE_POOLED_SHIFT) << FINE_STEPS_SHIFT) +
+                                       1;
+
+static_assert((1U << MIN_POOLED_SHIFT) == Buffer::MIN_POOLED_SIZE);
+static_assert((1U << MAX_POOLED_SHIFT) == Buffer::MAX_POOLED_SIZE);
+
+/**
+ * @ingroup packet
+ * @brief Round a capacity up to a size class.
+ *
+ * Up to 4 KiB, the size classes are powers of two, which leave room for
+ * the buffer to grow in place. Above, there are four size classes evenly
+ * spaced between two consecutive powers of two (e.g., 4 KiB, 5 KiB, 6 KiB
+ * and 7 KiB), so that a large capacity is rounded up by less than 25%.
+ *
+ * @param size the capacity, at most MAX_POOLED_SIZE
+ * @returns the capacity of the size class
  */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
+inline uint32_t
+GetPooledSize(uint32_t size)
 {
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
+    if (size <= Buffer::MIN_POOLED_SIZE)
+    {
+        return Buffer::MIN_POOLED_SIZE;
+    }
+    uint32_t log2 = std::bit_width(size - 1) - 1;
+    if (log2 < FINE_POOLED_SHIFT)
+    {
+        return std::bit_ceil(size);
+    }
+    uint32_t step = 1U << (log2 - FINE_STEPS_SHIFT);
+    return (size + step - 1) & ~(step - 1);
+}
+
+/**
+ * @ingroup packet
+ * @brief Get the size class of a pooled capacity.
+ * @param size the capacity, as returned by GetPooledSize()
+ * @returns the index of the size class
+ */
+inline uint32_t
+GetSizeClass(uint32_t size)
+{
+    uint32_t log2 = std::bit_width(size) - 1;
+    if (size <= (1U << FINE_POOLED_SHIFT))
+    {
+        return log2 - MIN_POOLED_SHIFT;
+    }
+    uint32_t mantissa = size >> (log2 - FINE_STEPS_SHIFT);
+    return FINE_POOLED_SHIFT - MIN_POOLED_SHIFT + ((log2 - FINE_POOLED_SHIFT) << FINE_STEPS_SHIFT) +
+           mantissa - (1U << FINE_STEPS_SHIFT);
+}
+
+} // namespace
+
+/**
+ * The pool of a thread is created on demand, and destroyed with the thread.
+ * The buffer data recycled by a thread after the destruction of its pool
+ * (e.g., by static destructors) are freed.
+ */
+struct Buffer::Pool
+{
+    ~Pool()
+    {
+        Clear();
+    }
+
+    /// Free all the buffer data held by the pool.
+    void Clear()
+    {
+        for (auto& freeList : freeLists)
+        {
+            for (auto data : freeList)
+            {
+                Buffer::Deallocate(data);
+            }
+            freeList.clear();
+        }
+        stats.buffersHeld = 0;
+        stats.bytesHeld = 0;
+    }
+
+    std::array<std::vector<Buffer::Data*>, POOL_SIZE_CLASSES> freeLists; //!< Free lists
+    Buffer::PoolStats stats{};                                             //!< Statistics
+};
+
+Buffer::Pool*
+Buffer::GetPool()
+{
+    /// Pool of the current thread, or nullptr
+    static thread_local Pool* t_pool = nullptr;
+    /// Whether the pool of the current thread was destroyed
+    static thread_local bool t_poolDestroyed = false;
+
+    if (t_pool != nullptr)
     {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
+        return t_pool;
+    }
+    if (t_poolDestroyed)
+    {
+        return nullptr;
+    }
+
+    /// Owner of the pool of a thread, which clears t_pool when the thread exits
+    struct PoolOwner
+    {
+        PoolOwner()
+        {
+            t_pool = &pool;
+        }
+
+        ~PoolOwner()
         {
-            Buffer::Deallocate(*i);
+            t_pool = nullptr;
+            t_poolDestroyed = true;
         }
-        delete g_freeList;
-        g_freeList = DESTROYED;
+
+        Pool pool; //!< The pool
+    };
+
+    static thread_local PoolOwner owner;
+    return t_pool;
+}
+
+void
+Buffer::SetPoolEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(enabled);
+    g_poolEnabled = enabled;
+    if (!enabled)
+    {
+        ClearPool();
+    }
+}
+
+void
+Buffer::SetPoolLimits(uint32_t maxBuffersPerClass, uint64_t maxBytes)
+{
+    NS_LOG_FUNCTION(maxBuffersPerClass << maxBytes);
+    g_maxBuffersPerClass = maxBuffersPerClass;
+    g_maxPoolBytes = maxBytes;
+}
+
+Buffer::PoolStats
+Buffer::GetPoolStats()
+{
+    Pool* pool = GetPool();
+    return pool != nullptr ? pool->stats : PoolStats{};
+}
+
+void
+Buffer::ClearPool()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Pool* pool = GetPool();
+    if (pool != nullptr)
+    {
+        pool->Clear();
     }
 }
 
@@ -91,65 +235,65 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    Pool* pool = GetPool();
+    if (!g_poolEnabled || pool == nullptr || data->m_size > MAX_POOLED_SIZE ||
+        GetPooledSize(data->m_size) != data->m_size)
     {
         Buffer::Deallocate(data);
+        return;
     }
-    else
+    auto& freeList = pool->freeLists[GetSizeClass(data->m_size)];
+    if (freeList.size() >= g_maxBuffersPerClass ||
+        pool->stats.bytesHeld + data->m_size > g_maxPoolBytes)
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        pool->stats.releases++;
+        Buffer::Deallocate(data);
+        return;
     }
+    freeList.push_back(data);
+    pool->stats.buffersHeld++;
+    pool->stats.bytesHeld += data->m_size;
 }
 
 Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
+    uint32_t size = GetAllocationSize(dataSize);
+    Pool* pool = g_poolEnabled ? GetPool() : nullptr;
+    if (pool != nullptr && size <= MAX_POOLED_SIZE)
     {
-        while (!g_freeList->empty())
+        auto& freeList = pool->freeLists[GetSizeClass(size)];
+        if (!freeList.empty())
         {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
+            Buffer::Data* data = freeList.back();
+            freeList.pop_back();
+            NS_ASSERT(data->m_size == size);
+            data->m_count = 1;
+            pool->stats.hits++;
+            pool->stats.buffersHeld--;
+            pool->stats.bytesHeld -= size;
+            return data;
         }
+        pool->stats.misses++;
     }
     Buffer::Data* data = Buffer::Allocate(dataSize);
     NS_ASSERT(data->m_count == 1);
     return data;
 }
-#else  /* BUFFER_FREE_LIST */
-void
-Buffer::Recycle(Buffer::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
-}
 
-Buffer::Data*
-Buffer::Create(uint32_t size)
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+
+uint32_t
+Buffer::GetAllocationSize(uint32_t reqSize)
 {
-    NS_LOG_FUNCTION(size);
-    return Allocate(size);
+    uint32_t size = std::max(reqSize, 1U) + ALLOC_OVER_PROVISION;
+    if (g_poolEnabled && size <= MAX_POOLED_SIZE)
+    {
+        return GetPooledSize(size);
+    }
+    return size;
 }
-#endif /* BUFFER_FREE_LIST */
-
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
 Buffer::Data*
 Buffer::Allocate(uint32_t reqSize)
@@ -160,7 +304,7 @@ Buffer::Allocate(uint32_t reqSize)
         reqSize = 1;
     }
     NS_ASSERT(reqSize >= 1);
-    reqSize += ALLOC_OVER_PROVISION;
+    reqSize = GetAllocationSize(reqSize);
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
     auto b = new uint8_t[size];
     auto data = reinterpret_cast<Buffer::Data*>(b);
@@ -179,18 +323,21 @@ Buffer::Deallocate(Buffer::Data* data)
 }
 
 Buffer::Buffer()
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this);
     Initialize(0);
 }
 
 Buffer::Buffer(uint32_t dataSize)
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this << dataSize);
     Initialize(dataSize);
 }
 
 Buffer::Buffer(uint32_t dataSize, bool initialize)
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this << dataSize << initialize);
     if (initialize)
@@ -199,6 +346,111 @@ Buffer::Buffer(uint32_t dataSize, bool initialize)
     }
 }
 
+void
+Buffer::SetChainingEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(enabled);
+    g_chainingEnabled = enabled;
+}
+
+uint32_t
+Buffer::GetSegmentCount() const
+{
+    return 1 + (m_chain != nullptr ? m_chain->m_segments.size() : 0);
+}
+
+Buffer::Chain*
+Buffer::GetWritableChain()
+{
+    if (m_chain == nullptr)
+    {
+        m_chain = new Chain{1, 0, {}};
+    }
+    else if (m_chain->m_count > 1)
+    {
+        // copy on write
+        m_chain->m_count--;
+        m_chain = new Chain{1, m_chain->m_size, m_chain->m_segments};
+    }
+    return m_chain;
+}
+
+void
+Buffer::ReleaseChain()
+{
+    if (m_chain != nullptr)
+    {
+        m_chain->m_count--;
+        if (m_chain->m_count == 0)
+        {
+            delete m_chain;
+        }
+        m_chain = nullptr;
+    }
+}
+
+Buffer
+Buffer::GetHead() const
+{
+    Buffer head(0, false);
+    head.m_data = m_data;
+    head.m_data->m_count++;
+    head.m_maxZeroAreaStart = m_maxZeroAreaStart;
+    head.m_zeroAreaStart = m_zeroAreaStart;
+    head.m_zeroAreaEnd = m_zeroAreaEnd;
+    head.m_start = m_start;
+    head.m_end = m_end;
+    return head;
+}
+
+void
+Buffer::SetHead(const Buffer& head)
+{
+    NS_ASSERT(head.m_chain == nullptr);
+    head.m_data->m_count++;
+    m_data->m_count--;
+    if (m_data->m_count == 0)
+    {
+        Recycle(m_data);
+    }
+    m_data = head.m_data;
+    g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
+    m_maxZeroAreaStart = head.m_maxZeroAreaStart;
+    m_zeroAreaStart = head.m_zeroAreaStart;
+    m_zeroAreaEnd = head.m_zeroAreaEnd;
+    m_start = head.m_start;
+    m_end = head.m_end;
+}
+
+void
+Buffer::PopFrontSegment()
+{
+    NS_ASSERT(m_chain != nullptr);
+    Chain* chain = GetWritableChain();
+    Buffer segment = chain->m_segments.front();
+    chain->m_segments.erase(chain->m_segments.begin());
+    chain->m_size -= segment.GetSize();
+    if (chain->m_segments.empty())
+    {
+        ReleaseChain();
+    }
+    SetHead(segment);
+}
+
+bool
+Buffer::CanAddAtStartInPlace(uint32_t start) const
+{
+    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+    return m_start >= start && !isDirty;
+}
+
+bool
+Buffer::CanAddAtEndInPlace(uint32_t end) const
+{
+    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+    return GetInternalEnd() + end <= m_data->m_size && !isDirty;
+}
+
 bool
 Buffer::CheckInternalState() const
 {
@@ -237,7 +489,8 @@ void
 Buffer::Initialize(uint32_t zeroSize)
 {
     NS_LOG_FUNCTION(this << zeroSize);
-    m_data = Buffer::Create(0);
+    // reserve room for the headers usually added in front of the buffer
+    m_data = Buffer::Create(g_recommendedStart);
     m_start = std::min(m_data->m_size, g_recommendedStart);
     m_maxZeroAreaStart = m_start;
     m_zeroAreaStart = m_start;
@@ -263,6 +516,15 @@ Buffer::operator=(const Buffer& o)
         m_data = o.m_data;
         m_data->m_count++;
     }
+    if (m_chain != o.m_chain)
+    {
+        if (o.m_chain != nullptr)
+        {
+            o.m_chain->m_count++;
+        }
+        ReleaseChain();
+        m_chain = o.m_chain;
+    }
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
     m_maxZeroAreaStart = o.m_maxZeroAreaStart;
     m_zeroAreaStart = o.m_zeroAreaStart;
@@ -283,6 +545,7 @@ Buffer::~Buffer()
     {
         Recycle(m_data);
     }
+    ReleaseChain();
 }
 
 uint32_t
@@ -304,8 +567,24 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
-    if (m_start >= start && !isDirty)
+    if (g_chainingEnabled && !CanAddAtStartInPlace(start) &&
+        GetInternalSize() >= MIN_CHAINED_SIZE && GetSegmentCount() < MAX_SEGMENTS)
+    {
+        /* start a new head instead of copying the data of the current one,
+         * which becomes the first segment of the chain.
+         */
+        Buffer head;
+        head.AddAtStart(start);
+        Buffer segment = GetHead();
+        Chain* chain = GetWritableChain();
+        chain->m_segments.insert(chain->m_segments.begin(), segment);
+        chain->m_size += segment.GetSize();
+        SetHead(head);
+        LOG_INTERNAL_STATE("chain start=" << start << ", ");
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    if (CanAddAtStartInPlace(start))
     {
         /* enough space in the buffer and not dirty.
          * To add: |..|
@@ -350,8 +629,37 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
-    if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
+    if (m_chain != nullptr)
+    {
+        Chain* chain = GetWritableChain();
+        const Buffer& last = chain->m_segments.back();
+        if (g_chainingEnabled && end > 0 && !last.CanAddAtEndInPlace(end) &&
+            last.GetInternalSize() >= MIN_CHAINED_SIZE && GetSegmentCount() < MAX_SEGMENTS)
+        {
+            Buffer segment;
+            segment.AddAtEnd(end);
+            chain->m_segments.push_back(segment);
+        }
+        else
+        {
+            chain->m_segments.back().AddAtEnd(end);
+        }
+        chain->m_size += end;
+        return;
+    }
+    if (g_chainingEnabled && end > 0 && !CanAddAtEndInPlace(end) &&
+        GetInternalSize() >= MIN_CHAINED_SIZE)
+    {
+        /* start a new segment instead of copying the data of the head. */
+        Buffer segment;
+        segment.AddAtEnd(end);
+        Chain* chain = GetWritableChain();
+        chain->m_segments.push_back(segment);
+        chain->m_size += end;
+        LOG_INTERNAL_STATE("chain end=" << end << ", ");
+        return;
+    }
+    if (CanAddAtEndInPlace(end))
     {
         /* enough space in buffer and not dirty
          * Add:    |...|
@@ -396,7 +704,33 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+    if (g_chainingEnabled && o.GetSize() >= MIN_CHAINED_SIZE &&
+        GetSegmentCount() + o.GetSegmentCount() <= MAX_SEGMENTS)
+    {
+        /* append the segments of the other buffer, which may be this one. */
+        Buffer other = o;
+        Chain* chain = GetWritableChain();
+        if (other.m_end > other.m_start)
+        {
+            chain->m_segments.push_back(other.GetHead());
+        }
+        if (other.m_chain != nullptr)
+        {
+            chain->m_segments.insert(chain->m_segments.end(),
+                                     other.m_chain->m_segments.begin(),
+                                     other.m_chain->m_segments.end());
+        }
+        chain->m_size += other.GetSize();
+        if (chain->m_segments.empty())
+        {
+            ReleaseChain();
+        }
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    if (m_chain == nullptr && o.m_chain == nullptr && m_data->m_count == 1 &&
+        (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
         m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
         o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
@@ -437,6 +771,11 @@ Buffer::RemoveAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+    while (m_chain != nullptr && start >= m_end - m_start)
+    {
+        start -= m_end - m_start;
+        PopFrontSegment();
+    }
     uint32_t newStart = m_start + start;
     if (newStart <= m_zeroAreaStart)
     {
@@ -483,6 +822,26 @@ Buffer::RemoveAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+    while (m_chain != nullptr && end > 0)
+    {
+        Chain* chain = GetWritableChain();
+        Buffer& last = chain->m_segments.back();
+        uint32_t size = std::min(end, last.GetSize());
+        chain->m_size -= size;
+        end -= size;
+        if (size == last.GetSize())
+        {
+            chain->m_segments.pop_back();
+            if (chain->m_segments.empty())
+            {
+                ReleaseChain();
+            }
+        }
+        else
+        {
+            last.RemoveAtEnd(size);
+        }
+    }
     uint32_t newEnd = m_end - std::min(end, m_end - m_start);
     if (newEnd > m_zeroAreaEnd)
     {
@@ -531,6 +890,14 @@ Buffer::CreateFullCopy() const
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        Buffer tmp;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        NS_ASSERT(tmp.CheckInternalState());
+        return tmp;
+    }
     if (m_zeroAreaEnd - m_zeroAreaStart != 0)
     {
         Buffer tmp;
@@ -555,6 +922,10 @@ uint32_t
 Buffer::GetSerializedSize() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_chain != nullptr)
+    {
+        TransformIntoRealBuffer();
+    }
     uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
     uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -571,6 +942,10 @@ uint32_t
 Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    if (m_chain != nullptr)
+    {
+        TransformIntoRealBuffer();
+    }
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -643,6 +1018,7 @@ Buffer::Deserialize(const uint8_t* buffer, uint32_t size)
     sizeCheck -= 4;
 
     // Create zero bytes
+    ReleaseChain();
     Initialize(zeroDataLength);
 
     // Add start data
@@ -700,6 +1076,19 @@ void
 Buffer::CopyData(std::ostream* os, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &os << size);
+    if (m_chain != nullptr)
+    {
+        uint32_t tmpsize = std::min(m_end - m_start, size);
+        GetHead().CopyData(os, tmpsize);
+        size -= tmpsize;
+        for (const auto& segment : m_chain->m_segments)
+        {
+            tmpsize = std::min(segment.GetSize(), size);
+            segment.CopyData(os, tmpsize);
+            size -= tmpsize;
+        }
+        return;
+    }
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
@@ -730,6 +1119,19 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &buffer << size);
     uint32_t originalSize = size;
+    if (m_chain != nullptr)
+    {
+        uint32_t copied = GetHead().CopyData(buffer, size);
+        buffer += copied;
+        size -= copied;
+        for (const auto& segment : m_chain->m_segments)
+        {
+            copied = segment.CopyData(buffer, size);
+            buffer += copied;
+            size -= copied;
+        }
+        return originalSize - size;
+    }
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
@@ -767,6 +1169,12 @@ uint32_t
 Buffer::Iterator::GetDistanceFrom(const Iterator& o) const
 {
     NS_LOG_FUNCTION(this << &o);
+    if (m_buffer != nullptr || o.m_buffer != nullptr)
+    {
+        NS_ASSERT(m_buffer == o.m_buffer);
+        int64_t diff = static_cast<int64_t>(GetPosition()) - o.GetPosition();
+        return diff < 0 ? -diff : diff;
+    }
     NS_ASSERT(m_data == o.m_data);
     int32_t diff = m_current - o.m_current;
     if (diff < 0)
@@ -783,6 +1191,10 @@ bool
 Buffer::Iterator::IsEnd() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_buffer != nullptr)
+    {
+        return GetPosition() == m_buffer->GetSize();
+    }
     return m_current == m_dataEnd;
 }
 
@@ -790,6 +1202,10 @@ bool
 Buffer::Iterator::IsStart() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_buffer != nullptr)
+    {
+        return GetPosition() == 0;
+    }
     return m_current == m_dataStart;
 }
 
@@ -808,38 +1224,187 @@ Buffer::Iterator::Check(uint32_t i) const
     return i >= m_dataStart && !(i >= m_zeroStart && i < m_zeroEnd) && i <= m_dataEnd;
 }
 
+uint32_t
+Buffer::Iterator::GetPosition() const
+{
+    return m_offset + m_current - m_dataStart;
+}
+
+void
+Buffer::Iterator::LoadSegment(uint32_t segment)
+{
+    // the buffer must not have been flattened since the iterator was created
+    NS_ASSERT_MSG(m_buffer != nullptr && m_buffer->m_chain != nullptr &&
+                      segment <= m_buffer->m_chain->m_segments.size(),
+                  "Iterator used after its buffer was modified");
+    const Buffer* buffer =
+        segment == 0 ? m_buffer : &m_buffer->m_chain->m_segments[segment - 1];
+    m_zeroStart = buffer->m_zeroAreaStart;
+    m_zeroEnd = buffer->m_zeroAreaEnd;
+    m_dataStart = buffer->m_start;
+    m_dataEnd = buffer->m_end;
+    m_data = buffer->m_data->m_data;
+    m_segment = segment;
+}
+
+void
+Buffer::Iterator::NextSegment()
+{
+    NS_ASSERT(m_buffer != nullptr && m_current == m_dataEnd);
+    if (m_segment < m_buffer->m_chain->m_segments.size())
+    {
+        m_offset += m_dataEnd - m_dataStart;
+        LoadSegment(m_segment + 1);
+        m_current = m_dataStart;
+    }
+}
+
+uint8_t
+Buffer::Iterator::SlowPeekU8()
+{
+    NextSegment();
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current < m_dataEnd, GetReadErrorMessage());
+    if (m_current < m_zeroStart)
+    {
+        return m_data[m_current];
+    }
+    else if (m_current < m_zeroEnd)
+    {
+        return 0;
+    }
+    return m_data[m_current - (m_zeroEnd - m_zeroStart)];
+}
+
+void
+Buffer::Iterator::PrevSegment()
+{
+    NS_ASSERT(m_buffer != nullptr && m_current == m_dataStart);
+    if (m_segment > 0)
+    {
+        LoadSegment(m_segment - 1);
+        m_offset -= m_dataEnd - m_dataStart;
+        m_current = m_dataEnd;
+    }
+}
+
+void
+Buffer::Iterator::SlowNext(uint32_t delta)
+{
+    NS_LOG_FUNCTION(this << delta);
+    while (m_current + delta > m_dataEnd && m_segment < m_buffer->m_chain->m_segments.size())
+    {
+        delta -= m_dataEnd - m_current;
+        m_current = m_dataEnd;
+        NextSegment();
+    }
+    NS_ASSERT(m_current + delta <= m_dataEnd);
+    m_current += delta;
+}
+
+void
+Buffer::Iterator::SlowPrev(uint32_t delta)
+{
+    NS_LOG_FUNCTION(this << delta);
+    while (m_current < m_dataStart + delta && m_segment > 0)
+    {
+        delta -= m_current - m_dataStart;
+        m_current = m_dataStart;
+        PrevSegment();
+    }
+    NS_ASSERT(m_current >= m_dataStart + delta);
+    m_current -= delta;
+}
+
+void
+Buffer::Iterator::SlowWriteU8(uint8_t data, uint32_t len)
+{
+    NS_LOG_FUNCTION(this << data << len);
+    while (len > 0)
+    {
+        if (m_current == m_dataEnd)
+        {
+            NextSegment();
+        }
+        uint32_t toWrite = std::min(len, m_dataEnd - m_current);
+        NS_ASSERT_MSG(toWrite > 0, GetWriteErrorMessage());
+        WriteU8(data, toWrite);
+        len -= toWrite;
+    }
+}
+
 void
 Buffer::Iterator::Write(Iterator start, Iterator end)
 {
     NS_LOG_FUNCTION(this << &start << &end);
-    NS_ASSERT(start.m_data == end.m_data);
-    NS_ASSERT(start.m_current <= end.m_current);
-    NS_ASSERT(start.m_zeroStart == end.m_zeroStart);
-    NS_ASSERT(start.m_zeroEnd == end.m_zeroEnd);
-    NS_ASSERT(m_data != start.m_data);
-    uint32_t size = end.m_current - start.m_current;
+    if (m_buffer == nullptr && start.m_buffer == nullptr)
+    {
+        NS_ASSERT(start.m_data == end.m_data);
+        NS_ASSERT(start.m_current <= end.m_current);
+        NS_ASSERT(start.m_zeroStart == end.m_zeroStart);
+        NS_ASSERT(start.m_zeroEnd == end.m_zeroEnd);
+        NS_ASSERT(m_data != start.m_data);
+        WriteSegment(start, end.m_current - start.m_current);
+        return;
+    }
+    NS_ASSERT(start.m_buffer == end.m_buffer);
+    NS_ASSERT(start.GetPosition() <= end.GetPosition());
+    uint32_t size = end.GetPosition() - start.GetPosition();
+    while (size > 0)
+    {
+        if (start.m_buffer != nullptr && start.m_current == start.m_dataEnd)
+        {
+            start.NextSegment();
+        }
+        if (m_buffer != nullptr && m_current == m_dataEnd)
+        {
+            NextSegment();
+        }
+        uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
+        if (m_buffer != nullptr)
+        {
+            toCopy = std::min(toCopy, m_dataEnd - m_current);
+        }
+        NS_ASSERT_MSG(toCopy > 0, GetWriteErrorMessage());
+        WriteSegment(start, toCopy);
+        start.m_current += toCopy;
+        size -= toCopy;
+    }
+}
+
+void
+Buffer::Iterator::WriteSegment(Iterator start, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << &start << size);
+    NS_ASSERT(start.m_current + size <= start.m_dataEnd);
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
-    uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
-    memcpy(to, from, toCopy);
-    m_current += toCopy;
+    memcpy(to, from, size);
 }
 
 void
@@ -935,6 +1500,22 @@ void
 Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    if (m_buffer != nullptr && m_current + size > m_dataEnd)
+    {
+        while (size > 0)
+        {
+            if (m_current == m_dataEnd)
+            {
+                NextSegment();
+            }
+            uint32_t toWrite = std::min(size, m_dataEnd - m_current);
+            NS_ASSERT_MSG(toWrite > 0, GetWriteErrorMessage());
+            Write(buffer, toWrite);
+            buffer += toWrite;
+            size -= toWrite;
+        }
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, size), GetWriteErrorMessage());
     uint8_t* to;
     if (m_current <= m_zeroStart)
@@ -1153,6 +1734,10 @@ uint32_t
 Buffer::Iterator::GetSize() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_buffer != nullptr)
+    {
+        return m_buffer->GetSize();
+    }
     return m_dataEnd - m_dataStart;
 }
 
@@ -1160,6 +1745,10 @@ uint32_t
 Buffer::Iterator::GetRemainingSize() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_buffer != nullptr)
+    {
+        return m_buffer->GetSize() - GetPosition();
+    }
     return m_dataEnd - m_current;
 }
 
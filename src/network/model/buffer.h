@@ -87,12 +87,42 @@ namespace ns3
  * @endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * The BufferData instances are allocated with a capacity rounded up to
+ * a size class, from MIN_POOLED_SIZE to MAX_POOLED_SIZE bytes: a power of
+ * two up to 4 KiB, and above one of four sizes evenly spaced between two
+ * consecutive powers of two, so that less than 25% of a large buffer data
+ * is wasted. The unused instances are recycled through per-thread free
+ * lists, one per size class.  The number of instances per size class and
+ * the number of bytes held by the free lists of a thread are bounded (see
+ * SetPoolLimits()), and the pool can be disabled with SetPoolEnabled().
+ *
+ * When chaining is enabled with SetChainingEnabled(), a Buffer can also
+ * hold a chain of segments after its own data, the "head" described above,
+ * much like the fragments of a Linux skb. Each segment is a Buffer which
+ * shares its BufferData with the Buffer it was taken from.
+ * AddAtEnd(const Buffer&) then appends the segments of the other Buffer
+ * instead of copying its bytes, and AddAtStart() and AddAtEnd(uint32_t)
+ * start a new segment instead of copying the data of a shared BufferData.
+ * CreateFragment(), RemoveAtStart() and RemoveAtEnd() only adjust the
+ * segments, and Iterator instances walk across the segment boundaries.
+ * The segment boundaries are only tested once an Iterator is past the
+ * zero area of a segment, so the iterators of a buffer without segments
+ * read and write the bytes before the zero area exactly as before.
+ * A Buffer is flattened back into a single BufferData when it would hold
+ * more than MAX_SEGMENTS segments, and by PeekData() and Serialize().
  */
 class Buffer
 {
   public:
     /**
      * @brief iterator in a Buffer instance
+     *
+     * Like the iterators of the standard containers, an Iterator is
+     * invalidated when its Buffer is modified or destroyed. An Iterator of
+     * a Buffer which holds a chain of segments also keeps a pointer to the
+     * Buffer itself, so it must not be used after the Buffer is moved,
+     * e.g., when the Buffer is returned by value or stored in a container.
      */
     class Iterator
     {
@@ -420,6 +450,60 @@ class Buffer
          * @param buffer the buffer this iterator refers to
          */
         inline void Construct(const Buffer* buffer);
+        /**
+         * Load the offsets and data of a segment of a chained buffer.
+         *
+         * @param segment the segment index, 0 for the head of the buffer
+         */
+        void LoadSegment(uint32_t segment);
+        /**
+         * Move from the end of the current segment to the start of the next
+         * one, if any.
+         */
+        void NextSegment();
+        /**
+         * Read the first byte of the next segment of a chained buffer,
+         * after reaching the end of the current segment.
+         *
+         * @returns the byte read
+         */
+        uint8_t SlowPeekU8();
+        /**
+         * Move from the start of the current segment to the end of the
+         * previous one, if any.
+         */
+        void PrevSegment();
+        /**
+         * Go forward across the segments of a chained buffer.
+         *
+         * @param delta number of bytes to go forward
+         */
+        void SlowNext(uint32_t delta);
+        /**
+         * Go backward across the segments of a chained buffer.
+         *
+         * @param delta number of bytes to go backward
+         */
+        void SlowPrev(uint32_t delta);
+        /**
+         * Write data len times across the segments of a chained buffer.
+         *
+         * @param data data to write in buffer
+         * @param len number of times data must be written in buffer
+         */
+        void SlowWriteU8(uint8_t data, uint32_t len);
+        /**
+         * Copy bytes from a single segment of another buffer into the
+         * current segment of this buffer.
+         *
+         * @param start the start of the data to copy
+         * @param size the number of bytes to copy
+         */
+        void WriteSegment(Iterator start, uint32_t size);
+        /**
+         * @returns the offset of the iterator from the start of the buffer
+         */
+        uint32_t GetPosition() const;
         /**
          * Checks that the [start, end) is not in the "virtual zero area".
          *
@@ -499,6 +583,16 @@ class Buffer
          * to this pointer.
          */
         uint8_t* m_data;
+        /**
+         * the buffer if it holds a chain of segments, nullptr otherwise. The
+         * offsets above then refer to the current segment. The buffer must
+         * outlive the iterator and must not be modified or moved meanwhile.
+         */
+        const Buffer* m_buffer;
+        /// index of the current segment, 0 for the head of the buffer
+        uint32_t m_segment;
+        /// offset of the start of the current segment from the start of the buffer
+        uint32_t m_offset;
     };
 
     /**
@@ -660,6 +754,67 @@ class Buffer
     Buffer(uint32_t dataSize, bool initialize);
     ~Buffer();
 
+    /// Statistics of the pool of buffer data of a thread.
+    struct PoolStats
+    {
+        uint64_t hits;        //!< Number of buffer data taken from the pool.
+        uint64_t misses;      //!< Number of buffer data allocated from the system.
+        uint64_t releases;    //!< Number of buffer data freed because the pool was full.
+        uint64_t buffersHeld; //!< Number of buffer data held by the pool.
+        uint64_t bytesHeld;   //!< Number of bytes held by the pool.
+    };
+
+    /// Smallest capacity of a pooled buffer data, in bytes.
+    static constexpr uint32_t MIN_POOLED_SIZE = 128;
+    /// Largest capacity of a pooled buffer data, in bytes.
+    static constexpr uint32_t MAX_POOLED_SIZE = 128 * 1024;
+
+    /**
+     * @brief Enable or disable the pool of buffer data.
+     *
+     * When disabled, the buffer data are allocated with the exact
+     * requested size, and freed as soon as they are unused.
+     *
+     * @param enabled whether the pool is enabled
+     */
+    static void SetPoolEnabled(bool enabled);
+    /**
+     * @brief Set the limits of the pool of buffer data of each thread.
+     *
+     * @param maxBuffersPerClass maximum number of buffer data held per size class
+     * @param maxBytes maximum number of bytes held over all the size classes
+     */
+    static void SetPoolLimits(uint32_t maxBuffersPerClass, uint64_t maxBytes);
+    /**
+     * @brief Get the statistics of the pool of buffer data of the calling thread.
+     *
+     * @return the pool statistics
+     */
+    static PoolStats GetPoolStats();
+    /**
+     * @brief Free all the buffer data held by the pool of the calling thread.
+     */
+    static void ClearPool();
+
+    /// Maximum number of segments of a chained buffer, including its head.
+    static constexpr uint32_t MAX_SEGMENTS = 16;
+    /// Minimum number of bytes of data that a new segment avoids to copy.
+    static constexpr uint32_t MIN_CHAINED_SIZE = 256;
+
+    /**
+     * @brief Enable or disable the chaining of the buffer segments.
+     *
+     * When disabled (the default), the buffers which hold a chain of
+     * segments keep it, but no new segments are chained.
+     *
+     * @param enabled whether chaining is enabled
+     */
+    static void SetChainingEnabled(bool enabled);
+    /**
+     * @return the number of segments of this buffer, including its head.
+     */
+    uint32_t GetSegmentCount() const;
+
   private:
     /**
      * This data structure is variable-sized through its last member whose size
@@ -783,9 +938,10 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value.  There is one value per thread, since the threads of the
+     * MultithreadedSimulatorImpl create buffers concurrently.
      */
-    static uint32_t g_recommendedStart;
+    static thread_local uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -808,20 +964,81 @@ class Buffer
      */
     uint32_t m_end;
 
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
+    /// Per-thread pool of buffer data, one free list per size class
+    struct Pool;
 
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
+    /// Reference-counted chain of the segments following the head of a buffer
+    struct Chain;
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
+    /**
+     * @brief Get the chain of this buffer, which is created or copied if
+     * needed to be modified by this buffer only.
+     * @returns the chain
+     */
+    Chain* GetWritableChain();
+    /**
+     * @brief Release the chain of this buffer, if any.
+     */
+    void ReleaseChain();
+    /**
+     * @brief Get the head of this buffer, without its chain.
+     * @returns a buffer sharing the data of the head of this buffer
+     */
+    Buffer GetHead() const;
+    /**
+     * @brief Replace the head of this buffer, and keep its chain.
+     * @param head the new head, which is not chained
+     */
+    void SetHead(const Buffer& head);
+    /**
+     * @brief Replace the head of this buffer with the first segment of its chain.
+     */
+    void PopFrontSegment();
+    /**
+     * @brief Check whether bytes can be added at the start of the head
+     * without reallocating its data.
+     * @param start the number of bytes to add
+     * @returns true if the data is not reallocated
+     */
+    bool CanAddAtStartInPlace(uint32_t start) const;
+    /**
+     * @brief Check whether bytes can be added at the end of the head
+     * without reallocating its data.
+     * @param end the number of bytes to add
+     * @returns true if the data is not reallocated
+     */
+    bool CanAddAtEndInPlace(uint32_t end) const;
+
+    /**
+     * @brief Get the pool of the calling thread.
+     * @returns the pool, or nullptr if the pool of the thread was destroyed
+     */
+    static Pool* GetPool();
+    /**
+     * @brief Get the capacity allocated for a buffer data.
+     * @param reqSize the requested size
+     * @returns the capacity, rounded up to a size class if pooled
+     */
+    static uint32_t GetAllocationSize(uint32_t reqSize);
+
+    /// The chain of the segments following the head, or nullptr
+    Chain* m_chain;
+
+    static bool g_chainingEnabled;        //!< Whether chaining is enabled
+    static bool g_poolEnabled;            //!< Whether the pool is enabled
+    static uint32_t g_maxBuffersPerClass; //!< Max buffer data per size class and thread
+    static uint64_t g_maxPoolBytes;       //!< Max bytes held by the pool of a thread
+};
+
+/**
+ * The segments of a chained Buffer after its head. The segments are not
+ * chained themselves, and are never empty.
+ */
+struct Buffer::Chain
+{
+    uint32_t m_count;               //!< Reference count
+    uint32_t m_size;                //!< Total number of bytes in the segments
+    std::vector<Buffer> m_segments; //!< The segments
 };
 
 } // namespace ns3
@@ -839,7 +1056,10 @@ Buffer::Iterator::Iterator()
       m_dataStart(0),
       m_dataEnd(0),
       m_current(0),
-      m_data(nullptr)
+      m_data(nullptr),
+      m_buffer(nullptr),
+      m_segment(0),
+      m_offset(0)
 {
 }
 
@@ -853,6 +1073,10 @@ Buffer::Iterator::Iterator(const Buffer* buffer, bool dummy)
 {
     Construct(buffer);
     m_current = m_dataEnd;
+    if (m_buffer != nullptr)
+    {
+        SlowNext(buffer->m_chain->m_size);
+    }
 }
 
 void
@@ -863,11 +1087,19 @@ Buffer::Iterator::Construct(const Buffer* buffer)
     m_dataStart = buffer->m_start;
     m_dataEnd = buffer->m_end;
     m_data = buffer->m_data->m_data;
+    m_buffer = buffer->m_chain != nullptr ? buffer : nullptr;
+    m_segment = 0;
+    m_offset = 0;
 }
 
 void
 Buffer::Iterator::Next()
 {
+    if (m_buffer != nullptr && m_current == m_dataEnd)
+    {
+        SlowNext(1);
+        return;
+    }
     NS_ASSERT(m_current + 1 <= m_dataEnd);
     m_current++;
 }
@@ -875,6 +1107,11 @@ Buffer::Iterator::Next()
 void
 Buffer::Iterator::Prev()
 {
+    if (m_buffer != nullptr && m_current == m_dataStart)
+    {
+        SlowPrev(1);
+        return;
+    }
     NS_ASSERT(m_current >= 1);
     m_current--;
 }
@@ -882,6 +1119,11 @@ Buffer::Iterator::Prev()
 void
 Buffer::Iterator::Next(uint32_t delta)
 {
+    if (m_buffer != nullptr && m_current + delta > m_dataEnd)
+    {
+        SlowNext(delta);
+        return;
+    }
     NS_ASSERT(m_current + delta <= m_dataEnd);
     m_current += delta;
 }
@@ -889,6 +1131,11 @@ Buffer::Iterator::Next(uint32_t delta)
 void
 Buffer::Iterator::Prev(uint32_t delta)
 {
+    if (m_buffer != nullptr && m_current < m_dataStart + delta)
+    {
+        SlowPrev(delta);
+        return;
+    }
     NS_ASSERT(m_current >= delta);
     m_current -= delta;
 }
@@ -896,15 +1143,20 @@ Buffer::Iterator::Prev(uint32_t delta)
 void
 Buffer::Iterator::WriteU8(uint8_t data)
 {
-    NS_ASSERT_MSG(Check(m_current), GetWriteErrorMessage());
-
     if (m_current < m_zeroStart)
     {
+        NS_ASSERT_MSG(Check(m_current), GetWriteErrorMessage());
         m_data[m_current] = data;
         m_current++;
     }
+    else if (m_buffer != nullptr && m_current == m_dataEnd)
+    {
+        // the end of a segment is never before its zero area
+        SlowWriteU8(data, 1);
+    }
     else
     {
+        NS_ASSERT_MSG(Check(m_current), GetWriteErrorMessage());
         m_data[m_current - (m_zeroEnd - m_zeroStart)] = data;
         m_current++;
     }
@@ -913,6 +1165,11 @@ Buffer::Iterator::WriteU8(uint8_t data)
 void
 Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 {
+    if (m_buffer != nullptr && m_current + len > m_dataEnd)
+    {
+        SlowWriteU8(data, len);
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + len), GetWriteErrorMessage());
     if (m_current <= m_zeroStart)
     {
@@ -930,16 +1187,22 @@ Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 void
 Buffer::Iterator::WriteHtonU16(uint16_t data)
 {
-    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 2), GetWriteErrorMessage());
     uint8_t* buffer;
     if (m_current + 2 <= m_zeroStart)
     {
         buffer = &m_data[m_current];
     }
+    else if (m_buffer != nullptr && m_current + 2 > m_dataEnd)
+    {
+        WriteU8((data >> 8) & 0xff);
+        WriteU8((data >> 0) & 0xff);
+        return;
+    }
     else
     {
         buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
+    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 2), GetWriteErrorMessage());
     buffer[0] = (data >> 8) & 0xff;
     buffer[1] = (data >> 0) & 0xff;
     m_current += 2;
@@ -948,17 +1211,24 @@ Buffer::Iterator::WriteHtonU16(uint16_t data)
 void
 Buffer::Iterator::WriteHtonU32(uint32_t data)
 {
-    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 4), GetWriteErrorMessage());
-
     uint8_t* buffer;
     if (m_current + 4 <= m_zeroStart)
     {
         buffer = &m_data[m_current];
     }
+    else if (m_buffer != nullptr && m_current + 4 > m_dataEnd)
+    {
+        WriteU8((data >> 24) & 0xff);
+        WriteU8((data >> 16) & 0xff);
+        WriteU8((data >> 8) & 0xff);
+        WriteU8((data >> 0) & 0xff);
+        return;
+    }
     else
     {
         buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
+    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 4), GetWriteErrorMessage());
     buffer[0] = (data >> 24) & 0xff;
     buffer[1] = (data >> 16) & 0xff;
     buffer[2] = (data >> 8) & 0xff;
@@ -974,7 +1244,7 @@ Buffer::Iterator::ReadNtohU16()
     {
         buffer = &m_data[m_current];
     }
-    else if (m_current >= m_zeroEnd)
+    else if (m_current >= m_zeroEnd && m_current + 2 <= m_dataEnd)
     {
         buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
@@ -998,7 +1268,7 @@ Buffer::Iterator::ReadNtohU32()
     {
         buffer = &m_data[m_current];
     }
-    else if (m_current >= m_zeroEnd)
+    else if (m_current >= m_zeroEnd && m_current + 4 <= m_dataEnd)
     {
         buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
@@ -1021,7 +1291,8 @@ Buffer::Iterator::ReadNtohU32()
 uint8_t
 Buffer::Iterator::PeekU8()
 {
-    NS_ASSERT_MSG(m_current >= m_dataStart && m_current < m_dataEnd, GetReadErrorMessage());
+    NS_ASSERT_MSG(m_current >= m_dataStart && (m_current < m_dataEnd || m_buffer != nullptr),
+                  GetReadErrorMessage());
 
     if (m_current < m_zeroStart)
     {
@@ -1032,6 +1303,11 @@ Buffer::Iterator::PeekU8()
     {
         return 0;
     }
+    else if (m_buffer != nullptr && m_current == m_dataEnd)
+    {
+        // the end of a segment is never before its zero area
+        return SlowPeekU8();
+    }
     else
     {
         uint8_t data = m_data[m_current - (m_zeroEnd - m_zeroStart)];
@@ -1074,16 +1350,21 @@ Buffer::Buffer(const Buffer& o)
       m_zeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaEnd(o.m_zeroAreaEnd),
       m_start(o.m_start),
-      m_end(o.m_end)
+      m_end(o.m_end),
+      m_chain(o.m_chain)
 {
     m_data->m_count++;
+    if (m_chain != nullptr)
+    {
+        m_chain->m_count++;
+    }
     NS_ASSERT(CheckInternalState());
 }
 
 uint32_t
 Buffer::GetSize() const
 {
-    return m_end - m_start;
+    return m_end - m_start + (m_chain != nullptr ? m_chain->m_size : 0);
 }
 
 Buffer::Iterator
@@ -43,15 +43,18 @@ struct ByteTagListData
  *
  * @brief Container class for struct ByteTagListData
  *
- * Internal use only.
+ * Internal use only.  There is one free list per thread, so that the
+ * threads of the MultithreadedSimulatorImpl can create and free packets
+ * concurrently.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static thread_local class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
 } g_freeList; //!< Container for struct ByteTagListData
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static thread_local uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static thread_local bool g_freeListDestroyed = false; //!< whether g_freeList is destroyed
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -61,6 +64,8 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList()
         auto buffer = (uint8_t*)(*i);
         delete[] buffer;
     }
+    clear();
+    g_freeListDestroyed = true;
 }
 #endif /* USE_FREE_LIST */
 
@@ -150,14 +155,18 @@ ByteTagList::ByteTagList(const ByteTagList& o)
     : m_minStart(o.m_minStart),
       m_maxEnd(o.m_maxEnd),
       m_adjustment(o.m_adjustment),
-      m_used(o.m_used),
-      m_data(o.m_data)
+      m_used(o.m_used)
 {
     NS_LOG_FUNCTION(this << &o);
-    if (m_data != nullptr)
+    if (IsAllocated())
     {
+        m_data = o.m_data;
         m_data->count++;
     }
+    else
+    {
+        std::memcpy(m_inline, o.m_inline, m_used);
+    }
 }
 
 ByteTagList&
@@ -168,24 +177,33 @@ ByteTagList::operator=(const ByteTagList& o)
         return *this;
     }
 
-    Deallocate(m_data);
+    if (IsAllocated())
+    {
+        Deallocate(m_data);
+    }
     m_minStart = o.m_minStart;
     m_maxEnd = o.m_maxEnd;
     m_adjustment = o.m_adjustment;
-    m_data = o.m_data;
     m_used = o.m_used;
-    if (m_data != nullptr)
+    if (IsAllocated())
     {
+        m_data = o.m_data;
         m_data->count++;
     }
+    else
+    {
+        std::memcpy(m_inline, o.m_inline, m_used);
+    }
     return *this;
 }
 
 ByteTagList::~ByteTagList()
 {
     NS_LOG_FUNCTION(this);
-    Deallocate(m_data);
-    m_data = nullptr;
+    if (IsAllocated())
+    {
+        Deallocate(m_data);
+    }
     m_used = 0;
 }
 
@@ -195,19 +213,26 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
     NS_LOG_FUNCTION(this << tid << bufferSize << start << end);
     uint32_t spaceNeeded = m_used + bufferSize + 4 + 4 + 4 + 4;
     NS_ASSERT(m_used <= spaceNeeded);
-    if (m_data == nullptr)
+    uint8_t* data = m_inline;
+    if (spaceNeeded > INLINE_SIZE)
     {
-        m_data = Allocate(spaceNeeded);
-        m_used = 0;
-    }
-    else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
-    {
-        ByteTagListData* newData = Allocate(spaceNeeded);
-        std::memcpy(&newData->data, &m_data->data, m_used);
-        Deallocate(m_data);
-        m_data = newData;
+        if (!IsAllocated())
+        {
+            // move the tags out of the inline storage
+            ByteTagListData* newData = Allocate(spaceNeeded);
+            std::memcpy(&newData->data, m_inline, m_used);
+            m_data = newData;
+        }
+        else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+        {
+            ByteTagListData* newData = Allocate(spaceNeeded);
+            std::memcpy(&newData->data, &m_data->data, m_used);
+            Deallocate(m_data);
+            m_data = newData;
+        }
+        data = m_data->data;
     }
-    TagBuffer tag = TagBuffer(&m_data->data[m_used], &m_data->data[spaceNeeded]);
+    TagBuffer tag = TagBuffer(&data[m_used], &data[spaceNeeded]);
     tag.WriteU32(tid.GetUid());
     tag.WriteU32(bufferSize);
     tag.WriteU32(start - m_adjustment);
@@ -221,7 +246,10 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_maxEnd = end - m_adjustment;
     }
     m_used = spaceNeeded;
-    m_data->dirty = m_used;
+    if (IsAllocated())
+    {
+        m_data->dirty = m_used;
+    }
     return tag;
 }
 
@@ -242,11 +270,13 @@ void
 ByteTagList::RemoveAll()
 {
     NS_LOG_FUNCTION(this);
-    Deallocate(m_data);
+    if (IsAllocated())
+    {
+        Deallocate(m_data);
+    }
     m_minStart = INT32_MAX;
     m_maxEnd = INT32_MIN;
     m_adjustment = 0;
-    m_data = nullptr;
     m_used = 0;
 }
 
@@ -263,16 +293,29 @@ ByteTagList::Iterator
 ByteTagList::Begin(int32_t offsetStart, int32_t offsetEnd) const
 {
     NS_LOG_FUNCTION(this << offsetStart << offsetEnd);
-    if (m_data == nullptr)
+    if (m_used == 0)
     {
         return Iterator(nullptr, nullptr, offsetStart, offsetEnd, 0);
     }
     else
     {
-        return Iterator(m_data->data, &m_data->data[m_used], offsetStart, offsetEnd, m_adjustment);
+        uint8_t* data = GetData();
+        return Iterator(data, &data[m_used], offsetStart, offsetEnd, m_adjustment);
     }
 }
 
+bool
+ByteTagList::IsAllocated() const
+{
+    return m_used > INLINE_SIZE;
+}
+
+uint8_t*
+ByteTagList::GetData() const
+{
+    return IsAllocated() ? m_data->data : const_cast<uint8_t*>(m_inline);
+}
+
 void
 ByteTagList::AddAtEnd(int32_t appendOffset)
 {
@@ -344,7 +387,7 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    while (!g_freeListDestroyed && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
@@ -378,7 +421,8 @@ ByteTagList::Deallocate(ByteTagListData* data)
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_freeListDestroyed || g_freeList.size() > FREE_LIST_SIZE ||
+            data->size < g_maxSize)
         {
             auto buffer = (uint8_t*)data;
             delete[] buffer;
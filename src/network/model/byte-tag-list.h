@@ -40,6 +40,13 @@ struct ByteTagListData;
  *     is shared and, thus, reference-counted. This data structure is unshared
  *     as-needed to emulate COW semantics.
  *
+ *   - The tag byte buffer is stored inline in the ByteTagList object, in
+ *     place of the pointer to the ByteTagListData, as long as it fits in
+ *     INLINE_SIZE bytes, which is the case for a single small tag such as
+ *     the one of the FlowMonitor. It is copied when the list is copied.
+ *     Since m_used only grows until the list is cleared, the ByteTagListData
+ *     is in use if and only if m_used exceeds INLINE_SIZE.
+ *
  *   - Each tag tags a unique set of bytes identified by the pair of offsets
  *     (start,end). These offsets are relative to the start of the packet
  *     Whenever the origin of the offset changes, the Packet adjusts all
@@ -272,11 +279,30 @@ class ByteTagList
      */
     void Deallocate(ByteTagListData* data);
 
-    int32_t m_minStart;      //!< minimal start offset
-    int32_t m_maxEnd;        //!< maximal end offset
-    int32_t m_adjustment;    //!< adjustment to byte tag offsets
-    uint32_t m_used;         //!< the number of used bytes in the buffer
-    ByteTagListData* m_data; //!< the ByteTagListData structure
+    /**
+     * @brief Check whether the tag byte buffer is stored in a ByteTagListData
+     * @returns true if m_data is in use, false if m_inline is
+     */
+    bool IsAllocated() const;
+
+    /**
+     * @brief Get the tag byte buffer
+     * @returns the data of the ByteTagListData structure, or the inline storage
+     */
+    uint8_t* GetData() const;
+
+    /// Size of the inline storage of the tag byte buffer
+    static constexpr uint32_t INLINE_SIZE = 40;
+
+    int32_t m_minStart;   //!< minimal start offset
+    int32_t m_maxEnd;     //!< maximal end offset
+    int32_t m_adjustment; //!< adjustment to byte tag offsets
+    uint32_t m_used;      //!< the number of used bytes in the buffer
+
+    union {
+        ByteTagListData* m_data;       //!< the ByteTagListData structure, if IsAllocated
+        uint8_t m_inline[INLINE_SIZE]; //!< the tag byte buffer, otherwise
+    };
 };
 
 void
@@ -25,10 +25,12 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+bool PacketMetadata::m_enableCompact = false;
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local bool PacketMetadata::m_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -37,7 +39,10 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
-    PacketMetadata::m_enable = false;
+    clear();
+    // the packets freed later on by this thread, e.g., by the destructors of
+    // static objects, are not recycled
+    PacketMetadata::m_freeListDestroyed = true;
 }
 
 void
@@ -62,6 +67,131 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableCompact()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Enable();
+    m_enableCompact = true;
+}
+
+bool
+PacketMetadata::IsCompact() const
+{
+    return m_used == COMPACT_USED;
+}
+
+uint32_t
+PacketMetadata::GetCompactCount() const
+{
+    NS_ASSERT(IsCompact());
+    return (m_tail == 0xffff) ? 0 : m_tail - m_head + 1;
+}
+
+PacketMetadata::CompactItem
+PacketMetadata::GetCompactItem(uint16_t index) const
+{
+    NS_ASSERT(IsCompact() && m_data != nullptr && index < COMPACT_ITEMS);
+    CompactItem item;
+    memcpy(&item, &m_data->m_data[index * sizeof(CompactItem)], sizeof(CompactItem));
+    return item;
+}
+
+void
+PacketMetadata::SetCompactItem(uint16_t index, const CompactItem& item)
+{
+    NS_ASSERT(IsCompact() && m_data != nullptr && m_data->m_count == 1 && index < COMPACT_ITEMS);
+    memcpy(&m_data->m_data[index * sizeof(CompactItem)], &item, sizeof(CompactItem));
+}
+
+void
+PacketMetadata::ReserveCompact(bool atStart)
+{
+    NS_LOG_FUNCTION(this << atStart);
+    uint32_t count = GetCompactCount();
+    NS_ASSERT(count < COMPACT_ITEMS);
+    bool hasRoom = (count == 0) || (atStart ? m_head > 0 : m_tail + 1U < COMPACT_ITEMS);
+    if (m_data != nullptr && m_data->m_count == 1 && hasRoom)
+    {
+        return;
+    }
+    // most packets get more headers than trailers, hence keep one free slot
+    // on the other side and leave the others on the requested side
+    uint32_t free = COMPACT_ITEMS - count;
+    uint16_t head = atStart ? free - (free > 1 ? 1 : 0) : (free > 1 ? 1 : 0);
+    if (m_data == nullptr || m_data->m_count > 1)
+    {
+        PacketMetadata::Data* newData = PacketMetadata::Create(COMPACT_ITEMS * sizeof(CompactItem));
+        if (count > 0)
+        {
+            memcpy(&newData->m_data[head * sizeof(CompactItem)],
+                   &m_data->m_data[m_head * sizeof(CompactItem)],
+                   count * sizeof(CompactItem));
+        }
+        if (m_data != nullptr)
+        {
+            m_data->m_count--;
+            if (m_data->m_count == 0)
+            {
+                PacketMetadata::Recycle(m_data);
+            }
+        }
+        m_data = newData;
+    }
+    else
+    {
+        memmove(&m_data->m_data[head * sizeof(CompactItem)],
+                &m_data->m_data[m_head * sizeof(CompactItem)],
+                count * sizeof(CompactItem));
+    }
+    if (count > 0)
+    {
+        m_head = head;
+        m_tail = head + count - 1;
+    }
+}
+
+void
+PacketMetadata::Spill()
+{
+    NS_LOG_FUNCTION(this);
+    if (!IsCompact())
+    {
+        return;
+    }
+    PacketMetadata::Data* compact = m_data;
+    uint16_t head = m_head;
+    uint32_t count = GetCompactCount();
+    m_data = PacketMetadata::Create(10 * (count + 1));
+    memset(m_data->m_data, 0xff, 4);
+    m_head = 0xffff;
+    m_tail = 0xffff;
+    m_used = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        CompactItem compactItem;
+        memcpy(&compactItem,
+               &compact->m_data[(head + i) * sizeof(CompactItem)],
+               sizeof(CompactItem));
+        PacketMetadata::SmallItem item;
+        item.next = 0xffff;
+        item.prev = m_tail;
+        item.typeUid = compactItem.typeUid << 1;
+        item.size = compactItem.size;
+        item.chunkUid = compactItem.chunkUid;
+        uint16_t written = AddSmall(&item);
+        UpdateTail(written);
+    }
+    if (compact != nullptr)
+    {
+        compact->m_count--;
+        if (compact->m_count == 0)
+        {
+            PacketMetadata::Recycle(compact);
+        }
+    }
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -123,6 +253,11 @@ bool
 PacketMetadata::IsStateOk() const
 {
     NS_LOG_FUNCTION(this);
+    if (IsCompact())
+    {
+        return (m_head == 0xffff && m_tail == 0xffff) ||
+               (m_data != nullptr && m_head <= m_tail && m_tail < COMPACT_ITEMS);
+    }
     bool ok = m_used <= m_data->m_size;
     ok &= IsPointerOk(m_head);
     ok &= IsPointerOk(m_tail);
@@ -491,6 +626,7 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
 
     // create a copy of the packet without its tail.
     PacketMetadata h(m_packetUid, 0);
+    h.Spill();
     uint16_t current = m_head;
     while (current != 0xffff && current != m_tail)
     {
@@ -516,6 +652,21 @@ PacketMetadata::ReadItems(uint16_t current,
     NS_LOG_FUNCTION(this << current << item->chunkUid << item->prev << item->next << item->size
                          << item->typeUid << extraItem->fragmentEnd << extraItem->fragmentStart
                          << extraItem->packetUid);
+    if (IsCompact())
+    {
+        // decode the compact item
+        NS_ASSERT(m_head <= current && current <= m_tail);
+        CompactItem compact = GetCompactItem(current);
+        item->next = (current == m_tail) ? 0xffff : current + 1;
+        item->prev = (current == m_head) ? 0xffff : current - 1;
+        item->typeUid = compact.typeUid << 1;
+        item->size = compact.size;
+        item->chunkUid = compact.chunkUid;
+        extraItem->fragmentStart = 0;
+        extraItem->fragmentEnd = compact.size;
+        extraItem->packetUid = m_packetUid;
+        return 0;
+    }
     NS_ASSERT(current <= m_data->m_size);
     const uint8_t* buffer = &m_data->m_data[current];
     item->next = buffer[0];
@@ -559,6 +710,10 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
+    if (m_freeListDestroyed)
+    {
+        return PacketMetadata::Allocate(m_maxSize);
+    }
     while (!m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
@@ -580,7 +735,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -648,9 +803,22 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     NS_LOG_FUNCTION(this << uid << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
+    if (IsCompact())
+    {
+        if (GetCompactCount() < COMPACT_ITEMS)
+        {
+            ReserveCompact(true);
+            m_head = (m_head == 0xffff) ? COMPACT_ITEMS - 2 : m_head - 1;
+            m_tail = (m_tail == 0xffff) ? m_head : m_tail;
+            SetCompactItem(m_head, {static_cast<uint16_t>(uid >> 1), m_chunkUid, size});
+            m_chunkUid++;
+            return;
+        }
+        Spill();
+    }
 
     PacketMetadata::SmallItem item;
     item.next = m_head;
@@ -670,7 +838,7 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
     NS_LOG_FUNCTION(this << &header << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -692,6 +860,21 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         }
         return;
     }
+    if (IsCompact())
+    {
+        // the byte buffer may be shared, hence it is left untouched
+        if (m_head == m_tail)
+        {
+            m_head = 0xffff;
+            m_tail = 0xffff;
+        }
+        else
+        {
+            m_head++;
+        }
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     if (m_head + read == m_used)
     {
         m_used = m_head;
@@ -715,9 +898,23 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
+    if (IsCompact())
+    {
+        if (GetCompactCount() < COMPACT_ITEMS)
+        {
+            ReserveCompact(false);
+            m_tail = (m_tail == 0xffff) ? 1 : m_tail + 1;
+            m_head = (m_head == 0xffff) ? m_tail : m_head;
+            SetCompactItem(m_tail, {static_cast<uint16_t>(uid >> 1), m_chunkUid, size});
+            m_chunkUid++;
+            NS_ASSERT(IsStateOk());
+            return;
+        }
+        Spill();
+    }
     PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
@@ -737,7 +934,7 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -759,6 +956,21 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         }
         return;
     }
+    if (IsCompact())
+    {
+        // the byte buffer may be shared, hence it is left untouched
+        if (m_head == m_tail)
+        {
+            m_head = 0xffff;
+            m_tail = 0xffff;
+        }
+        else
+        {
+            m_tail--;
+        }
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     if (m_tail + read == m_used)
     {
         m_used = m_tail;
@@ -781,7 +993,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
     NS_LOG_FUNCTION(this << &o);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     if (m_tail == 0xffff)
@@ -798,6 +1010,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         // we have nothing to append.
         return;
     }
+    Spill();
     NS_ASSERT(m_head != 0xffff && m_tail != 0xffff);
 
     // We read the current tail because we are going to append
@@ -857,7 +1070,7 @@ PacketMetadata::AddPaddingAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
 }
@@ -868,10 +1081,33 @@ PacketMetadata::RemoveAtStart(uint32_t start)
     NS_LOG_FUNCTION(this << start);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
-    NS_ASSERT(m_data != nullptr);
+    if (IsCompact())
+    {
+        // remove the whole items, and spill only if an item is fragmented.
+        while (m_head != 0xffff && start > 0 && GetCompactItem(m_head).size <= start)
+        {
+            start -= GetCompactItem(m_head).size;
+            if (m_head == m_tail)
+            {
+                m_head = 0xffff;
+                m_tail = 0xffff;
+            }
+            else
+            {
+                m_head++;
+            }
+        }
+        if (start == 0 || m_head == 0xffff)
+        {
+            NS_ASSERT(start == 0);
+            NS_ASSERT(IsStateOk());
+            return;
+        }
+        Spill();
+    }
     uint32_t leftToRemove = start;
     uint16_t current = m_head;
     while (current != 0xffff && leftToRemove > 0)
@@ -898,6 +1134,7 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            fragment.Spill();
             extraItem.fragmentStart += leftToRemove;
             leftToRemove = 0;
             uint16_t written = fragment.AddBig(0xffff, fragment.m_tail, &item, &extraItem);
@@ -929,10 +1166,33 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
-    NS_ASSERT(m_data != nullptr);
+    if (IsCompact())
+    {
+        // remove the whole items, and spill only if an item is fragmented.
+        while (m_tail != 0xffff && end > 0 && GetCompactItem(m_tail).size <= end)
+        {
+            end -= GetCompactItem(m_tail).size;
+            if (m_head == m_tail)
+            {
+                m_head = 0xffff;
+                m_tail = 0xffff;
+            }
+            else
+            {
+                m_tail--;
+            }
+        }
+        if (end == 0 || m_tail == 0xffff)
+        {
+            NS_ASSERT(end == 0);
+            NS_ASSERT(IsStateOk());
+            return;
+        }
+        Spill();
+    }
 
     uint32_t leftToRemove = end;
     uint16_t current = m_tail;
@@ -960,6 +1220,7 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            fragment.Spill();
             NS_ASSERT(extraItem.fragmentEnd > leftToRemove);
             extraItem.fragmentEnd -= leftToRemove;
             leftToRemove = 0;
@@ -1257,6 +1518,8 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
     const uint8_t* start = buffer;
     uint32_t desSize = size;
 
+    Spill();
+
     buffer = ReadFromRawU64(m_packetUid, start, buffer, size);
     desSize -= 8;
 
@@ -14,6 +14,7 @@
 #include "ns3/callback.h"
 #include "ns3/type-id.h"
 
+#include <atomic>
 #include <limits>
 #include <stdint.h>
 #include <vector>
@@ -65,6 +66,18 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * When the compact mode is enabled with PacketMetadata::EnableCompact,
+ * the items of a packet made only of whole headers, trailers and
+ * payload are stored as fixed-size (TypeId uid, size) records in the
+ * Data byte buffer, which avoids the encoding of the items. The byte
+ * buffer of a compact packet is allocated when its first item is added,
+ * and it is shared copy-on-write like the encoded one: removing items
+ * never copies it. The items are encoded into a new byte buffer (i.e.,
+ * spilled) only when there are more than COMPACT_ITEMS items, or when
+ * the packet is fragmented, concatenated with another packet, or
+ * deserialized. The compact items are decoded on demand by the
+ * ItemIterator, so the output of BeginItem is the same in both modes.
  */
 class PacketMetadata
 {
@@ -158,6 +171,11 @@ class PacketMetadata
      * @brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * @brief Enable the packet metadata, with the compact storage
+     * of the items of the new packets.
+     */
+    static void EnableCompact();
 
     /**
      * @brief Constructor
@@ -501,6 +519,9 @@ class PacketMetadata
 
     /**
      * @brief Class to hold all the metadata
+     *
+     * There is one free list per thread, so that the threads of the
+     * MultithreadedSimulatorImpl can create and free packets concurrently.
      */
     class DataFreeList : public std::vector<Data*>
     {
@@ -618,6 +639,61 @@ class PacketMetadata
     uint32_t ReadItems(uint16_t current,
                        PacketMetadata::SmallItem* item,
                        PacketMetadata::ExtraItem* extraItem) const;
+
+    /**
+     * @brief An item of the compact storage, which is a whole
+     * header, trailer or payload
+     */
+    struct CompactItem
+    {
+        uint16_t typeUid;  //!< TypeId uid of the header or trailer, zero for payload
+        uint16_t chunkUid; //!< chunk uid of the item
+        uint32_t size;     //!< size of the item
+    };
+
+    /** Maximum number of items of the compact storage */
+    static constexpr uint32_t COMPACT_ITEMS = 8;
+    /** Value of m_used which identifies the compact storage */
+    static constexpr uint32_t COMPACT_USED = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Check whether the items are stored in the compact format
+     * @returns true if the metadata is compact
+     */
+    bool IsCompact() const;
+    /**
+     * @brief Get the number of compact items
+     * @returns the number of items, if the metadata is compact
+     */
+    uint32_t GetCompactCount() const;
+    /**
+     * @brief Read a compact item
+     * @param index the index of the item in the Data byte buffer
+     * @returns the item
+     */
+    CompactItem GetCompactItem(uint16_t index) const;
+    /**
+     * @brief Write a compact item
+     * @param index the index of the item in the Data byte buffer
+     * @param item the item
+     */
+    void SetCompactItem(uint16_t index, const CompactItem& item);
+    /**
+     * @brief Make room for a compact item at the start or at the end
+     *
+     * The Data byte buffer is allocated or copied if it is missing or
+     * shared, and the items are moved if there is no free slot on the
+     * requested side.
+     *
+     * @param atStart true to make room before the head, false after the tail
+     */
+    void ReserveCompact(bool atStart);
+    /**
+     * @brief Encode the compact items into a new Data byte buffer
+     *
+     * Does nothing if the metadata is not compact.
+     */
+    void Spill();
     /**
      * @brief Add an header
      * @param uid header's uid to add
@@ -665,21 +741,28 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static thread_local DataFreeList m_freeList;  //!< the metadata data storage of the thread
+    static thread_local bool m_freeListDestroyed; //!< whether m_freeList of the thread is destroyed
+    static bool m_enable;                         //!< Enable the packet metadata
+    static bool m_enableChecking;                 //!< Enable the packet metadata checking
+    static bool m_enableCompact;                  //!< Enable the compact storage of the items
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
-    static bool m_metadataSkipped;
+    static std::atomic<bool> m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static thread_local uint32_t m_maxSize;  //!< maximum metadata size in the thread
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid
 
-    Data* m_data; //!< Metadata storage
+    /**
+     * Metadata storage. If the metadata is compact, m_head and m_tail
+     * are the indexes of the first and last CompactItem records of the
+     * byte buffer, which is nullptr until the first item is added.
+     */
+    Data* m_data;
     /*
        head -(next)-> tail
          ^             |
@@ -697,13 +780,16 @@ namespace ns3
 {
 
 PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
-    : m_data(PacketMetadata::Create(10)),
+    : m_data(m_enable && !m_enableCompact ? PacketMetadata::Create(10) : nullptr),
       m_head(0xffff),
       m_tail(0xffff),
-      m_used(0),
+      m_used(m_enable && !m_enableCompact ? 0 : COMPACT_USED),
       m_packetUid(uid)
 {
-    memset(m_data->m_data, 0xff, 4);
+    if (m_data != nullptr)
+    {
+        memset(m_data->m_data, 0xff, 4);
+    }
     if (size > 0)
     {
         DoAddHeader(0, size);
@@ -717,9 +803,11 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_used(o.m_used),
       m_packetUid(o.m_packetUid)
 {
-    NS_ASSERT(m_data != nullptr);
-    NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
-    m_data->m_count++;
+    if (m_data != nullptr)
+    {
+        NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
+        m_data->m_count++;
+    }
 }
 
 PacketMetadata&
@@ -728,15 +816,19 @@ PacketMetadata::operator=(const PacketMetadata& o)
     if (m_data != o.m_data)
     {
         // not self assignment
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (m_data != nullptr)
         {
-            PacketMetadata::Recycle(m_data);
+            m_data->m_count--;
+            if (m_data->m_count == 0)
+            {
+                PacketMetadata::Recycle(m_data);
+            }
         }
         m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        if (m_data != nullptr)
+        {
+            m_data->m_count++;
+        }
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -747,11 +839,13 @@ PacketMetadata::operator=(const PacketMetadata& o)
 
 PacketMetadata::~PacketMetadata()
 {
-    NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (m_data != nullptr)
     {
-        PacketMetadata::Recycle(m_data);
+        m_data->m_count--;
+        if (m_data->m_count == 0)
+        {
+            PacketMetadata::Recycle(m_data);
+        }
     }
 }
 
@@ -20,12 +20,80 @@
 #include "ns3/log.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+namespace
+{
+
+/// Size of the data area of the TagData recycled in the free list
+constexpr size_t POOLED_TAG_DATA_SIZE = 40;
+/// Maximum number of TagData in the free list of a thread
+constexpr size_t FREE_LIST_SIZE = 1024;
+
+/// Free list of the TagData of a thread
+struct TagDataFreeList
+{
+    ~TagDataFreeList()
+    {
+        for (auto p : list)
+        {
+            std::free(p);
+        }
+    }
+
+    std::vector<void*> list; //!< The memory of the recycled TagData
+};
+
+/**
+ * Get the free list of the current thread.
+ *
+ * @returns The free list, or nullptr if the thread is exiting.
+ */
+TagDataFreeList*
+GetFreeList()
+{
+    /// Free list of the current thread, or nullptr
+    static thread_local TagDataFreeList* t_freeList = nullptr;
+    /// Whether the free list of the current thread was destroyed
+    static thread_local bool t_freeListDestroyed = false;
+
+    if (t_freeList != nullptr)
+    {
+        return t_freeList;
+    }
+    if (t_freeListDestroyed)
+    {
+        return nullptr;
+    }
+
+    /// Owner of the free list of a thread, which clears t_freeList when the thread exits
+    struct FreeListOwner
+    {
+        FreeListOwner()
+        {
+            t_freeList = &freeList;
+        }
+
+        ~FreeListOwner()
+        {
+            t_freeList = nullptr;
+            t_freeListDestroyed = true;
+        }
+
+        TagDataFreeList freeList; //!< The free list
+    };
+
+    static thread_local FreeListOwner owner;
+    return t_freeList;
+}
+
+} // namespace
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -33,14 +101,49 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = nullptr;
+    if (dataSize <= POOLED_TAG_DATA_SIZE)
+    {
+        TagDataFreeList* freeList = GetFreeList();
+        if (freeList != nullptr && !freeList->list.empty())
+        {
+            p = freeList->list.back();
+            freeList->list.pop_back();
+        }
+        else
+        {
+            p = std::malloc(sizeof(TagData) + POOLED_TAG_DATA_SIZE - 1);
+        }
+    }
+    else
+    {
+        p = std::malloc(sizeof(TagData) + dataSize - 1);
+    }
+    // The matching frees are in FreeTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::FreeTagData(TagData* data)
+{
+    // the data area of the TagData is POOLED_TAG_DATA_SIZE long if the tag fits in it
+    bool pooled = data->size <= POOLED_TAG_DATA_SIZE;
+    data->~TagData();
+    if (pooled)
+    {
+        TagDataFreeList* freeList = GetFreeList();
+        if (freeList != nullptr && freeList->list.size() < FREE_LIST_SIZE)
+        {
+            freeList->list.push_back(data);
+            return;
+        }
+    }
+    std::free(data);
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -184,8 +287,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
@@ -109,6 +109,13 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * @par <b> Memory management </b>
+ *
+ *   - The TagData of the small tags are all allocated with the same
+ *     size, and are recycled through a per-thread free list instead of
+ *     being freed, so that adding a tag to a packet usually does not
+ *     allocate any memory.
  */
 class PacketTagList
 {
@@ -241,6 +248,13 @@ class PacketTagList
      * @returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Destroy and free a TagData struct allocated by CreateTagData,
+     * or recycle it in the free list.
+     *
+     * @param [in] data The TagData object.
+     */
+    static void FreeTagData(TagData* data);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -354,15 +368,13 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            FreeTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        FreeTagData(prev);
     }
     m_next = nullptr;
 }
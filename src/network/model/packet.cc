@@ -9,10 +9,12 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/simulator.h"
 
 #include <cstdarg>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -21,6 +23,26 @@ NS_LOG_COMPONENT_DEFINE("Packet");
 
 uint32_t Packet::m_globalUid = 0;
 
+namespace
+{
+
+/**
+ * Allocate the uid of a new packet.
+ *
+ * The uids are allocated by the MultithreadedSimulatorImpl while its
+ * partitions run, so that they do not depend on the thread scheduling.
+ *
+ * @param [in,out] globalUid The uid of the next packet.
+ * @returns The uid.
+ */
+uint32_t
+AllocatePacketUid(uint32_t& globalUid)
+{
+    return MultithreadedSimulatorImpl::AllocateUid(globalUid) - 1;
+}
+
+} // namespace
+
 TypeId
 ByteTagIterator::Item::GetTypeId() const
 {
@@ -125,6 +147,15 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+Ptr<Packet>
+Packet::DeepCopy() const
+{
+    std::vector<uint8_t> buffer(GetSerializedSize());
+    [[maybe_unused]] uint32_t serialized = Serialize(buffer.data(), buffer.size());
+    NS_ASSERT_MSG(serialized != 0, "Packet serialization failed");
+    return Create<Packet>(buffer.data(), buffer.size(), true);
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
@@ -135,10 +166,11 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 |
+                     AllocatePacketUid(m_globalUid),
+                 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -175,10 +207,11 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 |
+                     AllocatePacketUid(m_globalUid),
+                 size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -203,10 +236,11 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 |
+                     AllocatePacketUid(m_globalUid),
+                 size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -589,6 +623,13 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+void
+Packet::EnableCompactPrinting()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketMetadata::EnableCompact();
+}
+
 void
 Packet::EnableChecking()
 {
@@ -195,7 +195,9 @@ class PacketTagIterator
  * output from Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
- * Packet::EnablePrinting.
+ * Packet::EnablePrinting. Packet::EnableCompactPrinting provides the same
+ * output as Packet::EnablePrinting with a lower runtime cost for most
+ * packets.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -448,6 +450,19 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * @brief performs a deep copy of the packet.
+     *
+     * @returns a copy of the packet which shares no data with the
+     * original packet, and has the same uid.
+     *
+     * Unlike Copy(), the returned packet can be handed over to another
+     * thread, e.g., to a node in another partition of the
+     * MultithreadedSimulatorImpl, since the reference counts of the shared
+     * data are not atomic.
+     */
+    Ptr<Packet> DeepCopy() const;
+
     /**
      * @brief Returns the packet's Uid.
      *
@@ -514,6 +529,20 @@ class Packet : public SimpleRefCount<Packet>
      * simulation setup and before any packet is created.
      */
     static void EnablePrinting();
+    /**
+     * @brief Enable printing packets metadata, with a compact storage.
+     *
+     * Same as EnablePrinting, but the metadata of a packet made only
+     * of whole headers, trailers and payload is stored in a small
+     * array inside the packet, and is converted to the regular
+     * representation only when the packet is fragmented or
+     * concatenated, or has too many headers and trailers. This
+     * makes the metadata much cheaper to maintain for the packets
+     * which are never printed.
+     *
+     * \sa PacketMetadata::EnableCompact
+     */
+    static void EnableCompactPrinting();
     /**
      * @brief Enable packets metadata checking.
      *
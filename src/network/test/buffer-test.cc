@@ -11,6 +11,10 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -376,6 +380,347 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // aggregation of two buffers with adjacent zero areas
+    buffer = Buffer(2);
+    other = Buffer(2);
+    other.AddAtEnd(2);
+    i = other.End();
+    i.Prev(2);
+    i.WriteU8(0x55, 2);
+    buffer.AddAtEnd(other);
+    ENSURE_WRITTEN_BYTES(buffer, 6, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55);
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Chained buffer unit tests.
+ */
+class BufferChainTest : public TestCase
+{
+  private:
+    /**
+     * Create a buffer filled with a pattern.
+     * @param size The buffer size
+     * @param seed The first byte of the pattern
+     * @return the buffer
+     */
+    Buffer CreateBuffer(uint32_t size, uint8_t seed);
+    /**
+     * Check the content of a buffer.
+     * @param buffer The buffer to check
+     * @param expected The expected content
+     */
+    void CheckContent(const Buffer& buffer, const std::vector<uint8_t>& expected);
+    /**
+     * Get the content of a buffer, read with an iterator.
+     * @param buffer The buffer
+     * @return the content
+     */
+    std::vector<uint8_t> GetContent(const Buffer& buffer);
+
+  public:
+    void DoRun() override;
+    BufferChainTest();
+};
+
+BufferChainTest::BufferChainTest()
+    : TestCase("Chained buffer")
+{
+}
+
+Buffer
+BufferChainTest::CreateBuffer(uint32_t size, uint8_t seed)
+{
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    Buffer::Iterator i = buffer.Begin();
+    for (uint32_t j = 0; j < size; j++)
+    {
+        i.WriteU8(seed + j * 7);
+    }
+    return buffer;
+}
+
+std::vector<uint8_t>
+BufferChainTest::GetContent(const Buffer& buffer)
+{
+    std::vector<uint8_t> content;
+    for (Buffer::Iterator i = buffer.Begin(); !i.IsEnd();)
+    {
+        content.push_back(i.ReadU8());
+    }
+    return content;
+}
+
+void
+BufferChainTest::CheckContent(const Buffer& buffer, const std::vector<uint8_t>& expected)
+{
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), expected.size(), "Bad buffer size");
+    NS_TEST_ASSERT_MSG_EQ((GetContent(buffer) == expected), true, "Bad content read by iterator");
+    std::vector<uint8_t> copy(buffer.GetSize());
+    NS_TEST_ASSERT_MSG_EQ(buffer.CopyData(copy.data(), copy.size()),
+                          copy.size(),
+                          "Bad size copied");
+    NS_TEST_ASSERT_MSG_EQ((copy == expected), true, "Bad content copied");
+    std::ostringstream os;
+    buffer.CopyData(&os, buffer.GetSize());
+    NS_TEST_ASSERT_MSG_EQ((os.str() == std::string(expected.begin(), expected.end())),
+                          true,
+                          "Bad content copied to stream");
+}
+
+void
+BufferChainTest::DoRun()
+{
+    Buffer::SetChainingEnabled(true);
+
+    Buffer a = CreateBuffer(1000, 1);
+    Buffer b = CreateBuffer(1500, 2);
+    std::vector<uint8_t> expected = GetContent(a);
+    std::vector<uint8_t> bContent = GetContent(b);
+    expected.insert(expected.end(), bContent.begin(), bContent.end());
+
+    // concatenation
+    Buffer ab = a;
+    ab.AddAtEnd(b);
+    NS_TEST_ASSERT_MSG_EQ(ab.GetSegmentCount(), 2, "Buffer not chained");
+    CheckContent(ab, expected);
+    CheckContent(a, std::vector<uint8_t>(expected.begin(), expected.begin() + 1000));
+
+    // multi-byte reads and writes across the segment boundary
+    Buffer::Iterator i = ab.Begin();
+    i.Next(998);
+    uint32_t value = (expected[998] << 24) | (expected[999] << 16) | (expected[1000] << 8) |
+                     expected[1001];
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU32(), value, "Bad read across segments");
+    i = ab.End();
+    NS_TEST_ASSERT_MSG_EQ(i.IsEnd(), true, "Bad end iterator");
+    i.Prev(1501);
+    NS_TEST_ASSERT_MSG_EQ(i.GetRemainingSize(), 1501, "Bad remaining size");
+    NS_TEST_ASSERT_MSG_EQ(i.GetDistanceFrom(ab.Begin()), 999, "Bad distance");
+    NS_TEST_ASSERT_MSG_EQ(i.GetSize(), 2500, "Bad iterator size");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU16(), (expected[999] << 8) | expected[1000], "Bad read");
+
+    // headers are added to a new head instead of copying the shared data
+    ab.AddAtStart(8);
+    NS_TEST_ASSERT_MSG_EQ(ab.GetSegmentCount(), 3, "New head not chained");
+    ab.Begin().WriteHtonU64(0x0102030405060708);
+    std::vector<uint8_t> header{1, 2, 3, 4, 5, 6, 7, 8};
+    expected.insert(expected.begin(), header.begin(), header.end());
+    CheckContent(ab, expected);
+    CheckContent(b, bContent);
+
+    // fragments share the segments
+    Buffer fragment = ab.CreateFragment(500, 1000);
+    NS_TEST_ASSERT_MSG_EQ(fragment.GetSegmentCount(), 2, "Bad fragment segments");
+    CheckContent(fragment,
+                 std::vector<uint8_t>(expected.begin() + 500, expected.begin() + 1500));
+    fragment.RemoveAtStart(600);
+    fragment.RemoveAtEnd(100);
+    NS_TEST_ASSERT_MSG_EQ(fragment.GetSegmentCount(), 1, "Bad fragment segments");
+    CheckContent(fragment,
+                 std::vector<uint8_t>(expected.begin() + 1100, expected.begin() + 1400));
+
+    // trailers are added to a new segment
+    Buffer trailer = ab;
+    trailer.AddAtEnd(4);
+    i = trailer.End();
+    i.Prev(4);
+    i.WriteHtonU32(0xa0b0c0d0);
+    std::vector<uint8_t> withTrailer = expected;
+    withTrailer.insert(withTrailer.end(), {0xa0, 0xb0, 0xc0, 0xd0});
+    CheckContent(trailer, withTrailer);
+    CheckContent(ab, expected);
+
+    // copy from a chained buffer
+    Buffer copy;
+    copy.AddAtStart(100);
+    copy.AddAtEnd(ab);
+    Buffer::Iterator end = ab.Begin();
+    end.Next(100);
+    copy.Begin().Write(ab.Begin(), end);
+    std::vector<uint8_t> twice = expected;
+    twice.insert(twice.begin(), expected.begin(), expected.begin() + 100);
+    CheckContent(copy, twice);
+
+    // write across the segment boundaries
+    Buffer x = CreateBuffer(300, 3);
+    x.AddAtEnd(CreateBuffer(300, 4));
+    NS_TEST_ASSERT_MSG_EQ(x.GetSegmentCount(), 2, "Buffer not chained");
+    std::vector<uint8_t> written(600, 0x11);
+    uint8_t bytes[] = {0x21, 0x22, 0x23, 0x24, 0x25, 0x26};
+    i = x.Begin();
+    i.WriteU8(0x11, 299);
+    i.Write(bytes, 6);
+    std::copy(bytes, bytes + 6, written.begin() + 299);
+    i.WriteHtonU16(0x3132);
+    written[305] = 0x31;
+    written[306] = 0x32;
+    i.WriteU8(0x11, 293);
+    NS_TEST_ASSERT_MSG_EQ(i.IsEnd(), true, "Bad iterator position");
+    i.Prev(302);
+    i.WriteHtonU32(0x41424344);
+    written[298] = 0x41;
+    written[299] = 0x42;
+    written[300] = 0x43;
+    written[301] = 0x44;
+    CheckContent(x, written);
+
+    // flattening
+    Buffer flat = ab;
+    const uint8_t* data = flat.PeekData();
+    NS_TEST_ASSERT_MSG_EQ(flat.GetSegmentCount(), 1, "Buffer not flattened");
+    NS_TEST_ASSERT_MSG_EQ((std::vector<uint8_t>(data, data + flat.GetSize()) == expected),
+                          true,
+                          "Bad flattened content");
+    std::vector<uint8_t> serialized(ab.GetSerializedSize());
+    NS_TEST_ASSERT_MSG_EQ(ab.Serialize(serialized.data(), serialized.size()),
+                          serialized.size(),
+                          "Bad serialized size");
+    Buffer deserialized(0, false);
+    deserialized.Deserialize(serialized.data(), serialized.size());
+    CheckContent(deserialized, expected);
+
+    // the number of segments is bounded
+    Buffer many;
+    expected.clear();
+    for (uint8_t k = 0; k < 2 * Buffer::MAX_SEGMENTS; k++)
+    {
+        Buffer segment = CreateBuffer(Buffer::MIN_CHAINED_SIZE, k);
+        bContent = GetContent(segment);
+        expected.insert(expected.end(), bContent.begin(), bContent.end());
+        many.AddAtEnd(segment);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(many.GetSegmentCount(), Buffer::MAX_SEGMENTS, "Too many");
+    }
+    CheckContent(many, expected);
+
+    Buffer::SetChainingEnabled(false);
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer data pool unit tests.
+ */
+class BufferPoolTest : public TestCase
+{
+  private:
+    /**
+     * Create buffers of mixed sizes, fill them and check their content.
+     * @param sizes The sizes of the buffers
+     */
+    void CreateBuffers(const std::vector<uint32_t>& sizes);
+
+  public:
+    void DoRun() override;
+    BufferPoolTest();
+};
+
+BufferPoolTest::BufferPoolTest()
+    : TestCase("Buffer data pool")
+{
+}
+
+void
+BufferPoolTest::CreateBuffers(const std::vector<uint32_t>& sizes)
+{
+    std::vector<Buffer> buffers;
+    for (auto size : sizes)
+    {
+        Buffer buffer;
+        buffer.AddAtEnd(size);
+        Buffer::Iterator i = buffer.Begin();
+        for (uint32_t j = 0; j < size; j++)
+        {
+            i.WriteU8(j & 0xff);
+        }
+        // header added in front of the payload
+        buffer.AddAtStart(20);
+        buffer.Begin().WriteU8(0xaa, 20);
+        buffers.push_back(buffer);
+    }
+    for (std::size_t k = 0; k < sizes.size(); k++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(buffers[k].GetSize(), sizes[k] + 20, "Bad buffer size");
+        Buffer::Iterator i = buffers[k].Begin();
+        bool ok = true;
+        for (uint32_t j = 0; j < 20; j++)
+        {
+            ok &= (i.ReadU8() == 0xaa);
+        }
+        for (uint32_t j = 0; j < sizes[k]; j++)
+        {
+            ok &= (i.ReadU8() == (j & 0xff));
+        }
+        NS_TEST_ASSERT_MSG_EQ(ok, true, "Bad content in buffer of size " << sizes[k]);
+    }
+}
+
+void
+BufferPoolTest::DoRun()
+{
+    // 64B acks, 1500B data and 64kB aggregates
+    std::vector<uint32_t> sizes{64, 1500, 65000, 64, 1500, 64, 65000, 1500};
+
+    Buffer::ClearPool();
+    Buffer::PoolStats stats = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.buffersHeld, 0, "Pool not cleared");
+    NS_TEST_ASSERT_MSG_EQ(stats.bytesHeld, 0, "Pool not cleared");
+
+    CreateBuffers(sizes);
+    Buffer::PoolStats first = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_GT(first.buffersHeld, sizes.size(), "Buffer data not recycled");
+    NS_TEST_ASSERT_MSG_GT(first.bytesHeld, 2 * 65000, "Buffer data not recycled");
+
+    // the same workload is served by the pool
+    CreateBuffers(sizes);
+    Buffer::PoolStats second = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(second.misses, first.misses, "Buffer data not taken from the pool");
+    NS_TEST_ASSERT_MSG_GT(second.hits, first.hits, "Buffer data not taken from the pool");
+    NS_TEST_ASSERT_MSG_EQ(second.buffersHeld, first.buffersHeld, "Buffer data leaked");
+    NS_TEST_ASSERT_MSG_EQ(second.bytesHeld, first.bytesHeld, "Buffer data leaked");
+
+    // limits
+    Buffer::ClearPool();
+    Buffer::SetPoolLimits(1, 1024 * 1024);
+    CreateBuffers({1500, 1500, 1500});
+    stats = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.buffersHeld <= 2, true, "Too many buffer data per size class");
+    NS_TEST_ASSERT_MSG_GT(stats.releases, second.releases, "Buffer data not released");
+    Buffer::ClearPool();
+    Buffer::SetPoolLimits(1024, 100000);
+    CreateBuffers({65000, 65000});
+    stats = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(stats.bytesHeld, 100000, "Too many bytes held by the pool");
+    Buffer::SetPoolLimits(1024, 32 * 1024 * 1024);
+
+    // a large capacity just above a power of two is rounded up by less than 25%
+    Buffer::ClearPool();
+    {
+        Buffer buffer;
+        buffer.AddAtEnd(70000);
+        buffer.Begin().WriteU8(0, 70000);
+    }
+    stats = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.buffersHeld, 2, "Buffer data not recycled");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(stats.bytesHeld,
+                                70000 * 5 / 4 + Buffer::MIN_POOLED_SIZE,
+                                "Size classes too coarse");
+
+    // opt-out
+    Buffer::SetPoolEnabled(false);
+    stats = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.buffersHeld, 0, "Pool not cleared when disabled");
+    CreateBuffers(sizes);
+    Buffer::PoolStats disabled = Buffer::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(disabled.buffersHeld, 0, "Buffer data recycled by a disabled pool");
+    NS_TEST_ASSERT_MSG_EQ(disabled.hits, stats.hits, "Buffer data taken from a disabled pool");
+    Buffer::SetPoolEnabled(true);
+    CreateBuffers(sizes);
 }
 
 /**
@@ -394,6 +739,8 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferPoolTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferChainTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
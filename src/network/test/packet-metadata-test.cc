@@ -315,7 +315,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * @param compact Whether to enable the compact storage of the metadata.
+     */
+    PacketMetadataTest(bool compact);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -333,10 +337,13 @@ class PacketMetadataTest : public TestCase
      * @return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    bool m_compact; //!< Whether to enable the compact storage of the metadata.
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(bool compact)
+    : TestCase(compact ? "Packet metadata, compact storage" : "Packet metadata"),
+      m_compact(compact)
 {
 }
 
@@ -468,7 +475,14 @@ PacketMetadataTest::DoAddHeader(Ptr<Packet> p)
 void
 PacketMetadataTest::DoRun()
 {
-    PacketMetadata::Enable();
+    if (m_compact)
+    {
+        PacketMetadata::EnableCompact();
+    }
+    else
+    {
+        PacketMetadata::Enable();
+    }
 
     Ptr<Packet> p = Create<Packet>(0);
     Ptr<Packet> p1 = Create<Packet>(0);
@@ -826,6 +840,30 @@ PacketMetadataTest::DoRun()
     p2 = p->CreateFragment(6, 535 - 6);
     p1->AddAtEnd(p2);
 
+    // more headers and trailers than the compact storage can hold
+    p = Create<Packet>(100);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    ADD_HEADER(p, 3);
+    ADD_TRAILER(p, 4);
+    ADD_HEADER(p, 5);
+    ADD_TRAILER(p, 6);
+    ADD_HEADER(p, 7);
+    CHECK_HISTORY(p, 8, 7, 5, 3, 2, 1, 100, 4, 6);
+    p1 = p->Copy();
+    ADD_HEADER(p, 8);
+    ADD_TRAILER(p, 9);
+    CHECK_HISTORY(p, 10, 8, 7, 5, 3, 2, 1, 100, 4, 6, 9);
+    REM_HEADER(p, 8);
+    REM_TRAILER(p, 9);
+    CHECK_HISTORY(p, 8, 7, 5, 3, 2, 1, 100, 4, 6);
+    p->RemoveAtStart(7 + 5);
+    p->RemoveAtEnd(6);
+    CHECK_HISTORY(p, 5, 3, 2, 1, 100, 4);
+    CHECK_HISTORY(p1, 8, 7, 5, 3, 2, 1, 100, 4, 6);
+    p1->RemoveAtStart(7 + 2);
+    CHECK_HISTORY(p1, 7, 3, 3, 2, 1, 100, 4, 6);
+
     /// @internal
     /// See \bugid{1072}
     p = Create<Packet>(reinterpret_cast<const uint8_t*>("hello world"), 11);
@@ -885,7 +923,8 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", Type::UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(true), TestCase::Duration::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
@@ -969,6 +969,25 @@ PacketTest::DoRun()
         ALargeTestTag a;
         tmp->AddPacketTag(a);
     }
+
+    /* Test byte tags moving out of the inline storage of the list */
+    {
+        Ptr<Packet> tmp = Create<Packet>(100);
+        tmp->AddByteTag(ATestTag<1>(), 0, 10);
+        tmp->AddByteTag(ATestTag<2>(), 10, 20);
+        tmp->AddByteTag(ATestTag<3>(), 20, 30);
+        tmp->AddByteTag(ATestTag<4>(), 30, 40);
+        Ptr<Packet> copy = tmp->Copy();
+        CHECK(copy, 4, E(1, 0, 10), E(2, 10, 20), E(3, 20, 30), E(4, 30, 40));
+        tmp->AddByteTag(ATestTag<5>(), 40, 50);
+        copy->AddByteTag(ATestTag<6>(), 50, 60);
+        CHECK(tmp, 5, E(1, 0, 10), E(2, 10, 20), E(3, 20, 30), E(4, 30, 40), E(5, 40, 50));
+        CHECK(copy, 5, E(1, 0, 10), E(2, 10, 20), E(3, 20, 30), E(4, 30, 40), E(6, 50, 60));
+        Ptr<Packet> frag = copy->CreateFragment(15, 20);
+        CHECK(frag, 3, E(2, 0, 5), E(3, 5, 15), E(4, 15, 20));
+        frag->AddAtEnd(tmp->CreateFragment(35, 10));
+        CHECK(frag, 5, E(2, 0, 5), E(3, 5, 15), E(4, 15, 20), E(4, 20, 25), E(5, 25, 30));
+    }
 }
 
 /**
@@ -4,13 +4,19 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/pcap-file-wrapper.h"
 #include "ns3/pcap-file.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -1364,6 +1370,249 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the PcapFileWrapper writes the same
+ * files in Asynchronous mode, rotates them and writes the pcapng format.
+ */
+class AsynchronousWriteTestCase : public TestCase
+{
+  public:
+    AsynchronousWriteTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write the test records to a file.
+     *
+     * @param filename the name of the file
+     * @param asynchronous whether to write the file in Asynchronous mode
+     * @param bufferSize the BufferSize attribute
+     * @param maxFileSize the MaxFileSize attribute
+     * @param format the Format attribute
+     * @return the file, not closed
+     */
+    Ptr<PcapFileWrapper> WriteRecords(const std::string& filename,
+                                      bool asynchronous,
+                                      uint32_t bufferSize,
+                                      uint64_t maxFileSize,
+                                      PcapBufferedFile::Format format);
+
+    /**
+     * @param filename the name of a file
+     * @return the contents of the file
+     */
+    static std::string ReadContents(const std::string& filename);
+
+    /**
+     * @param contents the contents of a file
+     * @param offset the offset of an integer in the file
+     * @return the 32-bit integer stored in little-endian order at the offset
+     */
+    static uint32_t ReadUint32(const std::string& contents, std::size_t offset);
+
+    /**
+     * @param i the index of a record
+     * @return the size of the packet of the record
+     */
+    static uint32_t GetRecordSize(uint32_t i);
+
+    static constexpr uint32_t N_RECORDS = 200; //!< the number of records written
+    static constexpr uint32_t SNAP_LEN = 256;  //!< the maximum size of a record
+};
+
+AsynchronousWriteTestCase::AsynchronousWriteTestCase()
+    : TestCase("Check that PcapFileWrapper writes files in Asynchronous mode")
+{
+}
+
+uint32_t
+AsynchronousWriteTestCase::GetRecordSize(uint32_t i)
+{
+    return (i * 37) % 300 + 1;
+}
+
+Ptr<PcapFileWrapper>
+AsynchronousWriteTestCase::WriteRecords(const std::string& filename,
+                                        bool asynchronous,
+                                        uint32_t bufferSize,
+                                        uint64_t maxFileSize,
+                                        PcapBufferedFile::Format format)
+{
+    auto file = CreateObjectWithAttributes<PcapFileWrapper>("Asynchronous",
+                                                            BooleanValue(asynchronous),
+                                                            "BufferSize",
+                                                            UintegerValue(bufferSize),
+                                                            "MaxFileSize",
+                                                            UintegerValue(maxFileSize),
+                                                            "Format",
+                                                            EnumValue(format),
+                                                            "NanosecMode",
+                                                            BooleanValue(true));
+    file->Open(filename, std::ios::out);
+    file->Init(1, SNAP_LEN, 7);
+    uint8_t data[300];
+    for (uint32_t i = 0; i < N_RECORDS; ++i)
+    {
+        std::memset(data, i, sizeof(data));
+        file->Write(NanoSeconds(1234567 * i), data, GetRecordSize(i));
+    }
+    return file;
+}
+
+std::string
+AsynchronousWriteTestCase::ReadContents(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+uint32_t
+AsynchronousWriteTestCase::ReadUint32(const std::string& contents, std::size_t offset)
+{
+    uint32_t value = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(contents[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+void
+AsynchronousWriteTestCase::DoRun()
+{
+    //
+    // A file written in Asynchronous mode is identical to a file written by PcapFile.
+    //
+    const auto syncFilename = CreateTempDirFilename("sync.pcap");
+    const auto asyncFilename = CreateTempDirFilename("async.pcap");
+    auto syncFile = WriteRecords(syncFilename, false, 1000, 0, PcapBufferedFile::PCAP);
+    auto asyncFile = WriteRecords(asyncFilename, true, 1000, 0, PcapBufferedFile::PCAP);
+    NS_TEST_ASSERT_MSG_EQ(asyncFile->Fail(), false, "Writing " << asyncFilename << " failed");
+    NS_TEST_EXPECT_MSG_EQ(asyncFile->GetMagic(), syncFile->GetMagic(), "Unexpected magic");
+    NS_TEST_EXPECT_MSG_EQ(asyncFile->GetSnapLen(), SNAP_LEN, "Unexpected snap length");
+    syncFile->Close();
+    asyncFile->Flush();
+    const auto expected = ReadContents(syncFilename);
+    NS_TEST_EXPECT_MSG_EQ((ReadContents(asyncFilename) == expected),
+                          true,
+                          "The flushed file differs from the file written by PcapFile");
+    asyncFile->Close();
+    NS_TEST_EXPECT_MSG_EQ((ReadContents(asyncFilename) == expected),
+                          true,
+                          "The closed file differs from the file written by PcapFile");
+
+    //
+    // The buffered records are written when the simulator is destroyed.
+    //
+    asyncFile = WriteRecords(asyncFilename, true, 1 << 20, 0, PcapBufferedFile::PCAP);
+    NS_TEST_EXPECT_MSG_EQ(ReadContents(asyncFilename).size(),
+                          0,
+                          "The records should still be buffered");
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ((ReadContents(asyncFilename) == expected),
+                          true,
+                          "The records were not written when the simulator was destroyed");
+    remove(asyncFilename.c_str());
+
+    //
+    // The rotated files hold all the records, without exceeding their maximum size.
+    //
+    const uint32_t maxFileSize = 2000;
+    asyncFile = WriteRecords(asyncFilename, true, 1000, maxFileSize, PcapBufferedFile::PCAP);
+    asyncFile->Close();
+    const auto fileCount = asyncFile->GetFileCount();
+    NS_TEST_ASSERT_MSG_GT(fileCount, 1, "The file was not rotated");
+    uint32_t records = 0;
+    for (uint32_t index = 0; index < fileCount; ++index)
+    {
+        const auto filename = PcapBufferedFile::GetRotatedFileName(asyncFilename, index);
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(ReadContents(filename).size(),
+                                    maxFileSize,
+                                    "The file " << filename << " is too large");
+        PcapFile f;
+        f.Open(filename, std::ios::in);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Cannot read the rotated file " << filename);
+        NS_TEST_EXPECT_MSG_EQ(f.GetTimeZoneOffset(), 7, "Unexpected time zone offset");
+        uint8_t data[SNAP_LEN];
+        uint32_t tsSec;
+        uint32_t tsNsec;
+        uint32_t inclLen;
+        uint32_t origLen;
+        uint32_t readLen;
+        while (true)
+        {
+            f.Read(data, sizeof(data), tsSec, tsNsec, inclLen, origLen, readLen);
+            if (f.Fail())
+            {
+                break;
+            }
+            NS_TEST_EXPECT_MSG_EQ(tsSec * 1000000000ULL + tsNsec,
+                                  1234567ULL * records,
+                                  "Unexpected timestamp of record " << records);
+            NS_TEST_EXPECT_MSG_EQ(origLen,
+                                  GetRecordSize(records),
+                                  "Unexpected size of record " << records);
+            ++records;
+        }
+        f.Close();
+        remove(filename.c_str());
+    }
+    NS_TEST_EXPECT_MSG_EQ(records, N_RECORDS, "The rotated files do not hold all the records");
+
+    //
+    // The pcapng file holds a section header, an interface description, and a packet
+    // block per record.
+    //
+    const auto pcapngFilename = CreateTempDirFilename("async.pcapng");
+    asyncFile = WriteRecords(pcapngFilename, true, 1000, 0, PcapBufferedFile::PCAPNG);
+    asyncFile->Close();
+    const auto contents = ReadContents(pcapngFilename);
+    NS_TEST_ASSERT_MSG_GT(contents.size(), 60, "The pcapng file is too short");
+    NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, 0), 0x0a0d0d0a, "No section header block");
+    NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, 8), 0x1a2b3c4d, "Unexpected byte-order magic");
+    const std::size_t interface = ReadUint32(contents, 4);
+    NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, interface), 1, "No interface description block");
+    NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, interface + 8) & 0xffff,
+                          1,
+                          "Unexpected data link type");
+    NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, interface + 12), SNAP_LEN, "Unexpected snap length");
+    records = 0;
+    for (std::size_t offset = interface + ReadUint32(contents, interface + 4);
+         offset < contents.size();
+         offset += ReadUint32(contents, offset + 4))
+    {
+        const auto blockLength = ReadUint32(contents, offset + 4);
+        NS_TEST_ASSERT_MSG_EQ(ReadUint32(contents, offset), 6, "No enhanced packet block");
+        NS_TEST_ASSERT_MSG_EQ(ReadUint32(contents, offset + blockLength - 4),
+                              blockLength,
+                              "Unexpected trailing block length");
+        const uint64_t ts = (static_cast<uint64_t>(ReadUint32(contents, offset + 12)) << 32) |
+                            ReadUint32(contents, offset + 16);
+        NS_TEST_EXPECT_MSG_EQ(ts, 1234567ULL * records, "Unexpected timestamp");
+        const auto inclLen = ReadUint32(contents, offset + 20);
+        NS_TEST_EXPECT_MSG_EQ(inclLen,
+                              std::min(GetRecordSize(records), SNAP_LEN),
+                              "Unexpected captured length");
+        NS_TEST_EXPECT_MSG_EQ(ReadUint32(contents, offset + 24),
+                              GetRecordSize(records),
+                              "Unexpected original length");
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint8_t>(contents[offset + 28 + inclLen - 1]),
+                              static_cast<uint8_t>(records),
+                              "Unexpected packet data");
+        ++records;
+    }
+    NS_TEST_EXPECT_MSG_EQ(records, N_RECORDS, "The pcapng file does not hold all the records");
+
+    remove(syncFilename.c_str());
+    remove(pcapngFilename.c_str());
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1636,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AsynchronousWriteTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
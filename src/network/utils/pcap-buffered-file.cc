@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcap-buffered-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/buffer.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapBufferedFile");
+
+namespace
+{
+
+const uint32_t PCAP_MAGIC = 0xa1b2c3d4;      //!< Magic number of the pcap format
+const uint32_t PCAP_NS_MAGIC = 0xa1b23c4d;   //!< Magic number of the pcap format in nanoseconds
+const uint16_t PCAP_VERSION_MAJOR = 2;       //!< Major version of the pcap format
+const uint16_t PCAP_VERSION_MINOR = 4;       //!< Minor version of the pcap format
+const uint32_t PCAP_FILE_HEADER_SIZE = 24;   //!< Size of the pcap file header
+const uint32_t PCAP_RECORD_HEADER_SIZE = 16; //!< Size of the pcap record header
+
+const uint32_t PCAPNG_SECTION_HEADER_BLOCK = 0x0a0d0d0a;  //!< Type of the section header block
+const uint32_t PCAPNG_INTERFACE_BLOCK = 0x00000001;       //!< Type of the interface description
+const uint32_t PCAPNG_ENHANCED_PACKET_BLOCK = 0x00000006; //!< Type of the enhanced packet block
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d;      //!< Byte-order magic of the section
+const uint16_t PCAPNG_OPTION_END = 0;                     //!< Code of the end of the options
+const uint16_t PCAPNG_OPTION_TSRESOL = 9;                 //!< Code of the timestamp resolution
+const uint32_t PCAPNG_SECTION_HEADER_SIZE = 28;           //!< Size of the section header block
+const uint32_t PCAPNG_INTERFACE_SIZE = 32;                //!< Size of the interface description
+const uint32_t PCAPNG_PACKET_HEADER_SIZE = 28;            //!< Size of a packet block header
+
+/**
+ * Store an integer in little-endian order, which is the byte order of the
+ * files written by PcapFile.
+ *
+ * @tparam T \deduced the type of the integer
+ * @param [in] value the integer
+ * @param [out] out the location of the integer
+ * @return the location following the integer
+ */
+template <typename T>
+uint8_t*
+StoreLittleEndian(T value, uint8_t* out)
+{
+    for (std::size_t i = 0; i < sizeof(T); i++)
+    {
+        *out++ = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+    }
+    return out;
+}
+
+} // namespace
+
+/**
+ * A file written by the I/O thread.  The file is written only by the I/O
+ * thread once it has been opened, and is closed when the last buffer
+ * referencing it has been written.
+ */
+struct PcapBufferedFile::Stream
+{
+    std::ofstream file;  //!< the file
+    bool failed{false};  //!< whether writing the file failed, protected by the writer mutex
+    uint32_t pending{0}; //!< the number of buffers not written yet, protected by the writer mutex
+};
+
+/**
+ * The I/O thread, shared by all the buffered files, which writes the buffers
+ * in the order in which they were handed to it.
+ */
+class PcapBufferedFile::WriterThread
+{
+  public:
+    WriterThread();
+    ~WriterThread();
+
+    /**
+     * Get the I/O thread, which is started if no buffered file is open.
+     *
+     * @return the I/O thread
+     */
+    static std::shared_ptr<WriterThread> Get();
+
+    /**
+     * Hand a buffer to the thread, waiting if MAX_QUEUED_BYTES are queued.
+     *
+     * @param stream the file of the buffer
+     * @param buffer the buffer, which is replaced by an empty buffer
+     */
+    void Submit(const std::shared_ptr<Stream>& stream, std::vector<uint8_t>& buffer);
+
+    /**
+     * Wait until the buffers of a file have been written.
+     *
+     * @param stream the file
+     * @return true if writing the file failed
+     */
+    bool Wait(const std::shared_ptr<Stream>& stream);
+
+    /**
+     * @param stream the file
+     * @return true if writing the file failed
+     */
+    bool HasFailed(const std::shared_ptr<Stream>& stream);
+
+  private:
+    /// A buffer to write
+    struct Job
+    {
+        std::shared_ptr<Stream> stream; //!< the file
+        std::vector<uint8_t> data;      //!< the records
+    };
+
+    /// The loop of the thread
+    void Run();
+
+    std::mutex m_mutex;                              //!< the mutex of the members below
+    std::condition_variable m_jobAdded;              //!< notified when a job is queued
+    std::condition_variable m_jobDone;               //!< notified when a job is written
+    std::deque<Job> m_jobs;                          //!< the buffers to write
+    std::vector<std::vector<uint8_t>> m_freeBuffers; //!< the written buffers, for reuse
+    uint64_t m_queuedBytes{0};                       //!< the number of bytes to write
+    bool m_stop{false};                              //!< whether the thread must stop
+    std::thread m_thread;                            //!< the thread
+};
+
+PcapBufferedFile::WriterThread::WriterThread()
+{
+    NS_LOG_FUNCTION(this);
+    m_thread = std::thread(&WriterThread::Run, this);
+}
+
+PcapBufferedFile::WriterThread::~WriterThread()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobAdded.notify_one();
+    m_thread.join();
+}
+
+std::shared_ptr<PcapBufferedFile::WriterThread>
+PcapBufferedFile::WriterThread::Get()
+{
+    static std::mutex mutex;
+    static std::weak_ptr<WriterThread> instance;
+    std::lock_guard lock(mutex);
+    auto writer = instance.lock();
+    if (!writer)
+    {
+        writer = std::make_shared<WriterThread>();
+        instance = writer;
+    }
+    return writer;
+}
+
+void
+PcapBufferedFile::WriterThread::Submit(const std::shared_ptr<Stream>& stream,
+                                       std::vector<uint8_t>& buffer)
+{
+    std::unique_lock lock(m_mutex);
+    m_jobDone.wait(lock, [this] { return m_queuedBytes <= MAX_QUEUED_BYTES; });
+    m_queuedBytes += buffer.size();
+    stream->pending++;
+    const auto capacity = buffer.capacity();
+    m_jobs.push_back({stream, std::move(buffer)});
+    buffer = std::vector<uint8_t>();
+    if (!m_freeBuffers.empty())
+    {
+        buffer.swap(m_freeBuffers.back());
+        m_freeBuffers.pop_back();
+    }
+    lock.unlock();
+    m_jobAdded.notify_one();
+    buffer.reserve(capacity);
+}
+
+bool
+PcapBufferedFile::WriterThread::Wait(const std::shared_ptr<Stream>& stream)
+{
+    std::unique_lock lock(m_mutex);
+    m_jobDone.wait(lock, [&stream] { return stream->pending == 0; });
+    return stream->failed;
+}
+
+bool
+PcapBufferedFile::WriterThread::HasFailed(const std::shared_ptr<Stream>& stream)
+{
+    std::lock_guard lock(m_mutex);
+    return stream->failed;
+}
+
+void
+PcapBufferedFile::WriterThread::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_jobAdded.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty())
+        {
+            return;
+        }
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        // the file is only written by this thread, and flushed after each buffer
+        // so that the records handed to the thread are in the file system
+        job.stream->file.write(reinterpret_cast<const char*>(job.data.data()), job.data.size());
+        job.stream->file.flush();
+        const bool failed = job.stream->file.fail();
+
+        lock.lock();
+        job.stream->failed = job.stream->failed || failed;
+        job.stream->pending--;
+        m_queuedBytes -= job.data.size();
+        // keep a few buffers, enough for the files written at the same time to reuse them
+        if (m_freeBuffers.size() < 16)
+        {
+            job.data.clear();
+            m_freeBuffers.push_back(std::move(job.data));
+        }
+        // the last reference to a rotated file is released by the thread, which closes it
+        job.stream.reset();
+        m_jobDone.notify_all();
+    }
+}
+
+PcapBufferedFile::PcapBufferedFile()
+    : m_format(PCAP),
+      m_bufferSize(0),
+      m_maxFileSize(0),
+      m_fileSize(0),
+      m_fileHeaderSize(0),
+      m_fileCount(0),
+      m_initialized(false),
+      m_dataLinkType(0),
+      m_snapLen(0),
+      m_timeZoneCorrection(0),
+      m_nanosecMode(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapBufferedFile::~PcapBufferedFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+PcapBufferedFile::Open(const std::string& filename,
+                       Format format,
+                       uint32_t bufferSize,
+                       uint64_t maxFileSize)
+{
+    NS_LOG_FUNCTION(this << filename << format << bufferSize << maxFileSize);
+    Close();
+    m_filename = filename;
+    m_format = format;
+    m_bufferSize = bufferSize;
+    m_maxFileSize = maxFileSize;
+    m_fileSize = 0;
+    m_fileHeaderSize = 0;
+    m_fileCount = 1;
+    m_initialized = false;
+    m_writer = WriterThread::Get();
+    m_buffer.reserve(m_bufferSize);
+    OpenStream();
+}
+
+void
+PcapBufferedFile::OpenStream()
+{
+    NS_LOG_FUNCTION(this);
+    const auto filename = GetRotatedFileName(m_filename, m_fileCount - 1);
+    // the file is opened by this thread, so that an error is reported by Fail() right away
+    m_stream = std::make_shared<Stream>();
+    m_stream->file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+    m_stream->failed = m_stream->file.fail();
+    NS_LOG_LOGIC("Opened " << filename);
+}
+
+void
+PcapBufferedFile::Init(uint32_t dataLinkType,
+                       uint32_t snapLen,
+                       int32_t timeZoneCorrection,
+                       bool nanosecMode)
+{
+    NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << nanosecMode);
+    NS_ABORT_MSG_IF(!m_stream, "PcapBufferedFile::Init called on a closed file");
+    NS_ABORT_MSG_IF(m_initialized, "PcapBufferedFile::Init called twice");
+    m_dataLinkType = dataLinkType;
+    m_snapLen = snapLen;
+    m_timeZoneCorrection = timeZoneCorrection;
+    m_nanosecMode = nanosecMode;
+    m_initialized = true;
+    WriteFileHeader();
+}
+
+void
+PcapBufferedFile::WriteFileHeader()
+{
+    NS_LOG_FUNCTION(this);
+    const auto start = m_buffer.size();
+    if (m_format == PCAP)
+    {
+        m_buffer.resize(start + PCAP_FILE_HEADER_SIZE);
+        auto out = m_buffer.data() + start;
+        out = StoreLittleEndian(m_nanosecMode ? PCAP_NS_MAGIC : PCAP_MAGIC, out);
+        out = StoreLittleEndian(PCAP_VERSION_MAJOR, out);
+        out = StoreLittleEndian(PCAP_VERSION_MINOR, out);
+        out = StoreLittleEndian(m_timeZoneCorrection, out);
+        out = StoreLittleEndian(uint32_t{0}, out); // sigfigs
+        out = StoreLittleEndian(m_snapLen, out);
+        StoreLittleEndian(m_dataLinkType, out);
+    }
+    else
+    {
+        m_buffer.resize(start + PCAPNG_SECTION_HEADER_SIZE + PCAPNG_INTERFACE_SIZE);
+        auto out = m_buffer.data() + start;
+        out = StoreLittleEndian(PCAPNG_SECTION_HEADER_BLOCK, out);
+        out = StoreLittleEndian(PCAPNG_SECTION_HEADER_SIZE, out);
+        out = StoreLittleEndian(PCAPNG_BYTE_ORDER_MAGIC, out);
+        out = StoreLittleEndian(uint16_t{1}, out); // major version
+        out = StoreLittleEndian(uint16_t{0}, out); // minor version
+        out = StoreLittleEndian(int64_t{-1}, out); // unspecified section length
+        out = StoreLittleEndian(PCAPNG_SECTION_HEADER_SIZE, out);
+
+        out = StoreLittleEndian(PCAPNG_INTERFACE_BLOCK, out);
+        out = StoreLittleEndian(PCAPNG_INTERFACE_SIZE, out);
+        out = StoreLittleEndian(static_cast<uint16_t>(m_dataLinkType), out);
+        out = StoreLittleEndian(uint16_t{0}, out); // reserved
+        out = StoreLittleEndian(m_snapLen, out);
+        // the timestamps are in units of 10^-if_tsresol seconds
+        out = StoreLittleEndian(PCAPNG_OPTION_TSRESOL, out);
+        out = StoreLittleEndian(uint16_t{1}, out);
+        out = StoreLittleEndian(uint32_t{m_nanosecMode ? 9U : 6U}, out); // value and padding
+        out = StoreLittleEndian(PCAPNG_OPTION_END, out);
+        out = StoreLittleEndian(uint16_t{0}, out);
+        StoreLittleEndian(PCAPNG_INTERFACE_SIZE, out);
+    }
+    m_fileHeaderSize = m_buffer.size() - start;
+    m_fileSize = m_fileHeaderSize;
+}
+
+uint8_t*
+PcapBufferedFile::AppendRecord(Time t, uint32_t totalLen, uint32_t& inclLen)
+{
+    NS_ASSERT_MSG(m_initialized, "PcapBufferedFile::Init must be called before writing records");
+    inclLen = std::min(totalLen, m_snapLen);
+    // the packet blocks of pcapng are padded to 32 bits
+    const uint32_t recordSize = (m_format == PCAP)
+                                    ? PCAP_RECORD_HEADER_SIZE + inclLen
+                                    : PCAPNG_PACKET_HEADER_SIZE + ((inclLen + 3) & ~3U) + 4;
+    if (m_maxFileSize > 0 && m_fileSize > m_fileHeaderSize &&
+        m_fileSize + recordSize > m_maxFileSize)
+    {
+        Rotate();
+    }
+
+    const auto start = m_buffer.size();
+    m_buffer.resize(start + recordSize);
+    m_fileSize += recordSize;
+    auto out = m_buffer.data() + start;
+    const uint64_t ts = m_nanosecMode ? t.GetNanoSeconds() : t.GetMicroSeconds();
+    if (m_format == PCAP)
+    {
+        const uint64_t unitsPerSecond = m_nanosecMode ? 1000000000 : 1000000;
+        out = StoreLittleEndian(static_cast<uint32_t>(ts / unitsPerSecond), out);
+        out = StoreLittleEndian(static_cast<uint32_t>(ts % unitsPerSecond), out);
+        out = StoreLittleEndian(inclLen, out);
+        return StoreLittleEndian(totalLen, out);
+    }
+    out = StoreLittleEndian(PCAPNG_ENHANCED_PACKET_BLOCK, out);
+    out = StoreLittleEndian(recordSize, out);
+    out = StoreLittleEndian(uint32_t{0}, out); // interface
+    out = StoreLittleEndian(static_cast<uint32_t>(ts >> 32), out);
+    out = StoreLittleEndian(static_cast<uint32_t>(ts), out);
+    out = StoreLittleEndian(inclLen, out);
+    out = StoreLittleEndian(totalLen, out);
+    // the padding is zeroed by resize(), the block ends with its length
+    StoreLittleEndian(recordSize, m_buffer.data() + m_buffer.size() - 4);
+    return out;
+}
+
+void
+PcapBufferedFile::EndRecord()
+{
+    if (m_buffer.size() >= m_bufferSize)
+    {
+        Submit();
+    }
+}
+
+void
+PcapBufferedFile::Rotate()
+{
+    NS_LOG_FUNCTION(this);
+    // the current file is closed by the I/O thread, once its last buffer is written
+    Submit();
+    m_fileCount++;
+    OpenStream();
+    WriteFileHeader();
+}
+
+void
+PcapBufferedFile::Submit()
+{
+    if (!m_buffer.empty())
+    {
+        m_writer->Submit(m_stream, m_buffer);
+    }
+}
+
+void
+PcapBufferedFile::Write(Time t, const uint8_t* data, uint32_t totalLen)
+{
+    NS_LOG_FUNCTION(this << t << &data << totalLen);
+    uint32_t inclLen = 0;
+    auto out = AppendRecord(t, totalLen, inclLen);
+    std::copy_n(data, inclLen, out);
+    EndRecord();
+}
+
+void
+PcapBufferedFile::Write(Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << t << p);
+    uint32_t inclLen = 0;
+    auto out = AppendRecord(t, p->GetSize(), inclLen);
+    p->CopyData(out, inclLen);
+    EndRecord();
+}
+
+void
+PcapBufferedFile::Write(Time t, const Header& header, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << t << &header << p);
+    const uint32_t headerSize = header.GetSerializedSize();
+    uint32_t inclLen = 0;
+    auto out = AppendRecord(t, headerSize + p->GetSize(), inclLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    const uint32_t toCopy = std::min(headerSize, inclLen);
+    headerBuffer.CopyData(out, toCopy);
+    p->CopyData(out + toCopy, inclLen - toCopy);
+    EndRecord();
+}
+
+void
+PcapBufferedFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_stream)
+    {
+        Submit();
+        m_writer->Wait(m_stream);
+    }
+}
+
+void
+PcapBufferedFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_stream)
+    {
+        return;
+    }
+    Flush();
+    m_stream.reset();
+    m_buffer = std::vector<uint8_t>();
+    // the I/O thread is stopped when the last buffered file is closed
+    m_writer.reset();
+}
+
+bool
+PcapBufferedFile::Fail() const
+{
+    return !m_stream || m_writer->HasFailed(m_stream);
+}
+
+PcapBufferedFile::Format
+PcapBufferedFile::GetFormat() const
+{
+    return m_format;
+}
+
+uint32_t
+PcapBufferedFile::GetFileCount() const
+{
+    return m_fileCount;
+}
+
+uint32_t
+PcapBufferedFile::GetMagic() const
+{
+    if (m_format == PCAPNG)
+    {
+        return PCAPNG_BYTE_ORDER_MAGIC;
+    }
+    return m_nanosecMode ? PCAP_NS_MAGIC : PCAP_MAGIC;
+}
+
+uint16_t
+PcapBufferedFile::GetVersionMajor() const
+{
+    return m_format == PCAP ? PCAP_VERSION_MAJOR : 1;
+}
+
+uint16_t
+PcapBufferedFile::GetVersionMinor() const
+{
+    return m_format == PCAP ? PCAP_VERSION_MINOR : 0;
+}
+
+int32_t
+PcapBufferedFile::GetTimeZoneOffset() const
+{
+    return m_timeZoneCorrection;
+}
+
+uint32_t
+PcapBufferedFile::GetSnapLen() const
+{
+    return m_snapLen;
+}
+
+uint32_t
+PcapBufferedFile::GetDataLinkType() const
+{
+    return m_dataLinkType;
+}
+
+bool
+PcapBufferedFile::IsNanoSecMode() const
+{
+    return m_nanosecMode;
+}
+
+std::string
+PcapBufferedFile::GetRotatedFileName(const std::string& filename, uint32_t index)
+{
+    if (index == 0)
+    {
+        return filename;
+    }
+    // the extension is the part of the base name after its last dot, if any
+    const auto slash = filename.find_last_of("/\\");
+    const auto dot = filename.find_last_of('.');
+    const auto position = (dot == std::string::npos ||
+                           (slash != std::string::npos && dot < slash) || dot == slash + 1)
+                              ? filename.size()
+                              : dot;
+    return filename.substr(0, position) + "-" + std::to_string(index) + filename.substr(position);
+}
+
+} // namespace ns3
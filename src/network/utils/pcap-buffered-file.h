@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAP_BUFFERED_FILE_H
+#define PCAP_BUFFERED_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+class Header;
+
+/**
+ * @brief A pcap or pcapng file written from memory buffers by a background
+ * I/O thread.
+ *
+ * The records are serialized in a memory buffer of the file, which is handed
+ * to an I/O thread shared by all the buffered files when it holds at least a
+ * given number of bytes, so that the thread writing the records never waits
+ * for the file system, unless the I/O thread lags behind by more than
+ * MAX_QUEUED_BYTES bytes.  The I/O thread is started when the first buffered
+ * file is opened, and stopped when the last one is closed.
+ *
+ * The file can be written in the pcap format, in which case it is identical
+ * to a file written by PcapFile, or in the pcapng format, with a single
+ * section and a single interface.  The file can also be rotated: when a
+ * record would make the current file exceed a maximum size, the file is
+ * closed and the following records are written to a new file, named by
+ * GetRotatedFileName(), which starts with its own file header.
+ *
+ * The records written since the last buffer handed to the I/O thread are
+ * only in memory: Flush() or Close() must be called to write them.
+ */
+class PcapBufferedFile
+{
+  public:
+    /// The file formats
+    enum Format : uint8_t
+    {
+        PCAP, //!< The pcap (libpcap) format
+        PCAPNG //!< The pcapng format
+    };
+
+    /// The maximum number of bytes handed to the I/O thread and not written yet
+    static const uint64_t MAX_QUEUED_BYTES = 64 * 1024 * 1024;
+
+    PcapBufferedFile();
+    ~PcapBufferedFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PcapBufferedFile(const PcapBufferedFile&) = delete;
+    PcapBufferedFile& operator=(const PcapBufferedFile&) = delete;
+
+    /**
+     * Create a new file, or empty an existing file, to write records.
+     *
+     * @param filename the name of the file
+     * @param format the format of the file
+     * @param bufferSize the number of bytes of records buffered before they
+     * are handed to the I/O thread
+     * @param maxFileSize the maximum size of a file, in bytes, after which the
+     * file is rotated, or 0 to never rotate the file.  A file holds at least
+     * one record, even if it is larger than this size.
+     */
+    void Open(const std::string& filename,
+              Format format,
+              uint32_t bufferSize,
+              uint64_t maxFileSize);
+
+    /**
+     * Write the file header, and set the parameters of the records.
+     *
+     * @param dataLinkType the data link type of the records, as in PcapFile::Init
+     * @param snapLen the maximum number of bytes of a packet stored in a record
+     * @param timeZoneCorrection the offset of the local time zone from UTC, in
+     * hours, which is only stored in the pcap format
+     * @param nanosecMode whether the timestamps are stored in nanoseconds, rather
+     * than in microseconds
+     */
+    void Init(uint32_t dataLinkType,
+              uint32_t snapLen,
+              int32_t timeZoneCorrection,
+              bool nanosecMode);
+
+    /**
+     * @brief Write a record holding a data buffer
+     *
+     * @param t the timestamp of the record
+     * @param data the data buffer
+     * @param totalLen the size of the data buffer
+     */
+    void Write(Time t, const uint8_t* data, uint32_t totalLen);
+
+    /**
+     * @brief Write a record holding a packet
+     *
+     * @param t the timestamp of the record
+     * @param p the packet
+     */
+    void Write(Time t, Ptr<const Packet> p);
+
+    /**
+     * @brief Write a record holding a header followed by a packet
+     *
+     * @param t the timestamp of the record
+     * @param header the header
+     * @param p the packet
+     */
+    void Write(Time t, const Header& header, Ptr<const Packet> p);
+
+    /**
+     * Hand the buffered records to the I/O thread, and wait until all the
+     * records of the file have been written.
+     */
+    void Flush();
+
+    /**
+     * Write the buffered records and close the file.
+     */
+    void Close();
+
+    /**
+     * @return true if the file is not open, or if writing a file failed
+     */
+    bool Fail() const;
+
+    /**
+     * @return the format of the file
+     */
+    Format GetFormat() const;
+
+    /**
+     * @return the number of files written since the file was opened, including
+     * the current file
+     */
+    uint32_t GetFileCount() const;
+
+    /**
+     * @return the magic number of the pcap file header, or the byte-order magic
+     * of the pcapng section header
+     */
+    uint32_t GetMagic() const;
+
+    /**
+     * @return the major version of the file format
+     */
+    uint16_t GetVersionMajor() const;
+
+    /**
+     * @return the minor version of the file format
+     */
+    uint16_t GetVersionMinor() const;
+
+    /**
+     * @return the time zone offset set by Init()
+     */
+    int32_t GetTimeZoneOffset() const;
+
+    /**
+     * @return the maximum number of bytes of a packet stored in a record
+     */
+    uint32_t GetSnapLen() const;
+
+    /**
+     * @return the data link type of the records
+     */
+    uint32_t GetDataLinkType() const;
+
+    /**
+     * @return whether the timestamps are stored in nanoseconds
+     */
+    bool IsNanoSecMode() const;
+
+    /**
+     * Get the name of a rotated file: the files after the first one are
+     * numbered from 1, with the number inserted before the extension, e.g.,
+     * "trace.pcap", "trace-1.pcap", "trace-2.pcap".
+     *
+     * @param filename the name of the first file
+     * @param index the index of the file, from 0
+     * @return the name of the file
+     */
+    static std::string GetRotatedFileName(const std::string& filename, uint32_t index);
+
+  private:
+    class WriterThread;
+    struct Stream;
+
+    /**
+     * Append the file header to the buffer.
+     */
+    void WriteFileHeader();
+
+    /**
+     * Append a record to the buffer, rotating the file if needed.
+     *
+     * @param t the timestamp of the record
+     * @param totalLen the size of the packet
+     * @param[out] inclLen the number of bytes of the packet stored in the record
+     * @return the location of the packet bytes of the record in the buffer
+     */
+    uint8_t* AppendRecord(Time t, uint32_t totalLen, uint32_t& inclLen);
+
+    /**
+     * Hand the buffer to the I/O thread if it holds enough records.
+     */
+    void EndRecord();
+
+    /**
+     * Close the current file and open the next one.
+     */
+    void Rotate();
+
+    /**
+     * Open the current file.
+     */
+    void OpenStream();
+
+    /**
+     * Hand the buffered records to the I/O thread.
+     */
+    void Submit();
+
+    std::shared_ptr<WriterThread> m_writer; //!< the I/O thread
+    std::shared_ptr<Stream> m_stream;       //!< the current file
+    std::vector<uint8_t> m_buffer;          //!< the records not handed to the I/O thread
+    std::string m_filename;                 //!< the name of the first file
+    Format m_format;                        //!< the file format
+    uint32_t m_bufferSize;                  //!< the size of the buffer handed to the I/O thread
+    uint64_t m_maxFileSize;                 //!< the size of a file triggering its rotation
+    uint64_t m_fileSize;                    //!< the size of the current file, with its buffer
+    uint32_t m_fileHeaderSize;              //!< the size of the file header
+    uint32_t m_fileCount;                   //!< the number of files written
+    bool m_initialized;                     //!< whether Init() was called
+    uint32_t m_dataLinkType;                //!< the data link type
+    uint32_t m_snapLen;                     //!< the maximum size of a packet in a record
+    int32_t m_timeZoneCorrection;           //!< the time zone offset
+    bool m_nanosecMode;                     //!< whether the timestamps are in nanoseconds
+};
+
+} // namespace ns3
+
+#endif /* PCAP_BUFFERED_FILE_H */
@@ -6,10 +6,13 @@
 
 #include "pcap-file-wrapper.h"
 
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
 #include "ns3/buffer.h"
+#include "ns3/enum.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
 namespace ns3
@@ -37,7 +40,34 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("Asynchronous",
+                          "Whether the files opened for writing are buffered in memory and "
+                          "written by a background I/O thread.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asynchronous),
+                          MakeBooleanChecker())
+            .AddAttribute("BufferSize",
+                          "The number of bytes of records buffered before they are handed to "
+                          "the I/O thread, in Asynchronous mode.",
+                          UintegerValue(1 << 20),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MaxFileSize",
+                          "The size in bytes after which a new file is started, in "
+                          "Asynchronous mode (0 means no limit). The files after the first "
+                          "one are numbered from 1, e.g., trace-1.pcap.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_maxFileSize),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("Format",
+                          "The format of the files written in Asynchronous mode.",
+                          EnumValue(PcapBufferedFile::PCAP),
+                          MakeEnumAccessor<PcapBufferedFile::Format>(&PcapFileWrapper::m_format),
+                          MakeEnumChecker(PcapBufferedFile::PCAP,
+                                          "Pcap",
+                                          PcapBufferedFile::PCAPNG,
+                                          "Pcapng"));
     return tid;
 }
 
@@ -56,6 +86,10 @@ bool
 PcapFileWrapper::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->Fail();
+    }
     return m_file.Fail();
 }
 
@@ -77,14 +111,51 @@ void
 PcapFileWrapper::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Close();
+        m_fileCount = m_bufferedFile->GetFileCount();
+        m_bufferedFile.reset();
+        Simulator::Cancel(m_closeEvent);
+    }
     m_file.Close();
 }
 
+void
+PcapFileWrapper::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Flush();
+    }
+}
+
+uint32_t
+PcapFileWrapper::GetFileCount() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_bufferedFile ? m_bufferedFile->GetFileCount() : m_fileCount;
+}
+
 void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
-    m_file.Open(filename, mode);
+    m_fileCount = 1;
+    if (!m_asynchronous || (mode & std::ios::in) || !(mode & std::ios::out))
+    {
+        m_file.Open(filename, mode);
+        return;
+    }
+    NS_ASSERT((mode & std::ios::app) == 0);
+    if (!m_bufferedFile)
+    {
+        m_bufferedFile = std::make_unique<PcapBufferedFile>();
+        // the buffered records must be written even if the wrapper outlives the simulation
+        m_closeEvent = Simulator::ScheduleDestroy(&PcapFileWrapper::Close, this);
+    }
+    m_bufferedFile->Open(filename, m_format, m_bufferSize, m_maxFileSize);
 }
 
 void
@@ -96,13 +167,17 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     // a snaplen, we use the one provided.
     //
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
-    if (snapLen != std::numeric_limits<uint32_t>::max())
+    if (snapLen == std::numeric_limits<uint32_t>::max())
     {
-        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
+        snapLen = m_snapLen;
+    }
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Init(dataLinkType, snapLen, tzCorrection, m_nanosecMode);
     }
     else
     {
-        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
+        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
     }
 }
 
@@ -110,6 +185,11 @@ void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Write(t, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -130,6 +210,11 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Write(t, header, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -150,6 +235,11 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (m_bufferedFile)
+    {
+        m_bufferedFile->Write(t, buffer, length);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -200,6 +290,10 @@ uint32_t
 PcapFileWrapper::GetMagic()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetMagic();
+    }
     return m_file.GetMagic();
 }
 
@@ -207,6 +301,10 @@ uint16_t
 PcapFileWrapper::GetVersionMajor()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetVersionMajor();
+    }
     return m_file.GetVersionMajor();
 }
 
@@ -214,6 +312,10 @@ uint16_t
 PcapFileWrapper::GetVersionMinor()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetVersionMinor();
+    }
     return m_file.GetVersionMinor();
 }
 
@@ -221,6 +323,10 @@ int32_t
 PcapFileWrapper::GetTimeZoneOffset()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetTimeZoneOffset();
+    }
     return m_file.GetTimeZoneOffset();
 }
 
@@ -228,6 +334,10 @@ uint32_t
 PcapFileWrapper::GetSigFigs()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return 0;
+    }
     return m_file.GetSigFigs();
 }
 
@@ -235,6 +345,10 @@ uint32_t
 PcapFileWrapper::GetSnapLen()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetSnapLen();
+    }
     return m_file.GetSnapLen();
 }
 
@@ -242,6 +356,10 @@ uint32_t
 PcapFileWrapper::GetDataLinkType()
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferedFile)
+    {
+        return m_bufferedFile->GetDataLinkType();
+    }
     return m_file.GetDataLinkType();
 }
 
@@ -7,8 +7,10 @@
 #ifndef PCAP_FILE_WRAPPER_H
 #define PCAP_FILE_WRAPPER_H
 
+#include "pcap-buffered-file.h"
 #include "pcap-file.h"
 
+#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/packet.h"
@@ -17,6 +19,7 @@
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <memory>
 
 namespace ns3
 {
@@ -26,6 +29,13 @@ namespace ns3
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * When the Asynchronous attribute is set, the files opened for writing are
+ * written by a PcapBufferedFile instead of a PcapFile: the records are
+ * buffered in memory and written by a background I/O thread, the file can be
+ * rotated when it reaches the MaxFileSize attribute, and it can be written in
+ * the pcapng format.  The buffered records are written when the file is
+ * closed, at the latest when the simulator is destroyed.
  */
 class PcapFileWrapper : public Object
 {
@@ -72,6 +82,18 @@ class PcapFileWrapper : public Object
      */
     void Close();
 
+    /**
+     * Write the records buffered in Asynchronous mode to the file, and wait
+     * until they are written.  Does nothing in synchronous mode.
+     */
+    void Flush();
+
+    /**
+     * @return the number of files written since the file was opened, which is
+     * larger than 1 if the file was rotated in Asynchronous mode
+     */
+    uint32_t GetFileCount() const;
+
     /**
      * Initialize the pcap file associated with this wrapper.  This file must have
      * been previously opened with write permissions.
@@ -211,9 +233,16 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;                                  //!< Pcap file
+    uint32_t m_snapLen;                               //!< max length of saved packets
+    bool m_nanosecMode;                               //!< Timestamps in nanosecond mode
+    bool m_asynchronous;                              //!< Whether files are written asynchronously
+    uint32_t m_bufferSize;                            //!< Size of the asynchronous buffers
+    uint64_t m_maxFileSize;                           //!< Size of the rotated files
+    PcapBufferedFile::Format m_format;                //!< Format of the asynchronous files
+    std::unique_ptr<PcapBufferedFile> m_bufferedFile; //!< File open in Asynchronous mode
+    EventId m_closeEvent;                             //!< Closes the file at simulator destroy
+    uint32_t m_fileCount{1};                          //!< Files written by the last closed file
 };
 
 } // namespace ns3
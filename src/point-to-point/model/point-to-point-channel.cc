@@ -9,6 +9,8 @@
 #include "point-to-point-net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -71,9 +73,29 @@ PointToPointChannel::Attach(Ptr<PointToPointNetDevice> device)
         m_link[1].m_dst = m_link[0].m_src;
         m_link[0].m_state = IDLE;
         m_link[1].m_state = IDLE;
+        // cache the node ids before the simulation runs, if the devices are
+        // already added to their nodes
+        for (uint32_t wire = 0; wire < N_DEVICES; wire++)
+        {
+            if (m_link[wire].m_dst->GetNode())
+            {
+                GetDestinationNodeId(wire);
+            }
+        }
     }
 }
 
+uint32_t
+PointToPointChannel::GetDestinationNodeId(uint32_t wire)
+{
+    Link& link = m_link[wire];
+    if (link.m_dstNodeId == Simulator::NO_CONTEXT)
+    {
+        link.m_dstNodeId = link.m_dst->GetNode()->GetId();
+    }
+    return link.m_dstNodeId;
+}
+
 bool
 PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime)
 {
@@ -84,15 +106,25 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
     NS_ASSERT(m_link[1].m_state != INITIALIZING);
 
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+    uint32_t context = GetDestinationNodeId(wire);
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
+    // The receiver may run in another thread with the MultithreadedSimulatorImpl,
+    // hence it gets a deep copy of the packet, and the event holds a raw pointer
+    // to the device, whose reference count must not be modified by both threads
+    // (the device is kept alive by this channel)
+    Simulator::ScheduleWithContext(context,
                                    txTime + m_delay,
                                    &PointToPointNetDevice::Receive,
-                                   m_link[wire].m_dst,
-                                   p->Copy());
+                                   PeekPointer(m_link[wire].m_dst),
+                                   MultithreadedSimulatorImpl::IsRemoteContext(context)
+                                       ? p->DeepCopy()
+                                       : p->Copy());
 
     // Call the tx anim callback on the net device
-    m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+    if (!m_txrxPointToPoint.IsEmpty())
+    {
+        m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+    }
     return true;
 }
 
@@ -111,6 +143,14 @@ PointToPointChannel::GetPointToPointDevice(std::size_t i) const
     return m_link[i].m_src;
 }
 
+Address
+PointToPointChannel::GetRemoteAddress(const PointToPointNetDevice* device) const
+{
+    NS_ASSERT(m_nDevices == N_DEVICES);
+    uint32_t wire = device == PeekPointer(m_link[0].m_src) ? 0 : 1;
+    return m_link[wire].m_dst->GetAddress();
+}
+
 Ptr<NetDevice>
 PointToPointChannel::GetDevice(std::size_t i) const
 {
@@ -7,10 +7,12 @@
 #ifndef POINT_TO_POINT_CHANNEL_H
 #define POINT_TO_POINT_CHANNEL_H
 
+#include "ns3/address.h"
 #include "ns3/channel.h"
 #include "ns3/data-rate.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
 #include <list>
@@ -83,6 +85,18 @@ class PointToPointChannel : public Channel
      */
     Ptr<PointToPointNetDevice> GetPointToPointDevice(std::size_t i) const;
 
+    /**
+     * @brief Get the address of the device at the other end of the channel
+     *
+     * Unlike GetPointToPointDevice(), the remote device is not referenced
+     * through a Ptr, as it can be used concurrently by another partition of
+     * the MultithreadedSimulatorImpl.
+     *
+     * @param device One of the two devices attached to this channel
+     * @returns The address of the other device
+     */
+    Address GetRemoteAddress(const PointToPointNetDevice* device) const;
+
     /**
      * @brief Get NetDevice corresponding to index i on this channel
      * @param i Index number of the device requested
@@ -193,8 +207,22 @@ class PointToPointChannel : public Channel
         WireState m_state{INITIALIZING};  //!< State of the link
         Ptr<PointToPointNetDevice> m_src; //!< First NetDevice
         Ptr<PointToPointNetDevice> m_dst; //!< Second NetDevice
+        /** Id of the node of the second NetDevice, i.e., context of the receptions */
+        uint32_t m_dstNodeId{Simulator::NO_CONTEXT};
     };
 
+    /**
+     * Get the id of the node receiving the packets of a wire.
+     *
+     * The id is cached, so that the transmitter does not reference the
+     * node of the receiver, which can be in another partition of the
+     * MultithreadedSimulatorImpl.
+     *
+     * @param wire the wire
+     * @returns the node id
+     */
+    uint32_t GetDestinationNodeId(uint32_t wire);
+
     Link m_link[N_DEVICES]; //!< Link model
 };
 
@@ -6,14 +6,21 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/config.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-helper.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
+#include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +135,160 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test the PointToPointChannel between two partitions of the
+ * MultithreadedSimulatorImpl
+ *
+ * The two nodes of a PointToPointChannel are put in different partitions,
+ * and send packets to each other.  The packets received, and their uids,
+ * must not depend on the number of threads.
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointMultithreadedTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /// Packets received by a node: (reception time, uid relative to the first uid, size)
+    using Trace = std::vector<std::tuple<int64_t, uint64_t, uint32_t>>;
+
+    /**
+     * @brief Run the simulation
+     *
+     * @param threads The number of threads.
+     * @return The packets received by the two nodes.
+     */
+    std::vector<Trace> RunModel(uint32_t threads);
+
+    /**
+     * @brief Send a packet, and schedule the next one
+     *
+     * @param device NetDevice to send from.
+     * @param count Number of packets left to send.
+     */
+    void Send(Ptr<PointToPointNetDevice> device, uint32_t count);
+
+    /**
+     * @brief Record a received packet
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    std::vector<Trace> m_traces; //!< packets received by the nodes
+    uint64_t m_firstUid{0};      //!< uid of the packet created before the simulation
+};
+
+/// Number of packets sent by each node
+static constexpr uint32_t N_PACKETS = 100;
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest()
+    : TestCase("PointToPoint between partitions of the MultithreadedSimulatorImpl")
+{
+}
+
+void
+PointToPointMultithreadedTest::Send(Ptr<PointToPointNetDevice> device, uint32_t count)
+{
+    // the packets are created by the partition of the sender
+    Ptr<Packet> p = Create<Packet>(100 + count);
+    device->Send(p, device->GetBroadcast(), 0x800);
+    if (count > 1)
+    {
+        Simulator::Schedule(MicroSeconds(100 + 37 * (count % 5)),
+                            &PointToPointMultithreadedTest::Send,
+                            this,
+                            device,
+                            count - 1);
+    }
+}
+
+bool
+PointToPointMultithreadedTest::RxPacket(Ptr<NetDevice> dev,
+                                        Ptr<const Packet> pkt,
+                                        uint16_t mode,
+                                        const Address& sender)
+{
+    uint32_t nodeId = dev->GetNode()->GetId();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), nodeId, "Packet received in the wrong context");
+    m_traces[nodeId % 2].emplace_back(Simulator::Now().GetNanoSeconds(),
+                                      pkt->GetUid() - m_firstUid,
+                                      pkt->GetSize());
+    return true;
+}
+
+std::vector<PointToPointMultithreadedTest::Trace>
+PointToPointMultithreadedTest::RunModel(uint32_t threads)
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount", UintegerValue(2));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue(threads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Lookahead",
+                       TimeValue(MicroSeconds(500)));
+
+    // consecutive node ids, hence the nodes are in different partitions
+    NodeContainer nodes(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    p2p.SetChannelAttribute("Delay", TimeValue(MicroSeconds(500)));
+    auto devices = p2p.Install(nodes);
+
+    m_traces.assign(2, Trace());
+    m_firstUid = Create<Packet>()->GetUid();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto device = DynamicCast<PointToPointNetDevice>(devices.Get(i));
+        device->SetReceiveCallback(MakeCallback(&PointToPointMultithreadedTest::RxPacket, this));
+        Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                       MicroSeconds(10 * (i + 1)),
+                                       &PointToPointMultithreadedTest::Send,
+                                       this,
+                                       device,
+                                       N_PACKETS);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    return m_traces;
+}
+
+void
+PointToPointMultithreadedTest::DoRun()
+{
+    auto oneThread = RunModel(1);
+    auto twoThreads = RunModel(2);
+
+    std::set<uint64_t> uids;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(oneThread[i].size(), N_PACKETS, "Packets lost by node " << i);
+        NS_TEST_EXPECT_MSG_EQ((oneThread[i] == twoThreads[i]),
+                              true,
+                              "Packets received by node " << i << " depend on the thread count");
+        for (const auto& packet : oneThread[i])
+        {
+            uids.insert(std::get<1>(packet));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(uids.size(), 2 * N_PACKETS, "Duplicate packet uids");
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +305,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointMultithreadedTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -10,6 +10,8 @@
 
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -35,7 +37,49 @@ JakesPropagationLossModel::GetTypeId()
     static TypeId tid = TypeId("ns3::JakesPropagationLossModel")
                             .SetParent<PropagationLossModel>()
                             .SetGroupName("Propagation")
-                            .AddConstructor<JakesPropagationLossModel>();
+                            .AddConstructor<JakesPropagationLossModel>()
+                            .AddAttribute("CacheMaxSize",
+                                          "The maximum number of paths kept in the cache. The "
+                                          "least recently used path is evicted when a path is "
+                                          "added to a full cache (0 means no limit).",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &JakesPropagationLossModel::SetCacheMaxSize,
+                                              &JakesPropagationLossModel::GetCacheMaxSize),
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("CacheTimeToLive",
+                                          "The paths which have not been used for longer than "
+                                          "this time are evicted from the cache (0 means no "
+                                          "limit).",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(
+                                              &JakesPropagationLossModel::SetCacheTimeToLive,
+                                              &JakesPropagationLossModel::GetCacheTimeToLive),
+                                          MakeTimeChecker(Seconds(0)))
+                            .AddAttribute("CacheHits",
+                                          "The number of path lookups which found the path in "
+                                          "the cache.",
+                                          TypeId::ATTR_GET,
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &JakesPropagationLossModel::GetCacheHits),
+                                          MakeUintegerChecker<uint64_t>())
+                            .AddAttribute("CacheMisses",
+                                          "The number of path lookups which did not find the "
+                                          "path in the cache.",
+                                          TypeId::ATTR_GET,
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &JakesPropagationLossModel::GetCacheMisses),
+                                          MakeUintegerChecker<uint64_t>())
+                            .AddAttribute("CacheEvictions",
+                                          "The number of paths evicted from the cache because "
+                                          "it was full or the paths expired.",
+                                          TypeId::ATTR_GET,
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &JakesPropagationLossModel::GetCacheEvictions),
+                                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
@@ -74,6 +118,48 @@ JakesPropagationLossModel::GetUniformRandomVariable() const
     return m_uniformVariable;
 }
 
+void
+JakesPropagationLossModel::SetCacheMaxSize(uint32_t maxSize)
+{
+    m_propagationCache.SetMaxSize(maxSize);
+}
+
+uint32_t
+JakesPropagationLossModel::GetCacheMaxSize() const
+{
+    return m_propagationCache.GetMaxSize();
+}
+
+void
+JakesPropagationLossModel::SetCacheTimeToLive(Time timeToLive)
+{
+    m_propagationCache.SetTimeToLive(timeToLive);
+}
+
+Time
+JakesPropagationLossModel::GetCacheTimeToLive() const
+{
+    return m_propagationCache.GetTimeToLive();
+}
+
+uint64_t
+JakesPropagationLossModel::GetCacheHits() const
+{
+    return m_propagationCache.GetHits();
+}
+
+uint64_t
+JakesPropagationLossModel::GetCacheMisses() const
+{
+    return m_propagationCache.GetMisses();
+}
+
+uint64_t
+JakesPropagationLossModel::GetCacheEvictions() const
+{
+    return m_propagationCache.GetEvictions();
+}
+
 int64_t
 JakesPropagationLossModel::DoAssignStreams(int64_t stream)
 {
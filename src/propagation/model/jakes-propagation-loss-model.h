@@ -19,6 +19,11 @@ namespace ns3
  *
  * @brief a  Jakes narrowband propagation model.
  * Symmetrical cache for JakesProcess
+ *
+ * The cache of the Jakes processes of the paths is unbounded by default. The CacheMaxSize
+ * and CacheTimeToLive attributes bound it in long simulations with many moving nodes; the
+ * fading process of an evicted path starts again from a new random realization the next
+ * time the path is used.
  */
 
 class JakesPropagationLossModel : public PropagationLossModel
@@ -54,6 +59,37 @@ class JakesPropagationLossModel : public PropagationLossModel
      */
     Ptr<UniformRandomVariable> GetUniformRandomVariable() const;
 
+    /**
+     * Set the maximum number of paths in the propagation cache
+     * @param maxSize the maximum number of paths, 0 for no limit
+     */
+    void SetCacheMaxSize(uint32_t maxSize);
+    /**
+     * @return the maximum number of paths in the propagation cache, 0 for no limit
+     */
+    uint32_t GetCacheMaxSize() const;
+    /**
+     * Set the time to live of the paths in the propagation cache
+     * @param timeToLive the time to live, zero for no limit
+     */
+    void SetCacheTimeToLive(Time timeToLive);
+    /**
+     * @return the time to live of the paths in the propagation cache, zero for no limit
+     */
+    Time GetCacheTimeToLive() const;
+    /**
+     * @return the number of paths found in the propagation cache
+     */
+    uint64_t GetCacheHits() const;
+    /**
+     * @return the number of paths not found in the propagation cache
+     */
+    uint64_t GetCacheMisses() const;
+    /**
+     * @return the number of paths evicted from the propagation cache
+     */
+    uint64_t GetCacheEvictions() const;
+
     Ptr<UniformRandomVariable> m_uniformVariable;              //!< random stream
     mutable PropagationCache<JakesProcess> m_propagationCache; //!< Propagation cache
 };
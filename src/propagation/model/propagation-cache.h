@@ -9,8 +9,15 @@
 #define PROPAGATION_CACHE_H_
 
 #include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
 
-#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -19,6 +26,16 @@ namespace ns3
  * @brief Constructs a cache of objects, where each object is responsible for a single propagation
  * path loss calculations. Propagation path a-->b and b-->a is the same thing. Propagation path is
  * identified by a couple of MobilityModels and a spectrum model UID
+ *
+ * The paths are kept in a hash table. By default the cache is unbounded and the paths are kept
+ * until Cleanup() is called. The number of paths can be bounded with SetMaxSize(): when a path
+ * is added to a full cache, the least recently used path is evicted. Paths which have not been
+ * used for longer than the time set with SetTimeToLive() are evicted as well. The objects of the
+ * evicted paths are disposed, and a new object is created by the user of the cache the next time
+ * the path is used.
+ *
+ * The cache counts the hits, misses and evictions, so that the models using it can expose them
+ * as attributes.
  */
 template <class T>
 class PropagationCache
@@ -32,12 +49,84 @@ class PropagationCache
     {
     }
 
+    /**
+     * Set the maximum number of paths in the cache. The least recently used paths are evicted
+     * if the cache holds more paths.
+     * @param maxSize the maximum number of paths, 0 for no limit
+     */
+    void SetMaxSize(std::size_t maxSize)
+    {
+        m_maxSize = maxSize;
+        while (m_maxSize > 0 && m_lru.size() > m_maxSize)
+        {
+            Evict(std::prev(m_lru.end()));
+        }
+    }
+
+    /**
+     * @return the maximum number of paths in the cache, 0 for no limit
+     */
+    std::size_t GetMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+    /**
+     * Set the time to live of the paths: a path which has not been used for longer than this
+     * simulation time is evicted.
+     * @param timeToLive the time to live of the paths, zero for no limit
+     */
+    void SetTimeToLive(Time timeToLive)
+    {
+        m_timeToLive = timeToLive;
+    }
+
+    /**
+     * @return the time to live of the paths, zero for no limit
+     */
+    Time GetTimeToLive() const
+    {
+        return m_timeToLive;
+    }
+
+    /**
+     * @return the number of paths in the cache
+     */
+    std::size_t GetSize() const
+    {
+        return m_lru.size();
+    }
+
+    /**
+     * @return the number of calls to GetPathData() which found the path in the cache
+     */
+    uint64_t GetHits() const
+    {
+        return m_hits;
+    }
+
+    /**
+     * @return the number of calls to GetPathData() which did not find the path in the cache
+     */
+    uint64_t GetMisses() const
+    {
+        return m_misses;
+    }
+
+    /**
+     * @return the number of paths evicted because the cache was full or the paths expired
+     */
+    uint64_t GetEvictions() const
+    {
+        return m_evictions;
+    }
+
     /**
      * Get the model associated with the path
      * @param a 1st node mobility model
      * @param b 2nd node mobility model
      * @param modelUid model UID
-     * @return the model
+     * @return the model, or nullptr if the path is not in the cache or has expired
      */
     Ptr<T> GetPathData(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
     {
@@ -45,9 +134,21 @@ class PropagationCache
         auto it = m_pathCache.find(key);
         if (it == m_pathCache.end())
         {
+            ++m_misses;
+            return nullptr;
+        }
+        auto entry = it->second;
+        const Time now = Simulator::Now();
+        if (IsExpired(*entry, now))
+        {
+            Evict(entry);
+            ++m_misses;
             return nullptr;
         }
-        return it->second;
+        entry->m_lastAccess = now;
+        m_lru.splice(m_lru.begin(), m_lru, entry);
+        ++m_hits;
+        return entry->m_data;
     }
 
     /**
@@ -64,7 +165,18 @@ class PropagationCache
     {
         PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
         NS_ASSERT(m_pathCache.find(key) == m_pathCache.end());
-        m_pathCache.insert(std::make_pair(key, data));
+        const Time now = Simulator::Now();
+        // the list is sorted by last access time, so the expired paths are at its end
+        while (!m_lru.empty() && IsExpired(m_lru.back(), now))
+        {
+            Evict(std::prev(m_lru.end()));
+        }
+        if (m_maxSize > 0 && m_lru.size() >= m_maxSize)
+        {
+            Evict(std::prev(m_lru.end()));
+        }
+        m_lru.push_front(Entry{key, data, now});
+        m_pathCache.emplace(key, m_lru.begin());
     }
 
     /**
@@ -72,11 +184,12 @@ class PropagationCache
      */
     void Cleanup()
     {
-        for (auto i : m_pathCache)
+        for (auto& entry : m_lru)
         {
-            i.second->Dispose();
+            entry.m_data->Dispose();
         }
         m_pathCache.clear();
+        m_lru.clear();
     }
 
   private:
@@ -103,45 +216,90 @@ class PropagationCache
         uint32_t m_spectrumModelUid;            //!< model UID
 
         /**
-         * Less-than operator.
+         * Equality operator.
          *
-         * The goal of this operator is just to provide a stable comparison
-         * to be used in containers requiring a order (of any kind).
-         *
-         * If the models are different, the comparison is based on their Uid.
-         * Otherwise, the comparison is based on the pointers of the Mobility models.
+         * Links are supposed to be symmetrical, so the paths a-->b and b-->a are equal.
          *
          * @param other Right value of the operator.
-         * @returns True if the Left value is less than the Right value.
+         * @returns True if the two values identify the same path.
          */
-        bool operator<(const PropagationPathIdentifier& other) const
+        bool operator==(const PropagationPathIdentifier& other) const
         {
-            if (m_spectrumModelUid != other.m_spectrumModelUid)
-            {
-                return m_spectrumModelUid < other.m_spectrumModelUid;
-            }
-            /// Links are supposed to be symmetrical!
-            if (std::min(m_dstMobility, m_srcMobility) !=
-                std::min(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::min(m_dstMobility, m_srcMobility) <
-                       std::min(other.m_dstMobility, other.m_srcMobility);
-            }
-            if (std::max(m_dstMobility, m_srcMobility) !=
-                std::max(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::max(m_dstMobility, m_srcMobility) <
+            return m_spectrumModelUid == other.m_spectrumModelUid &&
+                   std::min(m_dstMobility, m_srcMobility) ==
+                       std::min(other.m_dstMobility, other.m_srcMobility) &&
+                   std::max(m_dstMobility, m_srcMobility) ==
                        std::max(other.m_dstMobility, other.m_srcMobility);
-            }
-            return false;
         }
     };
 
-    /// Typedef: PropagationPathIdentifier, Ptr<T>
-    typedef std::map<PropagationPathIdentifier, Ptr<T>> PathCache;
+    /// Symmetrical hash of a PropagationPathIdentifier
+    struct PropagationPathIdentifierHash
+    {
+        /**
+         * @param key the path identifier
+         * @return the hash of the path identifier, which does not depend on the direction
+         */
+        std::size_t operator()(const PropagationPathIdentifier& key) const
+        {
+            const auto src = reinterpret_cast<std::uintptr_t>(PeekPointer(key.m_srcMobility));
+            const auto dst = reinterpret_cast<std::uintptr_t>(PeekPointer(key.m_dstMobility));
+            std::size_t hash = std::hash<std::uintptr_t>()(std::min(src, dst));
+            hash ^= std::hash<std::uintptr_t>()(std::max(src, dst)) + 0x9e3779b9 + (hash << 6) +
+                    (hash >> 2);
+            hash ^= std::hash<uint32_t>()(key.m_spectrumModelUid) + 0x9e3779b9 + (hash << 6) +
+                    (hash >> 2);
+            return hash;
+        }
+    };
+
+    /// A path in the cache
+    struct Entry
+    {
+        PropagationPathIdentifier m_key; //!< path identifier
+        Ptr<T> m_data;                   //!< model associated with the path
+        Time m_lastAccess;               //!< last time the path was added or found
+    };
+
+    /// Paths sorted from the most recently used to the least recently used
+    typedef std::list<Entry> LruList;
+
+    /// Typedef: PropagationPathIdentifier, position of the path in the LRU list
+    typedef std::unordered_map<PropagationPathIdentifier,
+                               typename LruList::iterator,
+                               PropagationPathIdentifierHash>
+        PathCache;
+
+    /**
+     * @param entry the path
+     * @param now the current simulation time
+     * @return whether the path has not been used for longer than the time to live
+     */
+    bool IsExpired(const Entry& entry, Time now) const
+    {
+        return m_timeToLive.IsStrictlyPositive() && now - entry.m_lastAccess > m_timeToLive;
+    }
+
+    /**
+     * Remove a path from the cache and dispose its model
+     * @param entry the position of the path in the LRU list
+     */
+    void Evict(typename LruList::iterator entry)
+    {
+        entry->m_data->Dispose();
+        m_pathCache.erase(entry->m_key);
+        m_lru.erase(entry);
+        ++m_evictions;
+    }
 
   private:
-    PathCache m_pathCache; //!< Path cache
+    PathCache m_pathCache;    //!< Path cache
+    LruList m_lru;            //!< Paths sorted by last access
+    std::size_t m_maxSize{0}; //!< Maximum number of paths, 0 for no limit
+    Time m_timeToLive;        //!< Time to live of the paths, zero for no limit
+    uint64_t m_hits{0};       //!< Number of lookups which found the path
+    uint64_t m_misses{0};     //!< Number of lookups which did not find the path
+    uint64_t m_evictions{0};  //!< Number of evicted paths
 };
 } // namespace ns3
 
@@ -8,11 +8,15 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/jakes-propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -481,6 +485,105 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Test the bounds, the expiry and the counters of the propagation cache of
+ * JakesPropagationLossModel
+ */
+class JakesPropagationLossModelCacheTestCase : public TestCase
+{
+  public:
+    JakesPropagationLossModelCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the cache counters of the loss model
+     * @param hits the expected number of hits
+     * @param misses the expected number of misses
+     * @param evictions the expected number of evictions
+     */
+    void CheckCounters(uint64_t hits, uint64_t misses, uint64_t evictions);
+
+    Ptr<JakesPropagationLossModel> m_lossModel; //!< the loss model
+};
+
+JakesPropagationLossModelCacheTestCase::JakesPropagationLossModelCacheTestCase()
+    : TestCase("Test the propagation cache of JakesPropagationLossModel")
+{
+}
+
+void
+JakesPropagationLossModelCacheTestCase::CheckCounters(uint64_t hits,
+                                                      uint64_t misses,
+                                                      uint64_t evictions)
+{
+    UintegerValue value;
+    m_lossModel->GetAttribute("CacheHits", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), hits, "Unexpected number of cache hits");
+    m_lossModel->GetAttribute("CacheMisses", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), misses, "Unexpected number of cache misses");
+    m_lossModel->GetAttribute("CacheEvictions", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), evictions, "Unexpected number of cache evictions");
+}
+
+void
+JakesPropagationLossModelCacheTestCase::DoRun()
+{
+    std::vector<Ptr<MobilityModel>> mobility;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        mobility.push_back(CreateObject<ConstantPositionMobilityModel>());
+        mobility.back()->SetPosition(Vector(10.0 * i, 0, 0));
+    }
+    const auto& a = mobility[0];
+
+    // the cache is unbounded by default
+    m_lossModel = CreateObject<JakesPropagationLossModel>();
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        m_lossModel->CalcRxPower(0, a, mobility[i]);
+        m_lossModel->CalcRxPower(0, mobility[i], a);
+    }
+    CheckCounters(3, 3, 0);
+
+    m_lossModel = CreateObjectWithAttributes<JakesPropagationLossModel>("CacheMaxSize",
+                                                                        UintegerValue(2),
+                                                                        "CacheTimeToLive",
+                                                                        TimeValue(Seconds(1)));
+    // the paths a-->b and b-->a are the same
+    const double rxPower = m_lossModel->CalcRxPower(0, a, mobility[1]);
+    NS_TEST_EXPECT_MSG_EQ(m_lossModel->CalcRxPower(0, mobility[1], a),
+                          rxPower,
+                          "The cached path should be symmetrical");
+    CheckCounters(1, 1, 0);
+    // a third path evicts the least recently used one
+    m_lossModel->CalcRxPower(0, a, mobility[2]);
+    m_lossModel->CalcRxPower(0, a, mobility[1]);
+    m_lossModel->CalcRxPower(0, a, mobility[3]);
+    CheckCounters(2, 3, 1);
+    m_lossModel->CalcRxPower(0, a, mobility[1]);
+    m_lossModel->CalcRxPower(0, a, mobility[2]);
+    CheckCounters(3, 4, 2);
+
+    // the paths which have not been used for longer than the time to live expire
+    Simulator::Schedule(MilliSeconds(800), [&]() {
+        m_lossModel->CalcRxPower(0, a, mobility[2]);
+        CheckCounters(4, 4, 2);
+    });
+    Simulator::Schedule(MilliSeconds(1500), [&]() {
+        m_lossModel->CalcRxPower(0, a, mobility[2]);
+        CheckCounters(5, 4, 2);
+        m_lossModel->CalcRxPower(0, a, mobility[1]);
+        CheckCounters(5, 5, 3);
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+    m_lossModel = nullptr;
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -492,6 +595,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - JakesPropagationLossModel cache
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -507,6 +611,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new JakesPropagationLossModelCacheTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
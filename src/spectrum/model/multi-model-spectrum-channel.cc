@@ -27,6 +27,7 @@
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <iostream>
@@ -71,7 +72,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_propagationThreadCount{0}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -82,6 +84,7 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_threadPool.reset();
     SpectrumChannel::DoDispose();
 }
 
@@ -92,8 +95,18 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+                            .AddAttribute("PropagationThreadCount",
+                                          "If not zero, the propagation loss models are applied "
+                                          "to all the receivers when a transmission starts, "
+                                          "rather than when the signal reaches each receiver, "
+                                          "and the computationally intensive part of the "
+                                          "phased array spectrum propagation loss model is "
+                                          "executed by this number of threads. The results do "
+                                          "not depend on the number of threads.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &MultiModelSpectrumChannel::m_propagationThreadCount),
+                                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -116,6 +129,10 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         if (phyIt != rxInfoIterator->second.m_rxPhys.end())
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
+            if (rxInfoIterator->second.m_rxGrid)
+            {
+                rxInfoIterator->second.m_rxGrid->Remove(phy);
+            }
             --m_numDevices;
             break; // there should be at most one entry
         }
@@ -145,6 +162,10 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    if (rxInfoIterator->second.m_rxGrid)
+    {
+        rxInfoIterator->second.m_rxGrid->Add(phy);
+    }
 
     if (inserted)
     {
@@ -242,6 +263,9 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                  << txInfoIterator->second.m_spectrumConverterMap.begin()->first);
 
     std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds{};
+    // receptions computed when the transmission starts
+    std::vector<std::pair<Time, RxInfo>> pendingRxs;
+    std::vector<PhasedArraySpectrumPropagationLossModel::CompletionTask> completions;
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -299,9 +323,12 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             continue;
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        std::vector<Ptr<SpectrumPhy>> candidates;
+        const auto& rxPhys = GetCandidateReceivers(rxInfoIterator->second.m_rxPhys,
+                                                   rxInfoIterator->second.m_rxGrid,
+                                                   refTxMobility,
+                                                   candidates);
+        for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -371,25 +398,62 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                               .params = rxParams,
                               .receiver = *rxPhyIterator,
                               .availableConvertedPsds = convertedPsds};
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxInfo);
-                }
-                else
+                if (m_propagationThreadCount > 0)
                 {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay, &MultiModelSpectrumChannel::StartRx, this, rxInfo);
+                    // apply the propagation loss models now, on a copy of the parameters which
+                    // are kept in case the SpectrumModel of the receiver changes
+                    PhasedArraySpectrumPropagationLossModel::CompletionTask completion;
+                    rxInfo.rxParams = CalcRxParams(rxInfo, rxParams->Copy(), &completion);
+                    if (!rxInfo.rxParams)
+                    {
+                        continue;
+                    }
+                    if (completion)
+                    {
+                        completions.push_back(std::move(completion));
+                    }
+                    pendingRxs.emplace_back(delay, rxInfo);
+                    continue;
                 }
+                ScheduleStartRx(delay, rxInfo);
             }
         }
     }
+
+    if (!completions.empty())
+    {
+        if (!m_threadPool || m_threadPool->GetThreadCount() != m_propagationThreadCount)
+        {
+            m_threadPool = std::make_unique<ThreadPool>(m_propagationThreadCount);
+        }
+        m_threadPool->ParallelFor(completions.size(),
+                                  [&completions](std::size_t i) { completions[i](); });
+    }
+    for (const auto& [delay, rxInfo] : pendingRxs)
+    {
+        ScheduleStartRx(delay, rxInfo);
+    }
+}
+
+void
+MultiModelSpectrumChannel::ScheduleStartRx(const Time& delay, const RxInfo& rxInfo)
+{
+    if (auto rxNetDevice = rxInfo.receiver->GetDevice())
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        auto dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &MultiModelSpectrumChannel::StartRx,
+                                       this,
+                                       rxInfo);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay, &MultiModelSpectrumChannel::StartRx, this, rxInfo);
+    }
 }
 
 void
@@ -403,6 +467,13 @@ MultiModelSpectrumChannel::StartRx(const RxInfo& rxInfo)
     NS_LOG_LOGIC("rxSpectrumModelUid " << rxSpectrumModelUid << " phySpectrumModelUid "
                                        << phySpectrumModelUid);
 
+    if (rxInfo.rxParams && rxSpectrumModelUid == phySpectrumModelUid)
+    {
+        // the propagation loss models were applied when the transmission started
+        rxInfo.receiver->StartRx(rxInfo.rxParams);
+        return;
+    }
+
     if (rxSpectrumModelUid != phySpectrumModelUid)
     {
         NS_LOG_LOGIC("SpectrumModelUid changed since TX started");
@@ -436,6 +507,21 @@ MultiModelSpectrumChannel::StartRx(const RxInfo& rxInfo)
         }
     }
 
+    rxParams = CalcRxParams(rxInfo, rxParams, nullptr);
+    if (rxParams)
+    {
+        rxInfo.receiver->StartRx(rxParams);
+    }
+}
+
+Ptr<SpectrumSignalParameters>
+MultiModelSpectrumChannel::CalcRxParams(
+    const RxInfo& rxInfo,
+    Ptr<SpectrumSignalParameters> rxParams,
+    PhasedArraySpectrumPropagationLossModel::CompletionTask* completion)
+{
+    NS_LOG_FUNCTION(this << rxParams);
+
     auto txMobility = rxParams->txMobility;
     auto rxMobility = rxInfo.receiver->GetMobility();
     if (txMobility && rxMobility)
@@ -475,7 +561,7 @@ MultiModelSpectrumChannel::StartRx(const RxInfo& rxInfo)
         if (pathLossDb > m_maxLossDb)
         {
             // beyond range
-            return;
+            return nullptr;
         }
 
         const auto pathLossLinear = std::pow(10.0, (-pathLossDb) / 10.0);
@@ -496,16 +582,29 @@ MultiModelSpectrumChannel::StartRx(const RxInfo& rxInfo)
                           "PhasedArrayModel instances should be installed at both TX and RX "
                           "SpectrumPhy in order to use PhasedArraySpectrumPropagationLoss.");
 
-            rxParams = m_phasedArraySpectrumPropagationLoss->CalcRxPowerSpectralDensity(
-                rxParams,
-                txMobility,
-                rxMobility,
-                txPhasedArrayModel,
-                rxPhasedArrayModel);
+            if (completion)
+            {
+                rxParams = m_phasedArraySpectrumPropagationLoss->PrepareRxPowerSpectralDensity(
+                    rxParams,
+                    txMobility,
+                    rxMobility,
+                    txPhasedArrayModel,
+                    rxPhasedArrayModel,
+                    *completion);
+            }
+            else
+            {
+                rxParams = m_phasedArraySpectrumPropagationLoss->CalcRxPowerSpectralDensity(
+                    rxParams,
+                    txMobility,
+                    rxMobility,
+                    txPhasedArrayModel,
+                    rxPhasedArrayModel);
+            }
         }
     }
 
-    rxInfo.receiver->StartRx(rxParams);
+    return rxParams;
 }
 
 std::size_t
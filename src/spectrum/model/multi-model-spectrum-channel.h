@@ -9,14 +9,17 @@
 #ifndef MULTI_MODEL_SPECTRUM_CHANNEL_H
 #define MULTI_MODEL_SPECTRUM_CHANNEL_H
 
+#include "phased-array-spectrum-propagation-loss-model.h"
 #include "spectrum-channel.h"
 #include "spectrum-converter.h"
 #include "spectrum-propagation-loss-model.h"
 #include "spectrum-value.h"
 
 #include "ns3/propagation-delay-model.h"
+#include "ns3/thread-pool.h"
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace ns3
@@ -68,6 +71,7 @@ class RxSpectrumModelInfo
 
     Ptr<const SpectrumModel> m_rxSpectrumModel; //!< Rx Spectrum model.
     std::vector<Ptr<SpectrumPhy>> m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+    Ptr<SpectrumReceiverGrid> m_rxGrid;         //!< Spatial index of m_rxPhys, if MaxRange is set
 };
 
 /**
@@ -88,6 +92,18 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * By default, the propagation loss models are applied to a signal when
+ * it reaches each receiver.  If the PropagationThreadCount attribute is
+ * set, they are instead applied to all the receivers when the
+ * transmission starts, and the computationally intensive part of the
+ * PhasedArraySpectrumPropagationLossModel, if any (see
+ * PhasedArraySpectrumPropagationLossModel::PrepareRxPowerSpectralDensity),
+ * is executed by a pool of threads, before the receptions are scheduled.
+ * The models are applied to the receivers in a fixed order, so that the
+ * random variables are drawn in the same order and the results do not
+ * depend on the number of threads; they differ from the ones of the
+ * default mode, though, as the models are evaluated at a different time.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -138,8 +154,33 @@ class MultiModelSpectrumChannel : public SpectrumChannel
         Ptr<SpectrumPhy> receiver;            //!< pointer to the receiver SpectrumPhy
         std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>
             availableConvertedPsds; //!< available converted PSDs from the TX PSD
+        Ptr<SpectrumSignalParameters>
+            rxParams; //!< received signal parameters, if computed when the transmission started
     };
 
+    /**
+     * Apply the propagation loss models to a signal for a given receiver.
+     *
+     * @param rxInfo The information needed to handle the reception.
+     * @param rxParams The signal parameters, with the PSD in the SpectrumModel of the receiver.
+     * @param completion If not null, the computation of the
+     *        PhasedArraySpectrumPropagationLossModel may be left to this task, which
+     *        must be executed before the returned parameters are used.
+     * @return The received signal parameters, or nullptr if the receiver is beyond range.
+     */
+    Ptr<SpectrumSignalParameters> CalcRxParams(
+        const RxInfo& rxInfo,
+        Ptr<SpectrumSignalParameters> rxParams,
+        PhasedArraySpectrumPropagationLossModel::CompletionTask* completion);
+
+    /**
+     * Schedule the reception of a signal.
+     *
+     * @param delay The propagation delay.
+     * @param rxInfo The information needed to handle the reception.
+     */
+    void ScheduleStartRx(const Time& delay, const RxInfo& rxInfo);
+
     /**
      * Used internally to reschedule transmission after the propagation delay.
      *
@@ -165,6 +206,17 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * Number of threads computing the received signals when a transmission
+     * starts, or zero to compute them upon reception.
+     */
+    uint32_t m_propagationThreadCount;
+
+    /**
+     * Pool of threads used if m_propagationThreadCount is not zero.
+     */
+    std::unique_ptr<ThreadPool> m_threadPool;
 };
 
 } // namespace ns3
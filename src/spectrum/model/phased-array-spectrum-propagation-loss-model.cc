@@ -77,6 +77,49 @@ PhasedArraySpectrumPropagationLossModel::CalcRxPowerSpectralDensity(
     return rxParams;
 }
 
+Ptr<SpectrumSignalParameters>
+PhasedArraySpectrumPropagationLossModel::PrepareRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel,
+    CompletionTask& completion) const
+{
+    // as in CalcRxPowerSpectralDensity, the result of the last model in the
+    // chain is returned; the completion task of the others can be dropped
+    auto rxParams = DoPrepareRxPowerSpectralDensity(params,
+                                                    a,
+                                                    b,
+                                                    aPhasedArrayModel,
+                                                    bPhasedArrayModel,
+                                                    completion);
+
+    if (m_next)
+    {
+        rxParams = m_next->PrepareRxPowerSpectralDensity(params,
+                                                         a,
+                                                         b,
+                                                         aPhasedArrayModel,
+                                                         bPhasedArrayModel,
+                                                         completion);
+    }
+    return rxParams;
+}
+
+Ptr<SpectrumSignalParameters>
+PhasedArraySpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel,
+    CompletionTask& completion) const
+{
+    completion = nullptr;
+    return DoCalcRxPowerSpectralDensity(params, a, b, aPhasedArrayModel, bPhasedArrayModel);
+}
+
 int64_t
 PhasedArraySpectrumPropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -14,6 +14,8 @@
 #include "ns3/object.h"
 #include "ns3/phased-array-model.h"
 
+#include <functional>
+
 namespace ns3
 {
 
@@ -34,6 +36,12 @@ struct SpectrumSignalParameters;
 class PhasedArraySpectrumPropagationLossModel : public Object
 {
   public:
+    /**
+     * The part of the computation of a received PSD which is left to a
+     * thread pool by PrepareRxPowerSpectralDensity()
+     */
+    using CompletionTask = std::function<void()>;
+
     PhasedArraySpectrumPropagationLossModel();
     ~PhasedArraySpectrumPropagationLossModel() override;
 
@@ -78,6 +86,37 @@ class PhasedArraySpectrumPropagationLossModel : public Object
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
 
+    /**
+     * Start the calculation of the received PSD, leaving the
+     * computationally intensive part of it to a task which can be
+     * executed in another thread, concurrently with the tasks of other
+     * receivers of the same signal.
+     *
+     * This function must be called in the simulation thread: it draws the
+     * random variables and updates the state of the models.  The returned
+     * parameters must not be used before the completion task, if any, has
+     * been executed.  The result is the same as the one of
+     * CalcRxPowerSpectralDensity().
+     *
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param bPhasedArrayModel the instance of the phased antenna array of the receiver
+     * @param completion set to the task completing the calculation, or to an
+     *        empty function if there is nothing left to compute
+     *
+     * @return SpectrumSignalParameters which will hold the received PSD and
+     * the channel matrix once the completion task has been executed.
+     */
+    Ptr<SpectrumSignalParameters> PrepareRxPowerSpectralDensity(
+        Ptr<const SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel,
+        CompletionTask& completion) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -103,6 +142,41 @@ class PhasedArraySpectrumPropagationLossModel : public Object
      */
     virtual int64_t DoAssignStreams(int64_t stream) = 0;
 
+    /**
+     * Start the calculation of the received PSD, see PrepareRxPowerSpectralDensity().
+     *
+     * The completion task is executed in an unspecified thread, concurrently
+     * with the tasks of the other receivers of the signal, and after all of
+     * them have been prepared.  It must hence only modify the objects owned
+     * by its own receiver (e.g., the returned parameters), and read the
+     * others; as the reference counts are not atomic, it must neither copy
+     * nor release a Ptr to a shared object, including the ones it captures,
+     * which are released in the simulation thread.  Everything else (random
+     * variable draws, cache updates, calls to the Simulator, the mobility
+     * models and the antennas, logging) must be done here.
+     *
+     * The default implementation computes the PSD with
+     * DoCalcRxPowerSpectralDensity() and returns no completion task.
+     *
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param bPhasedArrayModel the instance of the phased antenna array of the receiver
+     * @param completion set to the task completing the calculation, or to an
+     *        empty function if there is nothing left to compute
+     *
+     * @return SpectrumSignalParameters which will hold the received PSD and
+     * the channel matrix once the completion task has been executed.
+     */
+    virtual Ptr<SpectrumSignalParameters> DoPrepareRxPowerSpectralDensity(
+        Ptr<const SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel,
+        CompletionTask& completion) const;
+
   private:
     /**
      *
@@ -46,6 +46,7 @@ SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_rxGrid = nullptr;
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -69,6 +70,10 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        if (m_rxGrid)
+        {
+            m_rxGrid->Remove(phy);
+        }
     }
 }
 
@@ -79,6 +84,10 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     if (std::find(m_phyList.cbegin(), m_phyList.cend(), phy) == m_phyList.cend())
     {
         m_phyList.push_back(phy);
+        if (m_rxGrid)
+        {
+            m_rxGrid->Add(phy);
+        }
     }
     else
     {
@@ -116,7 +125,9 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     Ptr<MobilityModel> refSenderMobility = txParams->txPhy->GetMobility();
     Ptr<MobilityModel> senderMobility = refSenderMobility;
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    std::vector<Ptr<SpectrumPhy>> candidates;
+    const auto& rxPhys = GetCandidateReceivers(m_phyList, m_rxGrid, refSenderMobility, candidates);
+    for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
         Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
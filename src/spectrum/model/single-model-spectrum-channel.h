@@ -63,6 +63,11 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      */
     PhyList m_phyList;
 
+    /**
+     * Spatial index of m_phyList, used if the MaxRange attribute is set.
+     */
+    Ptr<SpectrumReceiverGrid> m_rxGrid;
+
     /**
      * SpectrumModel that this channel instance is supporting.
      */
@@ -8,6 +8,8 @@
 
 #include "spectrum-channel.h"
 
+#include "wraparound-model.h"
+
 #include "ns3/abort.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
@@ -69,6 +71,21 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("MaxRange",
+                          "If positive, the maximum distance in meters between a "
+                          "transmitter and the receivers to which its transmissions "
+                          "are passed. The receivers are then looked up in a spatial "
+                          "index of their positions, updated when their MobilityModel "
+                          "reports a course change, so that the propagation models "
+                          "are not evaluated for the receivers out of range. "
+                          "Receivers without a MobilityModel always receive the "
+                          "transmissions. This is ignored if a WraparoundModel is "
+                          "aggregated to the channel. The default value of 0 "
+                          "disables the range limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
@@ -194,6 +211,29 @@ SpectrumChannel::GetPropagationDelayModel() const
     return m_propagationDelay;
 }
 
+const std::vector<Ptr<SpectrumPhy>>&
+SpectrumChannel::GetCandidateReceivers(const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                       Ptr<SpectrumReceiverGrid>& grid,
+                                       Ptr<const MobilityModel> txMobility,
+                                       std::vector<Ptr<SpectrumPhy>>& candidates)
+{
+    if (m_maxRange <= 0 || !txMobility || GetObject<WraparoundModel>())
+    {
+        return rxPhys;
+    }
+    if (!grid || grid->GetCellSize() != m_maxRange)
+    {
+        NS_LOG_LOGIC("Creating the grid of " << rxPhys.size() << " receivers");
+        grid = Create<SpectrumReceiverGrid>(m_maxRange);
+        for (const auto& phy : rxPhys)
+        {
+            grid->Add(phy);
+        }
+    }
+    candidates = grid->GetCandidates(txMobility->GetPosition(), m_maxRange);
+    return candidates;
+}
+
 int64_t
 SpectrumChannel::AssignStreams(int64_t stream)
 {
@@ -12,6 +12,7 @@
 #include "phased-array-spectrum-propagation-loss-model.h"
 #include "spectrum-phy.h"
 #include "spectrum-propagation-loss-model.h"
+#include "spectrum-receiver-grid.h"
 #include "spectrum-signal-parameters.h"
 #include "spectrum-transmit-filter.h"
 
@@ -227,6 +228,28 @@ class SpectrumChannel : public Channel
      */
     virtual int64_t DoAssignStreams(int64_t stream);
 
+    /**
+     * Get the receivers to be evaluated for a transmission. If the MaxRange
+     * attribute is not set, the transmitter has no MobilityModel or a
+     * WraparoundModel is aggregated to the channel, these are all the
+     * receivers of the given list. Otherwise, these are only the receivers
+     * of the list within MaxRange of the transmitter, and those without a
+     * MobilityModel, in the same order as in the list. They are found with a
+     * SpectrumReceiverGrid, which is created from the list when first needed.
+     * The caller must then keep the grid up to date with the list.
+     *
+     * @param rxPhys the receivers
+     * @param grid the spatial index of the receivers, nullptr if not created yet
+     * @param txMobility the MobilityModel of the transmitter
+     * @param candidates storage for the returned receivers, if they are a subset of rxPhys
+     * @return either rxPhys or candidates
+     */
+    const std::vector<Ptr<SpectrumPhy>>& GetCandidateReceivers(
+        const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+        Ptr<SpectrumReceiverGrid>& grid,
+        Ptr<const MobilityModel> txMobility,
+        std::vector<Ptr<SpectrumPhy>>& candidates);
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -258,6 +281,13 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Maximum range [m] of the transmissions, 0 if unlimited.
+     *
+     * Receivers farther than this distance from the transmitter are not evaluated.
+     */
+    double m_maxRange;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
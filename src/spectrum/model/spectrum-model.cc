@@ -81,6 +81,13 @@ SpectrumModel::InitModel()
     NS_LOG_INFO("creating new SpectrumModel, m_uid=" << m_uid);
     // sort bands by increasing frequency
     std::sort(m_bands.begin(), m_bands.end());
+
+    m_bandWidths.clear();
+    m_bandWidths.reserve(m_bands.size());
+    for (const auto& band : m_bands)
+    {
+        m_bandWidths.push_back(band.fh - band.fl);
+    }
     // check if bands are contiguous, i.e. if the upper limit of a band is equal to the lower limit
     // of the next band
     m_contiguousBands = true;
@@ -122,6 +129,12 @@ SpectrumModel::End() const
     return m_bands.end();
 }
 
+const std::vector<double>&
+SpectrumModel::GetBandWidths() const
+{
+    return m_bandWidths;
+}
+
 size_t
 SpectrumModel::GetNumBands() const
 {
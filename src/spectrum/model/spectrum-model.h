@@ -131,6 +131,14 @@ class SpectrumModel : public SimpleRefCount<SpectrumModel>
      */
     Bands::const_iterator End() const;
 
+    /**
+     * Get the width of each band, i.e., fh - fl, in the same order as the bands.
+     * This is used to integrate SpectrumValue instances.
+     *
+     * @return the vector of band widths
+     */
+    const std::vector<double>& GetBandWidths() const;
+
     /**
      * Check if another SpectrumModel has bands orthogonal to our bands.
      *
@@ -162,6 +170,9 @@ class SpectrumModel : public SimpleRefCount<SpectrumModel>
     bool m_uniqueBandSize;    //!< Whether all bands have the same size
     SpectrumModelUid_t m_uid; //!< unique id for a given set of frequencies
     static SpectrumModelUid_t m_uidCount; //!< counter to assign m_uids
+
+    /// Width of each band, cached to speed up the integration of SpectrumValue instances
+    std::vector<double> m_bandWidths;
 };
 
 } // namespace ns3
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "spectrum-receiver-grid.h"
+
+#include "spectrum-phy.h"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpectrumReceiverGrid");
+
+SpectrumReceiverGrid::SpectrumReceiverGrid(double cellSize)
+    : m_grid(cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+}
+
+double
+SpectrumReceiverGrid::GetCellSize() const
+{
+    return m_grid.GetCellSize();
+}
+
+std::size_t
+SpectrumReceiverGrid::GetNReceivers() const
+{
+    return m_phys.size();
+}
+
+void
+SpectrumReceiverGrid::Add(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_phys[m_grid.Add(MakeCallback(&SpectrumPhy::GetMobility, phy))] = phy;
+}
+
+void
+SpectrumReceiverGrid::Remove(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    auto it = std::find_if(m_phys.begin(), m_phys.end(), [&phy](const auto& entry) {
+        return entry.second == phy;
+    });
+    if (it == m_phys.end())
+    {
+        return;
+    }
+    m_grid.Remove(it->first);
+    m_phys.erase(it);
+}
+
+std::vector<Ptr<SpectrumPhy>>
+SpectrumReceiverGrid::GetCandidates(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    const auto indexes = m_grid.GetCandidates(position, range);
+    std::vector<Ptr<SpectrumPhy>> candidates;
+    candidates.reserve(indexes.size());
+    for (auto index : indexes)
+    {
+        candidates.push_back(m_phys.at(index));
+    }
+    NS_LOG_LOGIC(candidates.size() << " candidates out of " << m_phys.size() << " receivers");
+    return candidates;
+}
+
+} // namespace ns3
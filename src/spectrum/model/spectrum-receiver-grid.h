@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SPECTRUM_RECEIVER_GRID_H
+#define SPECTRUM_RECEIVER_GRID_H
+
+#include "ns3/mobility-grid.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+class SpectrumPhy;
+
+/**
+ * @ingroup spectrum
+ *
+ * @brief Uniform grid index of the positions of the receivers of a SpectrumChannel
+ *
+ * The grid is used by the spectrum channels to find the receivers which are
+ * within a maximum range of a transmitter (see the SpectrumChannel::MaxRange
+ * attribute) without evaluating the propagation models for all the receivers.
+ * The positions of the receivers are indexed by a MobilityGrid, see there for
+ * the handling of the receivers which are moving or have no MobilityModel.
+ *
+ * The receivers returned by a lookup are always sorted in the order in which
+ * they were added to the grid, so that the order of the receptions does not
+ * depend on the layout of the grid.
+ */
+class SpectrumReceiverGrid : public SimpleRefCount<SpectrumReceiverGrid>
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param cellSize the length [m] of the side of the cells of the grid
+     */
+    SpectrumReceiverGrid(double cellSize);
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpectrumReceiverGrid(const SpectrumReceiverGrid&) = delete;
+    SpectrumReceiverGrid& operator=(const SpectrumReceiverGrid&) = delete;
+
+    /**
+     * @return the length [m] of the side of the cells of the grid
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add a receiver to the grid. The receiver must not be in the grid already.
+     *
+     * @param phy the receiver
+     */
+    void Add(Ptr<SpectrumPhy> phy);
+
+    /**
+     * Remove a receiver from the grid, if present.
+     *
+     * @param phy the receiver
+     */
+    void Remove(Ptr<SpectrumPhy> phy);
+
+    /**
+     * @return the number of receivers in the grid
+     */
+    std::size_t GetNReceivers() const;
+
+    /**
+     * Get the receivers which may be within the given range of a position,
+     * i.e., the receivers whose distance from the position is not larger
+     * than the range, and the receivers without a MobilityModel.
+     *
+     * @param position the position of the transmitter
+     * @param range the range [m]
+     * @return the receivers, in the order in which they were added to the grid
+     */
+    std::vector<Ptr<SpectrumPhy>> GetCandidates(const Vector& position, double range);
+
+  private:
+    MobilityGrid m_grid;                         //!< the grid of the receiver positions
+    std::map<uint64_t, Ptr<SpectrumPhy>> m_phys; //!< receivers, by index in the grid
+};
+
+} // namespace ns3
+
+#endif /* SPECTRUM_RECEIVER_GRID_H */
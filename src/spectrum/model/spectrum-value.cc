@@ -11,11 +11,673 @@
 #include "ns3/log.h"
 #include "ns3/math.h"
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NS3_SPECTRUM_VALUE_AVX2
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define NS3_SPECTRUM_VALUE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("SpectrumValue");
 
+namespace
+{
+
+/// Element-wise operations supported by the SpectrumValue kernels
+enum class KernelOp
+{
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE
+};
+
+/**
+ * Table of the kernels used by SpectrumValue to process its values.
+ *
+ * The output array of the element-wise kernels may be the same as one of their input arrays,
+ * so that they can be used both in place and to reuse the storage of a temporary operand.
+ * Every implementation produces bit-identical results: the kernels never contract a
+ * multiplication and an addition in a single rounding, and the reductions always accumulate
+ * four interleaved partial sums which are combined in the same order.
+ */
+struct SpectrumValueKernels
+{
+    /// Name of the instruction set used by the kernels
+    const char* name;
+    /// Compute out = x + y
+    void (*add)(double* out, const double* x, const double* y, size_t n);
+    /// Compute out = x - y
+    void (*subtract)(double* out, const double* x, const double* y, size_t n);
+    /// Compute out = x * y
+    void (*multiply)(double* out, const double* x, const double* y, size_t n);
+    /// Compute out = x / y
+    void (*divide)(double* out, const double* x, const double* y, size_t n);
+    /// Compute out = x + s
+    void (*addScalar)(double* out, const double* x, double s, size_t n);
+    /// Compute out = x * s
+    void (*multiplyScalar)(double* out, const double* x, double s, size_t n);
+    /// Compute out = x / s
+    void (*divideScalar)(double* out, const double* x, double s, size_t n);
+    /// Compute out += x * y
+    void (*multiplyAdd)(double* out, const double* x, const double* y, size_t n);
+    /// Compute out += x * s
+    void (*multiplyAddScalar)(double* out, const double* x, double s, size_t n);
+    /// Return the sum of the values of x
+    double (*sum)(const double* x, size_t n);
+    /// Return the sum of the products x * y
+    double (*dot)(const double* x, const double* y, size_t n);
+};
+
+/**
+ * Apply an element-wise operation to two values
+ * @tparam OP the operation
+ * @param a the first operand
+ * @param b the second operand
+ * @return the result of the operation
+ */
+template <KernelOp OP>
+inline double
+ScalarApply(double a, double b)
+{
+    if constexpr (OP == KernelOp::ADD)
+    {
+        return a + b;
+    }
+    else if constexpr (OP == KernelOp::SUBTRACT)
+    {
+        return a - b;
+    }
+    else if constexpr (OP == KernelOp::MULTIPLY)
+    {
+        return a * b;
+    }
+    else
+    {
+        return a / b;
+    }
+}
+
+/**
+ * Portable element-wise kernel between two arrays
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+void
+ScalarBinary(double* out, const double* x, const double* y, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], y[i]);
+    }
+}
+
+/**
+ * Portable element-wise kernel between an array and a scalar
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+void
+ScalarBinaryScalar(double* out, const double* x, double s, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], s);
+    }
+}
+
+/**
+ * Portable kernel computing out += x * y
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+void
+ScalarMultiplyAdd(double* out, const double* x, const double* y, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        // separate statements, so that the compiler does not contract them in a fused
+        // multiply-add which would round differently from the SIMD kernels
+        const double p = x[i] * y[i];
+        out[i] += p;
+    }
+}
+
+/**
+ * Portable kernel computing out += x * s
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+void
+ScalarMultiplyAddScalar(double* out, const double* x, double s, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double p = x[i] * s;
+        out[i] += p;
+    }
+}
+
+/**
+ * Portable kernel computing the sum of an array
+ * @param x the input array
+ * @param n the number of elements
+ * @return the sum
+ */
+double
+ScalarSum(const double* x, size_t n)
+{
+    double acc[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            acc[k] += x[i + k];
+        }
+    }
+    double s = (acc[0] + acc[2]) + (acc[1] + acc[3]);
+    for (; i < n; ++i)
+    {
+        s += x[i];
+    }
+    return s;
+}
+
+/**
+ * Portable kernel computing the dot product of two arrays
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ * @return the dot product
+ */
+double
+ScalarDot(const double* x, const double* y, size_t n)
+{
+    double acc[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            const double p = x[i + k] * y[i + k];
+            acc[k] += p;
+        }
+    }
+    double s = (acc[0] + acc[2]) + (acc[1] + acc[3]);
+    for (; i < n; ++i)
+    {
+        const double p = x[i] * y[i];
+        s += p;
+    }
+    return s;
+}
+
+/// Portable kernels, used when no SIMD instruction set is available or when SIMD is disabled
+const SpectrumValueKernels g_scalarKernels = {
+    "scalar",
+    &ScalarBinary<KernelOp::ADD>,
+    &ScalarBinary<KernelOp::SUBTRACT>,
+    &ScalarBinary<KernelOp::MULTIPLY>,
+    &ScalarBinary<KernelOp::DIVIDE>,
+    &ScalarBinaryScalar<KernelOp::ADD>,
+    &ScalarBinaryScalar<KernelOp::MULTIPLY>,
+    &ScalarBinaryScalar<KernelOp::DIVIDE>,
+    &ScalarMultiplyAdd,
+    &ScalarMultiplyAddScalar,
+    &ScalarSum,
+    &ScalarDot,
+};
+
+#ifdef NS3_SPECTRUM_VALUE_AVX2
+
+/**
+ * Apply an element-wise operation to two vectors of four values
+ * @tparam OP the operation
+ * @param a the first operand
+ * @param b the second operand
+ * @return the result of the operation
+ */
+template <KernelOp OP>
+__attribute__((target("avx2"))) inline __m256d
+Avx2Apply(__m256d a, __m256d b)
+{
+    if constexpr (OP == KernelOp::ADD)
+    {
+        return _mm256_add_pd(a, b);
+    }
+    else if constexpr (OP == KernelOp::SUBTRACT)
+    {
+        return _mm256_sub_pd(a, b);
+    }
+    else if constexpr (OP == KernelOp::MULTIPLY)
+    {
+        return _mm256_mul_pd(a, b);
+    }
+    else
+    {
+        return _mm256_div_pd(a, b);
+    }
+}
+
+/**
+ * Combine four partial sums as ScalarSum and ScalarDot do
+ * @param acc the partial sums
+ * @return (acc[0] + acc[2]) + (acc[1] + acc[3])
+ */
+__attribute__((target("avx2"))) inline double
+Avx2Reduce(__m256d acc)
+{
+    __m128d v = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    return _mm_cvtsd_f64(v) + _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));
+}
+
+/**
+ * AVX2 element-wise kernel between two arrays
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+__attribute__((target("avx2"))) void
+Avx2Binary(double* out, const double* x, const double* y, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(out + i, Avx2Apply<OP>(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], y[i]);
+    }
+}
+
+/**
+ * AVX2 element-wise kernel between an array and a scalar
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+__attribute__((target("avx2"))) void
+Avx2BinaryScalar(double* out, const double* x, double s, size_t n)
+{
+    const __m256d vs = _mm256_set1_pd(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(out + i, Avx2Apply<OP>(_mm256_loadu_pd(x + i), vs));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], s);
+    }
+}
+
+/**
+ * AVX2 kernel computing out += x * y
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+__attribute__((target("avx2"))) void
+Avx2MultiplyAdd(double* out, const double* x, const double* y, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d p = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(out + i), p));
+    }
+    ScalarMultiplyAdd(out + i, x + i, y + i, n - i);
+}
+
+/**
+ * AVX2 kernel computing out += x * s
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+__attribute__((target("avx2"))) void
+Avx2MultiplyAddScalar(double* out, const double* x, double s, size_t n)
+{
+    const __m256d vs = _mm256_set1_pd(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d p = _mm256_mul_pd(_mm256_loadu_pd(x + i), vs);
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(out + i), p));
+    }
+    ScalarMultiplyAddScalar(out + i, x + i, s, n - i);
+}
+
+/**
+ * AVX2 kernel computing the sum of an array
+ * @param x the input array
+ * @param n the number of elements
+ * @return the sum
+ */
+__attribute__((target("avx2"))) double
+Avx2Sum(const double* x, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(x + i));
+    }
+    double s = Avx2Reduce(acc);
+    for (; i < n; ++i)
+    {
+        s += x[i];
+    }
+    return s;
+}
+
+/**
+ * AVX2 kernel computing the dot product of two arrays
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ * @return the dot product
+ */
+__attribute__((target("avx2"))) double
+Avx2Dot(const double* x, const double* y, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    }
+    double s = Avx2Reduce(acc);
+    for (; i < n; ++i)
+    {
+        const double p = x[i] * y[i];
+        s += p;
+    }
+    return s;
+}
+
+/// AVX2 kernels, used on x86-64 processors supporting AVX2
+const SpectrumValueKernels g_avx2Kernels = {
+    "avx2",
+    &Avx2Binary<KernelOp::ADD>,
+    &Avx2Binary<KernelOp::SUBTRACT>,
+    &Avx2Binary<KernelOp::MULTIPLY>,
+    &Avx2Binary<KernelOp::DIVIDE>,
+    &Avx2BinaryScalar<KernelOp::ADD>,
+    &Avx2BinaryScalar<KernelOp::MULTIPLY>,
+    &Avx2BinaryScalar<KernelOp::DIVIDE>,
+    &Avx2MultiplyAdd,
+    &Avx2MultiplyAddScalar,
+    &Avx2Sum,
+    &Avx2Dot,
+};
+
+#endif /* NS3_SPECTRUM_VALUE_AVX2 */
+
+#ifdef NS3_SPECTRUM_VALUE_NEON
+
+/**
+ * Apply an element-wise operation to two vectors of two values
+ * @tparam OP the operation
+ * @param a the first operand
+ * @param b the second operand
+ * @return the result of the operation
+ */
+template <KernelOp OP>
+inline float64x2_t
+NeonApply(float64x2_t a, float64x2_t b)
+{
+    if constexpr (OP == KernelOp::ADD)
+    {
+        return vaddq_f64(a, b);
+    }
+    else if constexpr (OP == KernelOp::SUBTRACT)
+    {
+        return vsubq_f64(a, b);
+    }
+    else if constexpr (OP == KernelOp::MULTIPLY)
+    {
+        return vmulq_f64(a, b);
+    }
+    else
+    {
+        return vdivq_f64(a, b);
+    }
+}
+
+/**
+ * Combine four partial sums as ScalarSum and ScalarDot do
+ * @param acc01 the first two partial sums
+ * @param acc23 the last two partial sums
+ * @return (acc[0] + acc[2]) + (acc[1] + acc[3])
+ */
+inline double
+NeonReduce(float64x2_t acc01, float64x2_t acc23)
+{
+    float64x2_t v = vaddq_f64(acc01, acc23);
+    return vgetq_lane_f64(v, 0) + vgetq_lane_f64(v, 1);
+}
+
+/**
+ * NEON element-wise kernel between two arrays
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+void
+NeonBinary(double* out, const double* x, const double* y, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        vst1q_f64(out + i, NeonApply<OP>(vld1q_f64(x + i), vld1q_f64(y + i)));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], y[i]);
+    }
+}
+
+/**
+ * NEON element-wise kernel between an array and a scalar
+ * @tparam OP the operation
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+template <KernelOp OP>
+void
+NeonBinaryScalar(double* out, const double* x, double s, size_t n)
+{
+    const float64x2_t vs = vdupq_n_f64(s);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        vst1q_f64(out + i, NeonApply<OP>(vld1q_f64(x + i), vs));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = ScalarApply<OP>(x[i], s);
+    }
+}
+
+/**
+ * NEON kernel computing out += x * y
+ * @param out the output array
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ */
+void
+NeonMultiplyAdd(double* out, const double* x, const double* y, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        float64x2_t p = vmulq_f64(vld1q_f64(x + i), vld1q_f64(y + i));
+        vst1q_f64(out + i, vaddq_f64(vld1q_f64(out + i), p));
+    }
+    ScalarMultiplyAdd(out + i, x + i, y + i, n - i);
+}
+
+/**
+ * NEON kernel computing out += x * s
+ * @param out the output array
+ * @param x the input array
+ * @param s the scalar
+ * @param n the number of elements
+ */
+void
+NeonMultiplyAddScalar(double* out, const double* x, double s, size_t n)
+{
+    const float64x2_t vs = vdupq_n_f64(s);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        float64x2_t p = vmulq_f64(vld1q_f64(x + i), vs);
+        vst1q_f64(out + i, vaddq_f64(vld1q_f64(out + i), p));
+    }
+    ScalarMultiplyAddScalar(out + i, x + i, s, n - i);
+}
+
+/**
+ * NEON kernel computing the sum of an array
+ * @param x the input array
+ * @param n the number of elements
+ * @return the sum
+ */
+double
+NeonSum(const double* x, size_t n)
+{
+    float64x2_t acc01 = vdupq_n_f64(0);
+    float64x2_t acc23 = vdupq_n_f64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc01 = vaddq_f64(acc01, vld1q_f64(x + i));
+        acc23 = vaddq_f64(acc23, vld1q_f64(x + i + 2));
+    }
+    double s = NeonReduce(acc01, acc23);
+    for (; i < n; ++i)
+    {
+        s += x[i];
+    }
+    return s;
+}
+
+/**
+ * NEON kernel computing the dot product of two arrays
+ * @param x the first input array
+ * @param y the second input array
+ * @param n the number of elements
+ * @return the dot product
+ */
+double
+NeonDot(const double* x, const double* y, size_t n)
+{
+    float64x2_t acc01 = vdupq_n_f64(0);
+    float64x2_t acc23 = vdupq_n_f64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc01 = vaddq_f64(acc01, vmulq_f64(vld1q_f64(x + i), vld1q_f64(y + i)));
+        acc23 = vaddq_f64(acc23, vmulq_f64(vld1q_f64(x + i + 2), vld1q_f64(y + i + 2)));
+    }
+    double s = NeonReduce(acc01, acc23);
+    for (; i < n; ++i)
+    {
+        const double p = x[i] * y[i];
+        s += p;
+    }
+    return s;
+}
+
+/// NEON kernels, used on AArch64 processors
+const SpectrumValueKernels g_neonKernels = {
+    "neon",
+    &NeonBinary<KernelOp::ADD>,
+    &NeonBinary<KernelOp::SUBTRACT>,
+    &NeonBinary<KernelOp::MULTIPLY>,
+    &NeonBinary<KernelOp::DIVIDE>,
+    &NeonBinaryScalar<KernelOp::ADD>,
+    &NeonBinaryScalar<KernelOp::MULTIPLY>,
+    &NeonBinaryScalar<KernelOp::DIVIDE>,
+    &NeonMultiplyAdd,
+    &NeonMultiplyAddScalar,
+    &NeonSum,
+    &NeonDot,
+};
+
+#endif /* NS3_SPECTRUM_VALUE_NEON */
+
+/// Whether the SIMD kernels are used when the processor supports them
+bool g_simdEnabled = true;
+
+/**
+ * Select the fastest kernels supported by the processor. The selection is made once, the
+ * first time this function is called.
+ * @return the SIMD kernels, or the portable kernels if no SIMD instruction set is supported
+ */
+const SpectrumValueKernels&
+GetSimdKernels()
+{
+    static const SpectrumValueKernels& kernels = []() -> const SpectrumValueKernels& {
+#if defined(NS3_SPECTRUM_VALUE_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return g_avx2Kernels;
+        }
+#elif defined(NS3_SPECTRUM_VALUE_NEON)
+        return g_neonKernels;
+#endif
+        return g_scalarKernels;
+    }();
+    return kernels;
+}
+
+/**
+ * @return the kernels to be used by SpectrumValue
+ */
+inline const SpectrumValueKernels&
+GetKernels()
+{
+    return g_simdEnabled ? GetSimdKernels() : g_scalarKernels;
+}
+
+} // namespace
+
+
 SpectrumValue::SpectrumValue()
 {
 }
@@ -89,47 +751,25 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
-    {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
-    }
+    GetKernels().add(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 += s;
-        ++it1;
-    }
+    GetKernels().addScalar(m_values.data(), m_values.data(), s, m_values.size());
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
-    {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
-    }
+    GetKernels().subtract(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
@@ -141,60 +781,50 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
-    {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
-    }
+    GetKernels().multiply(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 *= s;
-        ++it1;
-    }
+    GetKernels().multiplyScalar(m_values.data(), m_values.data(), s, m_values.size());
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
-    {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
-    }
+    GetKernels().divide(m_values.data(), m_values.data(), x.m_values.data(), m_values.size());
 }
 
 void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    auto it1 = m_values.begin();
+    GetKernels().divideScalar(m_values.data(), m_values.data(), s, m_values.size());
+}
 
-    while (it1 != m_values.end())
-    {
-        *it1 /= s;
-        ++it1;
-    }
+void
+SpectrumValue::ReverseSubtract(const SpectrumValue& x)
+{
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size());
+
+    GetKernels().subtract(m_values.data(), x.m_values.data(), m_values.data(), m_values.size());
+}
+
+void
+SpectrumValue::ReverseDivide(const SpectrumValue& x)
+{
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size());
+
+    GetKernels().divide(m_values.data(), x.m_values.data(), m_values.data(), m_values.size());
 }
 
 void
@@ -309,27 +939,13 @@ SpectrumValue::Log()
 double
 Norm(const SpectrumValue& x)
 {
-    double s = 0;
-    auto it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
-    {
-        s += (*it1) * (*it1);
-        ++it1;
-    }
-    return std::sqrt(s);
+    return std::sqrt(GetKernels().dot(x.m_values.data(), x.m_values.data(), x.m_values.size()));
 }
 
 double
 Sum(const SpectrumValue& x)
 {
-    double s = 0;
-    auto it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
-    {
-        s += (*it1);
-        ++it1;
-    }
-    return s;
+    return GetKernels().sum(x.m_values.data(), x.m_values.size());
 }
 
 double
@@ -348,28 +964,15 @@ Prod(const SpectrumValue& x)
 double
 Integral(const SpectrumValue& arg)
 {
-    double i = 0;
-    auto vit = arg.ConstValuesBegin();
-    auto bit = arg.ConstBandsBegin();
-    while (vit != arg.ConstValuesEnd())
-    {
-        NS_ASSERT(bit != arg.ConstBandsEnd());
-        i += (*vit) * (bit->fh - bit->fl);
-        ++vit;
-        ++bit;
-    }
-    NS_ASSERT(bit == arg.ConstBandsEnd());
-    return i;
+    const auto& widths = arg.m_spectrumModel->GetBandWidths();
+    NS_ASSERT(widths.size() == arg.m_values.size());
+    return GetKernels().dot(arg.m_values.data(), widths.data(), arg.m_values.size());
 }
 
 Ptr<SpectrumValue>
 SpectrumValue::Copy() const
 {
-    Ptr<SpectrumValue> p = Create<SpectrumValue>(m_spectrumModel);
-    *p = *this;
-    return p;
-
-    //  return Copy<SpectrumValue> (*this)
+    return Create<SpectrumValue>(*this);
 }
 
 /**
@@ -522,6 +1125,153 @@ operator-(const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator+(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Add(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(double lhs, SpectrumValue&& rhs)
+{
+    rhs.Add(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.ReverseSubtract(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(double lhs, SpectrumValue&& rhs)
+{
+    rhs.Subtract(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Multiply(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(double lhs, SpectrumValue&& rhs)
+{
+    rhs.Multiply(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.ReverseDivide(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(double lhs, SpectrumValue&& rhs)
+{
+    rhs.Divide(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& rhs)
+{
+    rhs.ChangeSign();
+    return std::move(rhs);
+}
+
 SpectrumValue
 Pow(double lhs, const SpectrumValue& rhs)
 {
@@ -647,6 +1397,59 @@ SpectrumValue::operator>>(int n) const
     return res;
 }
 
+void
+SpectrumValue::SetProduct(const SpectrumValue& x, const SpectrumValue& y)
+{
+    NS_ASSERT(x.m_spectrumModel == y.m_spectrumModel);
+    NS_ASSERT(x.m_values.size() == y.m_values.size());
+
+    m_spectrumModel = x.m_spectrumModel;
+    m_values.resize(x.m_values.size());
+    GetKernels().multiply(m_values.data(), x.m_values.data(), y.m_values.data(), m_values.size());
+}
+
+void
+SpectrumValue::SetProduct(const SpectrumValue& x, double s)
+{
+    m_spectrumModel = x.m_spectrumModel;
+    m_values.resize(x.m_values.size());
+    GetKernels().multiplyScalar(m_values.data(), x.m_values.data(), s, m_values.size());
+}
+
+void
+SpectrumValue::AddProduct(const SpectrumValue& x, const SpectrumValue& y)
+{
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel && x.m_spectrumModel == y.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size() && x.m_values.size() == y.m_values.size());
+
+    GetKernels().multiplyAdd(m_values.data(),
+                             x.m_values.data(),
+                             y.m_values.data(),
+                             m_values.size());
+}
+
+void
+SpectrumValue::AddProduct(const SpectrumValue& x, double s)
+{
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size());
+
+    GetKernels().multiplyAddScalar(m_values.data(), x.m_values.data(), s, m_values.size());
+}
+
+void
+SpectrumValue::SetSimdEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(enabled);
+    g_simdEnabled = enabled;
+}
+
+std::string
+SpectrumValue::GetSimdInstructionSet()
+{
+    return GetKernels().name;
+}
+
 uint32_t
 SpectrumValue::GetValuesN() const
 {
@@ -15,6 +15,7 @@
 #include "ns3/simple-ref-count.h"
 
 #include <ostream>
+#include <string>
 #include <vector>
 
 namespace ns3
@@ -319,6 +320,206 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator/(double lhs, const SpectrumValue& rhs);
 
+    /**
+     * addition operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * addition operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator reusing the storage of the temporary operands
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * addition operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the same value as operator+(double, const SpectrumValue&)
+     */
+    friend SpectrumValue operator+(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * subtraction operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator reusing the storage of the temporary operands
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * subtraction operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the same value as operator-(double, const SpectrumValue&)
+     */
+    friend SpectrumValue operator-(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * multiplication operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication operator reusing the storage of the temporary operands
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * multiplication operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the same value as operator*(double, const SpectrumValue&)
+     */
+    friend SpectrumValue operator*(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * division operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * division operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * division operator reusing the storage of the temporary operands
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * division operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * division operator reusing the storage of the temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the same value as operator/(double, const SpectrumValue&)
+     */
+    friend SpectrumValue operator/(double lhs, SpectrumValue&& rhs);
+
     /**
      * Compare two spectrum values
      *
@@ -355,6 +556,14 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator-(const SpectrumValue& rhs);
 
+    /**
+     * unary minus operator reusing the storage of the temporary operand
+     *
+     * @param rhs Right Hand Side of the operator
+     * @return the value of - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& rhs);
+
     /**
      * left shift operator
      *
@@ -463,12 +672,51 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     SpectrumValue& operator=(double rhs);
 
+    /**
+     * Set *this to the component-by-component product of x and y. This is
+     * equivalent to `*this = x * y`, but it is computed in a single pass
+     * which reuses the storage of *this instead of allocating a temporary.
+     *
+     * @param x the first factor
+     * @param y the second factor, which must use the same SpectrumModel as x
+     */
+    void SetProduct(const SpectrumValue& x, const SpectrumValue& y);
+
+    /**
+     * Set *this to the product of x by a scalar. This is equivalent to
+     * `*this = x * s` without allocating a temporary.
+     *
+     * @param x the SpectrumValue
+     * @param s the scalar
+     */
+    void SetProduct(const SpectrumValue& x, double s);
+
+    /**
+     * Add the component-by-component product of x and y to *this, in a single
+     * pass and without allocating a temporary (`*this += x * y`).
+     *
+     * @param x the first factor
+     * @param y the second factor
+     */
+    void AddProduct(const SpectrumValue& x, const SpectrumValue& y);
+
+    /**
+     * Add the product of x by a scalar to *this, in a single pass and without
+     * allocating a temporary (`*this += x * s`).
+     *
+     * @param x the SpectrumValue
+     * @param s the scalar
+     */
+    void AddProduct(const SpectrumValue& x, double s);
+
     /**
      *
      * @param x the operand
      *
      * @return the euclidean norm, i.e., the sum of the squares of all
      * the values in x
+     *
+     * @see SetSimdEnabled for the order of the additions
      */
     friend double Norm(const SpectrumValue& x);
 
@@ -478,6 +726,8 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @return the sum of all
      * the values in x
+     *
+     * @see SetSimdEnabled for the order of the additions
      */
     friend double Sum(const SpectrumValue& x);
 
@@ -541,6 +791,8 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      * @param arg the argument
      *
      * @return the value of the integral \f$\int_F g(f) df  \f$
+     *
+     * @see SetSimdEnabled for the order of the additions
      */
     friend double Integral(const SpectrumValue& arg);
 
@@ -561,6 +813,27 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
     // NS_DEPRECATED() - tag for future removal
     typedef void (*TracedCallback)(Ptr<SpectrumValue> value);
 
+    /**
+     * Enable or disable the SIMD kernels (AVX2 on x86-64 processors that
+     * support it, NEON on AArch64) used by the arithmetic operators, Sum, Norm
+     * and Integral. When disabled, or when no SIMD instruction set is
+     * available, portable kernels are used. Both give bit-identical results.
+     * SIMD kernels are enabled by default.
+     *
+     * With both kernels, Sum, Norm and Integral accumulate four interleaved
+     * partial sums, which are added together at the end. Their results may
+     * thus differ in the last bits from those of a sequential summation.
+     *
+     * @param enabled whether the SIMD kernels can be used
+     */
+    static void SetSimdEnabled(bool enabled);
+
+    /**
+     * @return the name of the instruction set used by the kernels: "avx2",
+     * "neon" or "scalar"
+     */
+    static std::string GetSimdInstructionSet();
+
   private:
     /**
      * Add a SpectrumValue (element to element addition)
@@ -602,6 +875,16 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      * @param s flat value
      */
     void Divide(double s);
+    /**
+     * Replace each element by the difference between the corresponding element of x and itself
+     * @param x SpectrumValue
+     */
+    void ReverseSubtract(const SpectrumValue& x);
+    /**
+     * Replace each element by the ratio between the corresponding element of x and itself
+     * @param x SpectrumValue
+     */
+    void ReverseDivide(const SpectrumValue& x);
     /**
      * Change the values sign
      */
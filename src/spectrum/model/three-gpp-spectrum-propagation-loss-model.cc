@@ -19,8 +19,10 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace ns3
 {
@@ -60,7 +62,18 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute("LongTermCacheSize",
+                          "The maximum number of long term components stored for each pair of "
+                          "antenna arrays, computed with different beamforming vectors for the "
+                          "same channel matrix. Storing more than one component avoids computing "
+                          "them again when the beamforming vectors alternate, e.g., when a "
+                          "transmitter serving several receivers in turn interferes with another "
+                          "receiver.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(
+                              &ThreeGppSpectrumPropagationLossModel::m_longTermCacheSize),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -232,48 +245,44 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     return longTerm;
 }
 
-Ptr<SpectrumSignalParameters>
+void
 ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
-    Ptr<const SpectrumSignalParameters> params,
-    Ptr<const MatrixBasedChannelModel::Complex3DVector> longTerm,
-    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+    SpectrumSignalParameters& rxParams,
+    const MatrixBasedChannelModel::Complex3DVector& longTerm,
+    const MatrixBasedChannelModel::ChannelMatrix& channelMatrix,
+    const MatrixBasedChannelModel::ChannelParams& channelParams,
+    const double dopplerFactor,
     const Vector& sSpeed,
     const Vector& uSpeed,
     const uint8_t numTxPorts,
     const uint8_t numRxPorts,
-    const bool isReverse) const
-
+    const bool isReverse)
 {
-    NS_LOG_FUNCTION(this);
-    Ptr<SpectrumSignalParameters> rxParams = params->Copy();
-    const size_t numCluster = channelMatrix->m_channel.GetNumPages();
+    const size_t numCluster = channelMatrix.m_channel.GetNumPages();
     // compute the doppler term
     // NOTE the update of Doppler is simplified by only taking the center angle of
     // each cluster in to consideration.
-    const double slotTime = Simulator::Now().GetSeconds();
-    const double factor = 2 * M_PI * slotTime * GetFrequency() / 3e8;
     PhasedArrayModel::ComplexVector doppler(numCluster);
 
     // Make sure that all the structures that are passed to this function
     // are of the correct dimensions before using the operator [].
-    NS_ASSERT(numCluster <= channelParams->m_alpha.size());
-    NS_ASSERT(numCluster <= channelParams->m_D.size());
-    NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::ZOA_INDEX].size());
-    NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::ZOD_INDEX].size());
-    NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::AOA_INDEX].size());
-    NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::AOD_INDEX].size());
-    NS_ASSERT(numCluster <= longTerm->GetNumPages());
+    NS_ASSERT(numCluster <= channelParams.m_alpha.size());
+    NS_ASSERT(numCluster <= channelParams.m_D.size());
+    NS_ASSERT(numCluster <= channelParams.m_angle[MatrixBasedChannelModel::ZOA_INDEX].size());
+    NS_ASSERT(numCluster <= channelParams.m_angle[MatrixBasedChannelModel::ZOD_INDEX].size());
+    NS_ASSERT(numCluster <= channelParams.m_angle[MatrixBasedChannelModel::AOA_INDEX].size());
+    NS_ASSERT(numCluster <= channelParams.m_angle[MatrixBasedChannelModel::AOD_INDEX].size());
+    NS_ASSERT(numCluster <= longTerm.GetNumPages());
 
     // check if channelParams structure is generated in direction s-to-u or u-to-s
-    const bool isSameDir = channelParams->m_nodeIds == channelMatrix->m_nodeIds;
+    const bool isSameDir = channelParams.m_nodeIds == channelMatrix.m_nodeIds;
 
     // if channel params is generated in the same direction in which we
     // generate the channel matrix, angles and zenith of departure and arrival are ok,
     // just set them to corresponding variable that will be used for the generation
     // of channel matrix, otherwise we need to flip angles and zeniths of departure and arrival
     using DPV = std::vector<std::pair<double, double>>;
-    const auto& cachedAngleSincos = channelParams->m_cachedAngleSincos;
+    const auto& cachedAngleSincos = channelParams.m_cachedAngleSincos;
     NS_ASSERT_MSG(cachedAngleSincos.size() > MatrixBasedChannelModel::ZOD_INDEX,
                   "Cached angle sin/cos not initialized");
     const DPV& zoa = cachedAngleSincos[isSameDir ? MatrixBasedChannelModel::ZOA_INDEX
@@ -302,12 +311,12 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
         // By default, m_vScatt is set to 0, so there is no additional Doppler
         // contribution.
 
-        const double alpha = channelParams->m_alpha[cIndex];
-        const double D = channelParams->m_D[cIndex];
+        const double alpha = channelParams.m_alpha[cIndex];
+        const double D = channelParams.m_D[cIndex];
 
         // cluster angle angle[direction][n], where direction = 0(aoa), 1(zoa).
         const double tempDoppler =
-            factor *
+            dopplerFactor *
             (zoa[cIndex].first * aoa[cIndex].second * uSpeed.x +
              zoa[cIndex].first * aoa[cIndex].first * uSpeed.y + zoa[cIndex].second * uSpeed.z +
              (zod[cIndex].first * aod[cIndex].second * sSpeed.x +
@@ -320,30 +329,30 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     NS_ASSERT(numCluster <= doppler.GetSize());
 
     // set the channel matrix
-    rxParams->spectrumChannelMatrix = GenSpectrumChannelMatrix(rxParams->psd,
-                                                               longTerm,
-                                                               channelMatrix,
-                                                               channelParams,
-                                                               doppler,
-                                                               numTxPorts,
-                                                               numRxPorts,
-                                                               isReverse);
-
-    NS_ASSERT_MSG(rxParams->psd->GetValuesN() == rxParams->spectrumChannelMatrix->GetNumPages(),
+    rxParams.spectrumChannelMatrix = GenSpectrumChannelMatrix(*rxParams.psd,
+                                                              longTerm,
+                                                              channelMatrix,
+                                                              channelParams,
+                                                              doppler,
+                                                              numTxPorts,
+                                                              numRxPorts,
+                                                              isReverse);
+
+    NS_ASSERT_MSG(rxParams.psd->GetValuesN() == rxParams.spectrumChannelMatrix->GetNumPages(),
                   "RX PSD and the spectrum channel matrix should have the same number of RBs ");
 
-    NS_ASSERT_MSG(!params->precodingMatrix || (params->precodingMatrix &&
-                                               params->precodingMatrix->GetNumPages() ==
-                                                   rxParams->spectrumChannelMatrix->GetNumPages()),
+    NS_ASSERT_MSG(!rxParams.precodingMatrix || (rxParams.precodingMatrix &&
+                                               rxParams.precodingMatrix->GetNumPages() ==
+                                                   rxParams.spectrumChannelMatrix->GetNumPages()),
                   "Unexpected mismatch in the number of RBs and channel matrix and precoding "
                   "matrix. MultiModelSpectrumChannel conversion is not yet supported.");
 
     // Calculate the RX PSD from the spectrum channel matrix H and the
     // precoding matrix P as PSD = Trace((H*P)^h * (H*P)), i.e., per RB:
     //   PSD[rb] = sum_rx sum_txStream |(H*P)[rx, txStream, rb]|^2
-    auto specMat = rxParams->spectrumChannelMatrix;
-    const uint32_t numRb = rxParams->psd->GetValuesN();
-    if (!rxParams->precodingMatrix)
+    const auto& specMat = rxParams.spectrumChannelMatrix;
+    const uint32_t numRb = rxParams.psd->GetValuesN();
+    if (!rxParams.precodingMatrix)
     {
         // When no precoding matrix is set, the default is a single isotropic
         // column P[tx, 0, rb] = 1/sqrt(numTx). In that case H*P reduces to
@@ -367,14 +376,14 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
                 }
                 psd += std::norm(rowSum);
             }
-            (*rxParams->psd)[rb] = psd * invNumTxPorts;
+            (*rxParams.psd)[rb] = psd * invNumTxPorts;
         }
     }
     else
     {
         // Explicit precoding matrix: form H*P, then sum the squared
         // magnitudes. std::norm(z) is |z|^2 without the square root.
-        MatrixBasedChannelModel::Complex3DVector hP = *specMat * *rxParams->precodingMatrix;
+        MatrixBasedChannelModel::Complex3DVector hP = *specMat * *rxParams.precodingMatrix;
         for (uint32_t rb = 0; rb < numRb; ++rb)
         {
             double psd = 0.0;
@@ -385,26 +394,75 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
                     psd += std::norm(hP(rx, txStream, rb));
                 }
             }
-            (*rxParams->psd)[rb] = psd;
+            (*rxParams.psd)[rb] = psd;
         }
     }
-    return rxParams;
+}
+
+bool
+ThreeGppSpectrumPropagationLossModel::IsDelaySincosValid(
+    const SpectrumValue& inPsd,
+    size_t numCluster,
+    const MatrixBasedChannelModel::ChannelParams& channelParams)
+{
+    const double rbWidth = inPsd.ConstBandsBegin()->fh - inPsd.ConstBandsBegin()->fl;
+    return channelParams.m_cachedDelaySincos.GetNumRows() == inPsd.GetValuesN() &&
+           channelParams.m_cachedDelaySincos.GetNumCols() == numCluster &&
+           channelParams.m_cachedRbWidth == rbWidth;
+}
+
+ComplexMatrixArray
+ThreeGppSpectrumPropagationLossModel::CalcDelaySincos(
+    const SpectrumValue& inPsd,
+    size_t numCluster,
+    const MatrixBasedChannelModel::ChannelParams& channelParams)
+{
+    const auto numRb = inPsd.GetValuesN();
+    ComplexMatrixArray delaySincos(numRb, numCluster);
+    auto sbit = inPsd.ConstBandsBegin(); // band iterator
+    for (unsigned i = 0; i < numRb; i++)
+    {
+        const double fsb = sbit->fc; // center frequency of the sub-band
+        for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+            const double delay = -2 * M_PI * fsb * channelParams.m_delay[cIndex];
+            delaySincos(i, cIndex) = std::complex(cos(delay), sin(delay));
+        }
+        ++sbit;
+    }
+    return delaySincos;
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::UpdateDelaySincos(
+    const SpectrumValue& inPsd,
+    size_t numCluster,
+    const MatrixBasedChannelModel::ChannelParams& channelParams)
+{
+    // Precompute the delay until numRb, numCluster or RB width changes
+    // Whenever the channelParams is updated, the number of numRbs, numClusters
+    // and RB width (12*SCS) are reset, ensuring these values are updated too
+    if (!IsDelaySincosValid(inPsd, numCluster, channelParams))
+    {
+        channelParams.m_cachedRbWidth = inPsd.ConstBandsBegin()->fh - inPsd.ConstBandsBegin()->fl;
+        channelParams.m_cachedDelaySincos = CalcDelaySincos(inPsd, numCluster, channelParams);
+    }
 }
 
 Ptr<MatrixBasedChannelModel::Complex3DVector>
 ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
-    Ptr<SpectrumValue> inPsd,
-    Ptr<const MatrixBasedChannelModel::Complex3DVector> longTerm,
-    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+    const SpectrumValue& inPsd,
+    const MatrixBasedChannelModel::Complex3DVector& longTerm,
+    const MatrixBasedChannelModel::ChannelMatrix& channelMatrix,
+    const MatrixBasedChannelModel::ChannelParams& channelParams,
     const PhasedArrayModel::ComplexVector& doppler,
     uint8_t numTxPorts,
     uint8_t numRxPorts,
     const bool isReverse)
 {
-    const size_t numCluster = channelMatrix->m_channel.GetNumPages();
-    const auto numRb = inPsd->GetValuesN();
-    NS_ASSERT_MSG(numCluster <= channelParams->m_delay.size(),
+    const size_t numCluster = channelMatrix.m_channel.GetNumPages();
+    const auto numRb = inPsd.GetValuesN();
+    NS_ASSERT_MSG(numCluster <= channelParams.m_delay.size(),
                   "Channel params delays size is smaller than number of clusters");
 
     // Avoid the full-copy of `*longTerm` on the (common) non-reverse
@@ -414,39 +472,26 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     MatrixBasedChannelModel::Complex3DVector reversedLongTerm;
     if (isReverse)
     {
-        reversedLongTerm = longTerm->Transpose();
+        reversedLongTerm = longTerm.Transpose();
     }
     const MatrixBasedChannelModel::Complex3DVector& directionalLongTerm =
-        isReverse ? reversedLongTerm : *longTerm;
+        isReverse ? reversedLongTerm : longTerm;
 
     Ptr<MatrixBasedChannelModel::Complex3DVector> chanSpct =
         Create<MatrixBasedChannelModel::Complex3DVector>(numRxPorts,
                                                          numTxPorts,
                                                          static_cast<uint16_t>(numRb));
 
-    // Precompute the delay until numRb, numCluster or RB width changes
-    // Whenever the channelParams is updated, the number of numRbs, numClusters
-    // and RB width (12*SCS) are reset, ensuring these values are updated too
-
-    if (const double rbWidth = inPsd->ConstBandsBegin()->fh - inPsd->ConstBandsBegin()->fl;
-        channelParams->m_cachedDelaySincos.GetNumRows() != numRb ||
-        channelParams->m_cachedDelaySincos.GetNumCols() != numCluster ||
-        channelParams->m_cachedRbWidth != rbWidth)
+    // The delay terms are normally cached in the channel params by
+    // UpdateDelaySincos; they are only computed here if the cache was
+    // prepared for another band layout, which is not updated as this
+    // function can be executed concurrently for several links.
+    const ComplexMatrixArray* delaySincosMatrix = &channelParams.m_cachedDelaySincos;
+    ComplexMatrixArray localDelaySincos;
+    if (!IsDelaySincosValid(inPsd, numCluster, channelParams))
     {
-        channelParams->m_cachedRbWidth = rbWidth;
-        channelParams->m_cachedDelaySincos = ComplexMatrixArray(numRb, numCluster);
-        auto sbit = inPsd->ConstBandsBegin(); // band iterator
-        for (unsigned i = 0; i < numRb; i++)
-        {
-            const double fsb = sbit->fc; // center frequency of the sub-band
-            for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
-            {
-                const double delay = -2 * M_PI * fsb * channelParams->m_delay[cIndex];
-                channelParams->m_cachedDelaySincos(i, cIndex) =
-                    std::complex(cos(delay), sin(delay));
-            }
-            ++sbit;
-        }
+        localDelaySincos = CalcDelaySincos(inPsd, numCluster, channelParams);
+        delaySincosMatrix = &localDelaySincos;
     }
 
     // The remaining work is the contraction
@@ -485,7 +530,7 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
 
     phasorRe.resize(numCluster * numRb);
     phasorIm.resize(numCluster * numRb);
-    const auto& delaySincos = channelParams->m_cachedDelaySincos.GetValues();
+    const auto& delaySincos = delaySincosMatrix->GetValues();
     for (size_t c = 0; c < numCluster; ++c)
     {
         const std::complex<double> dopplerC = doppler[c];
@@ -501,7 +546,7 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     // a zero channel coefficient.
     sqrtPsd.resize(numRb);
     {
-        auto vit = inPsd->ValuesBegin();
+        auto vit = inPsd.ConstValuesBegin();
         for (size_t rb = 0; rb < numRb; ++rb, ++vit)
         {
             sqrtPsd[rb] = (*vit > 0.0) ? std::sqrt(*vit) : 0.0;
@@ -561,72 +606,57 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
     Ptr<const PhasedArrayModel> aPhasedArrayModel,
     Ptr<const PhasedArrayModel> bPhasedArrayModel) const
 {
-    Ptr<const MatrixBasedChannelModel::Complex3DVector>
-        longTerm; // vector containing the long term component for each cluster
-
     // check if the channel matrix was generated considering a as the s-node and
     // b as the u-node or vice-versa
     const auto isReverse =
         channelMatrix->IsReverse(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
     const auto sAntenna = isReverse ? bPhasedArrayModel : aPhasedArrayModel;
     const auto uAntenna = isReverse ? aPhasedArrayModel : bPhasedArrayModel;
-
-    PhasedArrayModel::ComplexVector sW;
-    PhasedArrayModel::ComplexVector uW;
-    if (!isReverse)
-    {
-        sW = aPhasedArrayModel->GetBeamformingVector();
-        uW = bPhasedArrayModel->GetBeamformingVector();
-    }
-    else
-    {
-        sW = bPhasedArrayModel->GetBeamformingVector();
-        uW = aPhasedArrayModel->GetBeamformingVector();
-    }
-
-    bool update = false;   // indicates whether the long term has to be updated
-    bool notFound = false; // indicates if the long term has not been computed yet
+    const PhasedArrayModel::ComplexVector& sW = sAntenna->GetBeamformingVectorRef();
+    const PhasedArrayModel::ComplexVector& uW = uAntenna->GetBeamformingVectorRef();
 
     // compute the long term key, the key is unique for each tx-rx pair
     const uint64_t longTermId =
         MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
+    auto& longTerms = m_longTermMap[longTermId];
 
-    // look for the long term in the map and check if it is valid
-    if (m_longTermMap.contains(longTermId))
+    // the stored long term components are only valid for the channel matrix
+    // they were computed with
+    if (!longTerms.empty() &&
+        longTerms.front()->m_channel->m_generatedTime != channelMatrix->m_generatedTime)
     {
-        NS_LOG_DEBUG("found the long term component in the map");
-        longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-        // check if the channel matrix has been updated
-        // or the s beam has been changed
-        // or the u beam has been changed
-        update = m_longTermMap[longTermId]->m_channel->m_generatedTime !=
-                     channelMatrix->m_generatedTime ||
-                 m_longTermMap[longTermId]->m_sW != sW || m_longTermMap[longTermId]->m_uW != uW;
+        NS_LOG_DEBUG("the channel matrix has been updated, discard the long term components");
+        longTerms.clear();
     }
-    else
+
+    // look for the long term component computed with the current beamforming vectors
+    const auto it =
+        std::find_if(longTerms.begin(), longTerms.end(), [&sW, &uW](const auto& longTermItem) {
+            return longTermItem->m_sW == sW && longTermItem->m_uW == uW;
+        });
+    if (it != longTerms.end())
     {
-        NS_LOG_DEBUG("long term component NOT found");
-        notFound = true;
+        NS_LOG_DEBUG("found the long term component in the map");
+        // keep the components sorted from the most recently used one
+        std::rotate(longTerms.begin(), it, std::next(it));
+        return longTerms.front()->m_longTerm;
     }
 
-    if (update || notFound)
+    NS_LOG_DEBUG("compute the long term");
+    Ptr<LongTerm> longTermItem = Create<LongTerm>();
+    longTermItem->m_longTerm = CalcLongTerm(channelMatrix, sAntenna, uAntenna);
+    longTermItem->m_channel = channelMatrix;
+    longTermItem->m_sW = sW;
+    longTermItem->m_uW = uW;
+    // store the long term to reduce computation load
+    // only the small scale fading needs to be updated if the large scale parameters and antenna
+    // weights remain unchanged, or are changed back to the ones of a stored component.
+    while (!longTerms.empty() && longTerms.size() >= m_longTermCacheSize)
     {
-        NS_LOG_DEBUG("compute the long term");
-        // compute the long term component
-        longTerm = CalcLongTerm(channelMatrix, sAntenna, uAntenna);
-        Ptr<LongTerm> longTermItem = Create<LongTerm>();
-        longTermItem->m_longTerm = longTerm;
-        longTermItem->m_channel = channelMatrix;
-        longTermItem->m_sW = std::move(sW);
-        longTermItem->m_uW = std::move(uW);
-        // store the long term to reduce computation load
-        // only the small scale fading needs to be updated if the large scale parameters and antenna
-        // weights remain unchanged.
-        m_longTermMap[longTermId] = longTermItem;
+        longTerms.pop_back();
     }
-
-    return longTerm;
+    longTerms.insert(longTerms.begin(), longTermItem);
+    return longTermItem->m_longTerm;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -636,6 +666,28 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     Ptr<const MobilityModel> b,
     Ptr<const PhasedArrayModel> aPhasedArrayModel,
     Ptr<const PhasedArrayModel> bPhasedArrayModel) const
+{
+    NS_LOG_FUNCTION(this << spectrumSignalParams << a << b << aPhasedArrayModel
+                         << bPhasedArrayModel);
+    CompletionTask completion;
+    auto rxParams = DoPrepareRxPowerSpectralDensity(spectrumSignalParams,
+                                                    a,
+                                                    b,
+                                                    aPhasedArrayModel,
+                                                    bPhasedArrayModel,
+                                                    completion);
+    completion();
+    return rxParams;
+}
+
+Ptr<SpectrumSignalParameters>
+ThreeGppSpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> spectrumSignalParams,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel,
+    CompletionTask& completion) const
 {
     NS_LOG_FUNCTION(this << spectrumSignalParams << a << b << aPhasedArrayModel
                          << bPhasedArrayModel);
@@ -662,16 +714,44 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     const auto isReverse =
         channelMatrix->IsReverse(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
 
+    NS_LOG_LOGIC("copying signal parameters " << spectrumSignalParams);
+    Ptr<SpectrumSignalParameters> rxParams = spectrumSignalParams->Copy();
+    // the channel matrix is set by CalcBeamformingGain; reset it here, where the
+    // reference to the one of the signal can be released
+    rxParams->spectrumChannelMatrix = nullptr;
+    UpdateDelaySincos(*rxParams->psd, channelMatrix->m_channel.GetNumPages(), *channelParams);
+
+    // everything which depends on the simulation state is collected here
+    const double slotTime = Simulator::Now().GetSeconds();
+    const double dopplerFactor = 2 * M_PI * slotTime * GetFrequency() / 3e8;
+    const auto sSpeed = a->GetVelocity();
+    const auto uSpeed = b->GetVelocity();
+    const auto numTxPorts = aPhasedArrayModel->GetNumPorts();
+    const auto numRxPorts = bPhasedArrayModel->GetNumPorts();
+
     // apply the beamforming gain
-    return CalcBeamformingGain(spectrumSignalParams,
-                               longTerm,
-                               channelMatrix,
-                               channelParams,
-                               a->GetVelocity(),
-                               b->GetVelocity(),
-                               aPhasedArrayModel->GetNumPorts(),
-                               bPhasedArrayModel->GetNumPorts(),
-                               isReverse);
+    completion = [rxParams,
+                  longTerm,
+                  channelMatrix,
+                  channelParams,
+                  dopplerFactor,
+                  sSpeed,
+                  uSpeed,
+                  numTxPorts,
+                  numRxPorts,
+                  isReverse]() {
+        CalcBeamformingGain(*rxParams,
+                            *longTerm,
+                            *channelMatrix,
+                            *channelParams,
+                            dopplerFactor,
+                            sSpeed,
+                            uSpeed,
+                            numTxPorts,
+                            numRxPorts,
+                            isReverse);
+    };
+    return rxParams;
 }
 
 int64_t
@@ -17,6 +17,7 @@
 
 #include <complex>
 #include <unordered_map>
+#include <vector>
 
 class ThreeGppCalcLongTermMultiPortTest;
 class ThreeGppMimoPolarizationTest;
@@ -104,7 +105,9 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      * the propagation delay.
      * To reduce the computational load, the long term component associated with
      * a certain channel is cached and recomputed only when the channel realization
-     * is updated, or when the beamforming vectors change.
+     * is updated, or when the beamforming vectors change. The long term components
+     * computed with the last LongTermCacheSize pairs of beamforming vectors are
+     * kept, so that they are reused if the beamforming vectors change back.
      *
      * @param spectrumSignalParams spectrum signal tx parameters
      * @param a first node mobility model
@@ -149,15 +152,51 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      * @return 3D spectrum channel matrix with dimensions numRxPorts * numTxPorts * numRBs
      */
     static Ptr<MatrixBasedChannelModel::Complex3DVector> GenSpectrumChannelMatrix(
-        Ptr<SpectrumValue> inPsd,
-        Ptr<const MatrixBasedChannelModel::Complex3DVector> longTerm,
-        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+        const SpectrumValue& inPsd,
+        const MatrixBasedChannelModel::Complex3DVector& longTerm,
+        const MatrixBasedChannelModel::ChannelMatrix& channelMatrix,
+        const MatrixBasedChannelModel::ChannelParams& channelParams,
         const PhasedArrayModel::ComplexVector& doppler,
         const uint8_t numTxPorts,
         const uint8_t numRxPorts,
         const bool isReverse);
 
+    /**
+     * Check whether the delay terms cached in the channel params can be used
+     * for the given PSD
+     * @param inPsd the input PSD
+     * @param numCluster the number of clusters
+     * @param channelParams the channel parameters
+     * @return true if the cached delay terms match the band layout of the PSD
+     */
+    static bool IsDelaySincosValid(const SpectrumValue& inPsd,
+                                   size_t numCluster,
+                                   const MatrixBasedChannelModel::ChannelParams& channelParams);
+
+    /**
+     * Compute the delay terms exp(-j 2 pi f tau) of every band and cluster
+     * @param inPsd the input PSD, giving the center frequency of the bands
+     * @param numCluster the number of clusters
+     * @param channelParams the channel parameters, including delays
+     * @return the matrix of the delay terms, with one row per band and one
+     *         column per cluster
+     */
+    static ComplexMatrixArray CalcDelaySincos(
+        const SpectrumValue& inPsd,
+        size_t numCluster,
+        const MatrixBasedChannelModel::ChannelParams& channelParams);
+
+    /**
+     * Update the delay terms cached in the channel params, if they were
+     * computed for another band layout
+     * @param inPsd the input PSD
+     * @param numCluster the number of clusters
+     * @param channelParams the channel parameters, including delays
+     */
+    static void UpdateDelaySincos(const SpectrumValue& inPsd,
+                                  size_t numCluster,
+                                  const MatrixBasedChannelModel::ChannelParams& channelParams);
+
     /**
      * Get the operating frequency
      * @return the operating frequency in Hz
@@ -165,9 +204,10 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     double GetFrequency() const;
 
     /**
-     * Looks for the long term component in m_longTermMap. If found, checks
-     * whether it has to be updated. If not found or if it has to be updated,
-     * calls the method CalcLongTerm to compute it.
+     * Looks for the long term component computed with the current beamforming
+     * vectors and channel matrix in m_longTermMap. If not found, calls the
+     * method CalcLongTerm to compute it, and stores it in place of the least
+     * recently used one if LongTermCacheSize components are already stored.
      * @param channelMatrix the channel matrix
      * @param aPhasedArrayModel the antenna array of the tx device
      * @param bPhasedArrayModel the antenna array of the rx device
@@ -190,33 +230,64 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         Ptr<const PhasedArrayModel> uAnt) const;
 
     /**
-     * @brief Computes the beamforming gain and applies it to the TX PSD
-     * @param params SpectrumSignalParameters holding TX PSD
+     * @brief Computes the beamforming gain and applies it to the PSD
+     *
+     * This function only depends on its arguments, so that it can be
+     * executed concurrently for different receivers.
+     *
+     * @param rxParams the copy of the TX parameters, whose PSD is replaced by
+     *        the RX PSD and whose spectrum channel matrix is set
      * @param longTerm the long term component
      * @param channelMatrix the channel matrix structure
      * @param channelParams the channel params structure
+     * @param dopplerFactor the factor 2 pi t f / c of the Doppler term, at the
+     *        current time t
      * @param sSpeed the speed of the first node
      * @param uSpeed the speed of the second node
      * @param numTxPorts the number of the ports of the first node
      * @param numRxPorts the number of the ports of the second node
      * @param isReverse indicator that tells whether the channel matrix is reverse
-     * @return
      */
-    Ptr<SpectrumSignalParameters> CalcBeamformingGain(
-        Ptr<const SpectrumSignalParameters> params,
-        Ptr<const MatrixBasedChannelModel::Complex3DVector> longTerm,
-        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
-        const Vector& sSpeed,
-        const Vector& uSpeed,
-        const uint8_t numTxPorts,
-        const uint8_t numRxPorts,
-        const bool isReverse) const;
+    static void CalcBeamformingGain(SpectrumSignalParameters& rxParams,
+                                    const MatrixBasedChannelModel::Complex3DVector& longTerm,
+                                    const MatrixBasedChannelModel::ChannelMatrix& channelMatrix,
+                                    const MatrixBasedChannelModel::ChannelParams& channelParams,
+                                    const double dopplerFactor,
+                                    const Vector& sSpeed,
+                                    const Vector& uSpeed,
+                                    const uint8_t numTxPorts,
+                                    const uint8_t numRxPorts,
+                                    const bool isReverse);
+
+    /**
+     * Retrieves the channel matrix and the long term component of the link,
+     * and returns a task applying the beamforming gain, which is the most
+     * computationally intensive part of the calculation.
+     *
+     * @param spectrumSignalParams spectrum signal tx parameters
+     * @param a first node mobility model
+     * @param b second node mobility model
+     * @param aPhasedArrayModel the antenna array of the first node
+     * @param bPhasedArrayModel the antenna array of the second node
+     * @param completion set to the task applying the beamforming gain
+     * @return the parameters which will hold the received PSD once the
+     *         completion task has been executed
+     */
+    Ptr<SpectrumSignalParameters> DoPrepareRxPowerSpectralDensity(
+        Ptr<const SpectrumSignalParameters> spectrumSignalParams,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel,
+        CompletionTask& completion) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
-    //! map containing the long-term components
-    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>> m_longTermMap;
+    //! map containing the long-term components of each tx-rx pair, computed with different
+    //! beamforming vectors, from the most recently used one
+    mutable std::unordered_map<uint64_t, std::vector<Ptr<const LongTerm>>> m_longTermMap;
+    //! maximum number of long-term components stored for each tx-rx pair
+    uint32_t m_longTermCacheSize;
     //! the model to generate the channel matrix
     Ptr<MatrixBasedChannelModel> m_channelModel;
 };
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/channel-condition-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/isotropic-antenna-model.h"
+#include "ns3/log.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/three-gpp-channel-model.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/uinteger.h"
+#include "ns3/uniform-planar-array.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("SpectrumParallelPropagationTest");
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy with a phased array, recording the signals it receives
+ */
+class ParallelTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Constructor
+     * @param rxSpectrumModel the spectrum model of the PHY
+     * @param antenna the antenna of the PHY
+     */
+    ParallelTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel,
+                            Ptr<PhasedArrayModel> antenna);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::vector<Ptr<SpectrumSignalParameters>> m_rxParams; //!< the received signals
+
+  private:
+    void DoDispose() override;
+
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< the spectrum model
+    Ptr<MobilityModel> m_mobility;              //!< the mobility model
+    Ptr<PhasedArrayModel> m_antenna;            //!< the antenna
+};
+
+TypeId
+ParallelTestSpectrumPhy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ParallelTestSpectrumPhy").SetParent<SpectrumPhy>().SetGroupName("Spectrum");
+    return tid;
+}
+
+ParallelTestSpectrumPhy::ParallelTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel,
+                                                 Ptr<PhasedArrayModel> antenna)
+    : m_rxSpectrumModel(rxSpectrumModel),
+      m_antenna(antenna)
+{
+}
+
+void
+ParallelTestSpectrumPhy::DoDispose()
+{
+    m_mobility = nullptr;
+    m_antenna = nullptr;
+    m_rxParams.clear();
+    SpectrumPhy::DoDispose();
+}
+
+void
+ParallelTestSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+ParallelTestSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+ParallelTestSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+ParallelTestSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+ParallelTestSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+ParallelTestSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+ParallelTestSpectrumPhy::GetAntenna() const
+{
+    return m_antenna;
+}
+
+void
+ParallelTestSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxParams.push_back(params);
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test that the signals received through a MultiModelSpectrumChannel
+ * with a ThreeGppSpectrumPropagationLossModel do not depend on the number of
+ * threads set with the PropagationThreadCount attribute
+ */
+class SpectrumParallelPropagationTestCase : public TestCase
+{
+  public:
+    SpectrumParallelPropagationTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * The received signals of a simulation, per receiver
+     */
+    using RxSignals = std::vector<std::vector<Ptr<SpectrumSignalParameters>>>;
+
+    /**
+     * Run a simulation in which a node transmits two signals to several receivers
+     * @param threadCount the value of the PropagationThreadCount attribute
+     * @return the received signals
+     */
+    RxSignals RunSimulation(uint32_t threadCount);
+};
+
+SpectrumParallelPropagationTestCase::SpectrumParallelPropagationTestCase()
+    : TestCase("Check that the received signals do not depend on the number of threads")
+{
+}
+
+SpectrumParallelPropagationTestCase::RxSignals
+SpectrumParallelPropagationTestCase::RunSimulation(uint32_t threadCount)
+{
+    const uint32_t nReceivers = 12;
+
+    // 24 resource blocks of 180 kHz at 3.5 GHz
+    std::vector<double> freqs;
+    for (uint32_t i = 0; i <= 24; ++i)
+    {
+        freqs.push_back(3.5e9 + i * 180e3);
+    }
+    auto sm = Create<SpectrumModel>(freqs);
+
+    auto lossModel = CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    lossModel->SetChannelModelAttribute("Frequency", DoubleValue(3.5e9));
+    lossModel->SetChannelModelAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    lossModel->SetChannelModelAttribute(
+        "ChannelConditionModel",
+        PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    DynamicCast<ThreeGppChannelModel>(lossModel->GetChannelModel())->AssignStreams(1);
+
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->SetAttribute("PropagationThreadCount", UintegerValue(threadCount));
+    channel->AddPhasedArraySpectrumPropagationLossModel(lossModel);
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    NodeContainer nodes;
+    nodes.Create(nReceivers + 1);
+    std::vector<Ptr<ParallelTestSpectrumPhy>> phys;
+    for (uint32_t i = 0; i <= nReceivers; ++i)
+    {
+        auto antenna = CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(i == 0 ? 4 : 2),
+            "NumRows",
+            UintegerValue(2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>()));
+        const auto nElems = antenna->GetNumElems();
+        antenna->SetBeamformingVector(PhasedArrayModel::ComplexVector(
+            std::valarray<std::complex<double>>(1 / std::sqrt(nElems), nElems)));
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        // the receivers are on a spiral around the transmitter, at various distances
+        const double distance = 10.0 + 15.0 * i;
+        mobility->SetPosition(Vector(distance * std::cos(i), distance * std::sin(i), 1.5));
+        nodes.Get(i)->AggregateObject(mobility);
+        auto phy = CreateObject<ParallelTestSpectrumPhy>(sm, antenna);
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    auto transmit = [channel, sm, txPhy = phys[0]]() {
+        auto params = Create<SpectrumSignalParameters>();
+        params->psd = Create<SpectrumValue>(sm);
+        *params->psd = 1e-9;
+        params->txPhy = txPhy;
+        params->duration = MicroSeconds(100);
+        channel->StartTx(params);
+    };
+    Simulator::Schedule(MilliSeconds(1), transmit);
+    Simulator::Schedule(MilliSeconds(2), transmit);
+    Simulator::Run();
+
+    RxSignals signals;
+    for (uint32_t i = 1; i <= nReceivers; ++i)
+    {
+        signals.push_back(phys[i]->m_rxParams);
+    }
+    NS_TEST_EXPECT_MSG_EQ(phys[0]->m_rxParams.size(),
+                          0,
+                          "The transmitter received its own signal");
+    Simulator::Destroy();
+    return signals;
+}
+
+void
+SpectrumParallelPropagationTestCase::DoRun()
+{
+    auto reference = RunSimulation(0);
+    for (const auto& rxParams : reference)
+    {
+        NS_TEST_ASSERT_MSG_EQ(rxParams.size(), 2, "A receiver missed a signal");
+        NS_TEST_EXPECT_MSG_GT(Sum(*rxParams[0]->psd), 0, "Null received power");
+    }
+
+    auto serial = RunSimulation(1);
+    for (uint32_t threadCount : {2, 4})
+    {
+        auto parallel = RunSimulation(threadCount);
+        NS_TEST_ASSERT_MSG_EQ(parallel.size(), serial.size(), "Unexpected number of receivers");
+        for (std::size_t i = 0; i < serial.size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(parallel[i].size(), 2, "A receiver missed a signal");
+            for (std::size_t j = 0; j < parallel[i].size(); ++j)
+            {
+                const auto& expected = *serial[i][j];
+                const auto& actual = *parallel[i][j];
+                NS_TEST_EXPECT_MSG_EQ((*actual.psd == *expected.psd),
+                                      true,
+                                      "Different PSD for receiver " << i << " with "
+                                                                    << threadCount << " threads");
+                NS_TEST_ASSERT_MSG_EQ(bool(actual.spectrumChannelMatrix),
+                                      bool(expected.spectrumChannelMatrix),
+                                      "Different channel matrix for receiver "
+                                          << i << " with " << threadCount << " threads");
+                if (expected.spectrumChannelMatrix)
+                {
+                    NS_TEST_EXPECT_MSG_EQ((*actual.spectrumChannelMatrix ==
+                                           *expected.spectrumChannelMatrix),
+                                          true,
+                                          "Different channel matrix for receiver "
+                                              << i << " with " << threadCount << " threads");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Parallel propagation TestSuite
+ */
+class SpectrumParallelPropagationTestSuite : public TestSuite
+{
+  public:
+    SpectrumParallelPropagationTestSuite();
+};
+
+SpectrumParallelPropagationTestSuite::SpectrumParallelPropagationTestSuite()
+    : TestSuite("spectrum-parallel-propagation", Type::UNIT)
+{
+    AddTestCase(new SpectrumParallelPropagationTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SpectrumParallelPropagationTestSuite g_spectrumParallelPropagationTestSuite;
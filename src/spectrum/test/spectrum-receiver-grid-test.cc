@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-receiver-grid.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("SpectrumReceiverGridTest");
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy counting the signals it receives
+ */
+class GridTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Constructor
+     * @param rxSpectrumModel the spectrum model of the PHY
+     */
+    GridTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    uint32_t m_rxCount{0}; //!< number of received signals
+
+  private:
+    void DoDispose() override;
+
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< the spectrum model
+    Ptr<MobilityModel> m_mobility;              //!< the mobility model
+};
+
+TypeId
+GridTestSpectrumPhy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::GridTestSpectrumPhy").SetParent<SpectrumPhy>().SetGroupName("Spectrum");
+    return tid;
+}
+
+GridTestSpectrumPhy::GridTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel)
+    : m_rxSpectrumModel(rxSpectrumModel)
+{
+}
+
+void
+GridTestSpectrumPhy::DoDispose()
+{
+    m_mobility = nullptr;
+    SpectrumPhy::DoDispose();
+}
+
+void
+GridTestSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+GridTestSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+GridTestSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+GridTestSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+GridTestSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+GridTestSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+GridTestSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+GridTestSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    ++m_rxCount;
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test the lookups of a SpectrumReceiverGrid while receivers are moved,
+ * added and removed
+ */
+class SpectrumReceiverGridTestCase : public TestCase
+{
+  public:
+    SpectrumReceiverGridTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the receivers returned by a lookup
+     * @param position the position of the lookup
+     * @param expected the indexes in m_phys of the expected receivers, in order
+     */
+    void CheckCandidates(const Vector& position, const std::vector<uint32_t>& expected);
+
+    Ptr<SpectrumReceiverGrid> m_grid;             //!< the grid under test
+    std::vector<Ptr<GridTestSpectrumPhy>> m_phys; //!< the receivers
+};
+
+SpectrumReceiverGridTestCase::SpectrumReceiverGridTestCase()
+    : TestCase("Check the receivers found by a SpectrumReceiverGrid")
+{
+}
+
+void
+SpectrumReceiverGridTestCase::CheckCandidates(const Vector& position,
+                                              const std::vector<uint32_t>& expected)
+{
+    auto candidates = m_grid->GetCandidates(position, 25);
+    NS_TEST_ASSERT_MSG_EQ(candidates.size(),
+                          expected.size(),
+                          "Unexpected number of receivers around " << position << " at "
+                                                                   << Simulator::Now().As(Time::S));
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(candidates[i],
+                              m_phys[expected[i]],
+                              "Unexpected receiver " << i << " around " << position);
+    }
+}
+
+void
+SpectrumReceiverGridTestCase::DoRun()
+{
+    auto sm = Create<SpectrumModel>(std::vector<double>{1e9, 1.001e9});
+    m_grid = Create<SpectrumReceiverGrid>(25);
+
+    // receivers 0 to 9 every 10 meters along the X axis
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        auto phy = CreateObject<GridTestSpectrumPhy>(sm);
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(i * 10.0, 0, 0));
+        phy->SetMobility(mobility);
+        m_phys.push_back(phy);
+        m_grid->Add(phy);
+    }
+    // receiver 10 moving towards the origin at 10 m/s from x=100 m
+    auto moving = CreateObject<GridTestSpectrumPhy>(sm);
+    auto velocityMobility = CreateObject<ConstantVelocityMobilityModel>();
+    velocityMobility->SetPosition(Vector(100, 0, 0));
+    velocityMobility->SetVelocity(Vector(-10, 0, 0));
+    moving->SetMobility(velocityMobility);
+    m_phys.push_back(moving);
+    m_grid->Add(moving);
+    // receiver 11 without mobility model
+    auto unknown = CreateObject<GridTestSpectrumPhy>(sm);
+    m_phys.push_back(unknown);
+    m_grid->Add(unknown);
+
+    NS_TEST_EXPECT_MSG_EQ(m_grid->GetNReceivers(), 12, "Unexpected number of receivers");
+    CheckCandidates(Vector(0, 0, 0), {0, 1, 2, 11});
+    CheckCandidates(Vector(50, 20, 0), {4, 5, 6, 11});
+    CheckCandidates(Vector(-100, 0, 0), {11});
+
+    // the course change of receiver 9 moves it close to the origin
+    m_phys[9]->GetMobility()->SetPosition(Vector(5, 5, 0));
+    CheckCandidates(Vector(0, 0, 0), {0, 1, 2, 9, 11});
+    CheckCandidates(Vector(90, 0, 0), {7, 8, 10, 11});
+
+    // receiver 11 gets a mobility model far from the origin
+    auto mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(1000, 1000, 0));
+    unknown->SetMobility(mobility);
+    CheckCandidates(Vector(0, 0, 0), {0, 1, 2, 9});
+    CheckCandidates(Vector(1000, 990, 5), {11});
+
+    m_grid->Remove(m_phys[1]);
+    NS_TEST_EXPECT_MSG_EQ(m_grid->GetNReceivers(), 11, "Unexpected number of receivers");
+    CheckCandidates(Vector(0, 0, 0), {0, 2, 9});
+
+    // receiver 10 is found at its current position, and once stopped, in its new cell
+    Simulator::Schedule(Seconds(8), [this]() { CheckCandidates(Vector(0, 0, 0), {0, 2, 9, 10}); });
+    Simulator::Schedule(Seconds(9), [this, velocityMobility]() {
+        velocityMobility->SetVelocity(Vector(0, 0, 0));
+        CheckCandidates(Vector(0, 0, 0), {0, 2, 9, 10});
+        CheckCandidates(Vector(90, 0, 0), {7, 8});
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+
+    m_grid = nullptr;
+    m_phys.clear();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test that a spectrum channel with the MaxRange attribute set only
+ * delivers the signals to the receivers within range
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param channelType the TypeId name of the channel
+     * @param maxRange the value of the MaxRange attribute [m]
+     * @param expectedReceivers the number of receivers expected to receive the signal
+     */
+    SpectrumChannelMaxRangeTestCase(const std::string& channelType,
+                                    double maxRange,
+                                    uint32_t expectedReceivers);
+
+  private:
+    void DoRun() override;
+
+    std::string m_channelType;    //!< the TypeId name of the channel
+    double m_maxRange;            //!< the value of the MaxRange attribute [m]
+    uint32_t m_expectedReceivers; //!< the expected number of receivers of the signal
+};
+
+SpectrumChannelMaxRangeTestCase::SpectrumChannelMaxRangeTestCase(const std::string& channelType,
+                                                                 double maxRange,
+                                                                 uint32_t expectedReceivers)
+    : TestCase("Check the receivers of a " + channelType + " with MaxRange=" +
+               std::to_string(static_cast<uint32_t>(maxRange)) + " m"),
+      m_channelType(channelType),
+      m_maxRange(maxRange),
+      m_expectedReceivers(expectedReceivers)
+{
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    auto sm = Create<SpectrumModel>(std::vector<double>{1e9, 1.001e9});
+    ObjectFactory factory(m_channelType);
+    factory.Set("MaxRange", DoubleValue(m_maxRange));
+    auto channel = factory.Create<SpectrumChannel>();
+
+    // receivers every 10 meters along the X axis, the transmitter is the first one
+    std::vector<Ptr<GridTestSpectrumPhy>> phys;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        auto phy = CreateObject<GridTestSpectrumPhy>(sm);
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(i * 10.0, 0, 0));
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    auto transmit = [channel, sm, phys]() {
+        auto params = Create<SpectrumSignalParameters>();
+        params->psd = Create<SpectrumValue>(sm);
+        params->txPhy = phys[0];
+        params->duration = MicroSeconds(100);
+        channel->StartTx(params);
+    };
+    Simulator::Schedule(Seconds(1), transmit);
+    // the receivers added later are indexed as well
+    Simulator::Schedule(Seconds(2), [channel, sm, &phys]() {
+        auto phy = CreateObject<GridTestSpectrumPhy>(sm);
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(0, 5, 0));
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    });
+    Simulator::Schedule(Seconds(3), transmit);
+    Simulator::Run();
+
+    uint32_t receivers = 0;
+    for (std::size_t i = 1; i < 10; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(phys[i]->m_rxCount % 2, 0, "Receiver " << i << " missed a signal");
+        receivers += phys[i]->m_rxCount / 2;
+    }
+    NS_TEST_EXPECT_MSG_EQ(phys[0]->m_rxCount, 0, "The transmitter received its signal");
+    NS_TEST_EXPECT_MSG_EQ(receivers, m_expectedReceivers, "Unexpected number of receivers");
+    NS_TEST_EXPECT_MSG_EQ(phys[10]->m_rxCount, 1, "The receiver added last missed the signal");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumReceiverGrid TestSuite
+ */
+class SpectrumReceiverGridTestSuite : public TestSuite
+{
+  public:
+    SpectrumReceiverGridTestSuite();
+};
+
+SpectrumReceiverGridTestSuite::SpectrumReceiverGridTestSuite()
+    : TestSuite("spectrum-receiver-grid", Type::UNIT)
+{
+    AddTestCase(new SpectrumReceiverGridTestCase, TestCase::Duration::QUICK);
+    for (const auto& channelType :
+         {"ns3::SingleModelSpectrumChannel", "ns3::MultiModelSpectrumChannel"})
+    {
+        AddTestCase(new SpectrumChannelMaxRangeTestCase(channelType, 0, 9),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new SpectrumChannelMaxRangeTestCase(channelType, 25, 2),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new SpectrumChannelMaxRangeTestCase(channelType, 1000, 9),
+                    TestCase::Duration::QUICK);
+    }
+}
+
+/// Static variable for test initialization
+static SpectrumReceiverGridTestSuite g_spectrumReceiverGridTestSuite;
@@ -8,6 +8,7 @@
 
 #include "ns3/log.h"
 #include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/spectrum-converter.h"
 #include "ns3/spectrum-test.h"
 #include "ns3/spectrum-value.h"
@@ -15,6 +16,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 using namespace ns3;
 
@@ -137,6 +139,192 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test the kernels used by SpectrumValue
+ *
+ * The SIMD and the portable kernels must give bit-identical results, the
+ * operators taking temporaries must reuse their storage, and the fused
+ * operations must give the same results as the operators they replace.
+ * Since the reductions accumulate four partial sums, Sum, Norm and Integral
+ * are compared with sequential sums up to the bound of their rounding error.
+ */
+class SpectrumValueKernelsTestCase : public TestCase
+{
+  public:
+    SpectrumValueKernelsTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Compute the result of a set of operations with the kernels currently in use
+     * @param x the first operand
+     * @param y the second operand, whose values must be non-zero
+     * @return all the values of the results
+     */
+    std::vector<double> Compute(const SpectrumValue& x, const SpectrumValue& y);
+
+    /**
+     * Check Sum, Norm and Integral against sequential sums
+     * @param x the operand
+     */
+    void CheckReductions(const SpectrumValue& x);
+};
+
+SpectrumValueKernelsTestCase::SpectrumValueKernelsTestCase()
+    : TestCase("SpectrumValue kernels")
+{
+}
+
+std::vector<double>
+SpectrumValueKernelsTestCase::Compute(const SpectrumValue& x, const SpectrumValue& y)
+{
+    std::vector<double> results;
+    auto append = [&results](const SpectrumValue& v) {
+        results.insert(results.end(), v.ConstValuesBegin(), v.ConstValuesEnd());
+    };
+
+    append(x + y);
+    append(x - y);
+    append(x * y);
+    append(x / y);
+    append(x + 2.5);
+    append(x - 2.5);
+    append(x * 2.5);
+    append(x / 2.5);
+    append((x * y) + x);
+    append(x - (y * y));
+    append(x / (y + 1.0));
+    append((x + y) * (x - y));
+    append(-(x * y));
+
+    SpectrumValue r(x.GetSpectrumModel());
+    r.SetProduct(x, y);
+    append(r);
+    r.AddProduct(x, 0.5);
+    append(r);
+    r.AddProduct(y, y);
+    append(r);
+
+    results.push_back(Sum(x));
+    results.push_back(Norm(x));
+    results.push_back(Integral(x));
+    return results;
+}
+
+void
+SpectrumValueKernelsTestCase::CheckReductions(const SpectrumValue& x)
+{
+    const auto n = x.GetValuesN();
+    double sum = 0;
+    double absSum = 0;
+    double squares = 0;
+    double integral = 0;
+    double absIntegral = 0;
+    auto band = x.ConstBandsBegin();
+    for (std::size_t i = 0; i < n; ++i, ++band)
+    {
+        sum += x[i];
+        absSum += std::abs(x[i]);
+        squares += x[i] * x[i];
+        integral += x[i] * (band->fh - band->fl);
+        absIntegral += std::abs(x[i] * (band->fh - band->fl));
+    }
+
+    // both the sequential and the partial sums are within n * eps * sum(|x|) of the exact sum
+    const double tol = 2 * n * std::numeric_limits<double>::epsilon();
+    NS_TEST_EXPECT_MSG_EQ_TOL(Sum(x), sum, tol * absSum, "Wrong sum, n=" << n);
+    NS_TEST_EXPECT_MSG_EQ_TOL(Norm(x),
+                              std::sqrt(squares),
+                              tol * std::sqrt(squares),
+                              "Wrong norm, n=" << n);
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(x), integral, tol * absIntegral, "Wrong integral, n=" << n);
+}
+
+void
+SpectrumValueKernelsTestCase::DoRun()
+{
+    auto uv = CreateObject<UniformRandomVariable>();
+    uv->SetStream(1);
+
+    // cover the vectorized loops as well as their remainders
+    for (uint32_t n = 2; n <= 21; ++n)
+    {
+        std::vector<double> freqs;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            freqs.push_back(1e9 + i * 180e3 + uv->GetValue(-1e3, 1e3));
+        }
+        auto sm = Create<SpectrumModel>(freqs);
+        SpectrumValue x(sm);
+        SpectrumValue y(sm);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            x[i] = uv->GetValue(-1, 1);
+            y[i] = uv->GetValue(0.5, 2);
+        }
+
+        SpectrumValue::SetSimdEnabled(true);
+        auto simd = Compute(x, y);
+        SpectrumValue::SetSimdEnabled(false);
+        NS_TEST_ASSERT_MSG_EQ(SpectrumValue::GetSimdInstructionSet(),
+                              "scalar",
+                              "Portable kernels not in use");
+        auto scalar = Compute(x, y);
+        SpectrumValue::SetSimdEnabled(true);
+
+        NS_TEST_ASSERT_MSG_EQ(simd.size(), scalar.size(), "Unexpected number of results");
+        for (std::size_t i = 0; i < simd.size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(simd[i],
+                                  scalar[i],
+                                  "Result " << i << " differs between the "
+                                            << SpectrumValue::GetSimdInstructionSet()
+                                            << " and the portable kernels, n=" << n);
+        }
+
+        SpectrumValue::SetSimdEnabled(false);
+        CheckReductions(x);
+        SpectrumValue::SetSimdEnabled(true);
+        CheckReductions(x);
+
+        SpectrumValue r(sm);
+        const double* data = r.GetValues().data();
+        r.SetProduct(x, y);
+        NS_TEST_EXPECT_MSG_EQ((r == x * y), true, "SetProduct differs from operator*");
+        r.AddProduct(x, y);
+        NS_TEST_EXPECT_MSG_EQ((r == x * y + x * y), true, "AddProduct differs from operators");
+        r.SetProduct(x, 3.0);
+        NS_TEST_EXPECT_MSG_EQ((r == x * 3.0), true, "SetProduct differs from operator*");
+        NS_TEST_EXPECT_MSG_EQ(r.GetValues().data(), data, "SetProduct reallocated the values");
+
+        SpectrumValue t = x * y;
+        data = t.GetValues().data();
+        SpectrumValue u = x / (std::move(t) + 1.0);
+        NS_TEST_EXPECT_MSG_EQ(u.GetValues().data(), data, "The temporary storage was not reused");
+    }
+
+    // large spectrum models, where the sequential and the partial sums differ the most
+    for (uint32_t n : {1000, 10001})
+    {
+        std::vector<double> freqs;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            freqs.push_back(1e9 + i * 15e3);
+        }
+        SpectrumValue x(Create<SpectrumModel>(freqs));
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            x[i] = uv->GetValue(-1, 1) * std::pow(10, uv->GetValue(-15, -5));
+        }
+        SpectrumValue::SetSimdEnabled(false);
+        CheckReductions(x);
+        SpectrumValue::SetSimdEnabled(true);
+        CheckReductions(x);
+    }
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -320,6 +508,8 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"),
                 TestCase::Duration::QUICK);
+
+    AddTestCase(new SpectrumValueKernelsTestCase, TestCase::Duration::QUICK);
 }
 
 /**
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "cached-error-rate-model.h"
+
+#include "table-based-error-rate-model.h"
+#include "wifi-tx-vector.h"
+#include "wifi-utils.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedErrorRateModel);
+
+/// bounds of -ln(S), so that success rates of 0 and 1 map to finite values
+static constexpr double MIN_NEG_LOG_SUCCESS = 1e-30; //!< -ln(S) for S = 1
+static constexpr double MAX_NEG_LOG_SUCCESS = 1e3;   //!< -ln(S) for S = 0
+/// number of steps between the points checked along each axis of a cell
+static constexpr std::size_t CHECK_STEPS = 4;
+
+TypeId
+CachedErrorRateModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<CachedErrorRateModel>()
+            .AddAttribute("ErrorRateModel",
+                          "Ptr to the error rate model whose chunk success rates are cached",
+                          PointerValue(CreateObject<TableBasedErrorRateModel>()),
+                          MakePointerAccessor(&CachedErrorRateModel::m_errorRateModel),
+                          MakePointerChecker<ErrorRateModel>())
+            .AddAttribute("MinSnr",
+                          "The lowest SNR (dB) of the grids. The chunks received with a lower "
+                          "SNR are computed by the wrapped model.",
+                          DoubleValue(-10),
+                          MakeDoubleAccessor(&CachedErrorRateModel::m_minSnr),
+                          MakeDoubleChecker<dB_u>())
+            .AddAttribute("MaxSnr",
+                          "The highest SNR (dB) of the grids. The chunks received with a higher "
+                          "SNR are computed by the wrapped model.",
+                          DoubleValue(60),
+                          MakeDoubleAccessor(&CachedErrorRateModel::m_maxSnr),
+                          MakeDoubleChecker<dB_u>())
+            .AddAttribute("SnrStep",
+                          "The SNR step (dB) between the points of the grids.",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&CachedErrorRateModel::m_snrStep),
+                          MakeDoubleChecker<dB_u>(0.001))
+            .AddAttribute("Tolerance",
+                          "The maximum difference between the interpolated success rate and the "
+                          "one of the wrapped model. The cells where the difference exceeds half "
+                          "of it at one of the checked points are computed by the wrapped model.",
+                          DoubleValue(1e-3),
+                          MakeDoubleAccessor(&CachedErrorRateModel::m_tolerance),
+                          MakeDoubleChecker<double>(0, 1));
+    return tid;
+}
+
+CachedErrorRateModel::CachedErrorRateModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedErrorRateModel::~CachedErrorRateModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedErrorRateModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_errorRateModel = nullptr;
+    m_grids.clear();
+    ErrorRateModel::DoDispose();
+}
+
+bool
+CachedErrorRateModel::IsAwgn() const
+{
+    return m_errorRateModel->IsAwgn();
+}
+
+int64_t
+CachedErrorRateModel::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    return m_errorRateModel->AssignStreams(stream);
+}
+
+uint64_t
+CachedErrorRateModel::GetCacheHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedErrorRateModel::GetCacheMisses() const
+{
+    return m_misses;
+}
+
+void
+CachedErrorRateModel::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_grids.clear();
+}
+
+double
+CachedErrorRateModel::Sample(WifiMode mode,
+                             const WifiTxVector& txVector,
+                             double snr,
+                             uint64_t nbits,
+                             uint8_t numRxAntennas,
+                             WifiPpduField field,
+                             uint16_t staId) const
+{
+    m_misses++;
+    const auto success = m_errorRateModel->GetChunkSuccessRate(mode,
+                                                               txVector,
+                                                               snr,
+                                                               nbits,
+                                                               numRxAntennas,
+                                                               field,
+                                                               staId);
+    const auto negLog = (success > 0) ? -std::log(success) : MAX_NEG_LOG_SUCCESS;
+    return std::log(std::clamp(negLog, MIN_NEG_LOG_SUCCESS, MAX_NEG_LOG_SUCCESS));
+}
+
+double
+CachedErrorRateModel::Interpolate(const Grid& grid,
+                                  std::size_t cell,
+                                  double snrOffset,
+                                  double sizeOffset)
+{
+    const auto lower = grid.lower[cell] + snrOffset * (grid.lower[cell + 1] - grid.lower[cell]);
+    const auto upper = grid.upper[cell] + snrOffset * (grid.upper[cell + 1] - grid.upper[cell]);
+    const auto negLog = std::exp(lower + sizeOffset * (upper - lower));
+    return (negLog >= MAX_NEG_LOG_SUCCESS) ? 0 : std::exp(-negLog);
+}
+
+double
+CachedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                            const WifiTxVector& txVector,
+                                            double snr,
+                                            uint64_t nbits,
+                                            uint8_t numRxAntennas,
+                                            WifiPpduField field,
+                                            uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
+    const auto snrDb = RatioToDb(snr);
+    if (nbits == 0 || !(snrDb >= m_minSnr) || snrDb >= m_maxSnr)
+    {
+        m_misses++;
+        return m_errorRateModel->GetChunkSuccessRate(mode,
+                                                     txVector,
+                                                     snr,
+                                                     nbits,
+                                                     numRxAntennas,
+                                                     field,
+                                                     staId);
+    }
+
+    const auto numPoints =
+        static_cast<std::size_t>(std::ceil((m_maxSnr - m_minSnr) / m_snrStep)) + 1;
+    const auto position = (snrDb - m_minSnr) / m_snrStep;
+    const auto cell = std::min(static_cast<std::size_t>(position), numPoints - 2);
+    const auto snrOffset = position - cell;
+
+    // chunk sizes in [2^k, 2^(k+1)) share the same grid
+    const uint8_t k = std::bit_width(nbits) - 1;
+    const uint64_t lowerSize = uint64_t{1} << k;
+    const auto sizeOffset = std::log2(static_cast<double>(nbits)) - k;
+
+    auto& grid = m_grids[{mode.GetUid(),
+                          txVector.GetChannelWidth(),
+                          txVector.IsLdpc(),
+                          numRxAntennas,
+                          field,
+                          k}];
+    if (grid.lower.size() != numPoints)
+    {
+        // first use of this grid or grid parameters changed since it was built
+        grid.lower.assign(numPoints, std::numeric_limits<double>::quiet_NaN());
+        grid.upper.assign(numPoints, std::numeric_limits<double>::quiet_NaN());
+        grid.cells.assign(numPoints - 1, CELL_UNKNOWN);
+    }
+
+    if (grid.cells[cell] == CELL_UNKNOWN)
+    {
+        for (auto point : {cell, cell + 1})
+        {
+            if (std::isnan(grid.lower[point]))
+            {
+                const auto pointSnr = DbToRatio(m_minSnr + point * m_snrStep);
+                grid.lower[point] =
+                    Sample(mode, txVector, pointSnr, lowerSize, numRxAntennas, field, staId);
+                grid.upper[point] =
+                    Sample(mode, txVector, pointSnr, 2 * lowerSize, numRxAntennas, field, staId);
+            }
+        }
+        // the wrapped model may clip the success rate to 0 or 1, which is not smooth: the
+        // cells with both clipped and non clipped grid points are computed by the wrapped model
+        const std::array points{grid.lower[cell],
+                                grid.lower[cell + 1],
+                                grid.upper[cell],
+                                grid.upper[cell + 1]};
+        const auto allOrNone = [&points](double bound) {
+            const auto n = std::count(points.cbegin(), points.cend(), std::log(bound));
+            return n == 0 || n == std::ssize(points);
+        };
+        // check the interpolation error on a regular lattice of SNRs and chunk sizes covering
+        // the cell, with half the tolerance as margin for the error between the checked points
+        auto interpolate = allOrNone(MIN_NEG_LOG_SUCCESS) && allOrNone(MAX_NEG_LOG_SUCCESS);
+        for (std::size_t i = 0; i <= CHECK_STEPS && interpolate; i++)
+        {
+            const auto checkSnrOffset = static_cast<double>(i) / CHECK_STEPS;
+            const auto checkSnr = DbToRatio(m_minSnr + (cell + checkSnrOffset) * m_snrStep);
+            for (std::size_t j = 0; j <= CHECK_STEPS && interpolate; j++)
+            {
+                const auto size = static_cast<uint64_t>(
+                    std::round(lowerSize * std::exp2(static_cast<double>(j) / CHECK_STEPS)));
+                const auto expected = m_errorRateModel->GetChunkSuccessRate(mode,
+                                                                            txVector,
+                                                                            checkSnr,
+                                                                            size,
+                                                                            numRxAntennas,
+                                                                            field,
+                                                                            staId);
+                m_misses++;
+                const auto interpolated = Interpolate(grid,
+                                                      cell,
+                                                      checkSnrOffset,
+                                                      std::log2(static_cast<double>(size)) - k);
+                interpolate = std::abs(interpolated - expected) <= m_tolerance / 2;
+                NS_LOG_DEBUG("Cell " << cell << " of grid for mode " << mode << ", SNR offset "
+                                     << checkSnrOffset << " and size " << size
+                                     << ": expected=" << expected
+                                     << " interpolated=" << interpolated);
+            }
+        }
+        grid.cells[cell] = interpolate ? CELL_INTERPOLATE : CELL_DIRECT;
+    }
+
+    if (grid.cells[cell] == CELL_DIRECT)
+    {
+        m_misses++;
+        return m_errorRateModel->GetChunkSuccessRate(mode,
+                                                     txVector,
+                                                     snr,
+                                                     nbits,
+                                                     numRxAntennas,
+                                                     field,
+                                                     staId);
+    }
+    m_hits++;
+    return Interpolate(grid, cell, snrOffset, sizeOffset);
+}
+
+} // namespace ns3
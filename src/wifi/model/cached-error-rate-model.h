@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_ERROR_RATE_MODEL_H
+#define CACHED_ERROR_RATE_MODEL_H
+
+#include "error-rate-model.h"
+#include "wifi-mode.h"
+#include "wifi-units.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ * @brief an error rate model which memoizes the chunk success rates of another model
+ *
+ * The chunk success rates returned by the wrapped error rate model are sampled on
+ * a grid of SNR values (in dB), built lazily for every combination of mode, channel
+ * width, coding, number of RX antennas, PPDU field and range of chunk sizes. The
+ * chunk sizes are split into power-of-two ranges [2^k, 2^(k+1)) bits and the grid of
+ * a range stores the success rates at both ends of the range. Within a cell of the
+ * grid, the success rate S is interpolated linearly on ln(-ln(S)) against the SNR in
+ * dB and against the logarithm of the chunk size: this is exact along the chunk size
+ * for models whose success rate is the success rate of a bit raised to the power of
+ * the number of bits, and it follows closely the BER waterfall along the SNR.
+ *
+ * The first time a cell is used, the interpolated success rates are compared with the
+ * ones returned by the wrapped model on a lattice of 5 x 5 points evenly spread over the
+ * SNR range of the cell and over the logarithm of its chunk sizes. If a difference exceeds
+ * half the Tolerance attribute, the chunks falling in the cell are always computed by the
+ * wrapped model. The other half of the Tolerance is the margin for the points between the
+ * checked ones, hence the interpolation error is bounded by the Tolerance as long as the
+ * success rate of the wrapped model does not deviate from the interpolation by more than
+ * half the Tolerance between neighboring checked points. This holds for the error rate
+ * models provided by the wifi module, including across the steps of the
+ * TableBasedErrorRateModel, whose cells are computed by the wrapped model wherever the
+ * steps are significant.
+ * For the same reason, the cells where the wrapped model clips the success rate to 0 or 1
+ * at some of the grid points only are always computed by the wrapped model.
+ * The SNR values outside the [MinSnr, MaxSnr] range are also computed by the wrapped
+ * model.
+ *
+ * The wrapped model is expected to compute the success rate of a chunk from the
+ * mode, the channel width and the coding of the TXVECTOR, the number of RX antennas,
+ * the PPDU field, the SNR and the chunk size only, which is the case of the error
+ * rate models provided by the wifi module.
+ *
+ * This model can be selected for the PHYs installed by a WifiPhyHelper with e.g.:
+ * @code
+ *   phyHelper.SetErrorRateModel("ns3::CachedErrorRateModel",
+ *                               "ErrorRateModel",
+ *                               StringValue("ns3::NistErrorRateModel"));
+ * @endcode
+ */
+class CachedErrorRateModel : public ErrorRateModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedErrorRateModel();
+    ~CachedErrorRateModel() override;
+
+    bool IsAwgn() const override;
+    int64_t AssignStreams(int64_t stream) override;
+
+    /**
+     * @return the number of chunk success rates interpolated from the grids
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * @return the number of chunk success rates computed by the wrapped model
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * Discard all the grids built so far, e.g. after the wrapped model has been
+     * reconfigured.
+     */
+    void Flush();
+
+  private:
+    void DoDispose() override;
+
+    double DoGetChunkSuccessRate(WifiMode mode,
+                                 const WifiTxVector& txVector,
+                                 double snr,
+                                 uint64_t nbits,
+                                 uint8_t numRxAntennas,
+                                 WifiPpduField field,
+                                 uint16_t staId) const override;
+
+    /// the state of a cell of a grid
+    enum CellState : uint8_t
+    {
+        CELL_UNKNOWN = 0, //!< the cell has not been used yet
+        CELL_INTERPOLATE, //!< the success rates are interpolated in the cell
+        CELL_DIRECT       //!< the success rates are computed by the wrapped model in the cell
+    };
+
+    /// the grid of the success rates for a range of chunk sizes
+    struct Grid
+    {
+        std::vector<double> lower;    //!< ln(-ln(S)) at the lower end of the range, NaN if unknown
+        std::vector<double> upper;    //!< ln(-ln(S)) at the upper end of the range, NaN if unknown
+        std::vector<CellState> cells; //!< the state of the cells between the grid points
+    };
+
+    /// grid key: mode UID, channel width, LDPC, number of RX antennas, PPDU field and
+    /// base-2 logarithm of the lower end of the range of chunk sizes
+    using GridKey = std::tuple<uint32_t, MHz_u, bool, uint8_t, WifiPpduField, uint8_t>;
+
+    /**
+     * Call the wrapped model for a point of a grid and convert the result.
+     *
+     * @param mode the Wi-Fi mode applicable to the chunk
+     * @param txVector TXVECTOR of the overall transmission
+     * @param snr the SNR of the chunk
+     * @param nbits the number of bits in the chunk
+     * @param numRxAntennas the number of active RX antennas
+     * @param field the PPDU field to which the chunk belongs to
+     * @param staId the station ID for MU
+     * @return ln(-ln(S)), S being the success rate of the chunk
+     */
+    double Sample(WifiMode mode,
+                  const WifiTxVector& txVector,
+                  double snr,
+                  uint64_t nbits,
+                  uint8_t numRxAntennas,
+                  WifiPpduField field,
+                  uint16_t staId) const;
+
+    /**
+     * Interpolate the success rate of a chunk in a cell of a grid whose both ends are known.
+     *
+     * @param grid the grid
+     * @param cell the index of the cell
+     * @param snrOffset the position of the SNR within the cell, in [0, 1)
+     * @param sizeOffset the position of the chunk size within the range, in [0, 1)
+     * @return the success rate of the chunk
+     */
+    static double Interpolate(const Grid& grid,
+                              std::size_t cell,
+                              double snrOffset,
+                              double sizeOffset);
+
+    Ptr<ErrorRateModel> m_errorRateModel; //!< the wrapped error rate model
+    dB_u m_minSnr;                        //!< the lowest SNR of the grids
+    dB_u m_maxSnr;                        //!< the highest SNR of the grids
+    dB_u m_snrStep;                       //!< the SNR step between the points of the grids
+    double m_tolerance; //!< the maximum difference of success rate in the interpolated cells
+
+    mutable std::map<GridKey, Grid> m_grids; //!< the grids built so far
+    mutable uint64_t m_hits{0};              //!< the number of interpolated success rates
+    mutable uint64_t m_misses{0}; //!< the number of success rates computed by the wrapped model
+};
+
+} // namespace ns3
+
+#endif /* CACHED_ERROR_RATE_MODEL_H */
@@ -153,6 +153,28 @@ InterferenceHelper::NiChange::GetEvent() const
     return m_event;
 }
 
+/****************************************************************
+ *       Sorted-by-time list of NI changes, stored in blocks
+ ****************************************************************/
+
+InterferenceHelper::NiChanges::value_type&
+InterferenceHelper::NiChanges::operator[](size_type i)
+{
+    std::size_t block = 0;
+    while (i >= m_blocks[block].entries.size())
+    {
+        i -= m_blocks[block++].entries.size();
+    }
+    return Materialize(block).entries[i];
+}
+
+InterferenceHelper::NiChanges::value_type&
+InterferenceHelper::NiChanges::at(size_type i)
+{
+    NS_ABORT_MSG_IF(i >= m_size, "Index " << i << " out of range (size=" << m_size << ")");
+    return (*this)[i];
+}
+
 /****************************************************************
  *       The actual InterferenceHelper
  ****************************************************************/
@@ -359,20 +381,12 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             bandIt->second.firstPower = previousPowerStart;
         }
-        // With NiChanges backed by a sorted vector, a second insert may invalidate the
-        // iterator returned by the first. Capture both insert positions as indices --
-        // since GetStartTime() <= GetEndTime(), the second insert lands at an index
-        // >= the first, so the first index remains stable across the second insert.
-        const auto firstIt =
+        // The power of the event is added to the NI changes from its start (included) to its
+        // end (excluded), i.e., up to the position where the end NI change is to be inserted
+        const auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), bandIt);
-        const auto firstIdx = std::distance(niChanges.begin(), firstIt);
-        const auto lastIt =
-            AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), bandIt);
-        const auto lastIdx = std::distance(niChanges.begin(), lastIt);
-        for (auto i = firstIdx; i != lastIdx; ++i)
-        {
-            niChanges.at(i).second.AddPower(power);
-        }
+        niChanges.AddPower(first, GetNextPosition(event->GetEndTime(), bandIt), power);
+        AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), bandIt);
     }
 }
 
@@ -387,10 +401,7 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
         NS_ABORT_IF(bandIt == m_bandStates.end());
         auto first = GetPreviousPosition(event->GetStartTime(), bandIt);
         auto last = GetPreviousPosition(event->GetEndTime(), bandIt);
-        for (auto i = first; i != last; ++i)
-        {
-            i->second.AddPower(power);
-        }
+        bandIt->second.niChanges.AddPower(first, last, power);
     }
     event->UpdateRxPowerW(rxPower);
 }
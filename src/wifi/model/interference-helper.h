@@ -17,7 +17,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <map>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -402,58 +404,182 @@ class InterferenceHelper : public Object
      * Sorted-by-time list of NI changes for a single band.
      *
      * Entries are kept in non-decreasing time order and duplicate times are
-     * allowed. The backing std::vector amortises allocations across growth;
-     * insert/erase shift the tail, which is cheap because the steady-state
-     * size is small (a handful of in-flight events per band).
+     * allowed. The entries are stored in a sequence of contiguous blocks of at
+     * most MAX_BLOCK_SIZE entries: lookups binary search the blocks and then
+     * the entries of a block, an insert or an erase only shifts the entries of
+     * the blocks it touches, and AddPower adds the power to the entries of the
+     * partially covered blocks and records it as a pending addition on the
+     * fully covered ones. A band with a handful of in-flight events holds a
+     * single block and behaves as a plain sorted vector, while hundreds of
+     * overlapping PPDUs no longer cost a pass over the whole timeline each.
+     * Like for a vector, insertions and erasures invalidate the iterators.
      */
     class NiChanges
     {
       public:
-        using value_type = std::pair<Time, NiChange>;                   //!< (time, NI change) entry
-        using iterator = std::vector<value_type>::iterator;             //!< iterator type
-        using const_iterator = std::vector<value_type>::const_iterator; //!< const iterator type
-        using size_type = std::size_t;                                  //!< size type
+        using value_type = std::pair<Time, NiChange>; //!< (time, NI change) entry
+        using size_type = std::size_t;                //!< size type
+
+        /**
+         * Bidirectional iterator over the entries of a NiChanges container.
+         *
+         * @tparam IsConst whether the iterator gives read-only access to the entries
+         */
+        template <bool IsConst>
+        class Iterator
+        {
+          public:
+            using iterator_category = std::bidirectional_iterator_tag; //!< iterator category
+            using value_type = NiChanges::value_type;                   //!< value type
+            using difference_type = std::ptrdiff_t;                     //!< difference type
+            /// pointer type
+            using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+            /// reference type
+            using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+            /// container type
+            using Container = std::conditional_t<IsConst, const NiChanges, NiChanges>;
+
+            Iterator() = default;
+
+            /**
+             * Construct an iterator pointing to the given entry.
+             *
+             * @param container the container
+             * @param block the index of the block, the number of blocks for the end iterator
+             * @param offset the index of the entry in the block
+             */
+            Iterator(Container* container, std::size_t block, std::size_t offset)
+                : m_container(container),
+                  m_block(block),
+                  m_offset(offset)
+            {
+            }
+
+            /**
+             * Convert a non-const iterator into a const one.
+             *
+             * @param other the non-const iterator
+             */
+            template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+            Iterator(const Iterator<OtherIsConst>& other)
+                : m_container(other.m_container),
+                  m_block(other.m_block),
+                  m_offset(other.m_offset)
+            {
+            }
+
+            /// @return a reference to the entry, with all pending power additions applied
+            reference operator*() const
+            {
+                return m_container->Materialize(m_block).entries[m_offset];
+            }
+
+            /// @return a pointer to the entry, with all pending power additions applied
+            pointer operator->() const
+            {
+                return &**this;
+            }
+
+            /// @return this iterator, advanced to the next entry
+            Iterator& operator++()
+            {
+                if (++m_offset == m_container->m_blocks[m_block].entries.size())
+                {
+                    ++m_block;
+                    m_offset = 0;
+                }
+                return *this;
+            }
+
+            /// @return a copy of this iterator before it is advanced to the next entry
+            Iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            /// @return this iterator, moved to the previous entry
+            Iterator& operator--()
+            {
+                if (m_offset == 0)
+                {
+                    m_offset = m_container->m_blocks[--m_block].entries.size();
+                }
+                --m_offset;
+                return *this;
+            }
+
+            /// @return a copy of this iterator before it is moved to the previous entry
+            Iterator operator--(int)
+            {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            /**
+             * @param other the iterator to compare with
+             * @return true if both iterators point to the same entry
+             */
+            bool operator==(const Iterator& other) const
+            {
+                return m_block == other.m_block && m_offset == other.m_offset &&
+                       m_container == other.m_container;
+            }
+
+          private:
+            friend class NiChanges;
+            friend class Iterator<!IsConst>;
+
+            Container* m_container{nullptr}; //!< the container
+            std::size_t m_block{0};          //!< the index of the block
+            std::size_t m_offset{0};         //!< the index of the entry in the block
+        };
+
+        using iterator = Iterator<false>;      //!< iterator type
+        using const_iterator = Iterator<true>; //!< const iterator type
 
         /// @return an iterator to the first entry
         iterator begin()
         {
-            return m_data.begin();
+            return {this, 0, 0};
         }
 
         /// @return an iterator one past the last entry
         iterator end()
         {
-            return m_data.end();
+            return {this, m_blocks.size(), 0};
         }
 
         /// @return a const iterator to the first entry
         const_iterator begin() const
         {
-            return m_data.begin();
+            return {this, 0, 0};
         }
 
         /// @return a const iterator one past the last entry
         const_iterator end() const
         {
-            return m_data.end();
+            return {this, m_blocks.size(), 0};
         }
 
         /// @return a const iterator to the first entry
         const_iterator cbegin() const
         {
-            return m_data.cbegin();
+            return begin();
         }
 
         /// @return a const iterator one past the last entry
         const_iterator cend() const
         {
-            return m_data.cend();
+            return end();
         }
 
         /// @return the number of entries
         size_type size() const
         {
-            return m_data.size();
+            return m_size;
         }
 
         /**
@@ -461,20 +587,14 @@ class InterferenceHelper : public Object
          * @param i the index of the entry
          * @return reference to the i-th entry
          */
-        value_type& operator[](size_type i)
-        {
-            return m_data[i];
-        }
+        value_type& operator[](size_type i);
 
         /**
          * Bounds-checked access the i-th entry.
          * @param i the index of the entry
          * @return reference to the i-th entry
          */
-        value_type& at(size_type i)
-        {
-            return m_data.at(i);
-        }
+        value_type& at(size_type i);
 
         /**
          * Locate the first entry with time strictly greater than @p t.
@@ -483,7 +603,8 @@ class InterferenceHelper : public Object
          */
         iterator upper_bound(const Time& t)
         {
-            return std::upper_bound(m_data.begin(), m_data.end(), t, TimeLess{});
+            const auto [block, offset] = Bound(t, true);
+            return {this, block, offset};
         }
 
         /**
@@ -493,7 +614,8 @@ class InterferenceHelper : public Object
          */
         const_iterator upper_bound(const Time& t) const
         {
-            return std::upper_bound(m_data.cbegin(), m_data.cend(), t, TimeLess{});
+            const auto [block, offset] = Bound(t, true);
+            return {this, block, offset};
         }
 
         /**
@@ -503,7 +625,8 @@ class InterferenceHelper : public Object
          */
         iterator lower_bound(const Time& t)
         {
-            return std::lower_bound(m_data.begin(), m_data.end(), t, TimeLess{});
+            const auto [block, offset] = Bound(t, false);
+            return {this, block, offset};
         }
 
         /**
@@ -513,12 +636,13 @@ class InterferenceHelper : public Object
          */
         const_iterator lower_bound(const Time& t) const
         {
-            return std::lower_bound(m_data.cbegin(), m_data.cend(), t, TimeLess{});
+            const auto [block, offset] = Bound(t, false);
+            return {this, block, offset};
         }
 
         /**
          * Insert at a caller-provided position (typically the result of
-         * upper_bound(t)). May invalidate other iterators if the vector reallocates.
+         * upper_bound(t)). Invalidates the iterators.
          *
          * @param hint the position to insert at
          * @param value the entry to insert
@@ -526,7 +650,36 @@ class InterferenceHelper : public Object
          */
         iterator insert(const_iterator hint, value_type value)
         {
-            return m_data.insert(hint, std::move(value));
+            auto block = hint.m_block;
+            auto offset = hint.m_offset;
+            if (m_blocks.empty())
+            {
+                m_blocks.emplace_back();
+            }
+            else if (block == m_blocks.size())
+            {
+                // append to the last block
+                offset = m_blocks[--block].entries.size();
+            }
+            // the power of the entry is absolute, so apply the pending addition first
+            auto& entries = Materialize(block).entries;
+            entries.insert(entries.begin() + offset, std::move(value));
+            ++m_size;
+            if (entries.size() > MAX_BLOCK_SIZE)
+            {
+                const auto half = entries.size() / 2;
+                Block next;
+                next.entries.assign(std::make_move_iterator(entries.begin() + half),
+                                    std::make_move_iterator(entries.end()));
+                entries.erase(entries.begin() + half, entries.end());
+                m_blocks.insert(m_blocks.begin() + block + 1, std::move(next));
+                if (offset >= half)
+                {
+                    ++block;
+                    offset -= half;
+                }
+            }
+            return {this, block, offset};
         }
 
         /**
@@ -538,7 +691,7 @@ class InterferenceHelper : public Object
          */
         iterator insert(const value_type& v)
         {
-            return m_data.insert(upper_bound(v.first), v);
+            return insert(upper_bound(v.first), v);
         }
 
         /**
@@ -553,11 +706,11 @@ class InterferenceHelper : public Object
         iterator emplace(Args&&... args)
         {
             value_type v(std::forward<Args>(args)...);
-            return m_data.insert(upper_bound(v.first), std::move(v));
+            return insert(upper_bound(v.first), std::move(v));
         }
 
         /**
-         * Erase the entries in the range [first, last).
+         * Erase the entries in the range [first, last). Invalidates the iterators.
          *
          * @param first the first entry to erase
          * @param last one past the last entry to erase
@@ -565,37 +718,157 @@ class InterferenceHelper : public Object
          */
         iterator erase(const_iterator first, const_iterator last)
         {
-            return m_data.erase(first, last);
+            const auto block = first.m_block;
+            const auto offset = first.m_offset;
+            if (first == last)
+            {
+                return {this, block, offset};
+            }
+            if (block == last.m_block)
+            {
+                auto& entries = m_blocks[block].entries;
+                entries.erase(entries.begin() + offset, entries.begin() + last.m_offset);
+                m_size -= last.m_offset - offset;
+            }
+            else
+            {
+                // erase the tail of the first block, the blocks in between and the head of the
+                // last one
+                auto& firstEntries = m_blocks[block].entries;
+                m_size -= firstEntries.size() - offset;
+                firstEntries.erase(firstEntries.begin() + offset, firstEntries.end());
+                for (auto i = block + 1; i < last.m_block; ++i)
+                {
+                    m_size -= m_blocks[i].entries.size();
+                }
+                if (last.m_block < m_blocks.size())
+                {
+                    auto& lastEntries = m_blocks[last.m_block].entries;
+                    lastEntries.erase(lastEntries.begin(), lastEntries.begin() + last.m_offset);
+                    m_size -= last.m_offset;
+                }
+                m_blocks.erase(m_blocks.begin() + block + 1, m_blocks.begin() + last.m_block);
+            }
+            if (m_blocks[block].entries.empty())
+            {
+                m_blocks.erase(m_blocks.begin() + block);
+                return {this, block, 0};
+            }
+            if (block + 1 < m_blocks.size() && m_blocks[block].entries.size() +
+                                                       m_blocks[block + 1].entries.size() <=
+                                                   MAX_BLOCK_SIZE / 2)
+            {
+                // merge small neighbor blocks to keep the number of blocks low
+                auto& entries = Materialize(block).entries;
+                auto& nextEntries = Materialize(block + 1).entries;
+                entries.insert(entries.end(),
+                               std::make_move_iterator(nextEntries.begin()),
+                               std::make_move_iterator(nextEntries.end()));
+                m_blocks.erase(m_blocks.begin() + block + 1);
+            }
+            if (offset == m_blocks[block].entries.size())
+            {
+                return {this, block + 1, 0};
+            }
+            return {this, block, offset};
+        }
+
+        /**
+         * Add a given amount of power to every entry in the range [first, last).
+         * Blocks entirely in the range are updated in constant time.
+         *
+         * @param first the first entry to update
+         * @param last one past the last entry to update
+         * @param power the power to be added
+         */
+        void AddPower(const_iterator first, const_iterator last, Watt_u power)
+        {
+            const auto addToEntries = [&](std::size_t block, std::size_t from, std::size_t to) {
+                auto& entries = m_blocks[block].entries;
+                for (auto i = from; i < to; ++i)
+                {
+                    entries[i].second.AddPower(power);
+                }
+            };
+            if (first.m_block == last.m_block)
+            {
+                if (first.m_block < m_blocks.size())
+                {
+                    addToEntries(first.m_block, first.m_offset, last.m_offset);
+                }
+                return;
+            }
+            addToEntries(first.m_block, first.m_offset, m_blocks[first.m_block].entries.size());
+            for (auto i = first.m_block + 1; i < last.m_block; ++i)
+            {
+                m_blocks[i].lazy += power;
+            }
+            if (last.m_block < m_blocks.size())
+            {
+                addToEntries(last.m_block, 0, last.m_offset);
+            }
         }
 
       private:
-        /// Comparator for heterogeneous lookup of entries by Time
-        struct TimeLess
+        /// A block of consecutive entries
+        struct Block
         {
-            /**
-             * Compare an entry against a time.
-             * @param a the entry
-             * @param b the time
-             * @return true if the entry's time is lower than @p b
-             */
-            bool operator()(const value_type& a, const Time& b) const
+            std::vector<value_type> entries; //!< entries, in non-decreasing time order
+            Watt_u lazy{0.0}; //!< power to be added to all entries, not applied yet
+        };
+
+        /// Maximum number of entries in a block, a full block is split in two halves
+        static constexpr std::size_t MAX_BLOCK_SIZE = 128;
+
+        /**
+         * Apply the pending power addition of a block to its entries.
+         * @param block the index of the block
+         * @return the block
+         */
+        Block& Materialize(std::size_t block) const
+        {
+            auto& b = m_blocks[block];
+            if (b.lazy != Watt_u{0.0})
             {
-                return a.first < b;
+                for (auto& entry : b.entries)
+                {
+                    entry.second.AddPower(b.lazy);
+                }
+                b.lazy = Watt_u{0.0};
             }
+            return b;
+        }
 
-            /**
-             * Compare a time against an entry.
-             * @param a the time
-             * @param b the entry
-             * @return true if @p a is lower than the entry's time
-             */
-            bool operator()(const Time& a, const value_type& b) const
+        /**
+         * @param t the time to search for
+         * @param strict whether to look for a time strictly greater than @p t
+         * @return the block index and offset of the first entry whose time is greater than
+         *         (or equal to, if not @p strict) @p t, the end position if none
+         */
+        std::pair<std::size_t, std::size_t> Bound(const Time& t, bool strict) const
+        {
+            const auto isAfter = [&t, strict](const value_type& entry) {
+                return strict ? (t < entry.first) : !(entry.first < t);
+            };
+            // first block whose last entry is after t, then first entry of that block after t
+            const auto blockIt = std::partition_point(
+                m_blocks.cbegin(),
+                m_blocks.cend(),
+                [&isAfter](const Block& b) { return !isAfter(b.entries.back()); });
+            if (blockIt == m_blocks.cend())
             {
-                return a < b.first;
+                return {m_blocks.size(), 0};
             }
-        };
+            const auto& entries = blockIt->entries;
+            const auto entryIt = std::partition_point(
+                entries.cbegin(),
+                entries.cend(),
+                [&isAfter](const value_type& e) { return !isAfter(e); });
+            return {blockIt - m_blocks.cbegin(), entryIt - entries.cbegin()};
+        }
 
-        std::vector<value_type> m_data; //!< storage, kept in non-decreasing time order
+        mutable std::vector<Block> m_blocks; //!< non-empty blocks, in time order
+        size_type m_size{0};                 //!< number of entries
     };
 
     /**
@@ -105,8 +105,9 @@ struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
     uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
     uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
 
-    McsGroupData m_groupsTable; //!< Table of groups with stats.
-    bool m_isHt;                //!< If the station is HT capable.
+    McsGroupData m_groupsTable;  //!< Table of groups with stats.
+    MinstrelHtRate m_ratesTable; //!< Rates of the supported groups, stored contiguously.
+    bool m_isHt;                 //!< If the station is HT capable.
 
     std::ofstream m_statsFile; //!< File where statistics table is written.
 };
@@ -1765,13 +1766,31 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
             station->m_groupsTable[groupId].m_supported = true;
             station->m_groupsTable[groupId].m_col = 0;
             station->m_groupsTable[groupId].m_index = 0;
+        }
+    }
+    /// make sure at least one group is supported, otherwise we end up with an infinite loop in
+    /// SetNextSample
+    if (noSupportedGroupFound)
+    {
+        NS_FATAL_ERROR("No supported group has been found");
+    }
 
+    /**
+     * Create the rate lists of the supported groups, which are stored contiguously.
+     */
+    const auto numSupportedGroups =
+        std::count_if(station->m_groupsTable.cbegin(),
+                      station->m_groupsTable.cend(),
+                      [](const GroupInfo& group) { return group.m_supported; });
+    station->m_ratesTable = MinstrelHtRate(numSupportedGroups * m_numRates);
+    std::size_t offset = 0;
+    for (std::size_t groupId = 0; groupId < m_numGroups; groupId++)
+    {
+        if (station->m_groupsTable[groupId].m_supported)
+        {
             station->m_groupsTable[groupId].m_ratesTable =
-                MinstrelHtRate(m_numRates); /// Create the rate list for the group.
-            for (uint8_t i = 0; i < m_numRates; i++)
-            {
-                station->m_groupsTable[groupId].m_ratesTable[i].supported = false;
-            }
+                std::span(station->m_ratesTable).subspan(offset, m_numRates);
+            offset += m_numRates;
 
             // Initialize all modes supported by the remote station that belong to the current
             // group.
@@ -1812,12 +1831,6 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
             }
         }
     }
-    /// make sure at least one group is supported, otherwise we end up with an infinite loop in
-    /// SetNextSample
-    if (noSupportedGroupFound)
-    {
-        NS_FATAL_ERROR("No supported group has been found");
-    }
     SetNextSample(station);                /// Select the initial sample index.
     UpdateStats(station);                  /// Calculate the initial high throughput rates.
     station->m_txrate = FindRate(station); /// Select the rate to use.
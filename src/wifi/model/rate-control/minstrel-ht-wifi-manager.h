@@ -19,6 +19,8 @@
 #include "ns3/wifi-remote-station-manager.h"
 #include "ns3/wifi-types.h"
 
+#include <span>
+
 namespace ns3
 {
 
@@ -104,29 +106,29 @@ struct MinstrelHtRateInfo
      * Given a bit rate and a packet length n bytes.
      */
     Time perfectTxTime;
-    bool supported;      //!< If the rate is supported.
-    uint8_t mcsIndex;    //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
-    uint32_t retryCount; //!< Retry limit.
+    bool supported;    //!< If the rate is supported.
+    uint8_t mcsIndex;  //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
+    bool retryUpdated; //!< If number of retries was updated already.
+    uint32_t retryCount;         //!< Retry limit.
     uint32_t adjustedRetryCount; //!< Adjust the retry limit for this rate.
     uint32_t numRateAttempt;     //!< Number of transmission attempts so far.
     uint32_t numRateSuccess;     //!< Number of successful frames transmitted so far.
+    uint32_t prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
+    uint32_t prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
+    uint32_t numSamplesSkipped;  //!< Number of times this rate statistics were not updated because
+                                 //!< no attempts have been made.
     double prob; //!< Current probability within last time interval. (# frame success )/(# total
                  //!< frames)
-    bool retryUpdated; //!< If number of retries was updated already.
     /**
      * Exponential weighted moving average of probability.
      * EWMA calculation:
      * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
      */
     double ewmaProb;
-    double ewmsdProb;            //!< Exponential weighted moving standard deviation of probability.
-    uint32_t prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
-    uint32_t prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
-    uint32_t numSamplesSkipped;  //!< Number of times this rate statistics were not updated because
-                                 //!< no attempts have been made.
-    uint64_t successHist;        //!< Aggregate of all transmission successes.
-    uint64_t attemptHist;        //!< Aggregate of all transmission attempts.
-    double throughput;           //!< Throughput of this rate (in packets per second).
+    double ewmsdProb;     //!< Exponential weighted moving standard deviation of probability.
+    uint64_t successHist; //!< Aggregate of all transmission successes.
+    uint64_t attemptHist; //!< Aggregate of all transmission attempts.
+    double throughput;    //!< Throughput of this rate (in packets per second).
 };
 
 /**
@@ -143,13 +145,14 @@ struct GroupInfo
     /**
      * MCS rates are divided into groups based on the number of streams and flags that they use.
      */
-    uint8_t m_col;               //!< Sample table column.
-    uint8_t m_index;             //!< Sample table index.
-    bool m_supported;            //!< If the rates of this group are supported by the station.
-    uint16_t m_maxTpRate;        //!< The max throughput rate of this group in bps.
-    uint16_t m_maxTpRate2;       //!< The second max throughput rate of this group in bps.
-    uint16_t m_maxProbRate;      //!< The highest success probability rate of this group in bps.
-    MinstrelHtRate m_ratesTable; //!< Information about rates of this group.
+    uint8_t m_col;          //!< Sample table column.
+    uint8_t m_index;        //!< Sample table index.
+    bool m_supported;       //!< If the rates of this group are supported by the station.
+    uint16_t m_maxTpRate;   //!< The max throughput rate of this group in bps.
+    uint16_t m_maxTpRate2;  //!< The second max throughput rate of this group in bps.
+    uint16_t m_maxProbRate; //!< The highest success probability rate of this group in bps.
+    /// Information about rates of this group, stored in the rates table of the station.
+    std::span<MinstrelHtRateInfo> m_ratesTable;
 };
 
 /**
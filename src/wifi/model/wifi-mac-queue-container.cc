@@ -14,8 +14,6 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
-
 namespace ns3
 {
 
@@ -24,22 +22,24 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
+    m_expiryList.Clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& info = m_queues[queueId];
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == info.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    info.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    auto it = info.queue.emplace(pos, item);
+    Link(info, it);
+    return it;
 }
 
 WifiMacQueueContainer::iterator
@@ -50,13 +50,12 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto& info = m_queues[GetQueueId(pos->mpdu)];
+    NS_ASSERT(info.nBytes >= pos->mpdu->GetSize());
+    info.nBytes -= pos->mpdu->GetSize();
+    Unlink(info, pos);
 
-    return m_queues[queueId].erase(pos);
+    return info.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -65,6 +64,34 @@ WifiMacQueueContainer::GetItem(const const_iterator it) const
     return it->mpdu;
 }
 
+void
+WifiMacQueueContainer::SetExpiryTime(iterator it, Time expiryTime) const
+{
+    NS_ASSERT_MSG(!it->expired, "Cannot set the expiry time of an expired MPDU");
+
+    auto& info = m_queues[GetQueueId(it->mpdu)];
+    Unlink(info, it);
+    it->expiryTime = expiryTime;
+    Link(info, it);
+}
+
+void
+WifiMacQueueContainer::Link(QueueInfo& info, iterator it) const
+{
+    it->self = it;
+    m_expiryList.Insert(&*it);
+    info.expiryList.Insert(&*it);
+}
+
+void
+WifiMacQueueContainer::Unlink(QueueInfo& info, const_iterator it) const
+{
+    // the elements of the container are mutable, only the list iterator is const
+    auto elem = const_cast<WifiMacQueueElem*>(&*it);
+    m_expiryList.Remove(elem);
+    info.expiryList.Remove(elem);
+}
+
 WifiContainerQueueId
 WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 {
@@ -111,97 +138,69 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return m_queues[queueId].queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (auto it = m_queues.find(queueId); it != m_queues.end())
     {
-        return 0;
+        return it->second.nBytes;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return 0;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(m_queues[queueId].expiryList);
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(const WifiMacQueueExpiryList& list) const
 {
-    std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
-    auto firstExpiredIt = queue.begin();
-    auto lastExpiredIt = firstExpiredIt;
-    Time now = Simulator::Now();
+    std::optional<iterator> firstExpiredIt;
+    const auto now = Simulator::Now();
 
-    do
+    // visit the elements with expired lifetime in increasing order of expiry time; inflight
+    // MPDUs cannot be extracted and stay in the list until they are no longer inflight
+    for (auto elem = list.GetFirst(); elem != nullptr && elem->expiryTime <= now;)
     {
-        // advance firstExpiredIt and lastExpiredIt to skip all inflight MPDUs
-        for (firstExpiredIt = lastExpiredIt;
-             firstExpiredIt != queue.end() && !firstExpiredIt->inflights.empty();
-             ++firstExpiredIt, ++lastExpiredIt)
-        {
-        }
+        auto elemIt = elem->self;
+        elem = list.GetNext(elem);
 
-        if (!ret)
+        if (!elemIt->inflights.empty())
         {
-            // we get here in the first iteration only
-            ret = std::make_pair(firstExpiredIt, lastExpiredIt);
+            continue;
         }
 
-        // advance lastExpiredIt as we encounter MPDUs with expired lifetime that are not inflight
-        while (lastExpiredIt != queue.end() && lastExpiredIt->expiryTime <= now &&
-               lastExpiredIt->inflights.empty())
-        {
-            lastExpiredIt->expired = true;
-            // this MPDU is no longer queued
-            lastExpiredIt->ac = AC_UNDEF;
-            lastExpiredIt->deleter(lastExpiredIt->mpdu);
-
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
-
-            ++lastExpiredIt;
-        }
+        elemIt->expired = true;
+        // this MPDU is no longer queued
+        elemIt->ac = AC_UNDEF;
+        elemIt->deleter(elemIt->mpdu);
 
-        if (lastExpiredIt == firstExpiredIt)
+        auto& info = m_queues[GetQueueId(elemIt->mpdu)];
+        NS_ASSERT(info.nBytes >= elemIt->mpdu->GetSize());
+        info.nBytes -= elemIt->mpdu->GetSize();
+        // elem has been advanced, hence it is not invalidated by the removal of elemIt
+        Unlink(info, elemIt);
+
+        // transfer the MPDU to the tail of m_expiredQueue
+        m_expiredQueue.splice(m_expiredQueue.end(), info.queue, elemIt);
+        if (!firstExpiredIt)
         {
-            break;
+            firstExpiredIt = elemIt;
         }
+    }
 
-        // transfer non-inflight MPDUs with expired lifetime to the tail of m_expiredQueue
-        m_expiredQueue.splice(m_expiredQueue.end(), queue, firstExpiredIt, lastExpiredIt);
-        ret->second = m_expiredQueue.end();
-
-    } while (true);
-
-    return *ret;
+    return {firstExpiredIt.value_or(m_expiredQueue.end()), m_expiredQueue.end()};
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 {
-    std::optional<WifiMacQueueContainer::iterator> firstExpiredIt;
-
-    for (auto& queue : m_queues)
-    {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
-
-        if (firstIt != lastIt && !firstExpiredIt)
-        {
-            // this is the first queue with MPDUs with expired lifetime
-            firstExpiredIt = firstIt;
-        }
-    }
-    return std::make_pair(firstExpiredIt ? *firstExpiredIt : m_expiredQueue.end(),
-                          m_expiredQueue.end());
+    return DoExtractExpiredMpdus(m_expiryList);
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
@@ -272,27 +271,28 @@ operator<<(std::ostream& os, const WifiContainerQueueId& queueId)
 std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
-    std::vector<uint8_t> buffer;
-    buffer.reserve(1 + 1 + 6 + 6 + 1); // reserve the maximum possible size of the buffer
-    buffer.emplace_back(queueId.type);
-    buffer.emplace_back(static_cast<uint8_t>(queueId.addrType));
-    if (queueId.addr1.has_value())
-    {
-        const auto size = buffer.size();
-        buffer.resize(size + 6);
-        queueId.addr1.value().CopyTo(&buffer[size]);
-    }
-    if (queueId.addr2.has_value())
-    {
-        const auto size = buffer.size();
-        buffer.resize(size + 6);
-        queueId.addr2.value().CopyTo(&buffer[size]);
-    }
-    if (queueId.tid.has_value())
-    {
-        buffer.emplace_back(*queueId.tid);
-    }
-
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    // pack the fields in two 64-bit words instead of serializing them in a buffer, because
+    // the container queues are looked up every time an MPDU is enqueued, peeked or dequeued
+    const auto pack = [](const std::optional<ns3::Mac48Address>& addr) -> uint64_t {
+        if (!addr.has_value())
+        {
+            return 0;
+        }
+        uint8_t buffer[6];
+        addr->CopyTo(buffer);
+        uint64_t value = 1; // distinguishes a null address from a missing address
+        for (auto byte : buffer)
+        {
+            value = (value << 8) | byte;
+        }
+        return value;
+    };
+
+    uint64_t word = pack(queueId.addr1);
+    word ^= static_cast<uint64_t>(queueId.type) << 49;
+    word ^= static_cast<uint64_t>(queueId.addrType) << 52;
+    word ^= static_cast<uint64_t>(queueId.tid.has_value() ? *queueId.tid + 1 : 0) << 54;
+    // mix the words, so that all the bits of the key affect the bucket index
+    word = (word ^ (pack(queueId.addr2) * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL;
+    return word ^ (word >> 32);
 }
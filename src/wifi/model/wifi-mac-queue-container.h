@@ -210,6 +210,11 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ *
+ * The elements are also linked in intrusive lists sorted by expiry time, both per
+ * container queue and across all the container queues. Hence, extracting the MPDUs
+ * with expired lifetime only visits the MPDUs with expired lifetime (including those
+ * that cannot be extracted because they are inflight) rather than all the queued MPDUs.
  */
 class WifiMacQueueContainer
 {
@@ -251,6 +256,17 @@ class WifiMacQueueContainer
      */
     Ptr<WifiMpdu> GetItem(const const_iterator it) const;
 
+    /**
+     * Set the expiry time of the element pointed to by the given iterator and
+     * move the element in the expiry lists accordingly. The expiry time of an
+     * inserted element is initially zero, i.e., its lifetime is expired until its
+     * expiry time is set.
+     *
+     * @param it iterator pointing to an element that is not marked as expired
+     * @param expiryTime the expiry time of the element
+     */
+    void SetExpiryTime(iterator it, Time expiryTime) const;
+
     /**
      * Return the QueueId identifying the container queue in which the given MPDU is
      * (or is to be) enqueued. Note that the given MPDU must not contain a control frame.
@@ -306,21 +322,48 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// Information about a container queue
+    struct QueueInfo
+    {
+        ContainerQueue queue; //!< the elements of the container queue
+        uint32_t nBytes{0};   //!< the size in bytes of the container queue
+        WifiMacQueueExpiryList expiryList{
+            &WifiMacQueueElem::queueHook}; //!< the elements sorted by expiry time
+    };
+
     /**
-     * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
-     * container queue storing MPDUs with expired lifetime.
+     * Insert the given element in the expiry lists.
+     *
+     * @param info the information about the container queue storing the element
+     * @param it iterator pointing to the element
+     */
+    void Link(QueueInfo& info, iterator it) const;
+
+    /**
+     * Remove the given element from the expiry lists.
+     *
+     * @param info the information about the container queue storing the element
+     * @param it iterator pointing to the element
+     */
+    void Unlink(QueueInfo& info, const_iterator it) const;
+
+    /**
+     * Transfer non-inflight MPDUs with expired lifetime that are found in the given
+     * expiry list (either the one of a container queue or the one of the container)
+     * to the container queue storing MPDUs with expired lifetime.
      *
-     * @param queue the given container queue
+     * @param list the given expiry list
      * @return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(const WifiMacQueueExpiryList& list) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
+    mutable WifiMacQueueExpiryList m_expiryList{
+        &WifiMacQueueElem::containerHook}; //!< the elements of all the container queues
+                                           //!< sorted by expiry time
 };
 
 /**
@@ -15,9 +15,9 @@ namespace ns3
 
 WifiMacQueueElem::WifiMacQueueElem(Ptr<WifiMpdu> item)
     : mpdu(item),
-      expiryTime(0),
       ac(AC_UNDEF),
-      expired(false)
+      expired(false),
+      expiryTime(0)
 {
 }
 
@@ -27,4 +27,75 @@ WifiMacQueueElem::~WifiMacQueueElem()
     inflights.clear();
 }
 
+Time
+WifiMacQueueElem::GetExpiryTime() const
+{
+    return expiryTime;
+}
+
+WifiMacQueueExpiryList::WifiMacQueueExpiryList(Hook hook)
+    : m_hook(hook)
+{
+}
+
+void
+WifiMacQueueExpiryList::Insert(WifiMacQueueElem* elem)
+{
+    const auto expiryTime = elem->expiryTime;
+
+    // search the last element with an earlier or equal expiry time from the back and the
+    // first element with a later expiry time from the front, until either is found
+    WifiMacQueueElem* prev = m_last;
+    WifiMacQueueElem* next = m_first;
+    while (true)
+    {
+        if (prev == nullptr || prev->expiryTime <= expiryTime)
+        {
+            next = prev ? (prev->*m_hook).next : m_first;
+            break;
+        }
+        if (next->expiryTime > expiryTime)
+        {
+            prev = (next->*m_hook).prev;
+            break;
+        }
+        prev = (prev->*m_hook).prev;
+        next = (next->*m_hook).next;
+    }
+
+    auto& hook = elem->*m_hook;
+    hook.prev = prev;
+    hook.next = next;
+    (prev ? (prev->*m_hook).next : m_first) = elem;
+    (next ? (next->*m_hook).prev : m_last) = elem;
+}
+
+void
+WifiMacQueueExpiryList::Remove(WifiMacQueueElem* elem)
+{
+    auto& hook = elem->*m_hook;
+    (hook.prev ? (hook.prev->*m_hook).next : m_first) = hook.next;
+    (hook.next ? (hook.next->*m_hook).prev : m_last) = hook.prev;
+    hook = {};
+}
+
+WifiMacQueueElem*
+WifiMacQueueExpiryList::GetFirst() const
+{
+    return m_first;
+}
+
+WifiMacQueueElem*
+WifiMacQueueExpiryList::GetNext(const WifiMacQueueElem* elem) const
+{
+    return (elem->*m_hook).next;
+}
+
+void
+WifiMacQueueExpiryList::Clear()
+{
+    m_first = nullptr;
+    m_last = nullptr;
+}
+
 } // namespace ns3
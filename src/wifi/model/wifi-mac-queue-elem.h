@@ -14,12 +14,81 @@
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <list>
 #include <map>
 
 namespace ns3
 {
 
 class WifiMpdu;
+struct WifiMacQueueElem;
+
+/**
+ * @ingroup wifi
+ * Links of an element stored in a WifiMacQueue container in a WifiMacQueueExpiryList.
+ */
+struct WifiMacQueueExpiryHook
+{
+    WifiMacQueueElem* prev{nullptr}; ///< previous element in the list
+    WifiMacQueueElem* next{nullptr}; ///< next element in the list
+};
+
+/**
+ * @ingroup wifi
+ * Intrusive list of the elements stored in a WifiMacQueue container, sorted by expiry
+ * time. Elements with the same expiry time are kept in insertion order.
+ *
+ * The elements are linked through one of their WifiMacQueueExpiryHook members, hence
+ * indexing an element does not allocate memory. An element is inserted by searching
+ * its position from both ends of the list at the same time: expiry times are mostly set
+ * in increasing order, and an MPDU replacing another one keeps its (earlier) expiry time,
+ * hence the position is usually found within a few steps from either end.
+ */
+class WifiMacQueueExpiryList
+{
+  public:
+    /// Pointer to the hook of the elements used by a list
+    using Hook = WifiMacQueueExpiryHook WifiMacQueueElem::*;
+
+    /**
+     * Constructor.
+     * @param hook the hook of the elements used by this list
+     */
+    WifiMacQueueExpiryList(Hook hook);
+
+    /**
+     * Insert an element according to its expiry time.
+     * @param elem the element, which must not be in this list
+     */
+    void Insert(WifiMacQueueElem* elem);
+
+    /**
+     * Remove an element.
+     * @param elem the element, which must be in this list
+     */
+    void Remove(WifiMacQueueElem* elem);
+
+    /**
+     * @return the element with the earliest expiry time, or a null pointer if the list is empty
+     */
+    WifiMacQueueElem* GetFirst() const;
+
+    /**
+     * @param elem an element in this list
+     * @return the element following the given one, or a null pointer if it is the last one
+     */
+    WifiMacQueueElem* GetNext(const WifiMacQueueElem* elem) const;
+
+    /**
+     * Unlink all the elements.
+     */
+    void Clear();
+
+  private:
+    Hook m_hook;                        ///< the hook of the elements used by this list
+    WifiMacQueueElem* m_first{nullptr}; ///< the element with the earliest expiry time
+    WifiMacQueueElem* m_last{nullptr};  ///< the element with the latest expiry time
+};
 
 /**
  * @ingroup wifi
@@ -35,11 +104,13 @@ class WifiMpdu;
  * is indexed by the ID of the link over which the alias is in-flight.
  * For consistency, also data frame transmitted by non-MLDs have an alias, which is
  * simply a pointer to the original version of the data frame.
+ *
+ * The expiry time can only be set through WifiMacQueueContainer::SetExpiryTime(), which
+ * keeps the element sorted in the expiry lists of the container.
  */
 struct WifiMacQueueElem
 {
     Ptr<WifiMpdu> mpdu;                         ///< MPDU stored by this element
-    Time expiryTime{0};                         ///< expiry time of the MPDU (set by WifiMacQueue)
     AcIndex ac{AC_UNDEF};                       ///< the Access Category associated with the queue
                                                 ///< storing this element (set by WifiMacQueue)
     bool expired{false};                        ///< whether this MPDU has been marked as expired
@@ -53,6 +124,20 @@ struct WifiMacQueueElem
     WifiMacQueueElem(Ptr<WifiMpdu> item);
 
     ~WifiMacQueueElem();
+
+    /**
+     * @return the expiry time of the MPDU (set by WifiMacQueue)
+     */
+    Time GetExpiryTime() const;
+
+  private:
+    friend class WifiMacQueueContainer;
+    friend class WifiMacQueueExpiryList;
+
+    Time expiryTime{0};                         ///< expiry time of the MPDU
+    std::list<WifiMacQueueElem>::iterator self; ///< iterator pointing to this element
+    WifiMacQueueExpiryHook queueHook;           ///< links in the expiry list of the container queue
+    WifiMacQueueExpiryHook containerHook;       ///< links in the expiry list of the container
 };
 
 } // namespace ns3
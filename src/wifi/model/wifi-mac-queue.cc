@@ -178,10 +178,10 @@ WifiMacQueue::TtlExceeded(Ptr<const WifiMpdu> item, const Time& now)
 {
     NS_ASSERT(item && item->IsQueued());
     auto it = GetIt(item);
-    if (now > it->expiryTime)
+    if (now > it->GetExpiryTime())
     {
         NS_LOG_DEBUG("Removing packet that stayed in the queue for too long (queuing time="
-                     << now - it->expiryTime + m_maxDelay << ")");
+                     << now - it->GetExpiryTime() + m_maxDelay << ")");
         // Trace the expired MPDU first and then remove it from the queue (if still in the queue).
         // Indeed, the Expired traced source is connected to BlockAckManager::NotifyDiscardedMpdu,
         // which checks if the expired MPDU is in-flight or is a retransmission to determine
@@ -247,7 +247,7 @@ WifiMacQueue::Insert(ConstIterator pos, Ptr<WifiMpdu> item)
     {
         NS_ABORT_MSG_IF(WifiMacQueueContainer::GetQueueId(pos->mpdu) != queueId,
                         "pos must point to an element in the same container queue as item");
-        if (pos->expiryTime <= Simulator::Now())
+        if (pos->GetExpiryTime() <= Simulator::Now())
         {
             // the element pointed to by pos is stale and will be removed along with all of
             // its predecessors; the new item will be enqueued at the front of the queue
@@ -435,14 +435,14 @@ WifiMacQueue::Replace(Ptr<const WifiMpdu> currentItem, Ptr<WifiMpdu> newItem)
     NS_ASSERT(currentIt->mpdu == currentItem->GetOriginal());
     NS_ASSERT(!newItem->IsQueued());
 
-    Time expiryTime = currentIt->expiryTime;
+    Time expiryTime = currentIt->GetExpiryTime();
     auto pos = std::next(currentIt);
     DoDequeue({currentIt});
     bool ret = Insert(pos, newItem);
-    GetIt(newItem)->expiryTime = expiryTime;
     // The size of a WifiMacQueue is measured as number of packets. We dequeued
     // one packet, so there is certainly room for inserting one packet
     NS_ABORT_IF(!ret);
+    GetContainer().SetExpiryTime(GetIt(newItem), expiryTime);
 }
 
 uint32_t
@@ -495,7 +495,9 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
         // set item's information about its position in the queue
         item->SetQueueIt(ret, {});
         ret->ac = m_ac;
-        ret->expiryTime = item->GetHeader().IsCtl() ? Time::Max() : Simulator::Now() + m_maxDelay;
+        GetContainer().SetExpiryTime(
+            ret,
+            item->GetHeader().IsCtl() ? Time::Max() : Simulator::Now() + m_maxDelay);
         WmqIteratorTag tag;
         ret->deleter = [tag](auto mpdu) { mpdu->SetQueueIt(std::nullopt, tag); };
 
@@ -330,7 +330,7 @@ WifiMpdu::GetQueueAc() const
 Time
 WifiMpdu::GetExpiryTime() const
 {
-    return GetQueueIt()->expiryTime;
+    return GetQueueIt()->GetExpiryTime();
 }
 
 void
@@ -28,6 +28,7 @@
 #include "ns3/ht-configuration.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/open-hash-map.h"
 #include "ns3/pointer.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
@@ -35,6 +36,7 @@
 #include "ns3/vht-configuration.h"
 
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 
 #undef NS_LOG_APPEND_CONTEXT
@@ -49,6 +51,107 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("WifiPhy");
 
+namespace
+{
+
+/**
+ * Key of the cache of the TX durations. The fields of the TXVECTOR which the durations of
+ * a non-MU PPDU depend on are packed in two words.
+ */
+struct TxDurationKey
+{
+    uint64_t txVector{0}; //!< mode UID, preamble, band, NSS, NESS, STBC, LDPC, EHT PPDU type
+    uint64_t size{0};     //!< PSDU size, channel width and guard interval
+
+    /**
+     * @param other the key to compare with
+     * @return true if the keys are equal
+     */
+    bool operator==(const TxDurationKey& other) const = default;
+};
+
+/// Hash function of the keys of the cache of the TX durations
+struct TxDurationKeyHash
+{
+    /**
+     * @param key the key
+     * @return the hash of the key
+     */
+    std::size_t operator()(const TxDurationKey& key) const
+    {
+        return key.txVector ^ (key.size * 0xff51afd7ed558ccdULL);
+    }
+};
+
+/// Cache of the TX durations computed for non-MU PPDUs
+struct TxDurationCache
+{
+    OpenHashMap<TxDurationKey, Time, TxDurationKeyHash> entries; //!< the cached durations
+    uint64_t hits{0};                                             //!< the number of hits
+    uint64_t misses{0};                                           //!< the number of misses
+};
+
+/// The maximum number of entries of the cache of the TX durations
+std::atomic<std::size_t> g_txDurationCacheSize{4096};
+
+/**
+ * The durations are computed by the static PHY entities, which can be used by several
+ * threads at once, hence every thread has its own cache.
+ *
+ * @return the cache of the TX durations of the calling thread
+ */
+TxDurationCache&
+GetTxDurationCache()
+{
+    static thread_local TxDurationCache t_cache;
+    return t_cache;
+}
+
+/**
+ * @param size the PSDU size in bytes
+ * @param txVector the TXVECTOR, which must not be a MU TXVECTOR
+ * @param band the frequency band
+ * @param payload whether the key is for the duration of the payload only
+ * @return the key of the duration in the cache of the TX durations
+ */
+TxDurationKey
+GetTxDurationKey(uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, bool payload)
+{
+    const auto ehtPpduType = IsEht(txVector.GetPreambleType()) ? txVector.GetEhtPpduType() : 0;
+    return {.txVector = static_cast<uint64_t>(txVector.GetMode().GetUid()) |
+                        (static_cast<uint64_t>(txVector.GetPreambleType()) << 32) |
+                        (static_cast<uint64_t>(band) << 40) |
+                        (static_cast<uint64_t>(txVector.GetNss()) << 48) |
+                        (static_cast<uint64_t>(txVector.GetNess()) << 52) |
+                        (static_cast<uint64_t>(txVector.IsStbc()) << 56) |
+                        (static_cast<uint64_t>(txVector.IsLdpc()) << 57) |
+                        (static_cast<uint64_t>(ehtPpduType) << 58) |
+                        (static_cast<uint64_t>(payload) << 62),
+            .size = static_cast<uint64_t>(size) |
+                    (static_cast<uint64_t>(txVector.GetChannelWidth()) << 32) |
+                    (static_cast<uint64_t>(txVector.GetGuardInterval().GetNanoSeconds()) << 48)};
+}
+
+/**
+ * Store a duration in the cache of the TX durations of the calling thread, which is
+ * flushed if it is full.
+ *
+ * @param key the key of the duration
+ * @param duration the duration
+ */
+void
+StoreTxDuration(const TxDurationKey& key, Time duration)
+{
+    auto& cache = GetTxDurationCache();
+    if (cache.entries.GetSize() >= g_txDurationCacheSize.load(std::memory_order_relaxed))
+    {
+        cache.entries.Clear();
+    }
+    *cache.entries.Insert(key).first = duration;
+}
+
+} // namespace
+
 /****************************************************************
  *       The actual WifiPhy class
  ****************************************************************/
@@ -1530,16 +1633,35 @@ WifiPhy::GetPayloadDuration(uint32_t size,
                             MpduType mpdutype,
                             uint16_t staId)
 {
+    const auto cacheable = (mpdutype == NORMAL_MPDU) && !txVector.IsMu() &&
+                           (g_txDurationCacheSize.load(std::memory_order_relaxed) > 0);
+    TxDurationKey key;
+    if (cacheable)
+    {
+        auto& cache = GetTxDurationCache();
+        key = GetTxDurationKey(size, txVector, band, true);
+        if (const auto duration = cache.entries.Find(key))
+        {
+            ++cache.hits;
+            return *duration;
+        }
+        ++cache.misses;
+    }
     uint32_t totalAmpduSize;
     double totalAmpduNumSymbols;
-    return GetPayloadDuration(size,
-                              txVector,
-                              band,
-                              mpdutype,
-                              false,
-                              totalAmpduSize,
-                              totalAmpduNumSymbols,
-                              staId);
+    const auto duration = GetPayloadDuration(size,
+                                             txVector,
+                                             band,
+                                             mpdutype,
+                                             false,
+                                             totalAmpduSize,
+                                             totalAmpduNumSymbols,
+                                             staId);
+    if (cacheable)
+    {
+        StoreTxDuration(key, duration);
+    }
+    return duration;
 }
 
 Time
@@ -1577,12 +1699,67 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              uint16_t staId)
 {
     NS_ASSERT(txVector.IsValid(band));
+    const auto cacheable =
+        !txVector.IsMu() && (g_txDurationCacheSize.load(std::memory_order_relaxed) > 0);
+    TxDurationKey key;
+    if (cacheable)
+    {
+        auto& cache = GetTxDurationCache();
+        key = GetTxDurationKey(size, txVector, band, false);
+        if (const auto duration = cache.entries.Find(key))
+        {
+            ++cache.hits;
+            return *duration;
+        }
+        ++cache.misses;
+    }
+    uint32_t totalAmpduSize;
+    double totalAmpduNumSymbols;
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
-                    GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+                    GetPayloadDuration(size,
+                                       txVector,
+                                       band,
+                                       NORMAL_MPDU,
+                                       false,
+                                       totalAmpduSize,
+                                       totalAmpduNumSymbols,
+                                       staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (cacheable)
+    {
+        StoreTxDuration(key, duration);
+    }
     return duration;
 }
 
+void
+WifiPhy::SetTxDurationCacheSize(std::size_t maxEntries)
+{
+    g_txDurationCacheSize.store(maxEntries, std::memory_order_relaxed);
+    FlushTxDurationCache();
+}
+
+uint64_t
+WifiPhy::GetTxDurationCacheHits()
+{
+    return GetTxDurationCache().hits;
+}
+
+uint64_t
+WifiPhy::GetTxDurationCacheMisses()
+{
+    return GetTxDurationCache().misses;
+}
+
+void
+WifiPhy::FlushTxDurationCache()
+{
+    auto& cache = GetTxDurationCache();
+    cache.entries.Clear();
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
 Time
 WifiPhy::CalculateTxDuration(Ptr<const WifiPsdu> psdu,
                              const WifiTxVector& txVector,
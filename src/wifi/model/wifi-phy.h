@@ -348,6 +348,29 @@ class WIFI_EXPORT WifiPhy : public Object
      */
     static Time GetStartOfPacketDuration(const WifiTxVector& txVector);
 
+    /**
+     * Set the maximum number of entries of the cache of the durations computed by
+     * CalculateTxDuration() and GetPayloadDuration(). Only the durations of the PSDUs
+     * transmitted in non-MU PPDUs are cached. Every thread has its own cache, which is
+     * flushed when it is full. A value of zero disables the cache. The cache of the
+     * calling thread is flushed.
+     *
+     * @param maxEntries the maximum number of entries of the cache
+     */
+    static void SetTxDurationCacheSize(std::size_t maxEntries);
+    /**
+     * @return the number of durations served by the cache of the calling thread
+     */
+    static uint64_t GetTxDurationCacheHits();
+    /**
+     * @return the number of durations computed and stored in the cache of the calling thread
+     */
+    static uint64_t GetTxDurationCacheMisses();
+    /**
+     * Discard the entries and reset the counters of the cache of the calling thread.
+     */
+    static void FlushTxDurationCache();
+
     /**
      * The WifiPhy::GetModeList() method is used
      * (e.g., by a WifiRemoteStationManager) to determine the set of
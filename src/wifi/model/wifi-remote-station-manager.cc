@@ -531,7 +531,7 @@ WifiRemoteStationManager::RecordAssocRefused(Mac48Address address)
 uint16_t
 WifiRemoteStationManager::GetAssociationId(Mac48Address remoteAddress) const
 {
-    std::shared_ptr<WifiRemoteStationState> state;
+    WifiRemoteStationState* state;
     if (!remoteAddress.IsGroup() &&
         (state = LookupState(remoteAddress))->m_state == WifiRemoteStationState::GOT_ASSOC_TX_OK)
     {
@@ -582,10 +582,9 @@ WifiRemoteStationManager::SetPsMode(const Mac48Address& address, bool isInPsMode
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address);
-        stateIt != m_states.end() && stateIt->second->m_mleCommonInfo)
+    if (const auto state = FindState(address); state && state->m_mleCommonInfo)
     {
-        return stateIt->second->m_mleCommonInfo->m_mldMacAddress;
+        return state->m_mleCommonInfo->m_mldMacAddress;
     }
 
     return std::nullopt;
@@ -594,16 +593,32 @@ WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetAffiliatedStaAddress(const Mac48Address& mldAddress) const
 {
-    auto stateIt = m_states.find(mldAddress);
+    const auto state = FindState(mldAddress);
 
-    if (stateIt == m_states.end() || !stateIt->second->m_mleCommonInfo)
+    if (!state || !state->m_mleCommonInfo)
     {
         // MLD address not found
         return std::nullopt;
     }
 
-    NS_ASSERT(stateIt->second->m_mleCommonInfo->m_mldMacAddress == mldAddress);
-    return stateIt->second->m_address;
+    NS_ASSERT(state->m_mleCommonInfo->m_mldMacAddress == mldAddress);
+    return state->m_address;
+}
+
+std::optional<uint32_t>
+WifiRemoteStationManager::GetStationIndex(const Mac48Address& address) const
+{
+    if (const auto index = m_stationIndexes.Find(address))
+    {
+        return *index;
+    }
+    return std::nullopt;
+}
+
+std::size_t
+WifiRemoteStationManager::GetNStationIndexes() const
+{
+    return m_stationTable.size();
 }
 
 WifiTxVector
@@ -1493,13 +1508,16 @@ WifiRemoteStationManager::GetMostRecentRssi(Mac48Address address) const
     return std::nullopt;
 }
 
-std::shared_ptr<WifiRemoteStationState>
-WifiRemoteStationManager::LookupState(Mac48Address address) const
+WifiRemoteStationManager::StationEntry&
+WifiRemoteStationManager::GetStationEntry(Mac48Address address) const
 {
-    if (const auto stateIt = m_states.find(address); stateIt != m_states.cend())
+    auto self = const_cast<WifiRemoteStationManager*>(this);
+    const auto [index, inserted] = self->m_stationIndexes.Insert(address);
+    if (!inserted)
     {
-        return stateIt->second;
+        return self->m_stationTable[*index];
     }
+    *index = m_stationTable.size();
 
     auto state = std::make_shared<WifiRemoteStationState>();
     state->m_state = WifiRemoteStationState::BRAND_NEW;
@@ -1526,9 +1544,24 @@ WifiRemoteStationManager::LookupState(Mac48Address address) const
     state->m_aggregation = false;
     state->m_qosSupported = false;
     state->m_isInPsMode = false;
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert({address, state});
-    NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning new state");
-    return state;
+    NS_LOG_DEBUG("Station " << address << " added with index " << *index);
+    return self->m_stationTable.emplace_back(StationEntry{.state = state});
+}
+
+const WifiRemoteStationState*
+WifiRemoteStationManager::FindState(const Mac48Address& address) const
+{
+    if (const auto index = m_stationIndexes.Find(address))
+    {
+        return m_stationTable[*index].state.get();
+    }
+    return nullptr;
+}
+
+WifiRemoteStationState*
+WifiRemoteStationManager::LookupState(Mac48Address address) const
+{
+    return GetStationEntry(address).state.get();
 }
 
 WifiRemoteStation*
@@ -1537,17 +1570,19 @@ WifiRemoteStationManager::Lookup(Mac48Address address) const
     NS_LOG_FUNCTION(this << address);
     NS_ASSERT(!address.IsGroup());
     NS_ASSERT(address != m_wifiMac->GetAddress());
-    auto stationIt = m_stations.find(address);
-
-    if (stationIt != m_stations.end())
+    if (auto station = GetStationEntry(address).station)
     {
-        return stationIt->second;
+        return station;
     }
 
-    WifiRemoteStation* station = DoCreateStation();
-    station->m_state = LookupState(address).get();
+    // DoCreateStation() may add other stations to the table, hence the entry is fetched again
+    // by index once the station has been created
+    auto self = const_cast<WifiRemoteStationManager*>(this);
+    auto station = self->DoCreateStation();
+    auto& entry = self->m_stationTable[*m_stationIndexes.Find(address)];
+    entry.station = station;
+    station->m_state = entry.state.get();
     station->m_rssiAndUpdateTimePair = std::make_pair(dBm_u{0}, Seconds(0));
-    const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
     return station;
 }
 
@@ -1837,12 +1872,22 @@ WifiRemoteStationManager::AddStationMleCommonInfo(
     const std::shared_ptr<CommonInfoBasicMle>& mleCommonInfo)
 {
     NS_LOG_FUNCTION(this << from);
-    auto state = LookupState(from);
+    const auto state = GetStationEntry(from).state;
     state->m_mleCommonInfo = mleCommonInfo;
-    // insert another entry in m_states indexed by the MLD address and pointing to the same state
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert_or_assign(
-        mleCommonInfo->m_mldMacAddress,
-        state);
+    // point the entry of the MLD address to the same state
+    const auto [index, inserted] = m_stationIndexes.Insert(mleCommonInfo->m_mldMacAddress);
+    if (inserted)
+    {
+        *index = m_stationTable.size();
+        m_stationTable.emplace_back(StationEntry{.state = state});
+        return;
+    }
+    auto& entry = m_stationTable[*index];
+    entry.state = state;
+    if (entry.station)
+    {
+        entry.station->m_state = state.get();
+    }
 }
 
 Ptr<const HtCapabilities>
@@ -1988,12 +2033,12 @@ void
 WifiRemoteStationManager::Reset()
 {
     NS_LOG_FUNCTION(this);
-    m_states.clear();
-    for (auto& state : m_stations)
+    for (auto& entry : m_stationTable)
     {
-        delete (state.second);
+        delete entry.station;
     }
-    m_stations.clear();
+    m_stationTable.clear();
+    m_stationIndexes.Clear();
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
@@ -2531,9 +2576,9 @@ WifiRemoteStationManager::GetEmlsrSupported(const Mac48Address& address) const
 bool
 WifiRemoteStationManager::GetEmlsrEnabled(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address); stateIt != m_states.cend())
+    if (const auto state = FindState(address))
     {
-        return stateIt->second->m_emlsrEnabled;
+        return state->m_emlsrEnabled;
     }
     return false;
 }
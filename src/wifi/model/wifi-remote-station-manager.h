@@ -26,6 +26,7 @@
 #include "ns3/ht-operation.h"
 #include "ns3/mac48-address.h"
 #include "ns3/object.h"
+#include "ns3/open-hash-map.h"
 #include "ns3/traced-callback.h"
 #include "ns3/vht-capabilities.h"
 #include "ns3/vht-operation.h"
@@ -160,16 +161,6 @@ class WifiRemoteStationManager : public Object
         CTS_TO_SELF
     };
 
-    /**
-     * A map of WifiRemoteStations with Mac48Address as key
-     */
-    using Stations = std::unordered_map<Mac48Address, WifiRemoteStation*, WifiAddressHash>;
-    /**
-     * A map of WifiRemoteStationStates with Mac48Address as key
-     */
-    using StationStates =
-        std::unordered_map<Mac48Address, std::shared_ptr<WifiRemoteStationState>, WifiAddressHash>;
-
     /**
      * Set up PHY associated with this device since it is the object that
      * knows the full set of transmit rates that are supported.
@@ -922,6 +913,23 @@ class WifiRemoteStationManager : public Object
      */
     std::optional<Mac48Address> GetAffiliatedStaAddress(const Mac48Address& mldAddress) const;
 
+    /**
+     * Get the index of the given station in the table of the stations known by this
+     * manager. The indexes are dense, i.e., they are assigned in increasing order starting
+     * from zero when a station becomes known (at the latest when it associates), and they
+     * remain valid until the manager is reset. They can hence be used to store per-station
+     * information in contiguous arrays. The MLD address of a remote MLD has its own index.
+     *
+     * @param address the MAC address of the remote station
+     * @return the index of the station, if the station is known
+     */
+    std::optional<uint32_t> GetStationIndex(const Mac48Address& address) const;
+
+    /**
+     * @return the number of station indexes assigned so far
+     */
+    std::size_t GetNStationIndexes() const;
+
     /**
      * @param header MAC header
      * @param allowedWidth the allowed width to send this packet
@@ -1557,6 +1565,31 @@ class WifiRemoteStationManager : public Object
                                        MHz_u dataChannelWidth,
                                        uint8_t dataNss);
 
+    /// The entry of a station in the table of the stations known by this manager
+    struct StationEntry
+    {
+        std::shared_ptr<WifiRemoteStationState> state; //!< the state of the station
+        WifiRemoteStation* station{nullptr}; //!< the station, nullptr if not created yet
+    };
+
+    /**
+     * Return the entry of the station associated with the given address in the table of
+     * the stations, which is created if the station is not known yet. The returned
+     * reference is invalidated when another station is added to the table.
+     *
+     * @param address the address of the station
+     * @return the entry of the station
+     */
+    StationEntry& GetStationEntry(Mac48Address address) const;
+
+    /**
+     * Return the state of the station associated with the given address, if known.
+     *
+     * @param address the address of the station
+     * @return the state of the station, or nullptr if the station is not known
+     */
+    const WifiRemoteStationState* FindState(const Mac48Address& address) const;
+
     /**
      * Return the state of the station associated with the given address.
      *
@@ -1564,7 +1597,7 @@ class WifiRemoteStationManager : public Object
      * @return WifiRemoteStationState corresponding to the address
      * @hidecaller
      */
-    std::shared_ptr<WifiRemoteStationState> LookupState(Mac48Address address) const;
+    WifiRemoteStationState* LookupState(Mac48Address address) const;
     /**
      * Return the station associated with the given address.
      *
@@ -1625,8 +1658,9 @@ class WifiRemoteStationManager : public Object
     WifiModeList m_bssBasicRateSet; //!< basic rate set
     WifiModeList m_bssBasicMcsSet;  //!< basic MCS set
 
-    StationStates m_states; //!< States of known stations
-    Stations m_stations;    //!< Information for each known stations
+    /// Indexes of the known stations in the table of the stations, by address
+    OpenHashMap<Mac48Address, uint32_t, WifiAddressHash> m_stationIndexes;
+    std::vector<StationEntry> m_stationTable; //!< Table of the known stations, by index
 
     uint32_t m_maxSsrc;                //!< Maximum STA short retry count (SSRC)
     uint32_t m_maxSlrc;                //!< Maximum STA long retry count (SLRC)
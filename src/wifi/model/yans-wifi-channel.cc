@@ -14,7 +14,10 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/mobility-grid.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
@@ -46,7 +49,25 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "If positive, the maximum distance in meters between a transmitter "
+                          "and the PHYs to which its PPDUs are passed. The PHYs are then looked "
+                          "up in a grid of their positions, updated when their MobilityModel "
+                          "reports a course change, so that the propagation models are not "
+                          "evaluated for the PHYs out of range. The default value of 0 disables "
+                          "the range limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<meter_u>(0))
+            .AddAttribute("RxSensitivityCutoff",
+                          "If true, a PPDU is not passed to the PHYs at which its RX power, "
+                          "including the RX gain, is below their RX sensitivity for the width of "
+                          "the PPDU. These PHYs would drop the PPDU anyway, but their "
+                          "SignalArrival trace source is then not fired.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_rxSensitivityCutoff),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -58,6 +79,7 @@ YansWifiChannel::YansWifiChannel()
 YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
+    m_grid = nullptr;
     m_phyList.clear();
 }
 
@@ -81,24 +103,38 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    std::vector<uint64_t> candidates;
+    if (m_maxRange > 0)
     {
-        if (sender != (*i))
+        candidates = GetCandidates(senderMobility->GetPosition());
+    }
+    const auto numCandidates = (m_maxRange > 0) ? candidates.size() : m_phyList.size();
+    for (std::size_t j = 0; j < numCandidates; ++j)
+    {
+        const auto& phy = m_phyList[(m_maxRange > 0) ? candidates[j] : j];
+        if (sender != phy)
         {
             // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            if (phy->GetChannelNumber() != sender->GetChannelNumber())
             {
                 continue;
             }
 
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+            auto receiverMobility = phy->GetMobility()->GetObject<MobilityModel>();
             const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+            if (m_rxSensitivityCutoff &&
+                (rxPower + phy->GetRxGain() <
+                 phy->GetRxSensitivity() + RatioToDb(ppdu->GetTxChannelWidth() / MHz_u{20})))
+            {
+                NS_LOG_LOGIC("Skipping PHY " << phy << " with rxPower=" << rxPower << "dBm");
+                continue;
+            }
+            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
             NS_LOG_DEBUG("propagation: txPower="
                          << txPower << "dBm, rxPower=" << rxPower << "dBm, "
                          << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
                          << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
+            auto dstNetDevice = phy->GetDevice();
             uint32_t dstNode;
             if (!dstNetDevice)
             {
@@ -112,7 +148,7 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
             Simulator::ScheduleWithContext(dstNode,
                                            delay,
                                            &YansWifiChannel::Receive,
-                                           (*i),
+                                           phy,
                                            ppdu,
                                            rxPower);
         }
@@ -161,6 +197,27 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    if (m_grid)
+    {
+        m_grid->Add(MakeCallback(&YansWifiPhy::GetMobility, phy));
+    }
+}
+
+std::vector<uint64_t>
+YansWifiChannel::GetCandidates(const Vector& position) const
+{
+    NS_LOG_FUNCTION(this << position);
+    if (!m_grid || m_grid->GetCellSize() != m_maxRange)
+    {
+        NS_LOG_LOGIC("Building the grid of " << m_phyList.size() << " PHYs");
+        // the cells have the size of the range, hence only the neighbor cells are visited
+        m_grid = Create<MobilityGrid>(m_maxRange);
+        for (const auto& phy : m_phyList)
+        {
+            m_grid->Add(MakeCallback(&YansWifiPhy::GetMobility, phy));
+        }
+    }
+    return m_grid->GetCandidates(position, m_maxRange);
 }
 
 int64_t
@@ -12,10 +12,14 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/vector.h"
+
+#include <vector>
 
 namespace ns3
 {
 
+class MobilityGrid;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -32,6 +36,15 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * If the MaxRange attribute is set, the PHYs are indexed by a MobilityGrid
+ * of their positions in the XY plane, whose cells have the size of the range
+ * and which is updated when their MobilityModel reports a course change, so
+ * that a PPDU is only passed to the PHYs within range of the transmitter.
+ * The PHYs which are moving, or whose MobilityModel is not known yet, are
+ * kept out of the grid and always checked. If the RxSensitivityCutoff
+ * attribute is set, a PPDU is not passed to the PHYs at which it would be
+ * received below the RX sensitivity.
  */
 class YansWifiChannel : public Channel
 {
@@ -104,9 +117,23 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Get the indexes in the PHY list of the PHYs which may be within range of
+     * a transmitter, i.e., the PHYs in the grid within MaxRange of the transmitter
+     * and the PHYs out of the grid. The grid is built when first needed.
+     *
+     * @param position the position of the transmitter
+     * @return the indexes of the PHYs, in increasing order
+     */
+    std::vector<uint64_t> GetCandidates(const Vector& position) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    meter_u m_maxRange;                 //!< Maximum range of the transmissions, 0 if unlimited
+    bool m_rxSensitivityCutoff; //!< Whether to skip the PHYs at which a PPDU is below sensitivity
+
+    mutable Ptr<MobilityGrid> m_grid; //!< Grid of the PHY positions, indexed as m_phyList
 };
 
 } // namespace ns3
@@ -2012,6 +2012,179 @@ TxDurationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the cache of the durations computed by WifiPhy::CalculateTxDuration and
+ * WifiPhy::GetPayloadDuration
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Check the cache of the TX durations")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    auto ehtSu = WifiTxVector(EhtPhy::GetEhtMcs13(),
+                              0,
+                              WIFI_PREAMBLE_EHT_MU,
+                              NanoSeconds(800),
+                              1,
+                              1,
+                              0,
+                              MHz_u{320},
+                              true);
+    ehtSu.SetEhtPpduType(1);
+    const std::vector<std::pair<WifiTxVector, WifiPhyBand>> txVectors{
+        {WifiTxVector(DsssPhy::GetDsssRate1Mbps(),
+                      0,
+                      WIFI_PREAMBLE_LONG,
+                      NanoSeconds(800),
+                      1,
+                      1,
+                      0,
+                      MHz_u{22},
+                      false),
+         WIFI_PHY_BAND_2_4GHZ},
+        {WifiTxVector(ErpOfdmPhy::GetErpOfdmRate6Mbps(),
+                      0,
+                      WIFI_PREAMBLE_LONG,
+                      NanoSeconds(800),
+                      1,
+                      1,
+                      0,
+                      MHz_u{20},
+                      false),
+         WIFI_PHY_BAND_2_4GHZ},
+        {WifiTxVector(OfdmPhy::GetOfdmRate54Mbps(),
+                      0,
+                      WIFI_PREAMBLE_LONG,
+                      NanoSeconds(800),
+                      1,
+                      1,
+                      0,
+                      MHz_u{20},
+                      false),
+         WIFI_PHY_BAND_5GHZ},
+        {WifiTxVector(HtPhy::GetHtMcs15(),
+                      0,
+                      WIFI_PREAMBLE_HT_MF,
+                      NanoSeconds(400),
+                      2,
+                      2,
+                      0,
+                      MHz_u{40},
+                      true),
+         WIFI_PHY_BAND_5GHZ},
+        {WifiTxVector(VhtPhy::GetVhtMcs9(),
+                      0,
+                      WIFI_PREAMBLE_VHT_SU,
+                      NanoSeconds(800),
+                      1,
+                      1,
+                      0,
+                      MHz_u{80},
+                      true),
+         WIFI_PHY_BAND_5GHZ},
+        {WifiTxVector(HePhy::GetHeMcs11(),
+                      0,
+                      WIFI_PREAMBLE_HE_SU,
+                      NanoSeconds(800),
+                      2,
+                      2,
+                      0,
+                      MHz_u{160},
+                      true,
+                      false,
+                      true),
+         WIFI_PHY_BAND_6GHZ},
+        {WifiTxVector(HePhy::GetHeMcs0(),
+                      0,
+                      WIFI_PREAMBLE_HE_ER_SU,
+                      NanoSeconds(3200),
+                      1,
+                      1,
+                      0,
+                      MHz_u{20},
+                      true),
+         WIFI_PHY_BAND_5GHZ},
+        {ehtSu, WIFI_PHY_BAND_6GHZ}};
+    const std::vector<uint32_t> sizes{14, 1536, 4095};
+    const auto numDurations = 2 * txVectors.size() * sizes.size();
+
+    // compute the reference durations without the cache
+    WifiPhy::SetTxDurationCacheSize(0);
+    std::vector<Time> expected;
+    for (const auto& [txVector, band] : txVectors)
+    {
+        for (const auto size : sizes)
+        {
+            expected.push_back(WifiPhy::CalculateTxDuration(size, txVector, band));
+            expected.push_back(WifiPhy::GetPayloadDuration(size, txVector, band));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          0,
+                          "No duration should be cached when the cache is disabled");
+
+    auto checkDurations = [&]() {
+        std::size_t i = 0;
+        for (const auto& [txVector, band] : txVectors)
+        {
+            for (const auto size : sizes)
+            {
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, txVector, band),
+                                      expected.at(i++),
+                                      "Unexpected TX duration for " << txVector << " and size "
+                                                                    << size);
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetPayloadDuration(size, txVector, band),
+                                      expected.at(i++),
+                                      "Unexpected payload duration for " << txVector
+                                                                         << " and size " << size);
+            }
+        }
+    };
+
+    // the durations are computed once, then served from the cache
+    WifiPhy::SetTxDurationCacheSize(4096);
+    checkDurations();
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits(), 0, "Unexpected number of hits");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          numDurations,
+                          "Unexpected number of misses");
+    checkDurations();
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits(),
+                          numDurations,
+                          "Unexpected number of hits");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          numDurations,
+                          "Unexpected number of misses");
+
+    // a cache smaller than the number of durations is flushed when it is full
+    WifiPhy::SetTxDurationCacheSize(4);
+    checkDurations();
+    checkDurations();
+    NS_TEST_EXPECT_MSG_LT(WifiPhy::GetTxDurationCacheHits(),
+                          numDurations,
+                          "The bound on the number of entries has not been enforced");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits() + WifiPhy::GetTxDurationCacheMisses(),
+                          2 * numDurations,
+                          "Unexpected number of lookups");
+
+    WifiPhy::SetTxDurationCacheSize(4096);
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -2586,6 +2759,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 {
     AddTestCase(new TxDurationTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
     const auto p80OrLow80 = true;
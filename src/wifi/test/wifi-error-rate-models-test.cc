@@ -14,11 +14,15 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/cached-error-rate-model.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1110,6 +1114,116 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Wifi Cached Error Rate Model Test Case
+ *
+ * This test checks that the chunk success rates interpolated by the CachedErrorRateModel
+ * do not deviate from the ones of the wrapped error rate model by more than the
+ * tolerance, and that most of them are served from the cache once the grids are built.
+ */
+class CachedErrorRateModelTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param errorRateModel the type of the wrapped error rate model
+     */
+    CachedErrorRateModelTestCase(const std::string& errorRateModel);
+
+  private:
+    void DoRun() override;
+
+    std::string m_errorRateModel; ///< the type of the wrapped error rate model
+};
+
+CachedErrorRateModelTestCase::CachedErrorRateModelTestCase(const std::string& errorRateModel)
+    : TestCase("Check the chunk success rates of the CachedErrorRateModel wrapping " +
+               errorRateModel),
+      m_errorRateModel(errorRateModel)
+{
+}
+
+void
+CachedErrorRateModelTestCase::DoRun()
+{
+    const double tolerance = 1e-3;
+
+    ObjectFactory factory(m_errorRateModel);
+    auto model = factory.Create<ErrorRateModel>();
+    auto cached = CreateObjectWithAttributes<CachedErrorRateModel>("ErrorRateModel",
+                                                                   PointerValue(model),
+                                                                   "Tolerance",
+                                                                   DoubleValue(tolerance));
+
+    std::vector<WifiMode> modes{OfdmPhy::GetOfdmRate6Mbps(), OfdmPhy::GetOfdmRate54Mbps()};
+    for (uint8_t mcs = 0; mcs <= 11; mcs += 2)
+    {
+        modes.push_back(HePhy::GetHeMcs(mcs));
+    }
+    // sizes on both sides of the size threshold of the TableBasedErrorRateModel. The latter
+    // rounds the sizes down to bytes and the SNRs to 0.01 dB, hence the sizes and the SNRs
+    // below are not aligned on these, so as to check the steps of its success rates too.
+    const std::vector<uint64_t> sizes{1, 3, 27, 203, 1001, 3199, 3200, 3213, 11669, 63931};
+
+    double maxDeviation = 0;
+    for (auto pass = 0; pass < 2; pass++)
+    {
+        const auto hits = cached->GetCacheHits();
+        const auto misses = cached->GetCacheMisses();
+        for (const auto& mode : modes)
+        {
+            WifiTxVector txVector;
+            txVector.SetMode(mode);
+            for (auto i = 0; i < 400; i++)
+            {
+                const dB_u snr{-5 + 0.1237 * i};
+                for (auto nbits : sizes)
+                {
+                    const auto expected =
+                        model->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                    const auto actual =
+                        cached->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                    NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                              expected,
+                                              tolerance,
+                                              "Unexpected success rate for mode "
+                                                  << mode << ", SNR " << snr << " dB and "
+                                                  << nbits << " bits");
+                    maxDeviation = std::max(maxDeviation, std::abs(actual - expected));
+                }
+            }
+        }
+        if (pass == 1)
+        {
+            // the grids are built, hence nearly all the chunks are interpolated
+            NS_TEST_EXPECT_MSG_GT(cached->GetCacheHits() - hits,
+                                  10 * (cached->GetCacheMisses() - misses),
+                                  "The success rates are not served from the cache");
+        }
+    }
+    NS_LOG_INFO(m_errorRateModel << ": max deviation=" << maxDeviation
+                                 << " hits=" << cached->GetCacheHits()
+                                 << " misses=" << cached->GetCacheMisses());
+
+    // the chunks outside the range of the grids are computed by the wrapped model
+    WifiTxVector txVector;
+    txVector.SetMode(modes.front());
+    const auto misses = cached->GetCacheMisses();
+    NS_TEST_EXPECT_MSG_EQ(cached->GetChunkSuccessRate(modes.front(), txVector, DbToRatio(80), 100),
+                          model->GetChunkSuccessRate(modes.front(), txVector, DbToRatio(80), 100),
+                          "Unexpected success rate above the range of the grids");
+    NS_TEST_EXPECT_MSG_EQ(cached->GetCacheMisses(),
+                          misses + 1,
+                          "The wrapped model should have been called");
+
+    cached->Dispose();
+    model->Dispose();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1177,6 +1291,12 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
                                                 HePhy::GetHeMcs11(),
                                                 1458),
                 TestCase::Duration::QUICK);
+    AddTestCase(new CachedErrorRateModelTestCase("ns3::NistErrorRateModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new CachedErrorRateModelTestCase("ns3::YansErrorRateModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new CachedErrorRateModelTestCase("ns3::TableBasedErrorRateModel"),
+                TestCase::Duration::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
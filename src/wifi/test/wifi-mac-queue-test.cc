@@ -12,6 +12,7 @@
 #include "ns3/wifi-mac-queue.h"
 
 #include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -160,7 +161,7 @@ WifiExtractExpiredMpdusTest::Enqueue(Mac48Address rxAddr, bool inflight, Time ex
 
     auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
     auto elemIt = m_container.insert(m_container.GetQueue(queueId).cend(), mpdu);
-    elemIt->expiryTime = expiryTime;
+    m_container.SetExpiryTime(elemIt, expiryTime);
     if (inflight)
     {
         elemIt->inflights.emplace(0, mpdu);
@@ -417,6 +418,122 @@ WifiExtractExpiredMpdusTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the expiry index of the MAC queue container
+ *
+ * This test verifies that the MPDUs are extracted in increasing order of expiry time
+ * regardless of their position in the container queue, that the expiry time of an MPDU
+ * can be updated, that erased MPDUs are removed from the expiry index and that MPDUs
+ * whose expiry time has never been set expire immediately.
+ */
+class WifiMacQueueExpiryIndexTest : public TestCase
+{
+  public:
+    WifiMacQueueExpiryIndexTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the sequence numbers of the MPDUs in the given range.
+     *
+     * @param range the range [first, last) of iterators pointing to the extracted MPDUs
+     * @param expected the expected sequence numbers, in order
+     * @param now a string identifying the time of the check
+     */
+    void CheckExtracted(std::pair<WifiMacQueueContainer::iterator,
+                                  WifiMacQueueContainer::iterator> range,
+                        const std::vector<uint16_t>& expected,
+                        const std::string& now);
+
+    WifiMacQueueContainer m_container; //!< MAC queue container
+};
+
+WifiMacQueueExpiryIndexTest::WifiMacQueueExpiryIndexTest()
+    : TestCase("Test the expiry index of the MAC queue container")
+{
+}
+
+void
+WifiMacQueueExpiryIndexTest::CheckExtracted(
+    std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator> range,
+    const std::vector<uint16_t>& expected,
+    const std::string& now)
+{
+    std::vector<uint16_t> actual;
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        actual.push_back(it->mpdu->GetHeader().GetSequenceNumber());
+    }
+    NS_TEST_EXPECT_MSG_EQ(actual.size(), expected.size(), "Unexpected number of MPDUs at " << now);
+    for (std::size_t i = 0; i < std::min(actual.size(), expected.size()); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(actual[i], expected[i], "Unexpected extracted MPDU at " << now);
+    }
+}
+
+void
+WifiMacQueueExpiryIndexTest::DoRun()
+{
+    const auto txAddr = Mac48Address::Allocate();
+    const auto rxAddr = Mac48Address::Allocate();
+    const auto queueId = MakeWifiUnicastQueueId(WIFI_QOSDATA_QUEUE, rxAddr, 0);
+
+    std::vector<WifiMacQueueContainer::iterator> elems;
+    for (uint16_t seqNo = 0; seqNo < 6; ++seqNo)
+    {
+        WifiMacHeader header(WIFI_MAC_QOSDATA);
+        header.SetAddr1(rxAddr);
+        header.SetAddr2(txAddr);
+        header.SetQosTid(0);
+        header.SetSequenceNumber(seqNo);
+        auto mpdu = Create<WifiMpdu>(Create<Packet>(100), header);
+        elems.push_back(m_container.insert(m_container.GetQueue(queueId).cend(), mpdu));
+        elems.back()->deleter = [](auto mpdu) {};
+    }
+    const auto mpduSize = elems.front()->mpdu->GetSize();
+
+    // the expiry times are not sorted in queue order, MPDU 4 never expires and MPDU 5
+    // has no expiry time
+    m_container.SetExpiryTime(elems[0], MilliSeconds(30));
+    m_container.SetExpiryTime(elems[1], MilliSeconds(10));
+    m_container.SetExpiryTime(elems[2], MilliSeconds(20));
+    m_container.SetExpiryTime(elems[3], MilliSeconds(5));
+    m_container.SetExpiryTime(elems[4], Time::Max());
+    // postpone the expiry of MPDU 2 and remove MPDU 3 from the container
+    m_container.SetExpiryTime(elems[2], MilliSeconds(40));
+    m_container.erase(elems[3]);
+
+    Simulator::Schedule(MilliSeconds(25), [&]() {
+        CheckExtracted(m_container.ExtractExpiredMpdus(queueId), {5, 1}, "25ms");
+        CheckExtracted(m_container.ExtractExpiredMpdus(queueId), {}, "25ms");
+    });
+    Simulator::Schedule(MilliSeconds(50), [&]() {
+        CheckExtracted(m_container.ExtractAllExpiredMpdus(), {0, 2}, "50ms");
+    });
+    Simulator::Schedule(Seconds(10), [&]() {
+        CheckExtracted(m_container.ExtractAllExpiredMpdus(), {}, "10s");
+        CheckExtracted(m_container.GetAllExpiredMpdus(), {5, 1, 0, 2}, "10s");
+
+        const auto& queue = m_container.GetQueue(queueId);
+        NS_TEST_EXPECT_MSG_EQ(queue.size(), 1, "Expected one MPDU left in the container queue");
+        NS_TEST_EXPECT_MSG_EQ((!queue.empty() &&
+                               queue.front().mpdu->GetHeader().GetSequenceNumber() == 4),
+                              true,
+                              "Unexpected MPDU left in the container queue");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId),
+                              mpduSize,
+                              "Unexpected size of the container queue");
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+    m_container.clear();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -522,6 +639,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacQueueExpiryIndexTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiMacQueueFlushTest, TestCase::Duration::QUICK);
 }
 
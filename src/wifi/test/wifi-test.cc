@@ -11,9 +11,12 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -48,7 +51,9 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <algorithm>
 #include <optional>
+#include <random>
 
 using namespace ns3;
 
@@ -3978,6 +3983,384 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the NI changes kept by the interference helper behave as a sorted list
+ * while they are inserted, erased and updated by ranges in random order.
+ */
+class NiChangesTest : public TestCase
+{
+  public:
+    NiChangesTest();
+
+  private:
+    void DoRun() override;
+
+    /// Interference helper exposing the NI changes container
+    class NiChangesInterferenceHelper : public InterferenceHelper
+    {
+      public:
+        using InterferenceHelper::NiChange;
+        using InterferenceHelper::NiChanges;
+    };
+
+    using NiChange = NiChangesInterferenceHelper::NiChange;   //!< NI change
+    using NiChanges = NiChangesInterferenceHelper::NiChanges; //!< NI changes container
+    using Reference = std::vector<std::pair<Time, Watt_u>>;   //!< reference list of entries
+
+    /**
+     * Check that the NI changes hold the same entries as the reference list.
+     *
+     * @param niChanges the NI changes
+     * @param reference the reference list
+     */
+    void CheckEntries(NiChanges& niChanges, const Reference& reference);
+};
+
+NiChangesTest::NiChangesTest()
+    : TestCase("Check the NI changes container")
+{
+}
+
+void
+NiChangesTest::CheckEntries(NiChanges& niChanges, const Reference& reference)
+{
+    NS_TEST_ASSERT_MSG_EQ(niChanges.size(), reference.size(), "Unexpected number of entries");
+    std::size_t i = 0;
+    for (auto it = niChanges.cbegin(); it != niChanges.cend(); ++it, ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(it->first, reference[i].first, "Unexpected time at index " << i);
+        NS_TEST_ASSERT_MSG_EQ_TOL(it->second.GetPower(),
+                                  reference[i].second,
+                                  1e-9,
+                                  "Unexpected power at index " << i);
+    }
+    auto i2 = reference.size();
+    for (auto it = niChanges.end(); it != niChanges.begin();)
+    {
+        --it;
+        --i2;
+        NS_TEST_ASSERT_MSG_EQ(it->first, reference[i2].first, "Unexpected time at index " << i2);
+    }
+    if (!reference.empty())
+    {
+        const auto index = reference.size() / 2;
+        NS_TEST_ASSERT_MSG_EQ(niChanges[index].first,
+                              reference[index].first,
+                              "Unexpected time at index " << index);
+        for (const auto& t : {reference[index].first, reference[index].first + NanoSeconds(1)})
+        {
+            const auto lower = std::lower_bound(
+                reference.cbegin(),
+                reference.cend(),
+                t,
+                [](const auto& entry, const Time& time) { return entry.first < time; });
+            const auto upper = std::upper_bound(
+                reference.cbegin(),
+                reference.cend(),
+                t,
+                [](const Time& time, const auto& entry) { return time < entry.first; });
+            NS_TEST_ASSERT_MSG_EQ(std::distance(niChanges.begin(), niChanges.lower_bound(t)),
+                                  std::distance(reference.cbegin(), lower),
+                                  "Unexpected lower bound for " << t);
+            NS_TEST_ASSERT_MSG_EQ(std::distance(niChanges.begin(), niChanges.upper_bound(t)),
+                                  std::distance(reference.cbegin(), upper),
+                                  "Unexpected upper bound for " << t);
+        }
+    }
+}
+
+void
+NiChangesTest::DoRun()
+{
+    std::minstd_rand rng(1);
+    NiChanges niChanges;
+    Reference reference;
+
+    niChanges.emplace(Time{0}, NiChange(Watt_u{0}, nullptr));
+    reference.emplace_back(Time{0}, Watt_u{0});
+
+    for (uint32_t step = 0; step < 2000; ++step)
+    {
+        const auto op = rng() % 16;
+        if (op < 12)
+        {
+            // insert an entry and add power from it to another entry inserted later, like
+            // InterferenceHelper::AppendEvent does
+            const auto start = NanoSeconds(rng() % 1000);
+            const auto end = start + NanoSeconds(rng() % 100);
+            const auto power = Watt_u{1.0 + rng() % 10};
+            const auto startIt = niChanges.insert(niChanges.upper_bound(start),
+                                                  {start, NiChange(Watt_u{0.5}, nullptr)});
+            NS_TEST_ASSERT_MSG_EQ(startIt->first, start, "Unexpected inserted entry");
+            niChanges.AddPower(startIt, niChanges.upper_bound(end), power);
+            niChanges.insert(niChanges.upper_bound(end), {end, NiChange(Watt_u{0.25}, nullptr)});
+
+            auto comp = [](const Time& time, const auto& entry) { return time < entry.first; };
+            auto startPos = std::upper_bound(reference.begin(), reference.end(), start, comp);
+            startPos = reference.insert(startPos, {start, Watt_u{0.5}});
+            auto endPos = std::upper_bound(reference.begin(), reference.end(), end, comp);
+            for (auto it = startPos; it != endPos; ++it)
+            {
+                it->second += power;
+            }
+            reference.insert(endPos, {end, Watt_u{0.25}});
+        }
+        else if (op < 13 && reference.size() > 1)
+        {
+            // erase the oldest entries except the first one, like InterferenceHelper::AppendEvent
+            const auto count = 1 + rng() % std::min<std::size_t>(reference.size() - 1, 32);
+            const auto lastTime = std::next(niChanges.begin(), count)->first;
+            const auto next =
+                niChanges.erase(std::next(niChanges.begin()), std::next(niChanges.begin(), count));
+            NS_TEST_ASSERT_MSG_EQ(next->first, lastTime, "Unexpected iterator returned by erase");
+            reference.erase(std::next(reference.begin()), std::next(reference.begin(), count));
+        }
+        else
+        {
+            // add power to a random range of entries
+            const auto a = rng() % reference.size();
+            const auto b = a + rng() % (reference.size() - a + 1);
+            const auto power = Watt_u{0.125};
+            niChanges.AddPower(std::next(niChanges.begin(), a),
+                               std::next(niChanges.begin(), b),
+                               power);
+            niChanges.at(a).second.AddPower(power);
+            for (auto i = a; i < b; ++i)
+            {
+                reference[i].second += power;
+            }
+            reference[a].second += power;
+        }
+        NS_TEST_ASSERT_MSG_EQ(niChanges.begin()->first, Time{0}, "Unexpected first entry");
+        CheckEntries(niChanges, reference);
+    }
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the filtering of the receivers by the YansWifiChannel
+ *
+ * A node at the origin broadcasts a frame at time 1s and at time 3s. Four other nodes
+ * are at 10 m, at 100 m, at 2 km (and moved at 50 m at time 2s), and moving from 2 km
+ * at time 1s to the origin at time 3s. This test checks that the PPDUs reach all the
+ * receivers by default, and only the receivers within 500 m of the transmitter when
+ * either the MaxRange or the RxSensitivityCutoff attribute of the channel is set.
+ */
+class YansWifiChannelFilterTest : public TestCase
+{
+  public:
+    YansWifiChannelFilterTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the simulation with the given attribute of the channel set.
+     *
+     * @param name the name of the attribute, empty for none
+     * @param value the value of the attribute
+     * @param expected the expected number of PPDUs arriving at each receiver
+     */
+    void RunOne(const std::string& name,
+                const AttributeValue& value,
+                const std::vector<uint32_t>& expected);
+
+    /**
+     * Callback invoked when a signal arrives at a PHY.
+     *
+     * @param index the index of the receiver
+     * @param ppdu the PPDU
+     * @param rxPower the RX power in dBm
+     * @param duration the duration of the signal
+     */
+    void SignalArrival(std::size_t index, Ptr<const WifiPpdu> ppdu, double rxPower, Time duration);
+
+    std::vector<uint32_t> m_arrivals; ///< the number of PPDUs arriving at each receiver
+};
+
+YansWifiChannelFilterTest::YansWifiChannelFilterTest()
+    : TestCase("Check the filtering of the receivers by the YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelFilterTest::SignalArrival(std::size_t index,
+                                         Ptr<const WifiPpdu> ppdu,
+                                         double rxPower,
+                                         Time duration)
+{
+    m_arrivals.at(index)++;
+}
+
+void
+YansWifiChannelFilterTest::RunOne(const std::string& name,
+                                  const AttributeValue& value,
+                                  const std::vector<uint32_t>& expected)
+{
+    NodeContainer nodes(5);
+    auto channel = YansWifiChannelHelper::Default().Create();
+    if (!name.empty())
+    {
+        channel->SetAttribute(name, value);
+    }
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto devices = wifi.Install(phy, mac, nodes);
+
+    MobilityHelper mobility;
+    auto positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    positions->Add(Vector(10, 0, 0));
+    positions->Add(Vector(100, 0, 0));
+    positions->Add(Vector(2000, 0, 0));
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(NodeContainer(nodes.Get(0), nodes.Get(1), nodes.Get(2), nodes.Get(3)));
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(3000, 0, 0));
+    moving->SetVelocity(Vector(-1000, 0, 0));
+    nodes.Get(4)->AggregateObject(moving);
+
+    m_arrivals.assign(nodes.GetN(), 0);
+    for (uint32_t i = 1; i < nodes.GetN(); ++i)
+    {
+        auto dev = DynamicCast<WifiNetDevice>(devices.Get(i));
+        dev->GetPhy()->TraceConnectWithoutContext(
+            "SignalArrival",
+            MakeCallback(&YansWifiChannelFilterTest::SignalArrival, this).Bind(i));
+    }
+
+    auto sender = devices.Get(0);
+    for (auto time : {Seconds(1), Seconds(3)})
+    {
+        Simulator::Schedule(time, [=]() {
+            sender->Send(Create<Packet>(100), sender->GetBroadcast(), 1);
+        });
+    }
+    Simulator::Schedule(Seconds(2), [=]() {
+        nodes.Get(3)->GetObject<MobilityModel>()->SetPosition(Vector(50, 0, 0));
+    });
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const auto filter = name.empty() ? std::string("no filter") : name;
+    for (uint32_t i = 1; i < nodes.GetN(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_arrivals.at(i),
+                              expected.at(i - 1),
+                              "Unexpected number of PPDUs at receiver " << i << " with " << filter);
+    }
+}
+
+void
+YansWifiChannelFilterTest::DoRun()
+{
+    RunOne("", BooleanValue(false), {2, 2, 2, 2});
+    RunOne("MaxRange", DoubleValue(500), {2, 2, 1, 1});
+    RunOne("RxSensitivityCutoff", BooleanValue(true), {2, 2, 1, 1});
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the indexes of the stations known by a WifiRemoteStationManager
+ *
+ * This test checks that the stations get dense indexes in the order in which they become
+ * known, that the MLD address of a remote MLD gets its own index and shares the state of
+ * the affiliated station, and that the indexes are released when the manager is reset.
+ */
+class StationIndexTest : public TestCase
+{
+  public:
+    StationIndexTest();
+
+  private:
+    void DoRun() override;
+};
+
+StationIndexTest::StationIndexTest()
+    : TestCase("Check the indexes of the stations known by a WifiRemoteStationManager")
+{
+}
+
+void
+StationIndexTest::DoRun()
+{
+    NodeContainer nodes(1);
+    auto channel = YansWifiChannelHelper::Default().Create();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto device = DynamicCast<WifiNetDevice>(wifi.Install(phy, mac, nodes).Get(0));
+    auto manager = device->GetRemoteStationManager();
+
+    const std::size_t numStations = 500;
+    std::vector<Mac48Address> addresses;
+    for (std::size_t i = 0; i < numStations; ++i)
+    {
+        addresses.push_back(Mac48Address::Allocate());
+        NS_TEST_EXPECT_MSG_EQ(manager->GetStationIndex(addresses.back()).has_value(),
+                              false,
+                              "The station should not be known yet");
+        manager->SetAssociationId(addresses.back(), i + 1);
+        manager->RecordGotAssocTxOk(addresses.back());
+    }
+    NS_TEST_EXPECT_MSG_EQ(manager->GetNStationIndexes(),
+                          numStations,
+                          "Unexpected number of indexes");
+    for (std::size_t i = 0; i < numStations; ++i)
+    {
+        const auto index = manager->GetStationIndex(addresses[i]);
+        NS_TEST_ASSERT_MSG_EQ(index.has_value(), true, "The station should be known");
+        NS_TEST_EXPECT_MSG_EQ(*index, i, "Unexpected index for station " << addresses[i]);
+        NS_TEST_EXPECT_MSG_EQ(manager->GetAssociationId(addresses[i]),
+                              i + 1,
+                              "Unexpected AID for station " << addresses[i]);
+    }
+
+    // the MLD address gets a new index and shares the state of the affiliated station
+    auto mleCommonInfo = std::make_shared<CommonInfoBasicMle>();
+    mleCommonInfo->m_mldMacAddress = Mac48Address::Allocate();
+    manager->AddStationMleCommonInfo(addresses[7], mleCommonInfo);
+    NS_TEST_EXPECT_MSG_EQ(manager->GetStationIndex(mleCommonInfo->m_mldMacAddress).value_or(0),
+                          numStations,
+                          "Unexpected index for the MLD address");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetMldAddress(addresses[7]).value_or(Mac48Address()),
+                          mleCommonInfo->m_mldMacAddress,
+                          "Unexpected MLD address");
+    NS_TEST_EXPECT_MSG_EQ(
+        manager->GetAffiliatedStaAddress(mleCommonInfo->m_mldMacAddress).value_or(Mac48Address()),
+        addresses[7],
+        "Unexpected affiliated station address");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetAssociationId(mleCommonInfo->m_mldMacAddress),
+                          8,
+                          "The MLD address should share the state of the affiliated station");
+
+    manager->Reset();
+    NS_TEST_EXPECT_MSG_EQ(manager->GetNStationIndexes(), 0, "The indexes should be released");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetStationIndex(addresses[0]).has_value(),
+                          false,
+                          "The station should not be known anymore");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -4012,6 +4395,9 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new NiChangesTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelFilterTest, TestCase::Duration::QUICK);
+    AddTestCase(new StationIndexTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
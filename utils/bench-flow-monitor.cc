@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the overhead of the FlowMonitor:
+// it runs the same simulation of many short UDP flows crossing a router,
+// without and with a FlowMonitor installed on all the nodes, and prints
+// the wall clock time of both runs.
+// Sample usage:  ./ns3 run 'bench-flow-monitor --flows=10000 --packets=20'
+
+#include "ns3/applications-module.h"
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Run the simulation once.
+ *
+ * @param flows the number of flows
+ * @param packets the number of packets of each flow
+ * @param monitor whether to install a FlowMonitor
+ * @param[out] lostPackets the number of packets lost reported by the FlowMonitor
+ * @return the wall clock time of the simulation, in milliseconds
+ */
+static int64_t
+RunSimulation(uint32_t flows, uint32_t packets, bool monitor, uint64_t& lostPackets)
+{
+    Ipv4AddressGenerator::Reset();
+
+    // sources -- router -- sink, with a bottleneck which drops packets when the flows
+    // exceed its rate
+    NodeContainer nodes;
+    nodes.Create(3);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    auto access = p2p.Install(nodes.Get(0), nodes.Get(1));
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    auto bottleneck = p2p.Install(nodes.Get(1), nodes.Get(2));
+
+    Ipv4AddressHelper address("10.1.1.0", "255.255.255.0");
+    address.Assign(access);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    auto sinkInterfaces = address.Assign(bottleneck);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    const uint16_t port = 9;
+    UdpServerHelper server(port);
+    server.Install(nodes.Get(2)).Start(Seconds(0));
+
+    // every client is a flow, with its own source port
+    UdpClientHelper client(sinkInterfaces.GetAddress(1), port);
+    client.SetAttribute("MaxPackets", UintegerValue(packets));
+    client.SetAttribute("Interval", TimeValue(MilliSeconds(10)));
+    client.SetAttribute("PacketSize", UintegerValue(512));
+    ApplicationContainer clients;
+    for (uint32_t i = 0; i < flows; i++)
+    {
+        clients.Add(client.Install(nodes.Get(0)));
+    }
+    auto jitter = CreateObjectWithAttributes<UniformRandomVariable>("Max", DoubleValue(0.01));
+    clients.StartWithJitter(Seconds(1), jitter);
+
+    FlowMonitorHelper flowMonitorHelper;
+    if (monitor)
+    {
+        flowMonitorHelper.SetMonitorAttribute("FlowCapacity", UintegerValue(flows));
+        flowMonitorHelper.InstallAll();
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Stop(Seconds(2) + packets * MilliSeconds(10));
+    Simulator::Run();
+    if (monitor)
+    {
+        flowMonitorHelper.GetMonitor()->CheckForLostPackets();
+    }
+    const int64_t elapsed = time.End();
+
+    lostPackets = 0;
+    if (monitor)
+    {
+        for (const auto& [flowId, stats] : flowMonitorHelper.GetMonitor()->GetFlowStats())
+        {
+            lostPackets += stats.lostPackets;
+        }
+    }
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t flows = 1000;
+    uint32_t packets = 20;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the overhead of the FlowMonitor");
+    cmd.AddValue("flows", "number of UDP flows", flows);
+    cmd.AddValue("packets", "number of packets of each flow", packets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (flows == 0 || packets == 0)
+    {
+        std::cerr << "Error-- the number of flows and packets must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-flow-monitor with " << flows << " flows of " << packets
+              << " packets" << std::endl;
+
+    int64_t withoutMonitor = std::numeric_limits<int64_t>::max();
+    int64_t withMonitor = std::numeric_limits<int64_t>::max();
+    uint64_t lostPackets = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        withoutMonitor =
+            std::min(withoutMonitor, RunSimulation(flows, packets, false, lostPackets));
+        withMonitor = std::min(withMonitor, RunSimulation(flows, packets, true, lostPackets));
+    }
+
+    std::cout << withoutMonitor << " ms\tWithout FlowMonitor" << std::endl;
+    std::cout << withMonitor << " ms\tWith FlowMonitor (" << lostPackets << " packets lost)"
+              << std::endl;
+    if (withoutMonitor > 0)
+    {
+        std::cout << "Overhead: " << 100.0 * (withMonitor - withoutMonitor) / withoutMonitor
+                  << "%" << std::endl;
+    }
+    return 0;
+}
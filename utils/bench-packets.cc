@@ -21,6 +21,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -321,6 +322,33 @@ benchFragment(uint32_t n)
     }
 }
 
+static void
+benchFragmentData(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    std::vector<uint8_t> payload(2000, 0x42);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(payload.data(), payload.size());
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+
+        // fragment and reassemble, as Ipv4L3Protocol does
+        Ptr<Packet> frag0 = p->CreateFragment(0, 1000);
+        Ptr<Packet> frag1 = p->CreateFragment(1000, 1033);
+        frag0->AddHeader(ipv4);
+        frag1->AddHeader(ipv4);
+        frag0->RemoveHeader(ipv4);
+        frag1->RemoveHeader(ipv4);
+        frag0->AddAtEnd(frag1);
+
+        frag0->RemoveHeader(ipv4);
+        frag0->RemoveHeader(udp);
+    }
+}
+
 static void
 benchByteTags(uint32_t n)
 {
@@ -339,6 +367,42 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchTags(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    BenchTag<4> flowId;
+    BenchTag<8> timestamp;
+    BenchTag<12> snr;
+    BenchTag<16> ampdu;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // tag the packet on the sender side, as applications and MACs do
+        Ptr<Packet> p = Create<Packet>(2000);
+        p->AddByteTag(flowId);
+        p->AddByteTag(timestamp);
+        p->AddPacketTag(timestamp);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        p->AddPacketTag(snr);
+        p->AddPacketTag(ampdu);
+
+        // forward a copy over a hop, which replaces and removes tags
+        Ptr<Packet> o = p->Copy();
+        o->ReplacePacketTag(snr);
+        o->RemovePacketTag(ampdu);
+        o->RemoveHeader(ipv4);
+        o->RemovePacketTag(snr);
+        o->AddPacketTag(snr);
+        o->FindFirstMatchingByteTag(timestamp);
+        o->PeekPacketTag(timestamp);
+        o->RemoveHeader(udp);
+        o->RemoveAllPacketTags();
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -371,6 +435,8 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool compactMetadata = false;
+    bool enableChaining = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,6 +445,10 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("compact-metadata",
+                 "enable packet printing with the compact metadata storage",
+                 compactMetadata);
+    cmd.AddValue("enable-chaining", "enable the chaining of buffer segments", enableChaining);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -387,6 +457,15 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
+    if (compactMetadata)
+    {
+        Packet::EnableCompactPrinting();
+    }
+    else if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+    Buffer::SetChainingEnabled(enableChaining);
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
@@ -395,7 +474,12 @@ main(int argc, char* argv[])
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
+    runBench(&benchFragmentData,
+             n,
+             minIterations,
+             "Fragmentation and concatenation of data");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchTags, n, minIterations, "Tag-heavy forwarding");
 
     return 0;
 }
@@ -8,10 +8,12 @@
 
 #include "ns3/core-module.h"
 
+#include <algorithm>
 #include <cmath> // sqrt
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string.h>
 #include <vector>
 
@@ -229,6 +231,7 @@ class BenchSuite
 
     std::string m_scheduler;       /**< Descriptive string for the scheduler. */
     std::vector<Result> m_results; /**< Store for the run results. */
+    EventPool::Stats m_poolStats;  /**< Event allocations during the runs. */
 
 }; // BenchSuite
 
@@ -279,6 +282,8 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     m_results.reserve(runs);
     Header();
 
+    auto poolStats = EventPool::GetStats();
+
     // Prime
     DEB("priming");
     auto prime = bench.Run();
@@ -293,6 +298,14 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     }
 
     Simulator::Destroy();
+
+    m_poolStats = EventPool::GetStats();
+    m_poolStats.allocations -= poolStats.allocations;
+    m_poolStats.deallocations -= poolStats.deallocations;
+    m_poolStats.recycled -= poolStats.recycled;
+    m_poolStats.slabs -= poolStats.slabs;
+    m_poolStats.slabBytes -= poolStats.slabBytes;
+    m_poolStats.largeAllocations -= poolStats.largeAllocations;
 }
 
 void
@@ -318,6 +331,11 @@ BenchSuite::Header() const
 void
 BenchSuite::Log() const
 {
+    LOG("Event allocations: " << m_poolStats.allocations << ", recycled: "
+                              << m_poolStats.recycled << ", system (large): "
+                              << m_poolStats.largeAllocations << ", slabs: " << m_poolStats.slabs
+                              << " (" << m_poolStats.slabBytes << " bytes)");
+
     if (m_results.size() < 2)
     {
         LOG("");
@@ -373,6 +391,134 @@ BenchSuite::Log() const
     LOG("");
 }
 
+/**
+ *  Replay of a recorded event trace, directly against a Scheduler.
+ *
+ *  The trace is a DES Metrics JSON file (see DesMetrics), which records,
+ *  for each scheduled event, the time at which it was scheduled and
+ *  the time at which it expires.  The records are replayed in order:
+ *  before inserting an event scheduled at time \c t, all the events
+ *  expiring before \c t are removed from the scheduler.  This reproduces
+ *  the pending event population and the hold pattern of the recorded
+ *  simulation, without the cost of the event callbacks.
+ */
+class Replay
+{
+  public:
+    /** A trace record. */
+    struct Record
+    {
+        uint64_t now; /**< Time step when the event was scheduled. */
+        uint64_t ts;  /**< Time step when the event expires. */
+    };
+
+    /**
+     * Read the trace.
+     *
+     * @param [in] filename The DES Metrics trace file name.
+     */
+    Replay(const std::string& filename);
+
+    /**
+     * Get the number of records in the trace.
+     *
+     * @returns The number of records.
+     */
+    std::size_t GetSize() const
+    {
+        return m_records.size();
+    }
+
+    /**
+     * Replay the trace for each run.
+     *
+     * @param [in] factory Factory pre-configured to create the desired Scheduler.
+     * @param [in] runs The number of replications.
+     */
+    void Run(ObjectFactory& factory, uint64_t runs) const;
+
+  private:
+    std::vector<Record> m_records; /**< The trace records. */
+};
+
+Replay::Replay(const std::string& filename)
+{
+    std::ifstream input(filename);
+    if (!input.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open " << filename);
+    }
+    std::string line;
+    while (std::getline(input, line))
+    {
+        // event records look like:  ["send","now","recv","ts"]
+        auto start = line.find('[');
+        if (start == std::string::npos || line.find(']', start) == std::string::npos)
+        {
+            continue;
+        }
+        std::string fields = line.substr(start + 1, line.find(']', start) - start - 1);
+        std::replace(fields.begin(), fields.end(), '"', ' ');
+        std::replace(fields.begin(), fields.end(), ',', ' ');
+        std::istringstream iss(fields);
+        uint64_t send;
+        uint64_t recv;
+        Record record;
+        if (iss >> send >> record.now >> recv >> record.ts)
+        {
+            m_records.push_back(record);
+        }
+    }
+    LOG("  Replaying " << filename << ": found " << m_records.size() << " events");
+}
+
+void
+Replay::Run(ObjectFactory& factory, uint64_t runs) const
+{
+    LOG("");
+    LOG(factory.GetTypeId().GetName());
+    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::setw(g_fwidth) << "Time (s)"
+                  << std::setw(g_fwidth) << "Rate (ev/s)" << std::setw(g_fwidth) << "Per (s/ev)"
+                  << "Max pop.");
+
+    for (uint64_t run = 0; run < runs; ++run)
+    {
+        Ptr<Scheduler> scheduler = factory.Create<Scheduler>();
+        uint64_t pop = 0;
+        uint64_t maxPop = 0;
+        uint32_t uid = 0;
+
+        SystemWallClockMs timer;
+        timer.Start();
+        for (const auto& record : m_records)
+        {
+            while (pop > 0 && scheduler->PeekNext().key.m_ts < record.now)
+            {
+                scheduler->RemoveNext();
+                pop--;
+            }
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = std::max(record.ts, record.now);
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            scheduler->Insert(ev);
+            pop++;
+            maxPop = std::max(maxPop, pop);
+        }
+        while (!scheduler->IsEmpty())
+        {
+            scheduler->RemoveNext();
+        }
+        double time = timer.End() / 1000.0;
+
+        LOG(std::left << std::setw(g_fwidth) << run << std::setw(g_fwidth) << time
+                      << std::setw(g_fwidth) << m_records.size() / time << std::setw(g_fwidth)
+                      << time / m_records.size() << maxPop);
+    }
+    LOG("");
+}
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
@@ -443,6 +589,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -451,6 +598,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string replay = "";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -463,11 +611,15 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "Alternatively, --replay=\"<filename>\" replays the events\n"
+              "recorded in a DES Metrics trace directly against the scheduler.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -476,6 +628,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("replay", "DES Metrics trace file to replay", replay);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -491,17 +644,54 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
+    ObjectFactory factory("ns3::MapScheduler");
+
+    if (!replay.empty())
+    {
+        Replay trace(replay);
+        std::vector<std::string> schedulers;
+        if (schedCal)
+        {
+            schedulers.emplace_back("ns3::CalendarScheduler");
+        }
+        if (schedHeap)
+        {
+            schedulers.emplace_back("ns3::HeapScheduler");
+        }
+        if (schedLadder)
+        {
+            schedulers.emplace_back("ns3::LadderScheduler");
+        }
+        if (schedList)
+        {
+            schedulers.emplace_back("ns3::ListScheduler");
+        }
+        if (schedMap)
+        {
+            schedulers.emplace_back("ns3::MapScheduler");
+        }
+        if (schedPQ)
+        {
+            schedulers.emplace_back("ns3::PriorityQueueScheduler");
+        }
+        for (const auto& scheduler : schedulers)
+        {
+            factory.SetTypeId(scheduler);
+            trace.Run(factory, runs);
+        }
+        return 0;
+    }
+
     auto eventStream = GetRandomStream(filename);
 
-    ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
@@ -518,6 +708,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the 3GPP channel model: the generation
+// of new channels, and the per-link cost of updating the received PSD for a
+// gNB with a large antenna array and several UEs, with fixed and with
+// alternating gNB beams.
+// Sample usage:  ./ns3 run 'bench-three-gpp-channel --links=16 --rbs=273'
+
+#include "ns3/channel-condition-model.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/isotropic-antenna-model.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/uinteger.h"
+#include "ns3/uniform-planar-array.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Create a uniform planar array of isotropic elements.
+ *
+ * @param rows the number of rows of the array
+ * @param columns the number of columns of the array
+ * @param ports the number of vertical and horizontal ports
+ * @return the antenna array
+ */
+static Ptr<PhasedArrayModel>
+CreateArray(uint32_t rows, uint32_t columns, uint32_t ports)
+{
+    return CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumRows",
+        UintegerValue(rows),
+        "NumColumns",
+        UintegerValue(columns),
+        "NumVerticalPorts",
+        UintegerValue(ports),
+        "NumHorizontalPorts",
+        UintegerValue(ports),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+}
+
+/**
+ * Point the beam of an antenna array towards another node.
+ *
+ * @param thisMob the mobility model of the node of the array
+ * @param antenna the antenna array
+ * @param otherMob the mobility model of the other node
+ */
+static void
+PointBeam(Ptr<MobilityModel> thisMob, Ptr<PhasedArrayModel> antenna, Ptr<MobilityModel> otherMob)
+{
+    antenna->SetBeamformingVector(
+        antenna->GetBeamformingVector(Angles(otherMob->GetPosition(), thisMob->GetPosition())));
+}
+
+/**
+ * Run a benchmark step several times, and print the minimum time per link.
+ *
+ * @param step the benchmark step, returning the number of links updated
+ * @param minIterations the number of times the step is run
+ * @param name the name of the benchmark
+ */
+static void
+RunBench(const std::function<uint32_t()>& step, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint32_t links = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        links = step();
+        minDelay = std::min<uint64_t>(minDelay, time.End());
+    }
+    std::cout << minDelay * 1000.0 / links << " us/link"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t links = 16;
+    uint32_t rbs = 273;
+    uint32_t gnbRows = 8;
+    uint32_t gnbColumns = 8;
+    uint32_t gnbPorts = 1;
+    uint32_t ueRows = 2;
+    uint32_t ueColumns = 2;
+    uint32_t uePorts = 1;
+    uint32_t beams = 4;
+    uint32_t cacheSize = 4;
+    uint32_t n = 20;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the 3GPP channel model and spectrum propagation loss model");
+    cmd.AddValue("links", "number of UEs, each with a link to the gNB", links);
+    cmd.AddValue("rbs", "number of resource blocks of the PSD", rbs);
+    cmd.AddValue("gnb-rows", "number of rows of the gNB antenna array", gnbRows);
+    cmd.AddValue("gnb-columns", "number of columns of the gNB antenna array", gnbColumns);
+    cmd.AddValue("gnb-ports", "number of vertical and horizontal gNB ports", gnbPorts);
+    cmd.AddValue("ue-rows", "number of rows of the UE antenna arrays", ueRows);
+    cmd.AddValue("ue-columns", "number of columns of the UE antenna arrays", ueColumns);
+    cmd.AddValue("ue-ports", "number of vertical and horizontal UE ports", uePorts);
+    cmd.AddValue("beams", "number of gNB beams alternating in the last benchmark", beams);
+    cmd.AddValue("cache-size", "value of the LongTermCacheSize attribute", cacheSize);
+    cmd.AddValue("n", "number of updates of every link per iteration", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (links == 0 || rbs == 0 || n == 0 || beams == 0)
+    {
+        std::cerr << "Error-- the number of links, RBs, beams and updates must be positive"
+                  << std::endl;
+        return 1;
+    }
+    beams = std::min(beams, links);
+
+    const auto createLossModel = [cacheSize]() {
+        auto lossModel = CreateObjectWithAttributes<ThreeGppSpectrumPropagationLossModel>(
+            "LongTermCacheSize",
+            UintegerValue(cacheSize));
+        lossModel->SetChannelModelAttribute("Frequency", DoubleValue(3.5e9));
+        lossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+        lossModel->SetChannelModelAttribute(
+            "ChannelConditionModel",
+            PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+        return lossModel;
+    };
+    Ptr<ThreeGppSpectrumPropagationLossModel> lossModel;
+
+    // a gNB in the center of a ring of UEs
+    NodeContainer nodes;
+    nodes.Create(links + 1);
+    std::vector<Ptr<MobilityModel>> mobility;
+    for (uint32_t i = 0; i <= links; i++)
+    {
+        auto mob = CreateObject<ConstantPositionMobilityModel>();
+        if (i == 0)
+        {
+            mob->SetPosition(Vector(0.0, 0.0, 25.0));
+        }
+        else
+        {
+            const double angle = 2 * M_PI * i / links;
+            const double distance = 50.0 + 10.0 * i;
+            mob->SetPosition(Vector(distance * cos(angle), distance * sin(angle), 1.5));
+        }
+        nodes.Get(i)->AggregateObject(mob);
+        mobility.push_back(mob);
+    }
+    auto gnbAntenna = CreateArray(gnbRows, gnbColumns, gnbPorts);
+    std::vector<Ptr<PhasedArrayModel>> ueAntennas;
+    for (uint32_t i = 1; i <= links; i++)
+    {
+        ueAntennas.push_back(CreateArray(ueRows, ueColumns, uePorts));
+        PointBeam(mobility[i], ueAntennas.back(), mobility[0]);
+    }
+    PointBeam(mobility[0], gnbAntenna, mobility[1]);
+
+    // a flat PSD made of RBs of 12 subcarriers spaced by 30 kHz
+    std::vector<double> frequencies;
+    const double rbWidth = 12 * 30e3;
+    for (uint32_t rb = 0; rb < rbs; rb++)
+    {
+        frequencies.push_back(3.5e9 + (rb - rbs / 2.0) * rbWidth);
+    }
+    auto psd = Create<SpectrumValue>(Create<SpectrumModel>(frequencies));
+    *psd = 1e-9;
+    auto txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = psd;
+
+    const auto updateLink = [&](uint32_t ue) {
+        lossModel->CalcRxPowerSpectralDensity(txParams,
+                                              mobility[0],
+                                              mobility[ue + 1],
+                                              gnbAntenna,
+                                              ueAntennas[ue]);
+    };
+
+    std::cout << "Running bench-three-gpp-channel with " << links << " links, " << rbs
+              << " RBs, gNB array " << gnbRows << "x" << gnbColumns << ", UE arrays " << ueRows
+              << "x" << ueColumns << std::endl;
+
+    RunBench(
+        [&]() {
+            // the channels are generated again at every iteration
+            lossModel = createLossModel();
+            for (uint32_t ue = 0; ue < links; ue++)
+            {
+                updateLink(ue);
+            }
+            return links;
+        },
+        minIterations,
+        "New channel and long term");
+    RunBench(
+        [&]() {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                for (uint32_t ue = 0; ue < links; ue++)
+                {
+                    updateLink(ue);
+                }
+            }
+            return n * links;
+        },
+        minIterations,
+        "Fixed beams");
+    RunBench(
+        [&]() {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                // the gNB serves the UEs in turn, and interferes with the others
+                PointBeam(mobility[0], gnbAntenna, mobility[1 + i % beams]);
+                for (uint32_t ue = 0; ue < links; ue++)
+                {
+                    updateLink(ue);
+                }
+            }
+            return n * links;
+        },
+        minIterations,
+        "Alternating beams");
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the WifiMacQueue of an AP MLD serving
+// many stations: every station has a receiver address on each link of the AP and
+// the AP has full queues of QoS data frames for every TID. The head of each
+// container queue is inflight (waiting for a Block Ack), the other MPDUs expire
+// after the MaxDelay and are replaced by new ones. Every millisecond, the program
+// peeks the queues the way the MAC does (per link, per TID and receiver) and
+// enqueues new MPDUs into full queues, then it prints the wall clock time.
+// Sample usage:  ./ns3 run 'bench-wifi-mac-queue --stations=1000 --rounds=100'
+
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/frame-exchange-manager.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+
+#include <functional>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/// The TIDs of the frames, one per Access Category
+static const std::vector<uint8_t> g_tids{0, 1, 5, 6};
+
+/// The bench state
+struct Bench
+{
+    Ptr<ApWifiMac> mac;                           //!< the MAC of the AP MLD
+    std::vector<Mac48Address> apAddresses;        //!< the addresses of the AP links
+    std::vector<std::vector<Mac48Address>> peers; //!< the station addresses per link
+    uint32_t next{0};                             //!< the index of the next container queue
+    uint64_t enqueued{0};                         //!< the number of MPDUs enqueued
+    uint64_t expired{0};                          //!< the number of MPDUs with expired lifetime
+};
+
+/**
+ * Get the link, the TID and the receiver address of the container queue with the given index.
+ *
+ * @param bench the bench state
+ * @param index the index of the container queue
+ * @return the link ID, the TID and the receiver address
+ */
+static std::tuple<uint8_t, uint8_t, Mac48Address>
+GetQueue(const Bench& bench, uint32_t index)
+{
+    const uint8_t linkId = index % bench.apAddresses.size();
+    index /= bench.apAddresses.size();
+    const auto& peers = bench.peers[linkId];
+    return {linkId, g_tids[index % g_tids.size()], peers[(index / g_tids.size()) % peers.size()]};
+}
+
+/**
+ * Enqueue an MPDU into the container queue with the given index.
+ *
+ * @param bench the bench state
+ * @param index the index of the container queue
+ * @param inflight whether the MPDU is inflight
+ */
+static void
+Enqueue(Bench& bench, uint32_t index, bool inflight)
+{
+    const auto [linkId, tid, receiver] = GetQueue(bench, index);
+
+    WifiMacHeader header(WIFI_MAC_QOSDATA);
+    header.SetAddr1(receiver);
+    header.SetAddr2(bench.apAddresses[linkId]);
+    header.SetAddr3(bench.apAddresses[linkId]);
+    header.SetQosTid(tid);
+    auto mpdu = Create<WifiMpdu>(Create<Packet>(1000), header);
+    if (bench.mac->GetTxopQueue(QosUtilsMapTidToAc(tid))->Enqueue(mpdu))
+    {
+        bench.enqueued++;
+        if (inflight)
+        {
+            mpdu->SetInFlight(linkId);
+        }
+    }
+}
+
+/**
+ * Peek the queues and enqueue new MPDUs.
+ *
+ * @param bench the bench state
+ * @param nQueues the number of container queues
+ * @param operations the number of peeks and enqueues
+ */
+static void
+Round(Bench& bench, uint32_t nQueues, uint32_t operations)
+{
+    // every link looks for the next frame to transmit in every Access Category
+    for (uint8_t linkId = 0; linkId < bench.apAddresses.size(); linkId++)
+    {
+        for (auto tid : g_tids)
+        {
+            bench.mac->GetTxopQueue(QosUtilsMapTidToAc(tid))->Peek(linkId);
+        }
+    }
+
+    for (uint32_t i = 0; i < operations; i++, bench.next = (bench.next + 1) % nQueues)
+    {
+        // look for the frames to a station, e.g. to aggregate them in an A-MPDU
+        const auto [linkId, tid, receiver] = GetQueue(bench, bench.next);
+        bench.mac->GetTxopQueue(QosUtilsMapTidToAc(tid))->PeekByTidAndAddress(tid, receiver);
+
+        // a new frame arrives while the queue is full
+        Enqueue(bench, bench.next, false);
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 1000;
+    uint32_t links = 3;
+    uint32_t packets = 16;
+    uint32_t inflight = 8;
+    uint32_t rounds = 100;
+    uint32_t operations = 1000;
+    Time maxDelay = MilliSeconds(10);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the WifiMacQueue of an AP MLD serving many stations");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("links", "number of links of the AP MLD (at most 3)", links);
+    cmd.AddValue("packets", "number of MPDUs queued per station, TID and link", packets);
+    cmd.AddValue("inflight", "number of inflight MPDUs at the head of each queue", inflight);
+    cmd.AddValue("rounds", "number of rounds, one per millisecond", rounds);
+    cmd.AddValue("operations", "number of peeks and enqueues per round", operations);
+    cmd.AddValue("maxDelay", "the lifetime of the MPDUs", maxDelay);
+    cmd.Parse(argc, argv);
+
+    if (stations == 0 || links == 0 || links > 3 || packets == 0 || inflight > packets)
+    {
+        std::cerr << "Error-- invalid arguments" << std::endl;
+        return 1;
+    }
+
+    NodeContainer node;
+    node.Create(1);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211be);
+
+    const std::vector<std::pair<std::string, FrequencyRange>> channels{
+        {"{42, 80, BAND_5GHZ, 0}", WIFI_SPECTRUM_5_GHZ},
+        {"{23, 80, BAND_6GHZ, 0}", WIFI_SPECTRUM_6_GHZ},
+        {"{6, 40, BAND_2_4GHZ, 0}", WIFI_SPECTRUM_2_4_GHZ}};
+    SpectrumWifiPhyHelper phy(links);
+    for (uint8_t linkId = 0; linkId < links; linkId++)
+    {
+        phy.Set(linkId, "ChannelSettings", StringValue(channels[linkId].first));
+        phy.AddChannel(CreateObject<MultiModelSpectrumChannel>(), channels[linkId].second);
+    }
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac", "BeaconGeneration", BooleanValue(false));
+    auto device = DynamicCast<WifiNetDevice>(wifi.Install(phy, mac, node).Get(0));
+
+    Bench bench;
+    bench.mac = DynamicCast<ApWifiMac>(device->GetMac());
+    bench.peers.resize(links);
+    for (uint8_t linkId = 0; linkId < links; linkId++)
+    {
+        bench.apAddresses.push_back(bench.mac->GetFrameExchangeManager(linkId)->GetAddress());
+        for (uint32_t i = 0; i < stations; i++)
+        {
+            bench.peers[linkId].push_back(Mac48Address::Allocate());
+        }
+    }
+
+    const uint32_t nQueues = stations * g_tids.size() * links;
+    for (auto tid : g_tids)
+    {
+        auto queue = bench.mac->GetTxopQueue(QosUtilsMapTidToAc(tid));
+        queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, nQueues / g_tids.size() * packets));
+        queue->SetMaxDelay(maxDelay);
+        queue->TraceConnectWithoutContext("Expired",
+                                          Callback<void, Ptr<const WifiMpdu>>(
+                                              [&bench](Ptr<const WifiMpdu>) { bench.expired++; }));
+    }
+
+    std::cout << "Running bench-wifi-mac-queue with " << stations << " stations, "
+              << g_tids.size() << " TIDs, " << links << " links and " << packets
+              << " MPDUs per container queue" << std::endl;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t packet = 0; packet < packets; packet++)
+    {
+        for (uint32_t index = 0; index < nQueues; index++)
+        {
+            Enqueue(bench, index, packet < inflight);
+        }
+    }
+    const int64_t setup = time.End();
+
+    for (uint32_t round = 1; round <= rounds; round++)
+    {
+        Simulator::Schedule(MilliSeconds(round), &Round, std::ref(bench), nQueues, operations);
+    }
+    time.Start();
+    Simulator::Run();
+    const int64_t run = time.End();
+
+    std::cout << setup << " ms\tEnqueue " << nQueues * packets << " MPDUs" << std::endl;
+    std::cout << run << " ms\tRun " << rounds << " rounds (" << bench.enqueued
+              << " MPDUs enqueued, " << bench.expired << " expired)" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+/**
+ * @file
+ * Summarize and compare the event traces recorded by the EventTraceRecorder.
+ */
+
+using namespace ns3;
+
+/** Statistics of an event type. */
+struct TypeStats
+{
+    uint64_t count{0};    //!< Number of events.
+    uint64_t wallTime{0}; //!< Wall clock time spent by the events, in ns.
+};
+
+/**
+ * Print a record.
+ *
+ * @param [in] label The label of the line.
+ * @param [in] reader The trace reader.
+ * @param [in] record The record.
+ */
+void
+PrintRecord(const std::string& label,
+            const EventTraceReader& reader,
+            const EventTraceRecord& record)
+{
+    std::cout << "  " << std::left << std::setw(10) << label;
+    if (record.IsEndOfRun())
+    {
+        std::cout << "end of run at " << TimeStep(record.timestamp).As(Time::S) << std::endl;
+        return;
+    }
+    std::cout << "time " << TimeStep(record.timestamp).As(Time::S) << ", context "
+              << record.context << ", uid " << record.uid << ", "
+              << reader.GetTypeName(record.typeHash) << std::endl;
+}
+
+/**
+ * Print the number of events and the wall clock time per event type.
+ *
+ * @param [in] filename The trace file name.
+ * @return The exit code.
+ */
+int
+Summarize(const std::string& filename)
+{
+    EventTraceReader reader(filename);
+    if (!reader.IsOk())
+    {
+        std::cerr << filename << " is not a valid event trace" << std::endl;
+        return 1;
+    }
+
+    std::map<uint32_t, TypeStats> stats;
+    uint64_t events = 0;
+    uint64_t wallTime = 0;
+    uint64_t lastTimestamp = 0;
+    EventTraceRecord previous;
+    bool hasPrevious = false;
+    EventTraceRecord record;
+    while (reader.Read(record))
+    {
+        // the wall clock time of an event ends with the next record
+        if (hasPrevious && !previous.IsEndOfRun())
+        {
+            auto& s = stats[previous.typeHash];
+            s.count++;
+            s.wallTime += record.wallTime - previous.wallTime;
+            events++;
+            wallTime += record.wallTime - previous.wallTime;
+        }
+        lastTimestamp = record.timestamp;
+        previous = record;
+        hasPrevious = true;
+    }
+    if (hasPrevious && !previous.IsEndOfRun())
+    {
+        // the trace was not closed: the last event has no duration
+        stats[previous.typeHash].count++;
+        events++;
+    }
+
+    std::vector<std::pair<uint32_t, TypeStats>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.wallTime > b.second.wallTime;
+    });
+
+    std::cout << filename << ": " << events << " events, " << sorted.size() << " event types, "
+              << wallTime * 1e-9 << " s wall clock time, up to simulation time "
+              << TimeStep(lastTimestamp).As(Time::S) << std::endl
+              << std::endl;
+    std::cout << std::right << std::setw(12) << "Count" << std::setw(12) << "Wall (s)"
+              << std::setw(9) << "Share" << std::setw(12) << "Mean (ns)"
+              << "  Event type" << std::endl;
+    for (const auto& [hash, s] : sorted)
+    {
+        std::cout << std::right << std::setw(12) << s.count << std::setw(12) << std::fixed
+                  << std::setprecision(3) << s.wallTime * 1e-9 << std::setw(8)
+                  << std::setprecision(1) << (wallTime > 0 ? 100.0 * s.wallTime / wallTime : 0)
+                  << "%" << std::setw(12) << std::setprecision(0)
+                  << (s.count > 0 ? static_cast<double>(s.wallTime) / s.count : 0) << "  "
+                  << reader.GetTypeName(hash) << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * Find the first event which differs between two traces.
+ *
+ * The events are compared on their timestamp, context, uid and type;
+ * the wall clock times are ignored.
+ *
+ * @param [in] filename The first trace file name.
+ * @param [in] otherFilename The second trace file name.
+ * @return The exit code: 0 if the traces are identical, 1 otherwise.
+ */
+int
+Compare(const std::string& filename, const std::string& otherFilename)
+{
+    EventTraceReader reader(filename);
+    EventTraceReader other(otherFilename);
+    if (!reader.IsOk() || !other.IsOk())
+    {
+        std::cerr << "Invalid event trace" << std::endl;
+        return 1;
+    }
+
+    EventTraceRecord record;
+    EventTraceRecord otherRecord;
+    EventTraceRecord previous;
+    uint64_t index = 0;
+    while (true)
+    {
+        bool hasRecord = reader.Read(record);
+        bool hasOtherRecord = other.Read(otherRecord);
+        if (!hasRecord && !hasOtherRecord)
+        {
+            std::cout << "The traces are identical (" << index << " records)" << std::endl;
+            return 0;
+        }
+        bool same = hasRecord && hasOtherRecord && record.timestamp == otherRecord.timestamp &&
+                    record.context == otherRecord.context && record.uid == otherRecord.uid &&
+                    record.typeHash == otherRecord.typeHash;
+        if (!same)
+        {
+            std::cout << "The traces diverge at record " << index << ":" << std::endl;
+            if (index > 0)
+            {
+                PrintRecord("last same", reader, previous);
+            }
+            if (hasRecord)
+            {
+                PrintRecord("first", reader, record);
+            }
+            else
+            {
+                std::cout << "  first     end of trace" << std::endl;
+            }
+            if (hasOtherRecord)
+            {
+                PrintRecord("second", other, otherRecord);
+            }
+            else
+            {
+                std::cout << "  second    end of trace" << std::endl;
+            }
+            return 1;
+        }
+        previous = record;
+        index++;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string filename;
+    std::string compare;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Summarize and compare event traces.\n"
+              "\n"
+              "The event traces are recorded by setting the\n"
+              "ns3::DefaultSimulatorImpl::EventTraceFile attribute.\n"
+              "Without --compare, print the number of events and the wall clock\n"
+              "time spent per event type; with --compare, find the first event\n"
+              "which differs between the two traces.");
+    cmd.AddValue("file", "event trace file", filename);
+    cmd.AddValue("compare", "event trace file to compare with", compare);
+    cmd.Parse(argc, argv);
+
+    if (filename.empty())
+    {
+        std::cerr << "Missing --file argument" << std::endl;
+        return 1;
+    }
+    if (!compare.empty())
+    {
+        return Compare(filename, compare);
+    }
+    return Summarize(filename);
+}